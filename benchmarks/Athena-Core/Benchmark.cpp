@@ -0,0 +1,403 @@
+/** @file   Benchmark.cpp
+    @author Philip Abbet
+
+    Implementation of the class 'Benchmark'
+*/
+
+#include "Benchmark.h"
+#include <Athena-Core/Utils/PerfCounters.h>
+#include <Athena-Core/Utils/Timer.h>
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/prettywriter.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+
+using namespace Athena::Utils;
+using namespace rapidjson;
+
+
+/************************************** CONSTANTS ***************************************/
+
+/// Number of measures of each benchmark (the median one is reported)
+static const unsigned int NB_SAMPLES = 5;
+
+/// Default minimum duration of a measure (in milliseconds)
+static const unsigned long DEFAULT_MEASURE_TIME = 50;
+
+/// Maximum number of iterations of a measure
+static const unsigned int MAX_ITERATIONS = 1000000000;
+
+
+/********************************** STATIC ATTRIBUTES ***********************************/
+
+std::vector<std::string> Benchmark::s_files;
+const void* volatile Benchmark::s_pSink = 0;
+
+
+/*********************************** INTERNAL TYPES *************************************/
+
+/// A measure of a benchmark
+struct tSample
+{
+    double              time;                   ///< Time of an iteration (in nanoseconds)
+    unsigned long long  counters[PerfCounters::NB_COUNTERS];   ///< Performance counters
+
+    bool operator<(const tSample& sample) const
+    {
+        return time < sample.time;
+    }
+};
+
+
+/*********************************** STATIC FUNCTIONS ***********************************/
+
+static bool compareBenchmarks(const Benchmark* pBenchmark1, const Benchmark* pBenchmark2)
+{
+    return pBenchmark1->fullName() < pBenchmark2->fullName();
+}
+
+//-----------------------------------------------------------------------
+
+static bool writeJSON(const std::string& strFileName, const std::vector<Benchmark*>& benchmarks)
+{
+    StringBuffer s;
+    PrettyWriter<StringBuffer> writer(s);
+
+    writer.StartObject();
+    writer.String("benchmarks");
+    writer.StartArray();
+
+    for (std::vector<Benchmark*>::const_iterator iter = benchmarks.begin();
+         iter != benchmarks.end(); ++iter)
+    {
+        const Benchmark::tResult& result = (*iter)->result();
+
+        writer.StartObject();
+
+        writer.String("name");
+        writer.String((*iter)->fullName().c_str());
+
+        writer.String("iterations");
+        writer.Uint(result.nbIterations);
+
+        writer.String("ns_per_iteration");
+        writer.Double(result.nsPerIteration);
+
+        writer.String("min_ns_per_iteration");
+        writer.Double(result.minNsPerIteration);
+
+        if (result.megabytesPerSecond > 0.0)
+        {
+            writer.String("mb_per_second");
+            writer.Double(result.megabytesPerSecond);
+        }
+
+        if (!result.metrics.empty())
+        {
+            writer.String("metrics");
+            writer.StartObject();
+
+            for (Benchmark::tMetricsList::const_iterator iter2 = result.metrics.begin();
+                 iter2 != result.metrics.end(); ++iter2)
+            {
+                writer.String(iter2->first.c_str());
+                writer.Double(iter2->second);
+            }
+
+            writer.EndObject();
+        }
+
+        if (result.bCounters)
+        {
+            writer.String("counters");
+            writer.StartObject();
+
+            writer.String("instructions_per_iteration");
+            writer.Double(result.instructionsPerIteration);
+
+            writer.String("cycles_per_iteration");
+            writer.Double(result.cyclesPerIteration);
+
+            writer.String("ipc");
+            writer.Double(result.ipc);
+
+            writer.String("cache_misses_per_iteration");
+            writer.Double(result.cacheMissesPerIteration);
+
+            writer.String("cache_miss_rate");
+            writer.Double(result.cacheMissRate);
+
+            writer.String("branch_misses_per_iteration");
+            writer.Double(result.branchMissesPerIteration);
+
+            writer.String("branch_miss_rate");
+            writer.Double(result.branchMissRate);
+
+            writer.EndObject();
+        }
+
+        writer.EndObject();
+    }
+
+    writer.EndArray();
+    writer.EndObject();
+
+    FILE* pFile = fopen(strFileName.c_str(), "w");
+    if (!pFile)
+        return false;
+
+    fputs(s.GetString(), pFile);
+    fputs("\n", pFile);
+    fclose(pFile);
+
+    return true;
+}
+
+
+/****************************** CONSTRUCTION / DESTRUCTION ******************************/
+
+Benchmark::Benchmark(const char* strCategory, const char* strName, tFunction function)
+: m_strFullName(std::string(strCategory) + "/" + strName), m_function(function),
+  m_bytesPerIteration(0)
+{
+    m_result.nbIterations       = 0;
+    m_result.nsPerIteration     = 0.0;
+    m_result.minNsPerIteration  = 0.0;
+    m_result.megabytesPerSecond = 0.0;
+
+    m_result.bCounters                  = false;
+    m_result.instructionsPerIteration   = 0.0;
+    m_result.cyclesPerIteration         = 0.0;
+    m_result.ipc                        = 0.0;
+    m_result.cacheMissesPerIteration    = 0.0;
+    m_result.cacheMissRate              = 0.0;
+    m_result.branchMissesPerIteration   = 0.0;
+    m_result.branchMissRate             = 0.0;
+
+    benchmarks().push_back(this);
+}
+
+
+/*************************************** METHODS ****************************************/
+
+double Benchmark::measure(unsigned int nbIterations, PerfCounters* pCounters)
+{
+    Timer timer;
+
+    if (pCounters)
+        pCounters->start();
+
+    timer.reset();
+    m_function(*this, nbIterations);
+    double time = (double) timer.getNanoseconds();
+
+    if (pCounters)
+        pCounters->stop();
+
+    return time;
+}
+
+//-----------------------------------------------------------------------
+
+void Benchmark::run(unsigned long minMeasureTime, PerfCounters* pCounters)
+{
+    const double minTime = minMeasureTime * 1000000.0;
+
+    // Warm-up (the benchmarks can prepare their data during the first call)
+    measure(1);
+
+    // Find the number of iterations needed to reach a tenth of the minimum duration of a
+    // measure
+    unsigned int nbIterations = 1;
+    double time = measure(nbIterations);
+
+    while ((time < minTime / 10.0) && (nbIterations < MAX_ITERATIONS))
+    {
+        nbIterations = (unsigned int) std::min((double) MAX_ITERATIONS, nbIterations * 10.0);
+        time = measure(nbIterations);
+    }
+
+    // Scale the number of iterations to reach the minimum duration
+    if (time < minTime)
+    {
+        double factor = (time > 0.0 ? minTime / time : 10.0);
+        nbIterations = (unsigned int) std::min((double) MAX_ITERATIONS,
+                                               nbIterations * factor + 1.0);
+    }
+
+    // Measures
+    if (pCounters && !pCounters->isAvailable())
+        pCounters = 0;
+
+    std::vector<tSample> samples;
+    for (unsigned int i = 0; i < NB_SAMPLES; ++i)
+    {
+        tSample sample;
+        sample.time = measure(nbIterations, pCounters) / nbIterations;
+
+        for (unsigned int j = 0; j < PerfCounters::NB_COUNTERS; ++j)
+        {
+            sample.counters[j] = (pCounters ?
+                                  pCounters->value((PerfCounters::tCounter) (1 << j)) : 0);
+        }
+
+        samples.push_back(sample);
+    }
+
+    std::sort(samples.begin(), samples.end());
+
+    const tSample& median = samples[NB_SAMPLES / 2];
+
+    m_result.nbIterations       = nbIterations;
+    m_result.nsPerIteration     = median.time;
+    m_result.minNsPerIteration  = samples[0].time;
+    m_result.megabytesPerSecond = 0.0;
+
+    if ((m_bytesPerIteration > 0) && (m_result.nsPerIteration > 0.0))
+        m_result.megabytesPerSecond = m_bytesPerIteration * 1000.0 / m_result.nsPerIteration;
+
+    // Performance counters of the median measure
+    m_result.bCounters = (pCounters != 0);
+
+    if (pCounters)
+    {
+        const unsigned long long* counters = median.counters;
+
+        double instructions     = (double) counters[0];
+        double cycles           = (double) counters[1];
+        double cacheReferences  = (double) counters[2];
+        double cacheMisses      = (double) counters[3];
+        double branches         = (double) counters[4];
+        double branchMisses     = (double) counters[5];
+
+        m_result.instructionsPerIteration   = instructions / nbIterations;
+        m_result.cyclesPerIteration         = cycles / nbIterations;
+        m_result.ipc                        = (cycles > 0.0 ? instructions / cycles : 0.0);
+        m_result.cacheMissesPerIteration    = cacheMisses / nbIterations;
+        m_result.cacheMissRate              = (cacheReferences > 0.0 ?
+                                               cacheMisses / cacheReferences : 0.0);
+        m_result.branchMissesPerIteration   = branchMisses / nbIterations;
+        m_result.branchMissRate             = (branches > 0.0 ? branchMisses / branches : 0.0);
+    }
+}
+
+
+/************************************ STATIC METHODS ************************************/
+
+std::vector<Benchmark*>& Benchmark::benchmarks()
+{
+    static std::vector<Benchmark*> benchmarks;
+    return benchmarks;
+}
+
+//-----------------------------------------------------------------------
+
+int Benchmark::runAll(int argc, char** argv)
+{
+    std::string strFilter;
+    std::string strJSONFile;
+    unsigned long measureTime = DEFAULT_MEASURE_TIME;
+    bool bCounters = true;
+
+    // Parse the command line
+    for (int i = 1; i < argc; ++i)
+    {
+        if ((strcmp(argv[i], "--filter") == 0) && (i + 1 < argc))
+        {
+            strFilter = argv[++i];
+        }
+        else if ((strcmp(argv[i], "--json") == 0) && (i + 1 < argc))
+        {
+            strJSONFile = argv[++i];
+        }
+        else if ((strcmp(argv[i], "--time") == 0) && (i + 1 < argc))
+        {
+            measureTime = strtoul(argv[++i], 0, 10);
+            if (measureTime == 0)
+                measureTime = DEFAULT_MEASURE_TIME;
+        }
+        else if (strcmp(argv[i], "--no-counters") == 0)
+        {
+            bCounters = false;
+        }
+        else if (strncmp(argv[i], "--", 2) == 0)
+        {
+            fprintf(stderr, "Usage: %s [--filter <text>] [--json <file>] [--time <ms>] "
+                            "[--no-counters] [data files]\n", argv[0]);
+            return 1;
+        }
+        else
+        {
+            s_files.push_back(argv[i]);
+        }
+    }
+
+    // Select the benchmarks to run
+    std::vector<Benchmark*> selected;
+    for (std::vector<Benchmark*>::iterator iter = benchmarks().begin();
+         iter != benchmarks().end(); ++iter)
+    {
+        if (strFilter.empty() || ((*iter)->fullName().find(strFilter) != std::string::npos))
+            selected.push_back(*iter);
+    }
+
+    std::sort(selected.begin(), selected.end(), compareBenchmarks);
+
+    // Hardware performance counters
+    PerfCounters counters(bCounters ? (unsigned int) PerfCounters::ALL_COUNTERS : 0);
+
+    if (bCounters && !counters.isAvailable())
+        printf("(the hardware performance counters aren't available)\n\n");
+
+    // Run them
+    printf("%-45s %12s %14s %14s %12s", "Benchmark", "Iterations", "ns/iteration",
+           "min ns/iter.", "MB/s");
+
+    if (counters.isAvailable())
+        printf(" %8s %12s %10s %10s", "IPC", "instr./iter.", "LLC miss%", "br. miss%");
+
+    printf("\n");
+
+    for (std::vector<Benchmark*>::iterator iter = selected.begin();
+         iter != selected.end(); ++iter)
+    {
+        Benchmark* pBenchmark = *iter;
+
+        pBenchmark->run(measureTime, &counters);
+
+        const tResult& result = pBenchmark->result();
+
+        printf("%-45s %12u %14.2f %14.2f ", pBenchmark->fullName().c_str(),
+               result.nbIterations, result.nsPerIteration, result.minNsPerIteration);
+
+        if (result.megabytesPerSecond > 0.0)
+            printf("%12.1f", result.megabytesPerSecond);
+        else
+            printf("%12s", "-");
+
+        if (result.bCounters)
+        {
+            printf(" %8.2f %12.1f %10.2f %10.2f", result.ipc, result.instructionsPerIteration,
+                   result.cacheMissRate * 100.0, result.branchMissRate * 100.0);
+        }
+
+        for (tMetricsList::const_iterator iter2 = result.metrics.begin();
+             iter2 != result.metrics.end(); ++iter2)
+        {
+            printf("  %s=%g", iter2->first.c_str(), iter2->second);
+        }
+
+        printf("\n");
+        fflush(stdout);
+    }
+
+    if (!strJSONFile.empty() && !writeJSON(strJSONFile, selected))
+    {
+        fprintf(stderr, "Failed to write the results in '%s'\n", strJSONFile.c_str());
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,198 @@
+/** @file   Benchmark.h
+    @author Philip Abbet
+
+    Declaration of the class 'Benchmark'
+*/
+
+#ifndef _BENCHMARK_H_
+#define _BENCHMARK_H_
+
+#include <Athena-Core/Prerequisites.h>
+#include <string>
+#include <vector>
+#include <map>
+
+
+//----------------------------------------------------------------------------------------
+/// @brief  A benchmark, measuring the time taken by some code
+///
+/// The benchmarks are declared with the BENCHMARK macro, and register themselves when the
+/// program starts. Their function receives the number of iterations to execute, chosen
+/// by the harness so each measure lasts long enough to be meaningful:
+/// @code
+///     BENCHMARK(Variant, ConstructInt)
+///     {
+///         for (unsigned int i = 0; i < nbIterations; ++i)
+///             Benchmark::keep(Variant((int) i));
+///     }
+/// @endcode
+///
+/// Each benchmark is measured several times, the reported time being the median one.
+/// When the hardware performance counters are available (see Athena::Utils::PerfCounters),
+/// they are read during each measure, and the ones of the median measure are reported
+/// (instructions and cycles per iteration, IPC, cache and branch miss rates).
+/// The results can be written in a JSON file (sorted by name, so the files produced by
+/// two builds can be compared).
+//----------------------------------------------------------------------------------------
+class Benchmark
+{
+    //_____ Internal types __________
+public:
+    typedef void (*tFunction)(Benchmark& benchmark, unsigned int nbIterations);
+
+    typedef std::map<std::string, double> tMetricsList;
+
+    /// Result of a benchmark
+    struct tResult
+    {
+        unsigned int    nbIterations;       ///< Number of iterations of each measure
+        double          nsPerIteration;     ///< Median time of an iteration
+        double          minNsPerIteration;  ///< Fastest time of an iteration
+        double          megabytesPerSecond; ///< Throughput (0 if unknown)
+        tMetricsList    metrics;            ///< Additional results reported by the benchmark
+
+        bool            bCounters;                  ///< Indicates if the following are known
+        double          instructionsPerIteration;   ///< Instructions retired per iteration
+        double          cyclesPerIteration;         ///< CPU cycles per iteration
+        double          ipc;                        ///< Instructions per cycle
+        double          cacheMissesPerIteration;    ///< Last level cache misses per iteration
+        double          cacheMissRate;              ///< Ratio of last level cache misses
+        double          branchMissesPerIteration;   ///< Mispredicted branches per iteration
+        double          branchMissRate;             ///< Ratio of mispredicted branches
+    };
+
+
+    //_____ Construction / Destruction __________
+public:
+    //------------------------------------------------------------------------------------
+    /// @brief  Constructor (registers the benchmark)
+    ///
+    /// @param  strCategory     Category of the benchmark
+    /// @param  strName         Name of the benchmark
+    /// @param  function        The function to measure
+    //------------------------------------------------------------------------------------
+    Benchmark(const char* strCategory, const char* strName, tFunction function);
+
+
+    //_____ Methods called by the benchmarks __________
+public:
+    //------------------------------------------------------------------------------------
+    /// @brief  Set the number of bytes processed by each iteration (to report the
+    ///         throughput)
+    //------------------------------------------------------------------------------------
+    inline void setBytesPerIteration(size_t nbBytes)
+    {
+        m_bytesPerIteration = nbBytes;
+    }
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Report an additional result (for instance, a compression ratio)
+    //------------------------------------------------------------------------------------
+    inline void setMetric(const std::string& strName, double value)
+    {
+        m_result.metrics[strName] = value;
+    }
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Prevent the compiler from optimizing away the computation of a value
+    //------------------------------------------------------------------------------------
+    template<typename T>
+    static inline void keep(const T& value)
+    {
+#if defined(__GNUC__)
+        __asm__ __volatile__("" : : "r"(&value) : "memory");
+#else
+        s_pSink = &value;
+#endif
+    }
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Returns the data files given on the command line
+    //------------------------------------------------------------------------------------
+    static inline const std::vector<std::string>& files()
+    {
+        return s_files;
+    }
+
+
+    //_____ Methods called by the harness __________
+public:
+    //------------------------------------------------------------------------------------
+    /// @brief  Run the benchmarks
+    ///
+    /// Usage: Benchmarks-Athena-Core [--filter <text>] [--json <file>] [--time <ms>]
+    ///                               [--no-counters] [data files]
+    ///   - filter:      only run the benchmarks whose full name contains the text
+    ///   - json:        write the results in a JSON file
+    ///   - time:        minimum duration of each measure (50 ms by default)
+    ///   - no-counters: don't read the hardware performance counters
+    ///
+    /// @return The exit code of the program
+    //------------------------------------------------------------------------------------
+    static int runAll(int argc, char** argv);
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Returns the full name of the benchmark ("category/name")
+    //------------------------------------------------------------------------------------
+    inline const std::string& fullName() const
+    {
+        return m_strFullName;
+    }
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Returns the result of the benchmark
+    //------------------------------------------------------------------------------------
+    inline const tResult& result() const
+    {
+        return m_result;
+    }
+
+private:
+    //------------------------------------------------------------------------------------
+    /// @brief  Measure the benchmark
+    ///
+    /// @param  minMeasureTime  Minimum duration of each measure (in milliseconds)
+    /// @param  pCounters       The performance counters to read during the measures (can
+    ///                         be 0)
+    //------------------------------------------------------------------------------------
+    void run(unsigned long minMeasureTime, Athena::Utils::PerfCounters* pCounters);
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Execute a number of iterations and returns the time taken (in
+    ///         nanoseconds)
+    ///
+    /// If performance counters are given, they are read during the execution.
+    //------------------------------------------------------------------------------------
+    double measure(unsigned int nbIterations, Athena::Utils::PerfCounters* pCounters = 0);
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Returns the list of registered benchmarks
+    //------------------------------------------------------------------------------------
+    static std::vector<Benchmark*>& benchmarks();
+
+
+    //_____ Attributes __________
+private:
+    std::string     m_strFullName;          ///< Full name of the benchmark
+    tFunction       m_function;             ///< The function to measure
+    size_t          m_bytesPerIteration;    ///< Number of bytes processed by each iteration
+    tResult         m_result;               ///< The result
+
+    static std::vector<std::string> s_files;    ///< The data files
+    static const void* volatile     s_pSink;    ///< Used by keep()
+};
+
+
+//----------------------------------------------------------------------------------------
+/// @brief  Declare a benchmark
+///
+/// The body of the benchmark can use the variables 'benchmark' (the Benchmark object)
+/// and 'nbIterations'.
+//----------------------------------------------------------------------------------------
+#define BENCHMARK(CATEGORY, NAME)                                                          \
+    static void benchmark_##CATEGORY##_##NAME(Benchmark& benchmark, unsigned int nbIterations); \
+    static Benchmark registration_##CATEGORY##_##NAME(#CATEGORY, #NAME,                   \
+                                                      benchmark_##CATEGORY##_##NAME);      \
+    static void benchmark_##CATEGORY##_##NAME(Benchmark& benchmark, unsigned int nbIterations)
+
+#endif
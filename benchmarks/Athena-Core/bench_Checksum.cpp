@@ -0,0 +1,56 @@
+#include "Benchmark.h"
+#include <Athena-Core/Data/Checksum.h>
+
+using namespace Athena::Data;
+
+
+/// Size of the buffer used to measure the throughput
+static const size_t BUFFER_SIZE = 16 * 1024 * 1024;
+
+
+//-----------------------------------------------------------------------
+
+static const std::vector<unsigned char>& data()
+{
+    static std::vector<unsigned char> data;
+
+    if (data.empty())
+    {
+        data.resize(BUFFER_SIZE);
+        for (size_t i = 0; i < BUFFER_SIZE; ++i)
+            data[i] = (unsigned char) (i * 2654435761U >> 24);
+    }
+
+    return data;
+}
+
+//-----------------------------------------------------------------------
+
+BENCHMARK(Checksum, CRC32C)
+{
+    const std::vector<unsigned char>& buffer = data();
+
+    benchmark.setBytesPerIteration(buffer.size());
+    benchmark.setMetric("accelerated", Checksum::isCRC32CAccelerated() ? 1.0 : 0.0);
+
+    unsigned int crc = 0;
+    for (unsigned int i = 0; i < nbIterations; ++i)
+        crc ^= Checksum::crc32c(&buffer[0], buffer.size());
+
+    Benchmark::keep(crc);
+}
+
+//-----------------------------------------------------------------------
+
+BENCHMARK(Checksum, Hash64)
+{
+    const std::vector<unsigned char>& buffer = data();
+
+    benchmark.setBytesPerIteration(buffer.size());
+
+    unsigned long long hash = 0;
+    for (unsigned int i = 0; i < nbIterations; ++i)
+        hash ^= Checksum::hash64(&buffer[0], buffer.size());
+
+    Benchmark::keep(hash);
+}
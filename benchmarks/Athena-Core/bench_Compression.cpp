@@ -0,0 +1,216 @@
+#include "Benchmark.h"
+#include <Athena-Core/Data/CompressedDataStream.h>
+#include <Athena-Core/Data/FileDataStream.h>
+#include <Athena-Core/Data/LZCodec.h>
+#include <stdio.h>
+#include <algorithm>
+
+using namespace Athena::Data;
+
+
+/// Size of the blocks
+static const size_t BLOCK_SIZE = 64 * 1024;
+
+/// Name of the compressed file
+static const char* COMPRESSED_FILE = ATHENA_CORE_BENCHMARKS_GENERATED_PATH "compressed.bin";
+
+
+//-----------------------------------------------------------------------
+
+/// Generate a JSON scene (similar to the ones exported by the editor)
+static std::string generateScene(unsigned int nbEntities)
+{
+    std::string scene = "{\n    \"entities\": [\n";
+
+    for (unsigned int i = 0; i < nbEntities; ++i)
+    {
+        char buffer[512];
+        sprintf(buffer,
+                "        {\n"
+                "            \"name\": \"Entity%u\",\n"
+                "            \"transforms\": { \"position\": [%.3f, %.3f, %.3f], \"orientation\": [1.0, 0.0, 0.0, 0.0], \"scale\": [1.0, 1.0, 1.0] },\n"
+                "            \"components\": [ { \"type\": \"Visual/Object\", \"mesh\": \"mesh%u.mesh\", \"castShadows\": %s } ]\n"
+                "        }%s\n",
+                i, (i % 97) * 1.5f, (i % 13) * 0.25f, (i / 97) * -2.0f, i % 20,
+                (i % 3 == 0 ? "true" : "false"), (i + 1 < nbEntities ? "," : ""));
+        scene += buffer;
+    }
+
+    scene += "    ]\n}\n";
+
+    return scene;
+}
+
+//-----------------------------------------------------------------------
+
+/// Returns the content to compress: the files given on the command line (concatenated),
+/// or a generated scene
+static const std::string& content()
+{
+    static std::string content;
+
+    if (!content.empty())
+        return content;
+
+    const std::vector<std::string>& files = Benchmark::files();
+    for (std::vector<std::string>::const_iterator iter = files.begin(); iter != files.end(); ++iter)
+    {
+        FileDataStream stream(*iter);
+        if (!stream.isOpen())
+        {
+            fprintf(stderr, "Failed to open '%s'\n", iter->c_str());
+            continue;
+        }
+
+        char buffer[BLOCK_SIZE];
+        size_t count;
+
+        while ((count = stream.read(buffer, BLOCK_SIZE)) > 0)
+            content.append(buffer, count);
+    }
+
+    if (content.empty())
+        content = generateScene(20000);
+
+    return content;
+}
+
+//-----------------------------------------------------------------------
+
+/// Compress the content in blocks, returns the total compressed size
+static size_t compressBlocks(const std::string& content, std::vector<std::vector<char> >* pBlocks)
+{
+    std::vector<char> compressed(LZCodec::maxCompressedSize(BLOCK_SIZE));
+    size_t compressedSize = 0;
+
+    for (size_t offset = 0; offset < content.size(); offset += BLOCK_SIZE)
+    {
+        size_t size = std::min(BLOCK_SIZE, content.size() - offset);
+        size_t result = LZCodec::compress(content.data() + offset, size, &compressed[0],
+                                          compressed.size());
+
+        if (pBlocks)
+            pBlocks->push_back(std::vector<char>(compressed.begin(), compressed.begin() + result));
+
+        compressedSize += result;
+    }
+
+    return compressedSize;
+}
+
+//-----------------------------------------------------------------------
+
+/// Write the compressed file (if not already done)
+static void writeCompressedFile()
+{
+    static bool bWritten = false;
+
+    if (bWritten)
+        return;
+
+    const std::string& data = content();
+
+    CompressedDataStream stream(new FileDataStream(COMPRESSED_FILE, DataStream::WRITE),
+                                DataStream::WRITE, BLOCK_SIZE);
+    stream.write(data.data(), data.size());
+
+    bWritten = true;
+}
+
+//-----------------------------------------------------------------------
+
+BENCHMARK(Compression, Compress)
+{
+    const std::string& data = content();
+
+    benchmark.setBytesPerIteration(data.size());
+
+    size_t compressedSize = 0;
+    for (unsigned int i = 0; i < nbIterations; ++i)
+        compressedSize = compressBlocks(data, 0);
+
+    benchmark.setMetric("ratio", (compressedSize > 0 ? (double) data.size() / compressedSize : 0.0));
+}
+
+//-----------------------------------------------------------------------
+
+BENCHMARK(Compression, Decompress)
+{
+    const std::string& data = content();
+
+    static std::vector<std::vector<char> > blocks;
+    if (blocks.empty())
+        compressBlocks(data, &blocks);
+
+    benchmark.setBytesPerIteration(data.size());
+
+    std::vector<char> decompressed(BLOCK_SIZE);
+    bool bSuccess = true;
+
+    for (unsigned int i = 0; i < nbIterations; ++i)
+    {
+        for (size_t j = 0; j < blocks.size(); ++j)
+        {
+            size_t size = std::min(BLOCK_SIZE, data.size() - j * BLOCK_SIZE);
+            bSuccess = LZCodec::decompress(&blocks[j][0], blocks[j].size(), &decompressed[0],
+                                           size) && bSuccess;
+        }
+    }
+
+    benchmark.setMetric("failed", bSuccess ? 0.0 : 1.0);
+}
+
+//-----------------------------------------------------------------------
+
+BENCHMARK(Compression, StreamWrite)
+{
+    const std::string& data = content();
+
+    benchmark.setBytesPerIteration(data.size());
+
+    for (unsigned int i = 0; i < nbIterations; ++i)
+    {
+        CompressedDataStream stream(new FileDataStream(COMPRESSED_FILE, DataStream::WRITE),
+                                    DataStream::WRITE, BLOCK_SIZE);
+        stream.write(data.data(), data.size());
+    }
+}
+
+//-----------------------------------------------------------------------
+
+BENCHMARK(Compression, StreamRead)
+{
+    writeCompressedFile();
+
+    benchmark.setBytesPerIteration(content().size());
+
+    char buffer[4096];
+
+    for (unsigned int i = 0; i < nbIterations; ++i)
+    {
+        CompressedDataStream stream(new FileDataStream(COMPRESSED_FILE));
+        while (stream.read(buffer, sizeof(buffer)) > 0)
+            ;
+    }
+}
+
+//-----------------------------------------------------------------------
+
+BENCHMARK(Compression, StreamSeek)
+{
+    writeCompressedFile();
+
+    CompressedDataStream stream(new FileDataStream(COMPRESSED_FILE));
+    const size_t size = content().size();
+    char buffer[16];
+    unsigned int seed = 1;
+
+    for (unsigned int i = 0; i < nbIterations; ++i)
+    {
+        seed = seed * 1103515245 + 12345;
+        stream.seek((seed >> 8) % (size + 1));
+        stream.read(buffer, sizeof(buffer));
+    }
+
+    Benchmark::keep(buffer);
+}
@@ -0,0 +1,85 @@
+#include "Benchmark.h"
+#include <Athena-Core/Data/MemoryDataStream.h>
+#include <Athena-Core/Data/FileDataStream.h>
+#include <stdio.h>
+
+using namespace Athena::Data;
+
+
+/// Number of lines of the text
+static const unsigned int NB_LINES = 10000;
+
+/// Name of the text file
+static const char* TEXT_FILE = ATHENA_CORE_BENCHMARKS_GENERATED_PATH "lines.txt";
+
+
+//-----------------------------------------------------------------------
+
+/// Returns a text made of lines of various lengths
+static const std::string& text()
+{
+    static std::string text;
+
+    if (text.empty())
+    {
+        for (unsigned int i = 0; i < NB_LINES; ++i)
+        {
+            char buffer[32];
+            sprintf(buffer, "  line %u: ", i);
+            text += buffer;
+            text.append(i % 80, 'a' + (i % 26));
+            text += (i % 4 == 0 ? "\r\n" : "\n");
+        }
+
+        FileDataStream stream(TEXT_FILE, DataStream::WRITE);
+        stream.write(text.data(), text.size());
+    }
+
+    return text;
+}
+
+//-----------------------------------------------------------------------
+
+BENCHMARK(DataStream, GetLineMemory)
+{
+    const std::string& content = text();
+
+    benchmark.setBytesPerIteration(content.size());
+
+    for (unsigned int i = 0; i < nbIterations; ++i)
+    {
+        MemoryDataStream stream(content.data(), content.size());
+        while (!stream.eof())
+            Benchmark::keep(stream.getLine());
+    }
+}
+
+//-----------------------------------------------------------------------
+
+BENCHMARK(DataStream, GetLineFile)
+{
+    benchmark.setBytesPerIteration(text().size());
+
+    for (unsigned int i = 0; i < nbIterations; ++i)
+    {
+        FileDataStream stream(TEXT_FILE);
+        while (!stream.eof())
+            Benchmark::keep(stream.getLine());
+    }
+}
+
+//-----------------------------------------------------------------------
+
+BENCHMARK(DataStream, GetLineUntrimmed)
+{
+    const std::string& content = text();
+
+    benchmark.setBytesPerIteration(content.size());
+
+    for (unsigned int i = 0; i < nbIterations; ++i)
+    {
+        MemoryDataStream stream(content.data(), content.size());
+        while (!stream.eof())
+            Benchmark::keep(stream.getLine(false));
+    }
+}
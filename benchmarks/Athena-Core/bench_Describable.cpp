@@ -0,0 +1,307 @@
+#include "Benchmark.h"
+#include <Athena-Core/Utils/PropertiesTable.h>
+#include <Athena-Core/Data/Serialization.h>
+
+using namespace Athena::Data;
+using namespace Athena::Utils;
+
+
+/// Names of the properties of the describables
+static const char* NAMES[] = { "x", "y", "z", "yaw", "pitch", "roll", "scaleX", "scaleY",
+                               "scaleZ", "range", "intensity", "visible" };
+
+/// Number of properties of the describables
+static const unsigned int NB_PROPERTIES = sizeof(NAMES) / sizeof(NAMES[0]);
+
+
+//-----------------------------------------------------------------------
+/// Describable implementing its methods by hand
+//-----------------------------------------------------------------------
+class HandwrittenDescribable: public Describable
+{
+public:
+    HandwrittenDescribable()
+    {
+        for (unsigned int i = 0; i < NB_PROPERTIES - 1; ++i)
+            values[i] = 0.0f;
+
+        bVisible = true;
+    }
+
+    virtual PropertiesList* getProperties() const
+    {
+        PropertiesList* pList = Describable::getProperties();
+
+        pList->selectCategory("Node", false);
+
+        for (unsigned int i = 0; i < NB_PROPERTIES - 1; ++i)
+            pList->set(NAMES[i], new Variant(values[i]));
+
+        pList->set("visible", new Variant(bVisible));
+
+        return pList;
+    }
+
+    virtual bool setProperty(const std::string& strCategory, const std::string& strName,
+                             Variant* pValue)
+    {
+        if (strCategory == "Node")
+        {
+            if (strName == "x")
+                values[0] = pValue->toFloat();
+            else if (strName == "y")
+                values[1] = pValue->toFloat();
+            else if (strName == "z")
+                values[2] = pValue->toFloat();
+            else if (strName == "yaw")
+                values[3] = pValue->toFloat();
+            else if (strName == "pitch")
+                values[4] = pValue->toFloat();
+            else if (strName == "roll")
+                values[5] = pValue->toFloat();
+            else if (strName == "scaleX")
+                values[6] = pValue->toFloat();
+            else if (strName == "scaleY")
+                values[7] = pValue->toFloat();
+            else if (strName == "scaleZ")
+                values[8] = pValue->toFloat();
+            else if (strName == "range")
+                values[9] = pValue->toFloat();
+            else if (strName == "intensity")
+                values[10] = pValue->toFloat();
+            else if (strName == "visible")
+                bVisible = pValue->toBool();
+
+            delete pValue;
+            return true;
+        }
+
+        return Describable::setProperty(strCategory, strName, pValue);
+    }
+
+    float values[NB_PROPERTIES - 1];
+    bool  bVisible;
+};
+
+
+//-----------------------------------------------------------------------
+/// Same describable, using a table of properties
+//-----------------------------------------------------------------------
+class TableDescribable: public Describable
+{
+    ATHENA_DESCRIBABLE(TableDescribable, Describable)
+
+public:
+    TableDescribable()
+    : x(0.0f), y(0.0f), z(0.0f), yaw(0.0f), pitch(0.0f), roll(0.0f), scaleX(0.0f),
+      scaleY(0.0f), scaleZ(0.0f), range(0.0f), intensity(0.0f), bVisible(true)
+    {
+    }
+
+    float x, y, z, yaw, pitch, roll, scaleX, scaleY, scaleZ, range, intensity;
+    bool  bVisible;
+};
+
+
+ATHENA_PROPERTIES_BEGIN(TableDescribable, "Node")
+    ATHENA_PROPERTY("x",            float,  x)
+    ATHENA_PROPERTY("y",            float,  y)
+    ATHENA_PROPERTY("z",            float,  z)
+    ATHENA_PROPERTY("yaw",          float,  yaw)
+    ATHENA_PROPERTY("pitch",        float,  pitch)
+    ATHENA_PROPERTY("roll",         float,  roll)
+    ATHENA_PROPERTY("scaleX",       float,  scaleX)
+    ATHENA_PROPERTY("scaleY",       float,  scaleY)
+    ATHENA_PROPERTY("scaleZ",       float,  scaleZ)
+    ATHENA_PROPERTY("range",        float,  range)
+    ATHENA_PROPERTY("intensity",    float,  intensity)
+    ATHENA_PROPERTY("visible",      bool,   bVisible)
+ATHENA_PROPERTIES_END()
+
+
+//-----------------------------------------------------------------------
+
+template<class T>
+static void setProperties(Benchmark& benchmark, unsigned int nbIterations)
+{
+    T describable;
+    std::string strCategory = "Node";
+    std::vector<std::string> names(NAMES, NAMES + NB_PROPERTIES);
+    Variant value(1.0f);
+
+    for (unsigned int i = 0; i < nbIterations; ++i)
+    {
+        for (unsigned int p = 0; p < NB_PROPERTIES; ++p)
+            describable.setProperty(strCategory, names[p], new Variant(value));
+    }
+
+    benchmark.setMetric("properties_per_iteration", NB_PROPERTIES);
+}
+
+//-----------------------------------------------------------------------
+
+template<class T>
+static void getProperties(Benchmark& benchmark, unsigned int nbIterations)
+{
+    T describable;
+    unsigned int total = 0;
+
+    for (unsigned int i = 0; i < nbIterations; ++i)
+    {
+        PropertiesList* pList = describable.getProperties();
+        total += pList->nbTotalProperties();
+        delete pList;
+    }
+
+    Benchmark::keep(total);
+}
+
+//-----------------------------------------------------------------------
+
+BENCHMARK(Describable, SetPropertyHandwritten)
+{
+    setProperties<HandwrittenDescribable>(benchmark, nbIterations);
+}
+
+//-----------------------------------------------------------------------
+
+BENCHMARK(Describable, SetPropertyTable)
+{
+    setProperties<TableDescribable>(benchmark, nbIterations);
+}
+
+//-----------------------------------------------------------------------
+
+BENCHMARK(Describable, GetPropertiesHandwritten)
+{
+    getProperties<HandwrittenDescribable>(benchmark, nbIterations);
+}
+
+//-----------------------------------------------------------------------
+
+BENCHMARK(Describable, GetPropertiesTable)
+{
+    getProperties<TableDescribable>(benchmark, nbIterations);
+}
+
+//-----------------------------------------------------------------------
+
+BENCHMARK(Describable, EnumerateTable)
+{
+    TableDescribable describable;
+    unsigned int total = 0;
+
+    // Walk the descriptions of the properties, without allocating anything
+    for (unsigned int i = 0; i < nbIterations; ++i)
+    {
+        const PropertiesTable* pTable = describable.getPropertiesTable();
+        while (pTable)
+        {
+            for (unsigned int p = 0; p < pTable->nbProperties(); ++p)
+                total += pTable->property(p).type;
+
+            pTable = pTable->base();
+        }
+    }
+
+    Benchmark::keep(total);
+}
+
+//-----------------------------------------------------------------------
+
+BENCHMARK(Describable, SetPropertyHandle)
+{
+    TableDescribable describable;
+    std::vector<PropertyHandle> handles;
+
+    for (unsigned int p = 0; p < NB_PROPERTIES - 1; ++p)
+        handles.push_back(describable.resolveProperty("Node", NAMES[p]));
+
+    for (unsigned int i = 0; i < nbIterations; ++i)
+    {
+        for (unsigned int p = 0; p < NB_PROPERTIES - 1; ++p)
+            describable.setPropertyValue(handles[p], (float) i);
+    }
+
+    Benchmark::keep(describable.x);
+    benchmark.setMetric("properties_per_iteration", NB_PROPERTIES - 1);
+}
+
+//-----------------------------------------------------------------------
+
+BENCHMARK(Describable, SetPropertyHandleVariant)
+{
+    TableDescribable describable;
+    std::vector<PropertyHandle> handles;
+    Variant value(1.0f);
+
+    for (unsigned int p = 0; p < NB_PROPERTIES - 1; ++p)
+        handles.push_back(describable.resolveProperty("Node", NAMES[p]));
+
+    for (unsigned int i = 0; i < nbIterations; ++i)
+    {
+        for (unsigned int p = 0; p < NB_PROPERTIES - 1; ++p)
+            describable.setPropertyValue(handles[p], value);
+    }
+
+    Benchmark::keep(describable.x);
+    benchmark.setMetric("properties_per_iteration", NB_PROPERTIES - 1);
+}
+
+//-----------------------------------------------------------------------
+
+BENCHMARK(Describable, GetPropertyHandle)
+{
+    TableDescribable describable;
+    std::vector<PropertyHandle> handles;
+    float total = 0.0f;
+
+    for (unsigned int p = 0; p < NB_PROPERTIES - 1; ++p)
+        handles.push_back(describable.resolveProperty("Node", NAMES[p]));
+
+    for (unsigned int i = 0; i < nbIterations; ++i)
+    {
+        for (unsigned int p = 0; p < NB_PROPERTIES - 1; ++p)
+        {
+            float value;
+            describable.getPropertyValue(handles[p], value);
+            total += value;
+        }
+    }
+
+    Benchmark::keep(total);
+    benchmark.setMetric("properties_per_iteration", NB_PROPERTIES - 1);
+}
+
+//-----------------------------------------------------------------------
+
+BENCHMARK(Describable, AutosaveFull)
+{
+    TableDescribable describable;
+    PropertyHandle handle = describable.resolveProperty("Node", "x");
+
+    // One property modified between two saves
+    for (unsigned int i = 0; i < nbIterations; ++i)
+    {
+        describable.setPropertyValue(handle, (float) i);
+        Benchmark::keep(toJSON(&describable));
+    }
+}
+
+//-----------------------------------------------------------------------
+
+BENCHMARK(Describable, AutosaveChanges)
+{
+    TableDescribable describable;
+    PropertyHandle handle = describable.resolveProperty("Node", "x");
+
+    describable.setChangesTracking(true);
+
+    // One property modified between two saves
+    for (unsigned int i = 0; i < nbIterations; ++i)
+    {
+        describable.setPropertyValue(handle, (float) i);
+        Benchmark::keep(changesToJSON(&describable));
+        describable.clearChangedProperties();
+    }
+}
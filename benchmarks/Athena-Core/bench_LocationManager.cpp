@@ -0,0 +1,132 @@
+#include "Benchmark.h"
+#include <Athena-Core/Data/LocationManager.h>
+#include <Athena-Core/Data/DataStream.h>
+#include <Athena-Core/Data/FileDataStream.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <stdio.h>
+
+#if ATHENA_PLATFORM == ATHENA_PLATFORM_WIN32
+    #include <direct.h>
+    #define mkdir(PATH, MODE) _mkdir(PATH)
+#endif
+
+using namespace Athena::Data;
+
+
+/// Number of locations of the group
+static const unsigned int NB_LOCATIONS = 50;
+
+/// Number of files per location
+static const unsigned int NB_FILES = 20;
+
+/// Number of lookups per iteration
+static const unsigned int NB_LOOKUPS = 10000;
+
+/// Root directory of the locations
+static const std::string ROOT = ATHENA_CORE_BENCHMARKS_GENERATED_PATH "locations/";
+
+
+//-----------------------------------------------------------------------
+
+/// Create the locations (if not already done), and returns the names of the files to
+/// look for (some of them don't exist)
+static const std::vector<std::string>& createLocations()
+{
+    static std::vector<std::string> files;
+
+    if (!files.empty())
+        return files;
+
+    mkdir(ATHENA_CORE_BENCHMARKS_GENERATED_PATH, 0755);
+    mkdir(ROOT.c_str(), 0755);
+
+    for (unsigned int i = 0; i < NB_LOCATIONS; ++i)
+    {
+        char buffer[64];
+        sprintf(buffer, "location%02u/", i);
+        std::string strDirectory = ROOT + buffer;
+
+        mkdir(strDirectory.c_str(), 0755);
+
+        for (unsigned int j = 0; j < NB_FILES; ++j)
+        {
+            sprintf(buffer, "file_%02u_%02u.txt", i, j);
+
+            FileDataStream stream(strDirectory + buffer, DataStream::WRITE);
+            stream.write(buffer, 4);
+
+            files.push_back(buffer);
+        }
+
+        sprintf(buffer, "missing_%02u.txt", i);
+        files.push_back(buffer);
+    }
+
+    return files;
+}
+
+//-----------------------------------------------------------------------
+
+static void addLocations(LocationManager& manager)
+{
+    for (unsigned int i = 0; i < NB_LOCATIONS; ++i)
+    {
+        char buffer[64];
+        sprintf(buffer, "location%02u/", i);
+        manager.addLocation("benchmark", ROOT + buffer);
+    }
+}
+
+//-----------------------------------------------------------------------
+
+BENCHMARK(LocationManager, Path)
+{
+    const std::vector<std::string>& files = createLocations();
+
+    LocationManager manager;
+    addLocations(manager);
+
+    benchmark.setMetric("lookups_per_iteration", NB_LOOKUPS);
+
+    for (unsigned int i = 0; i < nbIterations; ++i)
+    {
+        for (unsigned int j = 0; j < NB_LOOKUPS; ++j)
+            Benchmark::keep(manager.path("benchmark", files[(j * 7919) % files.size()]));
+    }
+}
+
+//-----------------------------------------------------------------------
+
+BENCHMARK(LocationManager, Refresh)
+{
+    createLocations();
+
+    LocationManager manager;
+    addLocations(manager);
+
+    for (unsigned int i = 0; i < nbIterations; ++i)
+        manager.refresh("benchmark");
+}
+
+//-----------------------------------------------------------------------
+
+BENCHMARK(LocationManager, Open)
+{
+    const std::vector<std::string>& files = createLocations();
+
+    LocationManager manager;
+    addLocations(manager);
+
+    char buffer[4];
+
+    for (unsigned int i = 0; i < nbIterations; ++i)
+    {
+        DataStream* pStream = manager.open("benchmark", files[(i * 7919) % files.size()]);
+        if (pStream)
+        {
+            pStream->read(buffer, sizeof(buffer));
+            delete pStream;
+        }
+    }
+}
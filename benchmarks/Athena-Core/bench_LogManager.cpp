@@ -0,0 +1,56 @@
+#include "Benchmark.h"
+#include <Athena-Core/Log/LogManager.h>
+#include <Athena-Core/Log/ILogListener.h>
+
+using namespace Athena::Log;
+
+
+//-----------------------------------------------------------------------
+
+/// Listener discarding the messages, to only measure the cost of the log manager
+class NullLogListener: public ILogListener
+{
+public:
+    NullLogListener()
+    : nbMessages(0)
+    {
+    }
+
+    virtual void log(const std::string& strTimestamp, tMessageType type, const char* strContext,
+                     const std::string& strMessage, const char* strFileName,
+                     const char* strFunction, unsigned int uiLine)
+    {
+        ++nbMessages;
+    }
+
+    unsigned int nbMessages;
+};
+
+//-----------------------------------------------------------------------
+
+BENCHMARK(LogManager, Log)
+{
+    LogManager manager;
+    NullLogListener listener;
+    const std::string strMessage = "Some message";
+
+    manager.addListener(&listener);
+
+    for (unsigned int i = 0; i < nbIterations; ++i)
+        manager.log(LOG_WARNING, "Benchmark", strMessage, __FILE__, __FUNCTION__, __LINE__);
+
+    manager.removeListener(&listener);
+
+    Benchmark::keep(listener.nbMessages);
+}
+
+//-----------------------------------------------------------------------
+
+BENCHMARK(LogManager, LogWithoutListener)
+{
+    LogManager manager;
+    const std::string strMessage = "Some message";
+
+    for (unsigned int i = 0; i < nbIterations; ++i)
+        manager.log(LOG_WARNING, "Benchmark", strMessage, __FILE__, __FUNCTION__, __LINE__);
+}
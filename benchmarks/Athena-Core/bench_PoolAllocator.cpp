@@ -0,0 +1,141 @@
+#include "Benchmark.h"
+#include <Athena-Core/Utils/PoolAllocator.h>
+#include <Athena-Core/Utils/Thread.h>
+#include <Athena-Core/Utils/Variant.h>
+
+using namespace Athena::Utils;
+
+
+/// Number of threads allocating at the same time
+static const unsigned int NB_THREADS = 8;
+
+/// Number of objects alive at the same time in each thread
+static const unsigned int NB_OBJECTS = 64;
+
+
+//-----------------------------------------------------------------------
+/// Allocates with the global operator new
+//-----------------------------------------------------------------------
+struct SystemAllocator
+{
+    static void* allocate(size_t size)
+    {
+        return ::operator new(size);
+    }
+
+    static void deallocate(void* p, size_t size)
+    {
+        ::operator delete(p);
+    }
+};
+
+
+//-----------------------------------------------------------------------
+/// Allocates and releases blocks of the size of a variant
+//-----------------------------------------------------------------------
+template<class ALLOCATOR>
+class BlocksThread: public Thread
+{
+public:
+    BlocksThread(unsigned int nbIterations)
+    : m_nbIterations(nbIterations)
+    {
+    }
+
+protected:
+    virtual void run()
+    {
+        void* blocks[NB_OBJECTS];
+
+        for (unsigned int i = 0; i < m_nbIterations; ++i)
+        {
+            for (unsigned int j = 0; j < NB_OBJECTS; ++j)
+                blocks[j] = ALLOCATOR::allocate(sizeof(Variant));
+
+            Benchmark::keep(blocks[i % NB_OBJECTS]);
+
+            for (unsigned int j = 0; j < NB_OBJECTS; ++j)
+                ALLOCATOR::deallocate(blocks[j], sizeof(Variant));
+        }
+    }
+
+private:
+    unsigned int m_nbIterations;
+};
+
+
+//-----------------------------------------------------------------------
+/// Creates and destroys variants (from the pool if ATHENA_CORE_VARIANT_POOL is ON)
+//-----------------------------------------------------------------------
+class VariantsThread: public Thread
+{
+public:
+    VariantsThread(unsigned int nbIterations)
+    : m_nbIterations(nbIterations)
+    {
+    }
+
+protected:
+    virtual void run()
+    {
+        Variant* variants[NB_OBJECTS];
+
+        for (unsigned int i = 0; i < m_nbIterations; ++i)
+        {
+            for (unsigned int j = 0; j < NB_OBJECTS; ++j)
+                variants[j] = new Variant((int) j);
+
+            Benchmark::keep(variants[i % NB_OBJECTS]);
+
+            for (unsigned int j = 0; j < NB_OBJECTS; ++j)
+                delete variants[j];
+        }
+    }
+
+private:
+    unsigned int m_nbIterations;
+};
+
+
+//-----------------------------------------------------------------------
+
+template<class THREAD>
+static void runThreads(Benchmark& benchmark, unsigned int nbIterations)
+{
+    THREAD* threads[NB_THREADS];
+
+    for (unsigned int i = 0; i < NB_THREADS; ++i)
+        threads[i] = new THREAD(nbIterations);
+
+    for (unsigned int i = 0; i < NB_THREADS; ++i)
+        threads[i]->start();
+
+    for (unsigned int i = 0; i < NB_THREADS; ++i)
+    {
+        threads[i]->join();
+        delete threads[i];
+    }
+
+    benchmark.setMetric("allocations_per_iteration", NB_THREADS * NB_OBJECTS);
+}
+
+//-----------------------------------------------------------------------
+
+BENCHMARK(PoolAllocator, SystemThreads8)
+{
+    runThreads<BlocksThread<SystemAllocator> >(benchmark, nbIterations);
+}
+
+//-----------------------------------------------------------------------
+
+BENCHMARK(PoolAllocator, PoolThreads8)
+{
+    runThreads<BlocksThread<PoolAllocator> >(benchmark, nbIterations);
+}
+
+//-----------------------------------------------------------------------
+
+BENCHMARK(PoolAllocator, VariantsThreads8)
+{
+    runThreads<VariantsThread>(benchmark, nbIterations);
+}
@@ -0,0 +1,39 @@
+#include "Benchmark.h"
+#include <Athena-Core/Utils/Profiler.h>
+
+using namespace Athena::Utils;
+
+
+//-----------------------------------------------------------------------
+
+BENCHMARK(Profiler, ScopeDisabled)
+{
+    Profiler::enable(false);
+
+    for (unsigned int i = 0; i < nbIterations; ++i)
+    {
+        ATHENA_PROFILE_SCOPE("scope");
+        Benchmark::keep(i);
+    }
+}
+
+//-----------------------------------------------------------------------
+
+BENCHMARK(Profiler, ScopeEnabled)
+{
+    Profiler::reset();
+    Profiler::enable(true);
+
+    for (unsigned int i = 0; i < nbIterations; ++i)
+    {
+        ATHENA_PROFILE_SCOPE("scope");
+        Benchmark::keep(i);
+
+        // Process the events regularly, like an application would do once per frame
+        if ((i & 1023) == 1023)
+            Profiler::collect();
+    }
+
+    Profiler::enable(false);
+    Profiler::reset();
+}
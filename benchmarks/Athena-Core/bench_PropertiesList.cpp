@@ -0,0 +1,172 @@
+#include "Benchmark.h"
+#include <Athena-Core/Utils/PropertiesList.h>
+#include <stdio.h>
+
+using namespace Athena::Utils;
+
+
+/// Number of categories of the list
+static const unsigned int NB_CATEGORIES = 4;
+
+/// Number of properties per category
+static const unsigned int NB_PROPERTIES = 8;
+
+
+//-----------------------------------------------------------------------
+
+static std::string propertyName(unsigned int index)
+{
+    char buffer[32];
+    sprintf(buffer, "property%u", index);
+    return buffer;
+}
+
+//-----------------------------------------------------------------------
+
+static std::string categoryName(unsigned int index)
+{
+    char buffer[32];
+    sprintf(buffer, "Category%u", index);
+    return buffer;
+}
+
+//-----------------------------------------------------------------------
+
+BENCHMARK(PropertiesList, Set)
+{
+    std::vector<std::string> categories;
+    std::vector<std::string> names;
+
+    for (unsigned int i = 0; i < NB_CATEGORIES; ++i)
+        categories.push_back(categoryName(i));
+
+    for (unsigned int i = 0; i < NB_PROPERTIES; ++i)
+        names.push_back(propertyName(i));
+
+    for (unsigned int i = 0; i < nbIterations; ++i)
+    {
+        PropertiesList list;
+
+        for (unsigned int c = 0; c < NB_CATEGORIES; ++c)
+        {
+            list.selectCategory(categories[c]);
+
+            for (unsigned int p = 0; p < NB_PROPERTIES; ++p)
+                list.set(names[p], new Variant((int) p));
+        }
+    }
+}
+
+//-----------------------------------------------------------------------
+
+BENCHMARK(PropertiesList, Get)
+{
+    PropertiesList list;
+    std::vector<std::string> categories;
+    std::vector<std::string> names;
+
+    for (unsigned int i = 0; i < NB_CATEGORIES; ++i)
+        categories.push_back(categoryName(i));
+
+    for (unsigned int i = 0; i < NB_PROPERTIES; ++i)
+        names.push_back(propertyName(i));
+
+    for (unsigned int c = 0; c < NB_CATEGORIES; ++c)
+    {
+        list.selectCategory(categories[c]);
+
+        for (unsigned int p = 0; p < NB_PROPERTIES; ++p)
+            list.set(names[p], new Variant((int) p));
+    }
+
+    for (unsigned int i = 0; i < nbIterations; ++i)
+    {
+        unsigned int c = i % NB_CATEGORIES;
+        unsigned int p = (i / NB_CATEGORIES) % NB_PROPERTIES;
+
+        Benchmark::keep(list.get(categories[c], names[p]));
+    }
+}
+
+//-----------------------------------------------------------------------
+
+static void createPrototype(PropertiesList& prototype)
+{
+    for (unsigned int c = 0; c < NB_CATEGORIES; ++c)
+    {
+        prototype.selectCategory(categoryName(c));
+
+        for (unsigned int p = 0; p < NB_PROPERTIES; ++p)
+            prototype.set(propertyName(p), new Variant((int) p));
+    }
+}
+
+//-----------------------------------------------------------------------
+
+BENCHMARK(PropertiesList, DeepCopyPrototype)
+{
+    PropertiesList prototype;
+    createPrototype(prototype);
+
+    const PropertiesList& constPrototype = prototype;
+
+    // What the instances had to do before the categories were shared
+    for (unsigned int i = 0; i < nbIterations; ++i)
+    {
+        PropertiesList instance;
+
+        PropertiesList::tConstCategoriesIterator catIter = constPrototype.getCategoriesIterator();
+        while (catIter.hasMoreElements())
+        {
+            const PropertiesList::tCategory* pCategory = catIter.peekNextPtr();
+
+            instance.selectCategory(pCategory->strName);
+
+            PropertiesList::tConstPropertiesIterator propIter(pCategory->values.begin(),
+                                                              pCategory->values.end());
+            while (propIter.hasMoreElements())
+            {
+                instance.set(propIter.peekNextPtr()->strName,
+                             new Variant(*(propIter.peekNextPtr()->pValue)));
+                propIter.moveNext();
+            }
+
+            catIter.moveNext();
+        }
+
+        Benchmark::keep(instance.nbTotalProperties());
+    }
+}
+
+//-----------------------------------------------------------------------
+
+BENCHMARK(PropertiesList, SharePrototype)
+{
+    PropertiesList prototype;
+    createPrototype(prototype);
+
+    for (unsigned int i = 0; i < nbIterations; ++i)
+    {
+        PropertiesList instance(prototype);
+        Benchmark::keep(instance.nbTotalProperties());
+    }
+}
+
+//-----------------------------------------------------------------------
+
+BENCHMARK(PropertiesList, SharePrototypeAndModify)
+{
+    PropertiesList prototype;
+    createPrototype(prototype);
+
+    std::string strCategory = categoryName(0);
+    std::string strName = propertyName(0);
+
+    // Only the modified category is copied
+    for (unsigned int i = 0; i < nbIterations; ++i)
+    {
+        PropertiesList instance(prototype);
+        instance.set(strCategory, strName, new Variant((int) i));
+        Benchmark::keep(instance.nbTotalProperties());
+    }
+}
@@ -0,0 +1,240 @@
+#include "Benchmark.h"
+#include <Athena-Core/Data/Serialization.h>
+#include <Athena-Core/Data/JSONDocument.h>
+#include <Athena-Core/Utils/PropertiesTable.h>
+#include <Athena-Math/Vector3.h>
+#include <Athena-Math/Quaternion.h>
+#include <rapidjson/document.h>
+
+using namespace Athena;
+using namespace Athena::Data;
+using namespace Athena::Utils;
+
+
+//-----------------------------------------------------------------------
+
+/// Describable object with a few properties of different types
+class BenchmarkDescribable: public Describable
+{
+public:
+    BenchmarkDescribable()
+    : strName("entity"), position(1.0f, 2.0f, 3.0f), orientation(1.0f, 0.0f, 0.0f, 0.0f),
+      iIndex(10), bVisible(true)
+    {
+    }
+
+    virtual PropertiesList* getProperties() const
+    {
+        PropertiesList* pList = Describable::getProperties();
+
+        pList->selectCategory("Benchmark", false);
+        pList->set("name", new Variant(strName));
+        pList->set("position", new Variant(position));
+        pList->set("orientation", new Variant(orientation));
+        pList->set("index", new Variant(iIndex));
+        pList->set("visible", new Variant(bVisible));
+
+        return pList;
+    }
+
+    virtual bool setProperty(const std::string& strCategory, const std::string& strName,
+                             Variant* pValue)
+    {
+        if (strCategory != "Benchmark")
+            return Describable::setProperty(strCategory, strName, pValue);
+
+        if (strName == "name")
+            this->strName = pValue->toString();
+        else if (strName == "position")
+            position = pValue->toVector3();
+        else if (strName == "orientation")
+            orientation = pValue->toQuaternion();
+        else if (strName == "index")
+            iIndex = pValue->toInt();
+        else if (strName == "visible")
+            bVisible = pValue->toBool();
+
+        delete pValue;
+
+        return true;
+    }
+
+    std::string         strName;
+    Math::Vector3       position;
+    Math::Quaternion    orientation;
+    int                 iIndex;
+    bool                bVisible;
+};
+
+//-----------------------------------------------------------------------
+
+/// Same describable, using a table of properties
+class TableBenchmarkDescribable: public Describable
+{
+    ATHENA_DESCRIBABLE(TableBenchmarkDescribable, Describable)
+
+public:
+    TableBenchmarkDescribable()
+    : strName("entity"), position(1.0f, 2.0f, 3.0f), orientation(1.0f, 0.0f, 0.0f, 0.0f),
+      iIndex(10), bVisible(true)
+    {
+    }
+
+    std::string         strName;
+    Math::Vector3       position;
+    Math::Quaternion    orientation;
+    int                 iIndex;
+    bool                bVisible;
+};
+
+
+ATHENA_PROPERTIES_BEGIN(TableBenchmarkDescribable, "Benchmark")
+    ATHENA_PROPERTY("name",         std::string,        strName)
+    ATHENA_PROPERTY("position",     Math::Vector3,      position)
+    ATHENA_PROPERTY("orientation",  Math::Quaternion,   orientation)
+    ATHENA_PROPERTY("index",        int,                iIndex)
+    ATHENA_PROPERTY("visible",      bool,               bVisible)
+ATHENA_PROPERTIES_END()
+
+
+/// Number of objects in the loaded scenes
+static const unsigned int NB_OBJECTS = 100;
+
+//-----------------------------------------------------------------------
+
+/// Create a scene, and returns the document containing its objects
+static JSONDocument* createScene()
+{
+    JSONDocument* pDocument = JSONDocument::create();
+    rapidjson::Document& document = pDocument->document();
+
+    document.SetArray();
+
+    for (unsigned int i = 0; i < NB_OBJECTS; ++i)
+    {
+        TableBenchmarkDescribable describable;
+        describable.iIndex = (int) i;
+
+        rapidjson::Value object;
+        toJSON(&describable, object, document.GetAllocator());
+        document.PushBack(object, document.GetAllocator());
+    }
+
+    return pDocument;
+}
+
+//-----------------------------------------------------------------------
+
+/// Load the objects of a scene, and only read one of their properties
+static void loadScene(Benchmark& benchmark, unsigned int nbIterations, bool bLazy)
+{
+    JSONDocument* pDocument = createScene();
+    const rapidjson::Document& document = pDocument->document();
+
+    for (unsigned int i = 0; i < nbIterations; ++i)
+    {
+        TableBenchmarkDescribable objects[NB_OBJECTS];
+
+        for (unsigned int j = 0; j < NB_OBJECTS; ++j)
+        {
+            if (bLazy)
+                fromJSON(document[j], &objects[j], pDocument);
+            else
+                fromJSON(document[j], &objects[j]);
+        }
+
+        PropertyHandle handle = objects[0].resolveProperty("Benchmark", "index");
+
+        int total = 0;
+        for (unsigned int j = 0; j < NB_OBJECTS; ++j)
+        {
+            int index;
+            objects[j].getPropertyValue(handle, index);
+            total += index;
+        }
+
+        Benchmark::keep(total);
+    }
+
+    pDocument->release();
+
+    benchmark.setMetric("objects_per_iteration", NB_OBJECTS);
+}
+
+//-----------------------------------------------------------------------
+
+BENCHMARK(Serialization, VariantToJSON)
+{
+    Variant variant(Math::Vector3(1.0f, 2.0f, 3.0f));
+
+    for (unsigned int i = 0; i < nbIterations; ++i)
+    {
+        rapidjson::Document document;
+        rapidjson::Value value;
+
+        toJSON(&variant, value, document.GetAllocator());
+        Benchmark::keep(value);
+    }
+}
+
+//-----------------------------------------------------------------------
+
+BENCHMARK(Serialization, VariantFromJSON)
+{
+    Variant source(Math::Vector3(1.0f, 2.0f, 3.0f));
+    rapidjson::Document document;
+    rapidjson::Value value;
+
+    toJSON(&source, value, document.GetAllocator());
+
+    for (unsigned int i = 0; i < nbIterations; ++i)
+    {
+        Variant variant;
+        fromJSON(value, &variant);
+        Benchmark::keep(variant);
+    }
+}
+
+//-----------------------------------------------------------------------
+
+BENCHMARK(Serialization, DescribableToJSON)
+{
+    BenchmarkDescribable describable;
+
+    for (unsigned int i = 0; i < nbIterations; ++i)
+        Benchmark::keep(toJSON(&describable));
+}
+
+//-----------------------------------------------------------------------
+
+BENCHMARK(Serialization, DescribableFromJSON)
+{
+    BenchmarkDescribable source;
+    source.strName = "other";
+    source.iIndex = 20;
+
+    const std::string strJSON = toJSON(&source);
+
+    benchmark.setBytesPerIteration(strJSON.size());
+
+    for (unsigned int i = 0; i < nbIterations; ++i)
+    {
+        BenchmarkDescribable describable;
+        fromJSON(strJSON, &describable);
+        Benchmark::keep(describable.iIndex);
+    }
+}
+
+//-----------------------------------------------------------------------
+
+BENCHMARK(Serialization, SceneFromJSON)
+{
+    loadScene(benchmark, nbIterations, false);
+}
+
+//-----------------------------------------------------------------------
+
+BENCHMARK(Serialization, SceneFromJSONLazy)
+{
+    loadScene(benchmark, nbIterations, true);
+}
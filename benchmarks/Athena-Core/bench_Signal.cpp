@@ -0,0 +1,72 @@
+#include "Benchmark.h"
+#include <Athena-Core/Signals/Signal.h>
+#include <Athena-Core/Utils/Variant.h>
+
+using namespace Athena::Signals;
+using namespace Athena::Utils;
+
+
+/// Number of slots connected to the signals
+static const unsigned int NB_SLOTS = 4;
+
+
+//-----------------------------------------------------------------------
+
+static unsigned int g_counter = 0;
+
+template<unsigned int N>
+static void slot(Variant* pValue)
+{
+    g_counter += (pValue ? 2 : 1) * N;
+}
+
+//-----------------------------------------------------------------------
+
+struct Receiver
+{
+    Receiver()
+    : counter(0)
+    {
+    }
+
+    void method(Variant* pValue)
+    {
+        counter += (pValue ? 2 : 1);
+    }
+
+    unsigned int counter;
+};
+
+//-----------------------------------------------------------------------
+
+BENCHMARK(Signal, FireFunctions)
+{
+    Signal signal;
+    signal.connect(&slot<1>);
+    signal.connect(&slot<2>);
+    signal.connect(&slot<3>);
+    signal.connect(&slot<4>);
+
+    for (unsigned int i = 0; i < nbIterations; ++i)
+        signal.fire();
+
+    Benchmark::keep(g_counter);
+}
+
+//-----------------------------------------------------------------------
+
+BENCHMARK(Signal, FireMethods)
+{
+    Receiver receivers[NB_SLOTS];
+    Signal signal;
+
+    for (unsigned int i = 0; i < NB_SLOTS; ++i)
+        signal.connect(&receivers[i], &Receiver::method);
+
+    Variant value(10);
+
+    for (unsigned int i = 0; i < nbIterations; ++i)
+        signal.fire(&value);
+
+    Benchmark::keep(receivers[0].counter);
+}
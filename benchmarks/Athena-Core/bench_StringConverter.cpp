@@ -0,0 +1,213 @@
+#include "Benchmark.h"
+#include <Athena-Core/Utils/StringConverter.h>
+#include <sstream>
+
+using namespace Athena::Utils;
+using namespace Athena::Math;
+
+
+/// Number of values converted by each iteration
+static const unsigned int NB_VALUES = 16;
+
+
+//-----------------------------------------------------------------------
+
+static const int INTEGERS[NB_VALUES] =
+{
+    0, 7, -12, 345, -6789, 10000, 123456, -7654321, 42, 2147483647, -2147483647, 100,
+    999, 31415, -271828, 65536,
+};
+
+static const Real REALS[NB_VALUES] =
+{
+    0.0f, 1.0f, -0.5f, 3.25f, 0.1f, 1.0f / 3.0f, 123.456f, -9876.5f, 1e-3f, 2.5e7f,
+    3.14159265f, 2.71828182f, 1e20f, -1e-10f, 0.75f, 1000.0f,
+};
+
+static const char* INTEGER_TEXTS[NB_VALUES] =
+{
+    "0", "7", "-12", "345", "-6789", "10000", "123456", "-7654321", "42", "2147483647",
+    "-2147483647", "100", "999", "31415", "-271828", "65536",
+};
+
+static const char* REAL_TEXTS[NB_VALUES] =
+{
+    "0", "1", "-0.5", "3.25", "0.1", "0.333333", "123.456", "-9876.5", "0.001", "2.5e7",
+    "3.14159265", "2.71828182", "1e20", "-1e-10", "0.75", "1000",
+};
+
+//-----------------------------------------------------------------------
+
+/// The implementation of StringConverter::parseXXX() before it stopped using the
+/// streams
+template<typename T>
+static T parseWithStream(const std::string& strText)
+{
+    std::istringstream stream(strText);
+    T value = 0;
+    stream >> value;
+    return value;
+}
+
+//-----------------------------------------------------------------------
+
+/// The implementation of StringConverter::toString() before it stopped using the
+/// streams
+template<typename T>
+static std::string toStringWithStream(T val, unsigned short precision = 6)
+{
+    std::stringstream stream;
+    stream.precision(precision);
+    stream.width(0);
+    stream.fill(' ');
+    stream << val;
+    return stream.str();
+}
+
+
+//-----------------------------------------------------------------------
+
+BENCHMARK(StringConverter, IntToStringStream)
+{
+    for (unsigned int i = 0; i < nbIterations; ++i)
+    {
+        for (unsigned int j = 0; j < NB_VALUES; ++j)
+            Benchmark::keep(toStringWithStream(INTEGERS[j]));
+    }
+}
+
+//-----------------------------------------------------------------------
+
+BENCHMARK(StringConverter, IntToString)
+{
+    for (unsigned int i = 0; i < nbIterations; ++i)
+    {
+        for (unsigned int j = 0; j < NB_VALUES; ++j)
+            Benchmark::keep(StringConverter::toString(INTEGERS[j]));
+    }
+}
+
+//-----------------------------------------------------------------------
+
+BENCHMARK(StringConverter, IntToChars)
+{
+    char buffer[StringConverter::MAX_NUMBER_LENGTH];
+
+    for (unsigned int i = 0; i < nbIterations; ++i)
+    {
+        for (unsigned int j = 0; j < NB_VALUES; ++j)
+        {
+            StringConverter::toChars(buffer, buffer + sizeof(buffer), INTEGERS[j]);
+            Benchmark::keep(buffer);
+        }
+    }
+}
+
+//-----------------------------------------------------------------------
+
+BENCHMARK(StringConverter, IntToStringPadded)
+{
+    for (unsigned int i = 0; i < nbIterations; ++i)
+    {
+        for (unsigned int j = 0; j < NB_VALUES; ++j)
+            Benchmark::keep(StringConverter::toString(INTEGERS[j], 12, '0', std::ios::internal));
+    }
+}
+
+//-----------------------------------------------------------------------
+
+BENCHMARK(StringConverter, RealToStringStream)
+{
+    for (unsigned int i = 0; i < nbIterations; ++i)
+    {
+        for (unsigned int j = 0; j < NB_VALUES; ++j)
+            Benchmark::keep(toStringWithStream(REALS[j]));
+    }
+}
+
+//-----------------------------------------------------------------------
+
+BENCHMARK(StringConverter, RealToString)
+{
+    for (unsigned int i = 0; i < nbIterations; ++i)
+    {
+        for (unsigned int j = 0; j < NB_VALUES; ++j)
+            Benchmark::keep(StringConverter::toString(REALS[j]));
+    }
+}
+
+//-----------------------------------------------------------------------
+
+BENCHMARK(StringConverter, RealToCharsShortest)
+{
+    char buffer[StringConverter::MAX_NUMBER_LENGTH];
+
+    for (unsigned int i = 0; i < nbIterations; ++i)
+    {
+        for (unsigned int j = 0; j < NB_VALUES; ++j)
+        {
+            StringConverter::toChars(buffer, buffer + sizeof(buffer), REALS[j]);
+            Benchmark::keep(buffer);
+        }
+    }
+}
+
+//-----------------------------------------------------------------------
+
+BENCHMARK(StringConverter, ParseIntStream)
+{
+    std::string texts[NB_VALUES];
+    for (unsigned int j = 0; j < NB_VALUES; ++j)
+        texts[j] = INTEGER_TEXTS[j];
+
+    for (unsigned int i = 0; i < nbIterations; ++i)
+    {
+        for (unsigned int j = 0; j < NB_VALUES; ++j)
+            Benchmark::keep(parseWithStream<int>(texts[j]));
+    }
+}
+
+//-----------------------------------------------------------------------
+
+BENCHMARK(StringConverter, ParseInt)
+{
+    std::string texts[NB_VALUES];
+    for (unsigned int j = 0; j < NB_VALUES; ++j)
+        texts[j] = INTEGER_TEXTS[j];
+
+    for (unsigned int i = 0; i < nbIterations; ++i)
+    {
+        for (unsigned int j = 0; j < NB_VALUES; ++j)
+            Benchmark::keep(StringConverter::parseInt(texts[j]));
+    }
+}
+
+//-----------------------------------------------------------------------
+
+BENCHMARK(StringConverter, ParseRealStream)
+{
+    std::string texts[NB_VALUES];
+    for (unsigned int j = 0; j < NB_VALUES; ++j)
+        texts[j] = REAL_TEXTS[j];
+
+    for (unsigned int i = 0; i < nbIterations; ++i)
+    {
+        for (unsigned int j = 0; j < NB_VALUES; ++j)
+            Benchmark::keep(parseWithStream<Real>(texts[j]));
+    }
+}
+
+//-----------------------------------------------------------------------
+
+BENCHMARK(StringConverter, ParseReal)
+{
+    std::string texts[NB_VALUES];
+    for (unsigned int j = 0; j < NB_VALUES; ++j)
+        texts[j] = REAL_TEXTS[j];
+
+    for (unsigned int i = 0; i < nbIterations; ++i)
+    {
+        for (unsigned int j = 0; j < NB_VALUES; ++j)
+            Benchmark::keep(StringConverter::parseReal(texts[j]));
+    }
+}
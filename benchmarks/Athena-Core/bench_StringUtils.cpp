@@ -0,0 +1,579 @@
+#include "Benchmark.h"
+#include <Athena-Core/Utils/StringReplacer.h>
+#include <Athena-Core/Utils/StringUtils.h>
+#include <Athena-Core/Utils/StringTokenizer.h>
+#include <Athena-Core/Data/MemoryDataStream.h>
+#include <algorithm>
+#include <stdio.h>
+
+using namespace Athena::Utils;
+using namespace Athena::Data;
+
+
+/// Size of the text
+static const size_t TEXT_SIZE = 8 * 1024 * 1024;
+
+/// Number of words tested by the startsWith()/endsWith() benchmarks
+static const unsigned int NB_WORDS = 1024;
+
+
+//-----------------------------------------------------------------------
+
+/// Returns a text made of words of various lengths, separated by spaces, tabs and new
+/// lines
+static const std::string& text()
+{
+    static std::string text;
+
+    if (text.empty())
+    {
+        text.reserve(TEXT_SIZE + 64);
+
+        for (unsigned int i = 0; text.size() < TEXT_SIZE; ++i)
+        {
+            char buffer[32];
+            sprintf(buffer, "Word%u", i);
+            text += buffer;
+            text.append(i % 13, 'a' + (i % 26));
+            text += (i % 16 == 15 ? '\n' : (i % 5 == 0 ? '\t' : ' '));
+        }
+    }
+
+    return text;
+}
+
+//-----------------------------------------------------------------------
+
+/// Returns the words of the text
+static const StringUtils::tStringsList& words()
+{
+    static StringUtils::tStringsList words;
+
+    if (words.empty())
+    {
+        StringTokenizer tokenizer(text());
+
+        StringView token;
+        while (tokenizer.next(token) && (words.size() < NB_WORDS))
+            words.push_back(token.toString());
+    }
+
+    return words;
+}
+
+//-----------------------------------------------------------------------
+
+/// The implementation of StringUtils::split() before it used StringTokenizer
+static StringUtils::tStringsList splitWithSubstr(const std::string& str,
+                                                 const std::string& delims = "\t\n ")
+{
+    StringUtils::tStringsList ret;
+    ret.reserve(10);
+
+    size_t start = 0, pos;
+    do
+    {
+        pos = str.find_first_of(delims, start);
+        if (pos == start)
+        {
+            ret.push_back("");
+            start = pos + 1;
+        }
+        else if (pos == std::string::npos)
+        {
+            ret.push_back(str.substr(start));
+            break;
+        }
+        else
+        {
+            ret.push_back(str.substr(start, pos - start));
+            start = pos + 1;
+        }
+
+    } while ((start != std::string::npos) && (pos != std::string::npos));
+
+    return ret;
+}
+
+//-----------------------------------------------------------------------
+
+/// The implementation of StringUtils::startsWith() before it stopped copying the string
+static bool startsWithSubstr(const std::string& str, const std::string& pattern)
+{
+    if (str.length() < pattern.length() || pattern.empty())
+        return false;
+
+    std::string startOfThis = str.substr(0, pattern.length());
+    std::transform(startOfThis.begin(), startOfThis.end(), startOfThis.begin(), ::tolower);
+
+    return (startOfThis == pattern);
+}
+
+
+//-----------------------------------------------------------------------
+
+BENCHMARK(StringUtils, SplitSubstr)
+{
+    const std::string& content = text();
+
+    benchmark.setBytesPerIteration(content.size());
+
+    for (unsigned int i = 0; i < nbIterations; ++i)
+        Benchmark::keep(splitWithSubstr(content));
+}
+
+//-----------------------------------------------------------------------
+
+BENCHMARK(StringUtils, Split)
+{
+    const std::string& content = text();
+
+    benchmark.setBytesPerIteration(content.size());
+
+    for (unsigned int i = 0; i < nbIterations; ++i)
+        Benchmark::keep(StringUtils::split(content));
+}
+
+//-----------------------------------------------------------------------
+
+BENCHMARK(StringUtils, Tokenizer)
+{
+    const std::string& content = text();
+
+    benchmark.setBytesPerIteration(content.size());
+
+    for (unsigned int i = 0; i < nbIterations; ++i)
+    {
+        StringTokenizer tokenizer(content);
+
+        StringView token;
+        size_t total = 0;
+        while (tokenizer.next(token))
+            total += token.size();
+
+        Benchmark::keep(total);
+    }
+}
+
+//-----------------------------------------------------------------------
+
+BENCHMARK(StringUtils, TokenizerSingleDelimiter)
+{
+    const std::string& content = text();
+
+    benchmark.setBytesPerIteration(content.size());
+
+    for (unsigned int i = 0; i < nbIterations; ++i)
+    {
+        StringTokenizer tokenizer(content, "\n");
+
+        StringView token;
+        size_t total = 0;
+        while (tokenizer.next(token))
+            total += token.size();
+
+        Benchmark::keep(total);
+    }
+}
+
+//-----------------------------------------------------------------------
+
+BENCHMARK(StringUtils, TokenizerStream)
+{
+    const std::string& content = text();
+
+    benchmark.setBytesPerIteration(content.size());
+
+    for (unsigned int i = 0; i < nbIterations; ++i)
+    {
+        MemoryDataStream stream(content.data(), content.size());
+        StringTokenizer tokenizer(&stream);
+
+        StringView token;
+        size_t total = 0;
+        while (tokenizer.next(token))
+            total += token.size();
+
+        Benchmark::keep(total);
+    }
+}
+
+//-----------------------------------------------------------------------
+
+BENCHMARK(StringUtils, StartsWithSubstr)
+{
+    const StringUtils::tStringsList& list = words();
+    const std::string pattern = "word1";
+
+    for (unsigned int i = 0; i < nbIterations; ++i)
+    {
+        unsigned int nbMatches = 0;
+        for (unsigned int j = 0; j < list.size(); ++j)
+            nbMatches += (startsWithSubstr(list[j], pattern) ? 1 : 0);
+
+        Benchmark::keep(nbMatches);
+    }
+}
+
+//-----------------------------------------------------------------------
+
+BENCHMARK(StringUtils, StartsWith)
+{
+    const StringUtils::tStringsList& list = words();
+    const std::string pattern = "word1";
+
+    for (unsigned int i = 0; i < nbIterations; ++i)
+    {
+        unsigned int nbMatches = 0;
+        for (unsigned int j = 0; j < list.size(); ++j)
+            nbMatches += (StringUtils::startsWith(list[j], pattern) ? 1 : 0);
+
+        Benchmark::keep(nbMatches);
+    }
+}
+
+//-----------------------------------------------------------------------
+
+BENCHMARK(StringUtils, EndsWith)
+{
+    const StringUtils::tStringsList& list = words();
+    const std::string pattern = "aaa";
+
+    for (unsigned int i = 0; i < nbIterations; ++i)
+    {
+        unsigned int nbMatches = 0;
+        for (unsigned int j = 0; j < list.size(); ++j)
+            nbMatches += (StringUtils::endsWith(list[j], pattern) ? 1 : 0);
+
+        Benchmark::keep(nbMatches);
+    }
+}
+
+
+//-----------------------------------------------------------------------
+
+/// Returns a text without any delimiter nor whitespace
+static const std::string& letters()
+{
+    static std::string letters;
+
+    if (letters.empty())
+    {
+        letters.resize(TEXT_SIZE);
+        for (size_t i = 0; i < TEXT_SIZE; ++i)
+            letters[i] = (i % 3 == 0 ? 'A' : 'a') + (i % 26);
+    }
+
+    return letters;
+}
+
+//-----------------------------------------------------------------------
+
+/// Select the instruction set used by StringUtils during a benchmark (reporting it as
+/// unsupported if needed, in which case the scalar implementation is measured)
+class InstructionSetSelection
+{
+public:
+    InstructionSetSelection(Benchmark& benchmark, StringUtils::tInstructionSet instructionSet)
+    : m_previous(StringUtils::instructionSet())
+    {
+        if (!StringUtils::setInstructionSet(instructionSet))
+        {
+            StringUtils::setInstructionSet(StringUtils::INSTRUCTIONS_SCALAR);
+            benchmark.setMetric("unsupported", 1.0);
+        }
+    }
+
+    ~InstructionSetSelection()
+    {
+        StringUtils::setInstructionSet(m_previous);
+    }
+
+private:
+    StringUtils::tInstructionSet m_previous;
+};
+
+//-----------------------------------------------------------------------
+
+static void toLowerCase(Benchmark& benchmark, unsigned int nbIterations,
+                        StringUtils::tInstructionSet instructionSet)
+{
+    InstructionSetSelection selection(benchmark, instructionSet);
+
+    std::string content = letters();
+
+    benchmark.setBytesPerIteration(content.size());
+
+    for (unsigned int i = 0; i < nbIterations; ++i)
+    {
+        StringUtils::toLowerCase(content);
+        Benchmark::keep(content);
+    }
+}
+
+//-----------------------------------------------------------------------
+
+static void findFirstOf(Benchmark& benchmark, unsigned int nbIterations,
+                        StringUtils::tInstructionSet instructionSet)
+{
+    InstructionSetSelection selection(benchmark, instructionSet);
+
+    const std::string& content = letters();
+
+    benchmark.setBytesPerIteration(content.size());
+
+    for (unsigned int i = 0; i < nbIterations; ++i)
+        Benchmark::keep(StringUtils::findFirstOf(content, ";,|\n"));
+}
+
+//-----------------------------------------------------------------------
+
+static void trim(Benchmark& benchmark, unsigned int nbIterations,
+                 StringUtils::tInstructionSet instructionSet)
+{
+    InstructionSetSelection selection(benchmark, instructionSet);
+
+    // Whitespaces around a single character
+    std::string content(TEXT_SIZE / 2, ' ');
+    content += 'x';
+    content.append(TEXT_SIZE / 2, '\t');
+
+    benchmark.setBytesPerIteration(content.size());
+
+    for (unsigned int i = 0; i < nbIterations; ++i)
+    {
+        std::string s = content;
+        StringUtils::trim(s);
+        Benchmark::keep(s);
+    }
+}
+
+//-----------------------------------------------------------------------
+
+static void tokenize(Benchmark& benchmark, unsigned int nbIterations,
+                     StringUtils::tInstructionSet instructionSet)
+{
+    InstructionSetSelection selection(benchmark, instructionSet);
+
+    const std::string& content = text();
+
+    benchmark.setBytesPerIteration(content.size());
+
+    for (unsigned int i = 0; i < nbIterations; ++i)
+    {
+        StringTokenizer tokenizer(content);
+
+        StringView token;
+        size_t total = 0;
+        while (tokenizer.next(token))
+            total += token.size();
+
+        Benchmark::keep(total);
+    }
+}
+
+//-----------------------------------------------------------------------
+
+BENCHMARK(StringUtils, ToLowerCaseScalar)
+{
+    toLowerCase(benchmark, nbIterations, StringUtils::INSTRUCTIONS_SCALAR);
+}
+
+BENCHMARK(StringUtils, ToLowerCaseSSE2)
+{
+    toLowerCase(benchmark, nbIterations, StringUtils::INSTRUCTIONS_SSE2);
+}
+
+BENCHMARK(StringUtils, ToLowerCaseAVX2)
+{
+    toLowerCase(benchmark, nbIterations, StringUtils::INSTRUCTIONS_AVX2);
+}
+
+//-----------------------------------------------------------------------
+
+BENCHMARK(StringUtils, FindFirstOfScalar)
+{
+    findFirstOf(benchmark, nbIterations, StringUtils::INSTRUCTIONS_SCALAR);
+}
+
+BENCHMARK(StringUtils, FindFirstOfSSE2)
+{
+    findFirstOf(benchmark, nbIterations, StringUtils::INSTRUCTIONS_SSE2);
+}
+
+BENCHMARK(StringUtils, FindFirstOfAVX2)
+{
+    findFirstOf(benchmark, nbIterations, StringUtils::INSTRUCTIONS_AVX2);
+}
+
+//-----------------------------------------------------------------------
+
+BENCHMARK(StringUtils, TrimScalar)
+{
+    trim(benchmark, nbIterations, StringUtils::INSTRUCTIONS_SCALAR);
+}
+
+BENCHMARK(StringUtils, TrimSSE2)
+{
+    trim(benchmark, nbIterations, StringUtils::INSTRUCTIONS_SSE2);
+}
+
+BENCHMARK(StringUtils, TrimAVX2)
+{
+    trim(benchmark, nbIterations, StringUtils::INSTRUCTIONS_AVX2);
+}
+
+//-----------------------------------------------------------------------
+
+BENCHMARK(StringUtils, TokenizerScalar)
+{
+    tokenize(benchmark, nbIterations, StringUtils::INSTRUCTIONS_SCALAR);
+}
+
+BENCHMARK(StringUtils, TokenizerSSE2)
+{
+    tokenize(benchmark, nbIterations, StringUtils::INSTRUCTIONS_SSE2);
+}
+
+BENCHMARK(StringUtils, TokenizerAVX2)
+{
+    tokenize(benchmark, nbIterations, StringUtils::INSTRUCTIONS_AVX2);
+}
+
+
+//-----------------------------------------------------------------------
+
+/// Size of the template
+static const size_t TEMPLATE_SIZE = 1024 * 1024;
+
+/// Number of variables of the template
+static const unsigned int NB_VARIABLES = 8;
+
+//-----------------------------------------------------------------------
+
+/// Returns the replacements of the variables of the template
+static const StringUtils::tReplacementsList& variables()
+{
+    static StringUtils::tReplacementsList variables;
+
+    if (variables.empty())
+    {
+        for (unsigned int i = 0; i < NB_VARIABLES; ++i)
+        {
+            char strWhat[32];
+            char strWith[32];
+            sprintf(strWhat, "$(VARIABLE_%u)", i);
+            sprintf(strWith, "value%u", i * 1000);
+
+            variables.push_back(std::make_pair(std::string(strWhat), std::string(strWith)));
+        }
+    }
+
+    return variables;
+}
+
+//-----------------------------------------------------------------------
+
+/// Returns a text looking like a shader template, with a variable every few lines
+static const std::string& shaderTemplate()
+{
+    static std::string shaderTemplate;
+
+    if (shaderTemplate.empty())
+    {
+        shaderTemplate.reserve(TEMPLATE_SIZE + 128);
+
+        for (unsigned int i = 0; shaderTemplate.size() < TEMPLATE_SIZE; ++i)
+        {
+            char buffer[64];
+            sprintf(buffer, "    vec4 color%u = texture(sampler, uv * %u.0);\n", i, i % 10);
+            shaderTemplate += buffer;
+
+            if (i % 4 == 0)
+            {
+                shaderTemplate += "    color += ";
+                shaderTemplate += variables()[i % NB_VARIABLES].first;
+                shaderTemplate += ";\n";
+            }
+        }
+    }
+
+    return shaderTemplate;
+}
+
+//-----------------------------------------------------------------------
+
+/// The implementation of StringUtils::replaceAll() before it built the result in one
+/// pass
+static void replaceAllWithEraseInsert(std::string &strSource, const std::string& strWhat,
+                                      const std::string& strWith)
+{
+    size_t index = strSource.find(strWhat);
+
+    while (index != std::string::npos)
+    {
+        strSource.erase(index, strWhat.length());
+        strSource.insert(index, strWith);
+
+        index = strSource.find(strWhat, index + strWith.length());
+    }
+}
+
+//-----------------------------------------------------------------------
+
+BENCHMARK(StringUtils, ReplaceAllEraseInsert)
+{
+    benchmark.setBytesPerIteration(shaderTemplate().size());
+
+    for (unsigned int i = 0; i < nbIterations; ++i)
+    {
+        std::string s = shaderTemplate();
+        replaceAllWithEraseInsert(s, variables()[0].first, variables()[0].second);
+        Benchmark::keep(s);
+    }
+}
+
+//-----------------------------------------------------------------------
+
+BENCHMARK(StringUtils, ReplaceAll)
+{
+    benchmark.setBytesPerIteration(shaderTemplate().size());
+
+    for (unsigned int i = 0; i < nbIterations; ++i)
+    {
+        std::string s = shaderTemplate();
+        StringUtils::replaceAll(s, variables()[0].first, variables()[0].second);
+        Benchmark::keep(s);
+    }
+}
+
+//-----------------------------------------------------------------------
+
+BENCHMARK(StringUtils, ReplaceAllVariablesOneByOne)
+{
+    const StringUtils::tReplacementsList& list = variables();
+
+    benchmark.setBytesPerIteration(shaderTemplate().size());
+
+    for (unsigned int i = 0; i < nbIterations; ++i)
+    {
+        std::string s = shaderTemplate();
+
+        for (unsigned int j = 0; j < list.size(); ++j)
+            StringUtils::replaceAll(s, list[j].first, list[j].second);
+
+        Benchmark::keep(s);
+    }
+}
+
+//-----------------------------------------------------------------------
+
+BENCHMARK(StringUtils, ReplaceAllVariablesReplacer)
+{
+    StringReplacer replacer(variables());
+
+    benchmark.setBytesPerIteration(shaderTemplate().size());
+
+    for (unsigned int i = 0; i < nbIterations; ++i)
+        Benchmark::keep(replacer.replace(shaderTemplate()));
+}
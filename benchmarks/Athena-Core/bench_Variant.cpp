@@ -0,0 +1,104 @@
+#include "Benchmark.h"
+#include <Athena-Core/Utils/Variant.h>
+#include <Athena-Math/Vector3.h>
+#include <Athena-Math/Quaternion.h>
+
+using namespace Athena;
+using namespace Athena::Utils;
+
+
+//-----------------------------------------------------------------------
+
+BENCHMARK(Variant, ConstructInt)
+{
+    for (unsigned int i = 0; i < nbIterations; ++i)
+    {
+        Variant value((int) i);
+        Benchmark::keep(value);
+    }
+}
+
+//-----------------------------------------------------------------------
+
+BENCHMARK(Variant, ConstructString)
+{
+    const std::string strValue = "some string value";
+
+    for (unsigned int i = 0; i < nbIterations; ++i)
+    {
+        Variant value(strValue);
+        Benchmark::keep(value);
+    }
+}
+
+//-----------------------------------------------------------------------
+
+BENCHMARK(Variant, ConstructVector3)
+{
+    for (unsigned int i = 0; i < nbIterations; ++i)
+    {
+        Variant value(Math::Vector3((float) i, 2.0f, 3.0f));
+        Benchmark::keep(value);
+    }
+}
+
+//-----------------------------------------------------------------------
+
+BENCHMARK(Variant, Copy)
+{
+    Variant source(Math::Quaternion(1.0f, 0.0f, 0.0f, 0.0f));
+
+    for (unsigned int i = 0; i < nbIterations; ++i)
+    {
+        Variant value(source);
+        Benchmark::keep(value);
+    }
+}
+
+//-----------------------------------------------------------------------
+
+BENCHMARK(Variant, IntToString)
+{
+    for (unsigned int i = 0; i < nbIterations; ++i)
+        Benchmark::keep(Variant((int) i).toString());
+}
+
+//-----------------------------------------------------------------------
+
+BENCHMARK(Variant, FloatToString)
+{
+    for (unsigned int i = 0; i < nbIterations; ++i)
+        Benchmark::keep(Variant(i * 0.125f).toString());
+}
+
+//-----------------------------------------------------------------------
+
+BENCHMARK(Variant, StringToFloat)
+{
+    Variant value("123.456");
+
+    for (unsigned int i = 0; i < nbIterations; ++i)
+        Benchmark::keep(value.toFloat());
+}
+
+//-----------------------------------------------------------------------
+
+BENCHMARK(Variant, StringToVector3)
+{
+    Variant value("(1.5, 2.5, 3.5)");
+
+    for (unsigned int i = 0; i < nbIterations; ++i)
+        Benchmark::keep(value.toVector3());
+}
+
+//-----------------------------------------------------------------------
+
+BENCHMARK(Variant, ConvertStringToInt)
+{
+    for (unsigned int i = 0; i < nbIterations; ++i)
+    {
+        Variant value("12345");
+        value.convertTo(Variant::INTEGER);
+        Benchmark::keep(value);
+    }
+}
@@ -0,0 +1,7 @@
+#include "Benchmark.h"
+
+
+int main(int argc, char** argv)
+{
+    return Benchmark::runAll(argc, argv);
+}
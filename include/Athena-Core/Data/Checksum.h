@@ -0,0 +1,112 @@
+/** @file   Checksum.h
+    @author Philip Abbet
+
+    Declaration of the classes 'Athena::Data::Checksum' and 'Athena::Data::Hash64'
+*/
+
+#ifndef _ATHENA_DATA_CHECKSUM_H_
+#define _ATHENA_DATA_CHECKSUM_H_
+
+#include <Athena-Core/Prerequisites.h>
+
+
+namespace Athena {
+namespace Data {
+
+//----------------------------------------------------------------------------------------
+/// @brief  Computes checksums of blocks of data
+///
+/// Two algorithms are available:
+///   - CRC32C (Castagnoli polynomial), using the SSE4.2 'crc32' instruction when the CPU
+///     supports it (detected at runtime), and a table-driven implementation otherwise.
+///     Both give the same results.
+///   - a fast 64-bit non-cryptographic hash (the xxHash64 algorithm), better suited than
+///     a CRC to detect corruptions in large files
+///
+/// Both can be computed incrementally, by passing the previous result when processing the
+/// next block of data (see also Hash64 for the 64-bit hash).
+//----------------------------------------------------------------------------------------
+class ATHENA_CORE_SYMBOL Checksum
+{
+    //_____ Static methods __________
+public:
+    //------------------------------------------------------------------------------------
+    /// @brief  Compute the CRC32C of a block of data
+    ///
+    /// @param  pData   The data
+    /// @param  size    Size of the data
+    /// @param  crc     CRC of the previous data (to compute the CRC of several blocks of
+    ///                 data as if they were contiguous), 0 for the first block
+    /// @return         The CRC
+    //------------------------------------------------------------------------------------
+    static unsigned int crc32c(const void* pData, size_t size, unsigned int crc = 0);
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Compute the 64-bit hash of a block of data
+    ///
+    /// @param  pData   The data
+    /// @param  size    Size of the data
+    /// @param  seed    Seed of the hash
+    /// @return         The hash
+    //------------------------------------------------------------------------------------
+    static unsigned long long hash64(const void* pData, size_t size,
+                                     unsigned long long seed = 0);
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Indicates if the CRC32C is computed by the CPU
+    //------------------------------------------------------------------------------------
+    static bool isCRC32CAccelerated();
+};
+
+
+//----------------------------------------------------------------------------------------
+/// @brief  Computes the 64-bit hash of some data provided in several blocks
+///
+/// The result is the same than the one of Checksum::hash64() called on the concatenation
+/// of the blocks.
+//----------------------------------------------------------------------------------------
+class ATHENA_CORE_SYMBOL Hash64
+{
+    //_____ Construction / Destruction __________
+public:
+    //------------------------------------------------------------------------------------
+    /// @brief  Constructor
+    ///
+    /// @param  seed    Seed of the hash
+    //------------------------------------------------------------------------------------
+    Hash64(unsigned long long seed = 0);
+
+
+    //_____ Methods __________
+public:
+    //------------------------------------------------------------------------------------
+    /// @brief  Restart the computation of the hash
+    ///
+    /// @param  seed    Seed of the hash
+    //------------------------------------------------------------------------------------
+    void reset(unsigned long long seed = 0);
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Add a block of data to the hash
+    //------------------------------------------------------------------------------------
+    void update(const void* pData, size_t size);
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Returns the hash of all the data added so far
+    //------------------------------------------------------------------------------------
+    unsigned long long value() const;
+
+
+    //_____ Attributes __________
+private:
+    unsigned long long  m_accumulators[4];  ///< The accumulators (one per 8-byte lane)
+    unsigned long long  m_seed;             ///< Seed of the hash
+    unsigned long long  m_totalSize;        ///< Number of bytes added so far
+    unsigned char       m_buffer[32];       ///< Data not processed yet (less than a stripe)
+    unsigned int        m_bufferSize;       ///< Number of bytes in the buffer
+};
+
+}
+}
+
+#endif
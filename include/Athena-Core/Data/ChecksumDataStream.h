@@ -0,0 +1,185 @@
+/** @file   ChecksumDataStream.h
+    @author Philip Abbet
+
+    Definition of the class 'Athena::Data::ChecksumDataStream'
+*/
+
+#ifndef _ATHENA_DATA_CHECKSUMDATASTREAM_H_
+#define _ATHENA_DATA_CHECKSUMDATASTREAM_H_
+
+#include <Athena-Core/Prerequisites.h>
+#include <Athena-Core/Data/DataStream.h>
+#include <Athena-Core/Data/Checksum.h>
+
+
+namespace Athena {
+namespace Data {
+
+//----------------------------------------------------------------------------------------
+/// @brief  Stream computing the checksums (CRC32C and 64-bit hash) of the data read from
+///         (or written to) another stream
+///
+/// Usage example, to verify a file:
+/// @code
+///     ChecksumDataStream stream(new FileDataStream(strFileName));
+///     stream.readToEnd();
+///
+///     bool bValid = (stream.crc32c() == expectedCRC);
+/// @endcode
+///
+/// The data is processed in the order of the stream: when the stream is rewound (for
+/// instance by getLine(), which reads ahead), the data read again isn't processed twice.
+///
+/// @remark The checksums only cover the data going through read() and write(): the bytes
+///         skipped with skip() or seek() aren't included, and the data overwritten after
+///         a rewind isn't taken into account
+//----------------------------------------------------------------------------------------
+class ATHENA_CORE_SYMBOL ChecksumDataStream: public DataStream
+{
+    //_____ Construction / Destruction __________
+public:
+    //------------------------------------------------------------------------------------
+    /// @brief  Constructor
+    ///
+    /// @param  pStream     The stream (the checksum stream takes ownership of it)
+    //------------------------------------------------------------------------------------
+    ChecksumDataStream(DataStream* pStream);
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Destructor
+    //------------------------------------------------------------------------------------
+    virtual ~ChecksumDataStream();
+
+private:
+    // Not copiable
+    ChecksumDataStream(const ChecksumDataStream&);
+    ChecksumDataStream& operator=(const ChecksumDataStream&);
+
+
+    //_____ Methods __________
+public:
+    //------------------------------------------------------------------------------------
+    /// @brief  Returns the CRC32C of the data processed so far
+    //------------------------------------------------------------------------------------
+    inline unsigned int crc32c() const
+    {
+        return m_crc;
+    }
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Returns the 64-bit hash of the data processed so far
+    //------------------------------------------------------------------------------------
+    inline unsigned long long hash64() const
+    {
+        return m_hash.value();
+    }
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Returns the number of bytes processed so far
+    //------------------------------------------------------------------------------------
+    inline size_t nbBytes() const
+    {
+        return m_nbBytes;
+    }
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Restart the computation of the checksums (from the current position)
+    //------------------------------------------------------------------------------------
+    void reset();
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Read (and discard) all the remaining data of the stream, to compute its
+    ///         checksums
+    ///
+    /// @return The number of bytes read
+    //------------------------------------------------------------------------------------
+    size_t readToEnd();
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Returns the stream
+    //------------------------------------------------------------------------------------
+    inline DataStream* stream() const
+    {
+        return m_pStream;
+    }
+
+private:
+    //------------------------------------------------------------------------------------
+    /// @brief  Add some data (read or written at the given position) to the checksums
+    //------------------------------------------------------------------------------------
+    void process(size_t position, const void* pData, size_t size);
+
+
+    //_____ Implementation of DataStream __________
+public:
+    //------------------------------------------------------------------------------------
+    /// @brief  Read the requisite number of bytes from the stream, stopping at the end of
+    ///         the file
+    ///
+    /// @param  buf     Reference to a buffer pointer
+    /// @param  count   Number of bytes to read
+    /// @return         The number of bytes read
+    //------------------------------------------------------------------------------------
+    virtual size_t read(void* buf, size_t count);
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Write the requisite number of bytes to the stream (only applicable to
+    ///         streams that are not read-only)
+    ///
+    /// @param  buf     Pointer to a buffer containing the bytes to write
+    /// @param  count   Number of bytes to write
+    /// @return         The number of bytes written
+    //------------------------------------------------------------------------------------
+    virtual size_t write(const void* buf, size_t count);
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Skip a defined number of bytes. This can also be a negative value, in
+    ///         which case the file pointer rewinds a defined number of bytes.
+    //------------------------------------------------------------------------------------
+    virtual void skip(long count);
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Repositions the read point to a specified byte
+    //------------------------------------------------------------------------------------
+    virtual void seek(size_t pos);
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Returns the current byte offset from beginning
+    //------------------------------------------------------------------------------------
+    virtual size_t tell();
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Indicates if the stream has reached the end
+    //------------------------------------------------------------------------------------
+    virtual bool eof() const;
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Close the stream; this makes further operations invalid.
+    //------------------------------------------------------------------------------------
+    virtual void close();
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Flush the stream
+    //------------------------------------------------------------------------------------
+    virtual bool flush();
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Flush the stream, and make sure that the data written so far reached the
+    ///         storage device
+    //------------------------------------------------------------------------------------
+    virtual bool sync();
+
+
+    //_____ Attributes __________
+private:
+    DataStream*     m_pStream;  ///< The stream
+    unsigned int    m_crc;      ///< CRC32C of the data processed so far
+    Hash64          m_hash;     ///< 64-bit hash of the data processed so far
+    size_t          m_nbBytes;  ///< Number of bytes processed so far
+    size_t          m_end;      ///< Position following the last byte processed
+};
+
+}
+}
+
+#endif
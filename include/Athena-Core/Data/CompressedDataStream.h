@@ -0,0 +1,216 @@
+/** @file   CompressedDataStream.h
+    @author Philip Abbet
+
+    Definition of the class 'Athena::Data::CompressedDataStream'
+*/
+
+#ifndef _ATHENA_DATA_COMPRESSEDDATASTREAM_H_
+#define _ATHENA_DATA_COMPRESSEDDATASTREAM_H_
+
+#include <Athena-Core/Prerequisites.h>
+#include <Athena-Core/Data/DataStream.h>
+
+
+namespace Athena {
+namespace Data {
+
+//----------------------------------------------------------------------------------------
+/// @brief  Stream compressing (or decompressing) the data of another stream
+///
+/// The data is split into blocks (64 KB by default), each one compressed independently
+/// with the LZCodec. A seek table listing the blocks is stored at the end of the
+/// compressed data, so seek() only has to decompress the block containing the new
+/// position.
+///
+/// All the values are stored in little-endian order. Layout of the compressed data:
+///   - header (32 bytes): magic number ("ACMP"), version, size of the blocks, number of
+///     blocks, size of the uncompressed data, offset of the seek table
+///   - the blocks (the ones that don't compress are stored as-is)
+///   - the seek table: for each block, its offset, its stored size (the highest bit is
+///     set if the block isn't compressed) and its uncompressed size
+///
+/// In WRITE mode, the header is written again when the stream is closed, so the
+/// destination stream must support seek(). The READ_WRITE mode isn't supported.
+//----------------------------------------------------------------------------------------
+class ATHENA_CORE_SYMBOL CompressedDataStream: public DataStream
+{
+    //_____ Internal types __________
+private:
+    struct tBlock
+    {
+        unsigned long long  offset;         ///< Offset of the block in the stream
+        size_t              position;       ///< Position of the block in the uncompressed data
+        unsigned int        storedSize;     ///< Size of the (compressed) block in the stream
+        unsigned int        size;           ///< Uncompressed size of the block
+        bool                bCompressed;    ///< Indicates if the block is compressed
+    };
+
+    typedef std::vector<tBlock> tBlocksList;
+
+
+    //_____ Construction / Destruction __________
+public:
+    //------------------------------------------------------------------------------------
+    /// @brief  Constructor
+    ///
+    /// @param  pStream     The stream containing (or receiving) the compressed data (the
+    ///                     compressed stream takes ownership of it)
+    /// @param  mode        The mode (READ or WRITE)
+    /// @param  blockSize   Size of the blocks (only used in WRITE mode)
+    //------------------------------------------------------------------------------------
+    CompressedDataStream(DataStream* pStream, tMode mode = READ,
+                         size_t blockSize = 64 * 1024);
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Destructor
+    //------------------------------------------------------------------------------------
+    virtual ~CompressedDataStream();
+
+private:
+    // Not copiable
+    CompressedDataStream(const CompressedDataStream&);
+    CompressedDataStream& operator=(const CompressedDataStream&);
+
+
+    //_____ Methods __________
+public:
+    //------------------------------------------------------------------------------------
+    /// @brief  Indicates if the stream is usable (in READ mode: if the header and the seek
+    ///         table are valid)
+    //------------------------------------------------------------------------------------
+    inline bool isValid() const
+    {
+        return m_bValid;
+    }
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Returns the size of the uncompressed data
+    //------------------------------------------------------------------------------------
+    inline size_t size() const
+    {
+        return m_totalSize;
+    }
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Returns the number of blocks
+    //------------------------------------------------------------------------------------
+    inline unsigned int nbBlocks() const
+    {
+        return (unsigned int) m_blocks.size();
+    }
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Returns the size of the compressed data (blocks only, without the header
+    ///         and the seek table)
+    //------------------------------------------------------------------------------------
+    size_t compressedSize() const;
+
+private:
+    //------------------------------------------------------------------------------------
+    /// @brief  Read the header and the seek table
+    //------------------------------------------------------------------------------------
+    bool readHeader();
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Write the header (with the current number of blocks and size)
+    //------------------------------------------------------------------------------------
+    bool writeHeader(unsigned long long tableOffset);
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Decompress a block in the block buffer
+    //------------------------------------------------------------------------------------
+    bool loadBlock(unsigned int index);
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Returns the index of the block containing a position
+    //------------------------------------------------------------------------------------
+    unsigned int findBlock(size_t position) const;
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Compress the content of the block buffer and write it
+    //------------------------------------------------------------------------------------
+    bool writeBlock();
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Write the last block, the seek table and the final header
+    //------------------------------------------------------------------------------------
+    bool finish();
+
+
+    //_____ Implementation of DataStream __________
+public:
+    //------------------------------------------------------------------------------------
+    /// @brief  Read the requisite number of bytes from the stream, stopping at the end of
+    ///         the file
+    ///
+    /// @param  buf     Reference to a buffer pointer
+    /// @param  count   Number of bytes to read
+    /// @return         The number of bytes read
+    //------------------------------------------------------------------------------------
+    virtual size_t read(void* buf, size_t count);
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Write the requisite number of bytes to the stream (only in WRITE mode)
+    ///
+    /// @param  buf     Pointer to a buffer containing the bytes to write
+    /// @param  count   Number of bytes to write
+    /// @return         The number of bytes written
+    //------------------------------------------------------------------------------------
+    virtual size_t write(const void* buf, size_t count);
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Skip a defined number of bytes (only in READ mode). This can also be a
+    ///         negative value, in which case the file pointer rewinds a defined number of
+    ///         bytes.
+    //------------------------------------------------------------------------------------
+    virtual void skip(long count);
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Repositions the read point to a specified byte (only in READ mode)
+    //------------------------------------------------------------------------------------
+    virtual void seek(size_t pos);
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Returns the current byte offset from beginning (in the uncompressed data)
+    //------------------------------------------------------------------------------------
+    virtual size_t tell();
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Indicates if the stream has reached the end
+    //------------------------------------------------------------------------------------
+    virtual bool eof() const;
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Close the stream; this makes further operations invalid.
+    //------------------------------------------------------------------------------------
+    virtual void close();
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Compress the data buffered so far (ending the current block) and flush the
+    ///         destination stream
+    ///
+    /// @return 'false' if some data couldn't be written
+    //------------------------------------------------------------------------------------
+    virtual bool flush();
+
+
+    //_____ Attributes __________
+private:
+    DataStream*         m_pStream;          ///< The stream containing the compressed data
+    size_t              m_blockSize;        ///< Maximum size of a block
+    tBlocksList         m_blocks;           ///< The blocks (seek table)
+    std::vector<unsigned char> m_block;     ///< The uncompressed data of the current block
+    std::vector<unsigned char> m_compressed; ///< Temporary buffer for the compressed data
+    int                 m_current;          ///< Index of the block in the buffer (-1 if none)
+    size_t              m_used;             ///< Number of bytes in the buffer (WRITE mode)
+    size_t              m_position;         ///< Current position in the uncompressed data
+    size_t              m_totalSize;        ///< Size of the uncompressed data
+    unsigned long long  m_offset;           ///< Current offset in the compressed stream (WRITE mode)
+    bool                m_bValid;           ///< Indicates if the stream is usable
+    bool                m_bEOF;             ///< Indicates if a read reached the end
+};
+
+}
+}
+
+#endif
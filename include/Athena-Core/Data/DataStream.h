@@ -37,6 +37,28 @@ public:
         READ_WRITE = READ | WRITE
     };
 
+    /// Byte order of the values read by readArray() or written by writeArray()
+    enum tEndianness
+    {
+        ENDIAN_NATIVE,          ///< Byte order of the platform
+        ENDIAN_LITTLE,
+        ENDIAN_BIG,
+    };
+
+    /// Describes a buffer used by readv()
+    struct tBuffer
+    {
+        void*   pData;
+        size_t  size;
+    };
+
+    /// Describes a buffer used by writev()
+    struct tConstBuffer
+    {
+        const void* pData;
+        size_t      size;
+    };
+
 
     //_____ Construction / Destruction __________
 public:
@@ -100,9 +122,101 @@ public:
     //------------------------------------------------------------------------------------
     virtual void close() = 0;
 
+    //------------------------------------------------------------------------------------
+    /// @brief  Send the data buffered by the stream (if any) to its destination
+    ///
+    /// @return 'false' if some data couldn't be written
+    //------------------------------------------------------------------------------------
+    virtual bool flush()
+    {
+        // Default to no buffering
+        return true;
+    }
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Flush the stream, and make sure that the data written so far reached the
+    ///         storage device
+    ///
+    /// @return 'false' if some data couldn't be written
+    //------------------------------------------------------------------------------------
+    virtual bool sync()
+    {
+        return flush();
+    }
+
 
     //_____ Methods __________
 public:
+    //------------------------------------------------------------------------------------
+    /// @brief  Read data from the stream into several buffers, filling them in order and
+    ///         stopping at the end of the file
+    ///
+    /// @param  buffers     The buffers
+    /// @param  nbBuffers   Number of buffers
+    /// @return             The total number of bytes read
+    ///
+    /// @remark The default implementation calls read() for each buffer. Subclasses can
+    ///         do it in one operation.
+    //------------------------------------------------------------------------------------
+    virtual size_t readv(const tBuffer* buffers, unsigned int nbBuffers);
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Write the data contained in several buffers to the stream (only
+    ///         applicable to streams that are not read-only)
+    ///
+    /// @param  buffers     The buffers
+    /// @param  nbBuffers   Number of buffers
+    /// @return             The total number of bytes written
+    ///
+    /// @remark The default implementation calls write() for each buffer. Subclasses can
+    ///         do it in one operation.
+    //------------------------------------------------------------------------------------
+    virtual size_t writev(const tConstBuffer* buffers, unsigned int nbBuffers);
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Read an array of values in one operation
+    ///
+    /// @param  values      The array to fill
+    /// @param  count       Number of values to read
+    /// @param  endianness  Byte order of the values in the stream
+    /// @return             The number of values read (a value only partially read isn't
+    ///                     counted)
+    ///
+    /// @remark Only meaningful for the types that can be copied bytewise (numbers, or
+    ///         structures of bytes). The byte order conversion swaps all the bytes of
+    ///         each value, it is only meaningful for numbers.
+    //------------------------------------------------------------------------------------
+    template<typename T>
+    size_t readArray(T* values, size_t count, tEndianness endianness = ENDIAN_NATIVE)
+    {
+        size_t nbRead = read(values, count * sizeof(T)) / sizeof(T);
+
+        if ((sizeof(T) > 1) && !isNativeEndianness(endianness))
+            swapBytes(values, nbRead, sizeof(T));
+
+        return nbRead;
+    }
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Write an array of values in one operation (only applicable to streams that
+    ///         are not read-only)
+    ///
+    /// @param  values      The values
+    /// @param  count       Number of values to write
+    /// @param  endianness  Byte order of the values in the stream
+    /// @return             The number of values written
+    ///
+    /// @remark See readArray()
+    //------------------------------------------------------------------------------------
+    template<typename T>
+    size_t writeArray(const T* values, size_t count, tEndianness endianness = ENDIAN_NATIVE)
+    {
+        if ((sizeof(T) > 1) && !isNativeEndianness(endianness))
+            return writeSwapped(values, count, sizeof(T));
+
+        return write(values, count * sizeof(T)) / sizeof(T);
+    }
+
     //------------------------------------------------------------------------------------
     /// @brief  Get a single line from the stream
     ///
@@ -162,6 +276,38 @@ public:
     }
 
 
+    //_____ Static methods __________
+public:
+    //------------------------------------------------------------------------------------
+    /// @brief  Indicates if a byte order is the one of the platform
+    //------------------------------------------------------------------------------------
+    static inline bool isNativeEndianness(tEndianness endianness)
+    {
+        if (endianness == ENDIAN_NATIVE)
+            return true;
+
+        const unsigned short test = 1;
+        return ((*reinterpret_cast<const unsigned char*>(&test) == 1) ==
+                (endianness == ENDIAN_LITTLE));
+    }
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Reverse the byte order of each value of an array
+    ///
+    /// @param  values  The array
+    /// @param  count   Number of values in the array
+    /// @param  size    Size of a value, in bytes
+    //------------------------------------------------------------------------------------
+    static void swapBytes(void* values, size_t count, size_t size);
+
+private:
+    //------------------------------------------------------------------------------------
+    /// @brief  Write an array of values, reversing the byte order of each of them
+    /// @return The number of values written
+    //------------------------------------------------------------------------------------
+    size_t writeSwapped(const void* values, size_t count, size_t size);
+
+
     //_____ Attributes __________
 protected:
     tMode m_mode;
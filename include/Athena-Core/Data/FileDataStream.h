@@ -9,7 +9,6 @@
 
 #include <Athena-Core/Prerequisites.h>
 #include <Athena-Core/Data/DataStream.h>
-#include <fstream>
 
 
 namespace Athena {
@@ -17,6 +16,16 @@ namespace Data {
 
 //----------------------------------------------------------------------------------------
 /// @brief  DataStream implementation for a file
+///
+/// The file is accessed through a file descriptor. The small reads and writes done at the
+/// current position of the stream (read(), write(), readLine(), operator>>, ...) go
+/// through a buffer, flushed when the stream is moved or closed. Larger transfers go
+/// directly to the file, and readv() and writev() make one system call per group of up to
+/// 16 buffers (on Linux; one per buffer on the other platforms).
+///
+/// All the accesses are positional (pread/pwrite): the position of the stream is only
+/// maintained by the stream itself. So readAt() can be used concurrently from several
+/// threads on the same stream without any lock, as long as the stream isn't closed.
 //----------------------------------------------------------------------------------------
 class ATHENA_CORE_SYMBOL FileDataStream: public DataStream
 {
@@ -26,7 +35,8 @@ public:
     /// @brief  Constructor
     ///
     /// @param  strFileName     Path to the file
-    /// @param  bReadOnly       Indicates if the file must be open in read-only mode
+    /// @param  mode            The mode: in WRITE mode, the file is created (or truncated),
+    ///                         in READ_WRITE mode, it must already exist
     //------------------------------------------------------------------------------------
     FileDataStream(const std::string& strFileName, tMode mode = READ);
 
@@ -43,9 +53,58 @@ public:
     //------------------------------------------------------------------------------------
     inline bool isOpen() const
     {
-        return m_stream.is_open();
+        return (m_file >= 0);
     }
 
+    //------------------------------------------------------------------------------------
+    /// @brief  Read bytes at a given position, without using (or modifying) the current
+    ///         position of the stream
+    ///
+    /// @param  offset  Position of the first byte to read
+    /// @param  buf     Reference to a buffer pointer
+    /// @param  count   Number of bytes to read
+    /// @return         The number of bytes read (less than count at the end of the file)
+    ///
+    /// @remark Thread-safe. The bytes written with write() aren't visible until flush()
+    ///         is called.
+    //------------------------------------------------------------------------------------
+    size_t readAt(size_t offset, void* buf, size_t count) const;
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Read bytes at a given position into several buffers, without using (or
+    ///         modifying) the current position of the stream
+    ///
+    /// @param  offset      Position of the first byte to read
+    /// @param  buffers     The buffers
+    /// @param  nbBuffers   Number of buffers
+    /// @return             The total number of bytes read
+    ///
+    /// @remark Thread-safe
+    //------------------------------------------------------------------------------------
+    size_t readvAt(size_t offset, const tBuffer* buffers, unsigned int nbBuffers) const;
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Write bytes at a given position, without using (or modifying) the current
+    ///         position of the stream
+    ///
+    /// @param  offset  Position of the first byte to write
+    /// @param  buf     Pointer to a buffer containing the bytes to write
+    /// @param  count   Number of bytes to write
+    /// @return         The number of bytes written
+    //------------------------------------------------------------------------------------
+    size_t writeAt(size_t offset, const void* buf, size_t count);
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Write the data contained in several buffers at a given position, without
+    ///         using (or modifying) the current position of the stream
+    ///
+    /// @param  offset      Position of the first byte to write
+    /// @param  buffers     The buffers
+    /// @param  nbBuffers   Number of buffers
+    /// @return             The total number of bytes written
+    //------------------------------------------------------------------------------------
+    size_t writevAt(size_t offset, const tConstBuffer* buffers, unsigned int nbBuffers);
+
 
     //_____ Implementation of DataStream __________
 public:
@@ -69,6 +128,25 @@ public:
     //------------------------------------------------------------------------------------
     virtual size_t write(const void* buf, size_t count);
 
+    //------------------------------------------------------------------------------------
+    /// @brief  Read data from the stream into several buffers, filling them in order and
+    ///         stopping at the end of the file
+    ///
+    /// @param  buffers     The buffers
+    /// @param  nbBuffers   Number of buffers
+    /// @return             The total number of bytes read
+    //------------------------------------------------------------------------------------
+    virtual size_t readv(const tBuffer* buffers, unsigned int nbBuffers);
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Write the data contained in several buffers to the stream
+    ///
+    /// @param  buffers     The buffers
+    /// @param  nbBuffers   Number of buffers
+    /// @return             The total number of bytes written
+    //------------------------------------------------------------------------------------
+    virtual size_t writev(const tConstBuffer* buffers, unsigned int nbBuffers);
+
     //------------------------------------------------------------------------------------
     /// @brief  Skip a defined number of bytes. This can also be a negative value, in
     ///         which case the file pointer rewinds a defined number of bytes.
@@ -95,10 +173,30 @@ public:
     //------------------------------------------------------------------------------------
     virtual void close();
 
+    //------------------------------------------------------------------------------------
+    /// @brief  Write the bytes still in the buffer to the file
+    ///
+    /// @return 'false' if some data couldn't be written
+    //------------------------------------------------------------------------------------
+    virtual bool flush();
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Make sure that the data written so far reached the storage device
+    ///
+    /// @return 'false' if failed
+    //------------------------------------------------------------------------------------
+    virtual bool sync();
+
 
     //_____ Attributes __________
 protected:
-    std::fstream m_stream;
+    int             m_file;         ///< The file descriptor (-1 if not opened)
+    size_t          m_position;     ///< Current position in the file
+    bool            m_bEOF;         ///< Indicates if a read reached the end of the file
+    unsigned char*  m_pBuffer;      ///< Buffer of the cursor API (allocated on first use)
+    size_t          m_bufferOffset; ///< Position in the file of the first byte of the buffer
+    size_t          m_bufferSize;   ///< Number of bytes in the buffer
+    bool            m_bBufferDirty; ///< Indicates if the buffer contains bytes to write
 };
 
 }
@@ -0,0 +1,144 @@
+/** @file   FileRequest.h
+    @author Philip Abbet
+
+    Declaration of the class 'Athena::Data::FileRequest'
+*/
+
+#ifndef _ATHENA_DATA_FILEREQUEST_H_
+#define _ATHENA_DATA_FILEREQUEST_H_
+
+#include <Athena-Core/Prerequisites.h>
+#include <Athena-Core/Utils/Mutex.h>
+#include <Athena-Core/Utils/Condition.h>
+
+
+namespace Athena {
+namespace Data {
+
+//----------------------------------------------------------------------------------------
+/// @brief  Represents the asynchronous loading of a file in memory
+///
+/// The requests are created by LocationManager::openAsync(), and processed by the I/O
+/// threads of the location manager. The owner of the request can check if the file is
+/// loaded with isReady(), or wait for it with wait(), then create streams on the content
+/// of the file with createStream(). The content is loaded only once, and shared by all
+/// those streams.
+///
+/// @remark The requests are reference-counted (they are shared between their owner and
+///         the I/O threads): use release() instead of deleting them
+//----------------------------------------------------------------------------------------
+class ATHENA_CORE_SYMBOL FileRequest
+{
+    //_____ Internal types __________
+public:
+    enum tState
+    {
+        PENDING,        ///< The file isn't loaded yet
+        SUCCEEDED,      ///< The file is loaded
+        FAILED,         ///< The file couldn't be loaded (or the request was cancelled)
+    };
+
+
+    //_____ Construction / Destruction __________
+public:
+    //------------------------------------------------------------------------------------
+    /// @brief  Create a pending request
+    ///
+    /// @param  strPath     Path to the file to load
+    //------------------------------------------------------------------------------------
+    FileRequest(const std::string& strPath);
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Create an already completed request
+    ///
+    /// @param  strPath     Path to the file
+    /// @param  pStream     The stream (the request takes its ownership), 0 if the file
+    ///                     couldn't be opened
+    //------------------------------------------------------------------------------------
+    FileRequest(const std::string& strPath, MemoryDataStream* pStream);
+
+private:
+    ~FileRequest();
+
+    // Not copiable
+    FileRequest(const FileRequest&);
+    FileRequest& operator=(const FileRequest&);
+
+
+    //_____ Methods __________
+public:
+    //------------------------------------------------------------------------------------
+    /// @brief  Increments the reference count of the request
+    //------------------------------------------------------------------------------------
+    void addRef();
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Decrements the reference count of the request, destroying it when it
+    ///         reaches 0
+    //------------------------------------------------------------------------------------
+    void release();
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Returns the path to the file
+    //------------------------------------------------------------------------------------
+    inline const std::string& path() const
+    {
+        return m_strPath;
+    }
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Returns the state of the request
+    //------------------------------------------------------------------------------------
+    tState state();
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Indicates if the request is completed (successfully or not)
+    //------------------------------------------------------------------------------------
+    inline bool isReady()
+    {
+        return (state() != PENDING);
+    }
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Wait until the request is completed
+    /// @return The final state of the request
+    //------------------------------------------------------------------------------------
+    tState wait();
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Wait until the request is completed, and create a stream on the content
+    ///         of the file
+    ///
+    /// @return The stream (the caller must delete it), 0 if the request failed. All the
+    ///         streams share the same content, without copying it.
+    //------------------------------------------------------------------------------------
+    MemoryDataStream* createStream();
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Load the file (called by the I/O threads)
+    //------------------------------------------------------------------------------------
+    void execute();
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Mark the request as completed (called by the I/O threads)
+    ///
+    /// @param  pStream     The stream (the request takes its ownership), 0 if the file
+    ///                     couldn't be loaded
+    //------------------------------------------------------------------------------------
+    void complete(MemoryDataStream* pStream);
+
+
+    //_____ Attributes __________
+private:
+    std::string         m_strPath;      ///< Path to the file
+    tState              m_state;        ///< State of the request
+    MemoryDataStream*   m_pStream;      ///< The stream on the content of the file
+    unsigned int        m_nbRefs;       ///< Reference count
+    Utils::Mutex        m_mutex;        ///< Protects the other attributes
+    Utils::Condition    m_completed;    ///< Signaled when the request is completed
+};
+
+}
+}
+
+#endif
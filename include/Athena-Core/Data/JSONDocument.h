@@ -0,0 +1,86 @@
+/** @file   JSONDocument.h
+    @author Philip Abbet
+
+    Declaration of the class 'Athena::Data::JSONDocument'
+*/
+
+#ifndef _ATHENA_DATA_JSONDOCUMENT_H_
+#define _ATHENA_DATA_JSONDOCUMENT_H_
+
+#include <Athena-Core/Prerequisites.h>
+#include <Athena-Core/Utils/PropertiesSource.h>
+#include <rapidjson/document.h>
+
+
+namespace Athena {
+namespace Data {
+
+//----------------------------------------------------------------------------------------
+/// @brief  A reference-counted JSON document, from which the describables can load their
+///         properties lazily (@see fromJSON())
+///
+/// The document is filled by its creator (by parsing a string or with loadJSONFile()),
+/// then must not be modified anymore: the describables keep pointers to its values
+/// until they are converted.
+///
+/// Usage example, to load a file containing many objects:
+/// @code
+///     JSONDocument* pDocument = JSONDocument::create();
+///     loadJSONFile("scene.json", pDocument->document());
+///
+///     for (unsigned int i = 0; i < pDocument->document().Size(); ++i)
+///         fromJSON(pDocument->document()[i], objects[i], pDocument);
+///
+///     // The document is destroyed once all its values were converted
+///     pDocument->release();
+/// @endcode
+//----------------------------------------------------------------------------------------
+class ATHENA_CORE_SYMBOL JSONDocument: public Utils::PropertiesSource
+{
+    //_____ Construction / Destruction __________
+public:
+    //------------------------------------------------------------------------------------
+    /// @brief  Create an empty document
+    ///
+    /// @return The document (with a reference count of 1)
+    //------------------------------------------------------------------------------------
+    static JSONDocument* create();
+
+protected:
+    JSONDocument();
+    virtual ~JSONDocument();
+
+
+    //_____ Methods __________
+public:
+    //------------------------------------------------------------------------------------
+    /// @brief  Returns the rapidjson document
+    //------------------------------------------------------------------------------------
+    inline rapidjson::Document& document()
+    {
+        return m_document;
+    }
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Returns the rapidjson document
+    //------------------------------------------------------------------------------------
+    inline const rapidjson::Document& document() const
+    {
+        return m_document;
+    }
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Converts a value of the document (a pointer to a rapidjson value)
+    //------------------------------------------------------------------------------------
+    virtual void convert(const void* pValue, Utils::Variant& value) const;
+
+
+    //_____ Attributes __________
+private:
+    rapidjson::Document m_document; ///< The document
+};
+
+}
+}
+
+#endif
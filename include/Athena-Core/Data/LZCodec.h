@@ -0,0 +1,82 @@
+/** @file   LZCodec.h
+    @author Philip Abbet
+
+    Declaration of the class 'Athena::Data::LZCodec'
+*/
+
+#ifndef _ATHENA_DATA_LZCODEC_H_
+#define _ATHENA_DATA_LZCODEC_H_
+
+#include <Athena-Core/Prerequisites.h>
+
+
+namespace Athena {
+namespace Data {
+
+//----------------------------------------------------------------------------------------
+/// @brief  Fast LZ77 block compressor
+///
+/// Each block is compressed independently (the matches can't reference the content of
+/// another block), so any block can be decompressed on its own. The compressed data is a
+/// list of sequences, each made of:
+///   - a token: the number of literals in the high 4 bits, the length of the match minus
+///     4 in the low 4 bits (a value of 15 means that the length continues in the next
+///     bytes, as a sum of bytes ending with a byte lower than 255)
+///   - the literals
+///   - the offset of the match (2 bytes, little-endian)
+///
+/// The last sequence only contains literals (no offset, its match length is 0).
+///
+/// The compressor favours speed over ratio: it uses a single hash table of 4-byte
+/// prefixes, without chaining.
+//----------------------------------------------------------------------------------------
+class ATHENA_CORE_SYMBOL LZCodec
+{
+    //_____ Static methods __________
+public:
+    //------------------------------------------------------------------------------------
+    /// @brief  Compress a block
+    ///
+    /// @param  pSrc            The data to compress
+    /// @param  srcSize         Size of the data to compress
+    /// @param  pDest           The buffer receiving the compressed data
+    /// @param  destCapacity    Size of the destination buffer
+    /// @return                 Size of the compressed data, 0 if the destination buffer is
+    ///                         too small
+    //------------------------------------------------------------------------------------
+    static size_t compress(const void* pSrc, size_t srcSize, void* pDest, size_t destCapacity);
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Decompress a block
+    ///
+    /// @param  pSrc            The compressed data
+    /// @param  srcSize         Size of the compressed data
+    /// @param  pDest           The buffer receiving the decompressed data
+    /// @param  destSize        Size of the decompressed data
+    /// @return                 'false' if the compressed data is corrupted or doesn't
+    ///                         decompress to exactly destSize bytes
+    ///
+    /// @remark Safe with corrupted data: no read or write is done outside of the buffers
+    //------------------------------------------------------------------------------------
+    static bool decompress(const void* pSrc, size_t srcSize, void* pDest, size_t destSize);
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Returns the size needed in the worst case to compress a block
+    ///
+    /// @param  srcSize     Size of the data to compress
+    //------------------------------------------------------------------------------------
+    static inline size_t maxCompressedSize(size_t srcSize)
+    {
+        return srcSize + srcSize / 255 + 16;
+    }
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Maximum distance between a match and the data it references
+    //------------------------------------------------------------------------------------
+    static const size_t MAX_OFFSET = 65535;
+};
+
+}
+}
+
+#endif
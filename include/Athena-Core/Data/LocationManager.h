@@ -16,9 +16,22 @@
 namespace Athena {
 namespace Data {
 
+class IOThreadPool;
+
 //----------------------------------------------------------------------------------------
 /// @brief  This class is used to store some locations
 ///
+/// The content of the locations of a group is scanned the first time a file is searched
+/// in that group, so the subsequent searches are resolved from memory. The result of each
+/// search is remembered until the group is refreshed (for the unsuccessful ones, only
+/// the most recent ones are remembered).
+///
+/// A location can also be a pack file (see PackFile): the files it contains are then
+/// read directly from its memory mapping, without opening them individually.
+///
+/// Files can also be loaded in memory asynchronously by a pool of I/O threads (see
+/// openAsync() and prefetch()), so the I/O can overlap with other work.
+///
 /// @remark This class is a singleton.
 //----------------------------------------------------------------------------------------
 class ATHENA_CORE_SYMBOL LocationManager: public Utils::Singleton<LocationManager>
@@ -30,13 +43,34 @@ public:
     typedef tLocationsList::iterator                tLocationsNativeIterator;
 
     typedef std::vector<std::string>                tGroupsList;
+    typedef std::vector<std::string>                tFilesList;
 
 private:
-    typedef std::map<std::string, tLocationsList>   tGroupsMap;
+    /// Maps a file name to the index of the location containing it (-1 if not found)
+    typedef std::map<std::string, int>              tFilesMap;
+    typedef tFilesMap::iterator                     tFilesNativeIterator;
+
+    struct tGroup
+    {
+        tLocationsList  locations;      ///< The locations, in search order
+        std::vector<PackFile*> packs;   ///< The pack file of each location (0 for the others)
+        tFilesMap       files;          ///< The files already resolved or indexed
+        unsigned int    nbNotFound;     ///< Number of files not found in 'files'
+        bool            bIndexed;       ///< Indicates if the locations were scanned
+        bool            bFullyIndexed;  ///< Indicates if all the locations could be scanned
+    };
+
+    typedef std::map<std::string, tGroup>           tGroupsMap;
     typedef Utils::MapIterator<tGroupsMap>          tGroupsIterator;
     typedef tGroupsMap::iterator                    tGroupsNativeIterator;
     typedef tGroupsMap::const_iterator              tGroupsNativeConstIterator;
 
+    /// Maps a (group, file name) pair to a pending or completed request
+    typedef std::map<std::pair<std::string, std::string>, FileRequest*> tRequestsMap;
+
+    /// Maps an inotify watch descriptor to the groups interested by it
+    typedef std::map<int, std::vector<std::string> >   tWatchesMap;
+
 
     //_____ Construction / Destruction __________
 public:
@@ -89,6 +123,14 @@ public:
     ///
     /// @param  strGroup        The group to look in
     /// @param  strFileName     The name of the file
+    ///
+    /// @remark The result is cached: a file added to (or removed from) a location after
+    ///         a search will only be noticed after a call to refresh(), or automatically
+    ///         if the auto-refresh mode is enabled
+    ///
+    /// @remark For a file contained in a pack file, the returned path is the path of the
+    ///         pack file followed by '/' and the name of the file: it can't be opened
+    ///         directly, use open() instead
     //------------------------------------------------------------------------------------
     std::string path(const std::string& strGroup, const std::string& strFileName);
 
@@ -97,9 +139,52 @@ public:
     ///
     /// @param  strGroup        The group to look in
     /// @param  strFileName     The name of the file
+    /// @return                 The stream (the caller must delete it), 0 if not found
     //------------------------------------------------------------------------------------
     DataStream* open(const std::string& strGroup, const std::string& strFileName);
 
+    //------------------------------------------------------------------------------------
+    /// @brief  Load a file in memory asynchronously, using the I/O threads
+    ///
+    /// @param  strGroup        The group to look in
+    /// @param  strFileName     The name of the file
+    /// @return                 The request (the caller must release it), 0 if not found
+    ///
+    /// @remark The file is searched immediately, only its loading is asynchronous. Files
+    ///         contained in pack files don't need to be loaded: their requests are
+    ///         already completed.
+    //------------------------------------------------------------------------------------
+    FileRequest* openAsync(const std::string& strGroup, const std::string& strFileName);
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Load some files in memory asynchronously, using the I/O threads, so they
+    ///         are available immediately when opened later
+    ///
+    /// @param  strGroup        The group to look in
+    /// @param  files           The names of the files
+    ///
+    /// @remark The prefetched files are kept in memory until their group is refreshed:
+    ///         open() returns streams sharing the loaded content (waiting for it if
+    ///         necessary), so a file can be read by several consumers without being
+    ///         loaded or copied again. openAsync() returns the request of the prefetch.
+    //------------------------------------------------------------------------------------
+    void prefetch(const std::string& strGroup, const tFilesList& files);
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Set the number of I/O threads (2 by default)
+    ///
+    /// @remark Must be called before the first asynchronous operation
+    //------------------------------------------------------------------------------------
+    void setNbIOThreads(unsigned int nbThreads);
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Returns the number of I/O threads
+    //------------------------------------------------------------------------------------
+    inline unsigned int nbIOThreads() const
+    {
+        return m_nbIOThreads;
+    }
+
     //------------------------------------------------------------------------------------
     /// @brief  Returns the locations associated to the given group
     ///
@@ -120,10 +205,80 @@ public:
     //------------------------------------------------------------------------------------
     tGroupsList groups() const;
 
+    //------------------------------------------------------------------------------------
+    /// @brief  Forget everything known about the content of the locations of all the
+    ///         groups (they will be scanned again at the next search)
+    //------------------------------------------------------------------------------------
+    void refresh();
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Forget everything known about the content of the locations of a group
+    ///         (they will be scanned again at the next search)
+    ///
+    /// @param  strGroup        The group
+    //------------------------------------------------------------------------------------
+    void refresh(const std::string& strGroup);
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Enable or disable the automatic refresh of the groups when the content of
+    ///         their locations is modified
+    ///
+    /// @param  bEnabled        Indicates if the auto-refresh mode must be enabled
+    /// @return                 'false' if the auto-refresh mode isn't supported
+    ///
+    /// @remark Only supported on Linux (using inotify). Only the locations that can be
+    ///         scanned (directories ending with a path separator) are watched.
+    //------------------------------------------------------------------------------------
+    bool setAutoRefresh(bool bEnabled);
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Indicates if the auto-refresh mode is enabled
+    //------------------------------------------------------------------------------------
+    inline bool isAutoRefreshEnabled() const
+    {
+        return (m_notifications >= 0);
+    }
+
+
+    //_____ Internal methods __________
+private:
+    //------------------------------------------------------------------------------------
+    /// @brief  Search a file
+    ///
+    /// @param  strGroup        The group to look in
+    /// @param  strFileName     The name of the file
+    /// @param  location        Set to the index of the location containing the file (-1
+    ///                         if not found)
+    /// @return                 The group, 0 if unknown
+    //------------------------------------------------------------------------------------
+    tGroup* findFile(const std::string& strGroup, const std::string& strFileName,
+                     int& location);
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Scan the locations of a group
+    //------------------------------------------------------------------------------------
+    void indexGroup(const std::string& strGroup, tGroup& group);
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Returns the index of the location of a group containing a file (-1 if not
+    ///         found)
+    //------------------------------------------------------------------------------------
+    int resolve(tGroup& group, const std::string& strFileName);
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Process the pending change notifications (auto-refresh mode)
+    //------------------------------------------------------------------------------------
+    void processNotifications();
+
 
     //_____ Attributes __________
 private:
-    tGroupsMap m_groups;        ///< The groups
+    tGroupsMap  m_groups;           ///< The groups
+    int         m_notifications;    ///< File descriptor used to watch the locations (-1 if disabled)
+    tWatchesMap m_watches;          ///< The watched directories
+    tRequestsMap m_prefetched;      ///< The prefetched files
+    IOThreadPool* m_pIOThreadPool;  ///< The I/O threads (created when needed)
+    unsigned int m_nbIOThreads;     ///< Number of I/O threads
 };
 
 }
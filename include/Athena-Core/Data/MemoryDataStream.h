@@ -0,0 +1,169 @@
+/** @file   MemoryDataStream.h
+    @author Philip Abbet
+
+    Definition of the class 'Athena::Data::MemoryDataStream'
+*/
+
+#ifndef _ATHENA_DATA_MEMORYDATASTREAM_H_
+#define _ATHENA_DATA_MEMORYDATASTREAM_H_
+
+#include <Athena-Core/Prerequisites.h>
+#include <Athena-Core/Data/DataStream.h>
+
+
+namespace Athena {
+namespace Data {
+
+//----------------------------------------------------------------------------------------
+/// @brief  Read-only DataStream implementation for a buffer in memory
+///
+/// The buffer can be:
+///   - owned by the stream (deleted when the stream is closed)
+///   - borrowed (the caller must keep it alive as long as the stream is used)
+///   - shared with other streams (see SharedBuffer)
+///
+/// Sub-streams on a part of the buffer can be created with slice(), without copying the
+/// data. When the buffer is owned or shared, the slices share it with the stream, so
+/// they remain valid after the stream is destroyed.
+//----------------------------------------------------------------------------------------
+class ATHENA_CORE_SYMBOL MemoryDataStream: public DataStream
+{
+    //_____ Internal types __________
+public:
+    enum tOwnership
+    {
+        BORROW,             ///< The buffer is borrowed
+        TAKE_OWNERSHIP,     ///< The stream takes the ownership of the buffer
+    };
+
+
+    //_____ Construction / Destruction __________
+public:
+    //------------------------------------------------------------------------------------
+    /// @brief  Constructor, using a borrowed buffer in memory
+    ///
+    /// @param  pData       The buffer
+    /// @param  size        Size of the buffer
+    //------------------------------------------------------------------------------------
+    MemoryDataStream(const void* pData, size_t size);
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Constructor, using a buffer in memory that the stream can own
+    ///
+    /// @param  pData       The buffer; if the stream takes its ownership, it must have
+    ///                     been allocated with new unsigned char[]
+    /// @param  size        Size of the buffer
+    /// @param  ownership   Indicates if the buffer is borrowed or if the stream takes its
+    ///                     ownership
+    //------------------------------------------------------------------------------------
+    MemoryDataStream(unsigned char* pData, size_t size, tOwnership ownership);
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Constructor, using a shared buffer
+    ///
+    /// @param  pBuffer     The buffer (its reference count is incremented)
+    /// @param  offset      Offset of the data of the stream in the buffer
+    /// @param  size        Size of the data of the stream (by default, until the end of
+    ///                     the buffer)
+    //------------------------------------------------------------------------------------
+    MemoryDataStream(SharedBuffer* pBuffer, size_t offset = 0, size_t size = (size_t) -1);
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Destructor
+    //------------------------------------------------------------------------------------
+    virtual ~MemoryDataStream();
+
+private:
+    // Not copiable
+    MemoryDataStream(const MemoryDataStream&);
+    MemoryDataStream& operator=(const MemoryDataStream&);
+
+
+    //_____ Methods __________
+public:
+    //------------------------------------------------------------------------------------
+    /// @brief  Create a stream on a part of the data of this one, without copying it
+    ///
+    /// @param  offset  Offset of the part, from the beginning of this stream
+    /// @param  size    Size of the part (truncated at the end of this stream)
+    /// @return         The new stream (the caller must delete it)
+    //------------------------------------------------------------------------------------
+    MemoryDataStream* slice(size_t offset, size_t size = (size_t) -1) const;
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Returns the data of the stream
+    //------------------------------------------------------------------------------------
+    inline const unsigned char* data() const
+    {
+        return m_pData;
+    }
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Returns the size of the data of the stream
+    //------------------------------------------------------------------------------------
+    inline size_t size() const
+    {
+        return m_size;
+    }
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Returns the shared buffer containing the data (0 if the data is borrowed)
+    //------------------------------------------------------------------------------------
+    inline SharedBuffer* buffer() const
+    {
+        return m_pBuffer;
+    }
+
+
+    //_____ Implementation of DataStream __________
+public:
+    //------------------------------------------------------------------------------------
+    /// @brief  Read the requisite number of bytes from the stream, stopping at the end of
+    ///         the buffer
+    ///
+    /// @param  buf     Reference to a buffer pointer
+    /// @param  count   Number of bytes to read
+    /// @return         The number of bytes read
+    //------------------------------------------------------------------------------------
+    virtual size_t read(void* buf, size_t count);
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Skip a defined number of bytes. This can also be a negative value, in
+    ///         which case the file pointer rewinds a defined number of bytes.
+    //------------------------------------------------------------------------------------
+    virtual void skip(long count);
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Repositions the read point to a specified byte
+    //------------------------------------------------------------------------------------
+    virtual void seek(size_t pos);
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Returns the current byte offset from beginning
+    //------------------------------------------------------------------------------------
+    virtual size_t tell();
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Indicates if the stream has reached the end
+    //------------------------------------------------------------------------------------
+    virtual bool eof() const;
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Close the stream; this makes further operations invalid.
+    //------------------------------------------------------------------------------------
+    virtual void close();
+
+
+    //_____ Attributes __________
+protected:
+    SharedBuffer*           m_pBuffer;  ///< The shared buffer (0 if borrowed)
+    const unsigned char*    m_pData;    ///< The data
+    size_t                  m_size;     ///< Size of the data
+    size_t                  m_pos;      ///< Current position in the data
+    bool                    m_bEOF;     ///< Indicates if a read reached the end of the data
+};
+
+}
+}
+
+#endif
@@ -0,0 +1,162 @@
+/** @file   PackFile.h
+    @author Philip Abbet
+
+    Declaration of the class 'Athena::Data::PackFile'
+*/
+
+#ifndef _ATHENA_DATA_PACKFILE_H_
+#define _ATHENA_DATA_PACKFILE_H_
+
+#include <Athena-Core/Prerequisites.h>
+#include <Athena-Core/Data/SharedBuffer.h>
+
+
+namespace Athena {
+namespace Data {
+
+//----------------------------------------------------------------------------------------
+/// @brief  Gives access to the content of a pack file
+///
+/// A pack file contains the files of a directory (and of its sub-directories), followed
+/// by a table of contents indexed by the hash of the file names. The pack file is mapped
+/// in memory, and the streams returned by open() read directly from that mapping.
+///
+/// All the values are stored in little-endian order. Layout of a pack file:
+///   - header (32 bytes): magic number ("APAK"), version, number of entries, number of
+///     hash buckets (a power of 2), offset of the table of contents, checksum (64-bit
+///     hash of everything following the header, see Checksum::hash64(); 0 if unknown)
+///   - the content of the files, each one aligned on 16 bytes
+///   - the table of contents: the index of the first entry of each bucket (plus one
+///     final index), the entries sorted by bucket (hash of the name, offset and size of
+///     the data, position and length of the name) and the names
+///
+/// @remark The pack files are read-only shared buffers (reference-counted): the streams
+///         returned by open() keep the pack file alive, so it can be released while they
+///         are in use
+//----------------------------------------------------------------------------------------
+class ATHENA_CORE_SYMBOL PackFile: public SharedBuffer
+{
+    //_____ Construction / Destruction __________
+public:
+    //------------------------------------------------------------------------------------
+    /// @brief  Open a pack file
+    ///
+    /// @param  strFileName     Path to the pack file
+    /// @return                 The pack file (with a reference count of 1), 0 if the file
+    ///                         doesn't exist or isn't a valid pack file
+    //------------------------------------------------------------------------------------
+    static PackFile* load(const std::string& strFileName);
+
+private:
+    PackFile(const std::string& strFileName);
+    virtual ~PackFile();
+
+    // Not copiable
+    PackFile(const PackFile&);
+    PackFile& operator=(const PackFile&);
+
+
+    //_____ Static methods __________
+public:
+    //------------------------------------------------------------------------------------
+    /// @brief  Create a pack file containing all the files of a directory (and of its
+    ///         sub-directories)
+    ///
+    /// @param  strDirectory    The directory
+    /// @param  strFileName     Path to the pack file to create (not included in the pack
+    ///                         if it is in the directory)
+    /// @return                 'true' if successful; in case of failure, the pack file is
+    ///                         deleted
+    //------------------------------------------------------------------------------------
+    static bool build(const std::string& strDirectory, const std::string& strFileName);
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Compute the hash of a file name, as used in the table of contents
+    //------------------------------------------------------------------------------------
+    static unsigned long long hash(const std::string& strName);
+
+
+    //_____ Methods __________
+public:
+    //------------------------------------------------------------------------------------
+    /// @brief  Check the integrity of the pack file, by comparing its content with the
+    ///         checksum stored in its header
+    ///
+    /// @return 'false' if the pack file is corrupted ('true' if no checksum is available)
+    ///
+    /// @remark Reads the whole pack file
+    //------------------------------------------------------------------------------------
+    bool verify() const;
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Indicates if the pack file contains a file
+    ///
+    /// @param  strName     Name of the file (relative to the packed directory, with '/'
+    ///                     as separator)
+    //------------------------------------------------------------------------------------
+    bool contains(const std::string& strName) const;
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Open a file contained in the pack file
+    ///
+    /// @param  strName     Name of the file (relative to the packed directory, with '/'
+    ///                     as separator)
+    /// @return             A stream on the content of the file (sharing the memory
+    ///                     mapping), 0 if not found. The caller must delete it.
+    //------------------------------------------------------------------------------------
+    MemoryDataStream* open(const std::string& strName);
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Returns the number of files in the pack file
+    //------------------------------------------------------------------------------------
+    inline unsigned int nbEntries() const
+    {
+        return m_nbEntries;
+    }
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Returns the name of one of the files in the pack file
+    //------------------------------------------------------------------------------------
+    std::string entryName(unsigned int index) const;
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Returns the path to the pack file
+    //------------------------------------------------------------------------------------
+    inline const std::string& fileName() const
+    {
+        return m_strFileName;
+    }
+
+private:
+    //------------------------------------------------------------------------------------
+    /// @brief  Map the file in memory and check its table of contents
+    //------------------------------------------------------------------------------------
+    bool map();
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Returns the entry of the table of contents describing a file, 0 if not
+    ///         found
+    //------------------------------------------------------------------------------------
+    const unsigned char* findEntry(const std::string& strName) const;
+
+
+    //_____ Attributes __________
+private:
+    std::string             m_strFileName;  ///< Path to the pack file
+    unsigned int            m_nbEntries;    ///< Number of files
+    unsigned int            m_nbBuckets;    ///< Number of buckets in the hash table
+    const unsigned char*    m_pBuckets;     ///< The buckets of the hash table
+    const unsigned char*    m_pEntries;     ///< The entries of the table of contents
+    const unsigned char*    m_pNames;       ///< The names of the files
+    size_t                  m_namesSize;    ///< Size of the names block
+
+#if ATHENA_PLATFORM == ATHENA_PLATFORM_WIN32
+    void*                   m_hFile;        ///< Handle of the file
+    void*                   m_hMapping;     ///< Handle of the mapping
+#endif
+};
+
+}
+}
+
+#endif
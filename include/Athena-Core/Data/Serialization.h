@@ -66,6 +66,30 @@ namespace Data {
                                      Utils::PropertiesList* pDelayedProperties = 0);
 
 
+    //------------------------------------------------------------------------------------
+    /// @brief Assign the properties represented by a rapidjson value to a Describable
+    /// object, lazily (@see Athena::Utils::Describable::addPendingProperty())
+    ///
+    /// The values of the properties declared in the tables of the describable (@see
+    /// Athena::Utils::PropertiesTable) and having a known type are only converted when
+    /// first accessed, or by Describable::materializeAll(). The other ones are assigned
+    /// immediately.
+    ///
+    /// @param json_describable     The rapidjson value (must belong to the document)
+    /// @retval pDescribable        The describable
+    /// @param pDocument            The document containing the value, kept alive until
+    ///                             all the pending values are converted
+    /// @retval pDelayedProperties  If provided, the properties that aren't usable yet
+    ///                             (because, for example, another object which isn't
+    ///                             already created is needed) are put into that list by
+    ///                             the describable
+    //------------------------------------------------------------------------------------
+    ATHENA_CORE_SYMBOL void fromJSON(const rapidjson::Value& json_describable,
+                                     Utils::Describable* pDescribable,
+                                     JSONDocument* pDocument,
+                                     Utils::PropertiesList* pDelayedProperties = 0);
+
+
     //------------------------------------------------------------------------------------
     /// @brief Returns the JSON representation of a describable object (@see
     /// Athena::Utils::Describable) as a string
@@ -73,6 +97,65 @@ namespace Data {
     ATHENA_CORE_SYMBOL std::string toJSON(Utils::Describable* pDescribable);
 
 
+    //------------------------------------------------------------------------------------
+    /// @brief Returns the rapidjson representation of the properties of a describable
+    /// object modified since the last call to its clearChangedProperties() method (@see
+    /// Athena::Utils::Describable::getChangedProperties())
+    ///
+    /// The result can be applied to another describable with fromJSON().
+    ///
+    /// @param  pDescribable    The describable
+    /// @retval json_changes    The resulting rapidjson representation
+    /// @param  allocator       The memory allocator to use
+    //------------------------------------------------------------------------------------
+    ATHENA_CORE_SYMBOL void changesToJSON(Utils::Describable* pDescribable,
+                                          rapidjson::Value &json_changes,
+                                          rapidjson::Value::AllocatorType &allocator);
+
+
+    //------------------------------------------------------------------------------------
+    /// @brief Returns the JSON representation of the properties of a describable object
+    /// modified since the last call to its clearChangedProperties() method, as a
+    /// (compact) string
+    //------------------------------------------------------------------------------------
+    ATHENA_CORE_SYMBOL std::string changesToJSON(Utils::Describable* pDescribable);
+
+
+    //------------------------------------------------------------------------------------
+    /// @brief Write the properties of a describable object modified since the last call
+    /// to its clearChangedProperties() method into a stream, in a compact binary format
+    ///
+    /// The properties are identified by their index in the tables of the class of the
+    /// describable (@see Athena::Utils::PropertiesTable), so the changes can only be
+    /// read by a describable of the same class (built with the same declarations of
+    /// properties). A hash of the layout of the properties is written first, so
+    /// readChanges() rejects the changes written by another class.
+    ///
+    /// @param  pDescribable    The describable
+    /// @param  pStream         The stream
+    /// @return                 'false' if the stream failed
+    //------------------------------------------------------------------------------------
+    ATHENA_CORE_SYMBOL bool writeChanges(Utils::Describable* pDescribable,
+                                         DataStream* pStream);
+
+
+    //------------------------------------------------------------------------------------
+    /// @brief Apply the changes written by writeChanges() to a describable object
+    ///
+    /// @param  pStream             The stream
+    /// @retval pDescribable        The describable
+    /// @retval pDelayedProperties  If provided, the properties that aren't usable yet
+    ///                             (because, for example, another object which isn't
+    ///                             already created is needed) are put into that list by
+    ///                             the describable
+    /// @return                     'false' if the data is invalid, or was written by a
+    ///                             describable of another class
+    //------------------------------------------------------------------------------------
+    ATHENA_CORE_SYMBOL bool readChanges(DataStream* pStream,
+                                        Utils::Describable* pDescribable,
+                                        Utils::PropertiesList* pDelayedProperties = 0);
+
+
     //------------------------------------------------------------------------------------
     /// @brief Returns the Describable object represented by a JSON string
     ///
@@ -82,10 +165,15 @@ namespace Data {
     ///                             (because, for example, another object which isn't
     ///                             already created is needed) are put into that list by
     ///                             the describable
+    /// @param  bLazy               If 'true', the parsed document is kept by the
+    ///                             describable and the values of its properties are
+    ///                             only converted when needed (@see the lazy version
+    ///                             of fromJSON() above)
     //------------------------------------------------------------------------------------
     ATHENA_CORE_SYMBOL bool fromJSON(const std::string& json_describable,
                                      Utils::Describable* pDescribable,
-                                     Utils::PropertiesList* pDelayedProperties = 0);
+                                     Utils::PropertiesList* pDelayedProperties = 0,
+                                     bool bLazy = false);
 
 
     //------------------------------------------------------------------------------------
@@ -0,0 +1,124 @@
+/** @file   SharedBuffer.h
+    @author Philip Abbet
+
+    Declaration of the class 'Athena::Data::SharedBuffer'
+*/
+
+#ifndef _ATHENA_DATA_SHAREDBUFFER_H_
+#define _ATHENA_DATA_SHAREDBUFFER_H_
+
+#include <Athena-Core/Prerequisites.h>
+
+
+namespace Athena {
+namespace Data {
+
+//----------------------------------------------------------------------------------------
+/// @brief  A reference-counted buffer in memory, shared by several streams
+///
+/// The buffer must not be modified once shared: its content is filled by its creator
+/// (using writableData()), then it is only read (see MemoryDataStream).
+///
+/// Subclasses can share memory they manage themselves, which is then read-only (see
+/// PackFile).
+///
+/// @remark The reference count is thread-safe: the buffer can be shared between threads
+//----------------------------------------------------------------------------------------
+class ATHENA_CORE_SYMBOL SharedBuffer
+{
+    //_____ Construction / Destruction __________
+public:
+    //------------------------------------------------------------------------------------
+    /// @brief  Allocate a buffer
+    ///
+    /// @param  size    Size of the buffer
+    /// @return         The buffer (with a reference count of 1)
+    //------------------------------------------------------------------------------------
+    static SharedBuffer* create(size_t size);
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Create a buffer using a block of memory allocated with new[]
+    ///
+    /// @param  pData   The block of memory (the buffer takes its ownership)
+    /// @param  size    Size of the block of memory
+    /// @return         The buffer (with a reference count of 1)
+    //------------------------------------------------------------------------------------
+    static SharedBuffer* wrap(unsigned char* pData, size_t size);
+
+protected:
+    //------------------------------------------------------------------------------------
+    /// @brief  Constructor of a read-only buffer, whose memory is managed by the subclass
+    //------------------------------------------------------------------------------------
+    SharedBuffer(const unsigned char* pData, size_t size);
+
+    virtual ~SharedBuffer();
+
+private:
+    // Not copiable
+    SharedBuffer(const SharedBuffer&);
+    SharedBuffer& operator=(const SharedBuffer&);
+
+
+    //_____ Methods __________
+public:
+    //------------------------------------------------------------------------------------
+    /// @brief  Increments the reference count of the buffer
+    //------------------------------------------------------------------------------------
+    void addRef();
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Decrements the reference count of the buffer, destroying it when it
+    ///         reaches 0
+    //------------------------------------------------------------------------------------
+    void release();
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Returns the content of the buffer
+    //------------------------------------------------------------------------------------
+    inline const unsigned char* data() const
+    {
+        return m_pData;
+    }
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Returns the content of the buffer, to fill it before sharing it
+    ///
+    /// @return The content of the buffer, 0 if the buffer is read-only
+    //------------------------------------------------------------------------------------
+    inline unsigned char* writableData()
+    {
+        return m_pWritableData;
+    }
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Indicates if the content of the buffer can't be modified
+    //------------------------------------------------------------------------------------
+    inline bool isReadOnly() const
+    {
+        return (m_pWritableData == 0);
+    }
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Returns the size of the buffer
+    //------------------------------------------------------------------------------------
+    inline size_t size() const
+    {
+        return m_size;
+    }
+
+
+    //_____ Attributes __________
+protected:
+    const unsigned char*    m_pData;            ///< The content of the buffer
+    size_t                  m_size;             ///< Size of the buffer
+
+private:
+    unsigned char*          m_pWritableData;    ///< The content of the buffer if owned by
+                                                ///  it (deleted with it), 0 if read-only
+    volatile int            m_nbRefs;           ///< Reference count
+};
+
+}
+}
+
+#endif
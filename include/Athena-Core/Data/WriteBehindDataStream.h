@@ -0,0 +1,180 @@
+/** @file   WriteBehindDataStream.h
+    @author Philip Abbet
+
+    Definition of the class 'Athena::Data::WriteBehindDataStream'
+*/
+
+#ifndef _ATHENA_DATA_WRITEBEHINDDATASTREAM_H_
+#define _ATHENA_DATA_WRITEBEHINDDATASTREAM_H_
+
+#include <Athena-Core/Prerequisites.h>
+#include <Athena-Core/Data/DataStream.h>
+#include <Athena-Core/Utils/Mutex.h>
+#include <Athena-Core/Utils/Condition.h>
+#include <deque>
+
+
+namespace Athena {
+namespace Data {
+
+class WriteBehindThread;
+
+//----------------------------------------------------------------------------------------
+/// @brief  Output stream writing its data to another stream from a background thread
+///
+/// The data written to the stream is copied into a buffer. Once full, the buffer is
+/// handed to a writer thread, which writes it to the destination stream while the next
+/// buffer is filled. So the writes only block when all the buffers are waiting to be
+/// written (i.e. when the data is produced faster than the destination can absorb it).
+///
+/// flush() and sync() are barriers: they return once all the data written so far was
+/// sent to the destination stream (and, for sync(), reached the storage device).
+///
+/// When the destination stream fails to write a buffer, the stream enters an error
+/// state: the data not yet written is discarded, write() returns 0 and flush() and
+/// sync() return 'false'.
+///
+/// @remark The stream must only be used by one thread (the writer thread being
+///         internal). seek() and skip() wait for the pending buffers to be written.
+//----------------------------------------------------------------------------------------
+class ATHENA_CORE_SYMBOL WriteBehindDataStream: public DataStream
+{
+    friend class WriteBehindThread;
+
+
+    //_____ Construction / Destruction __________
+public:
+    //------------------------------------------------------------------------------------
+    /// @brief  Constructor
+    ///
+    /// @param  pStream         The destination stream (the write-behind stream takes
+    ///                         ownership of it)
+    /// @param  bufferSize      Size of each buffer
+    /// @param  nbBuffers       Number of buffers (at least 2: 2 for double buffering, 3
+    ///                         for triple buffering)
+    //------------------------------------------------------------------------------------
+    WriteBehindDataStream(DataStream* pStream, size_t bufferSize = 64 * 1024,
+                          unsigned int nbBuffers = 3);
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Destructor
+    //------------------------------------------------------------------------------------
+    virtual ~WriteBehindDataStream();
+
+private:
+    // Not copiable
+    WriteBehindDataStream(const WriteBehindDataStream&);
+    WriteBehindDataStream& operator=(const WriteBehindDataStream&);
+
+
+    //_____ Methods __________
+public:
+    //------------------------------------------------------------------------------------
+    /// @brief  Indicates if the destination stream failed to write some data
+    //------------------------------------------------------------------------------------
+    bool hasFailed() const;
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Returns the destination stream
+    //------------------------------------------------------------------------------------
+    inline DataStream* stream() const
+    {
+        return m_pStream;
+    }
+
+private:
+    //------------------------------------------------------------------------------------
+    /// @brief  Hand the current buffer to the writer thread
+    //------------------------------------------------------------------------------------
+    void submit();
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Write the submitted buffers to the destination stream, until the stream is
+    ///         closed (called by the writer thread)
+    //------------------------------------------------------------------------------------
+    void process();
+
+
+    //_____ Implementation of DataStream __________
+public:
+    //------------------------------------------------------------------------------------
+    /// @brief  Not supported (write-only stream)
+    //------------------------------------------------------------------------------------
+    virtual size_t read(void* buf, size_t count);
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Write the requisite number of bytes to the stream
+    ///
+    /// @param  buf     Pointer to a buffer containing the bytes to write
+    /// @param  count   Number of bytes to write
+    /// @return         The number of bytes accepted (0 if the stream is in error state)
+    //------------------------------------------------------------------------------------
+    virtual size_t write(const void* buf, size_t count);
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Skip a defined number of bytes in the destination stream. This can also be
+    ///         a negative value, in which case the file pointer rewinds a defined number
+    ///         of bytes.
+    //------------------------------------------------------------------------------------
+    virtual void skip(long count);
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Repositions the write point of the destination stream to a specified byte
+    //------------------------------------------------------------------------------------
+    virtual void seek(size_t pos);
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Returns the current byte offset from beginning (including the bytes not
+    ///         written yet)
+    //------------------------------------------------------------------------------------
+    virtual size_t tell();
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Always 'false' (write-only stream)
+    //------------------------------------------------------------------------------------
+    virtual bool eof() const;
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Flush the stream, stop the writer thread and close the destination stream
+    //------------------------------------------------------------------------------------
+    virtual void close();
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Wait until all the data written so far was sent to the destination stream
+    ///
+    /// @return 'false' if some data couldn't be written
+    //------------------------------------------------------------------------------------
+    virtual bool flush();
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Wait until all the data written so far was sent to the destination stream
+    ///         and reached the storage device
+    ///
+    /// @return 'false' if some data couldn't be written
+    //------------------------------------------------------------------------------------
+    virtual bool sync();
+
+
+    //_____ Attributes __________
+private:
+    DataStream*         m_pStream;      ///< The destination stream
+    WriteBehindThread*  m_pThread;      ///< The writer thread (0 if the data is written synchronously)
+    size_t              m_bufferSize;   ///< Size of each buffer
+    std::vector<char*>  m_buffers;      ///< All the buffers
+    std::deque<char*>   m_free;         ///< The buffers available for writing
+    std::deque<std::pair<char*, size_t> > m_pending; ///< The buffers waiting to be written
+    char*               m_pCurrent;     ///< The buffer being filled (0 if none)
+    size_t              m_used;         ///< Number of bytes in the buffer being filled
+    size_t              m_position;     ///< Current position in the stream
+    bool                m_bWriting;     ///< Indicates if the writer thread is writing a buffer
+    bool                m_bFailed;      ///< Indicates if the destination stream failed
+    bool                m_bStopping;    ///< Indicates if the writer thread must stop
+    mutable Utils::Mutex m_mutex;       ///< Protects the buffer lists and the state
+    Utils::Condition    m_submitted;    ///< Signaled when a buffer is submitted
+    Utils::Condition    m_written;      ///< Signaled when a buffer was written
+};
+
+}
+}
+
+#endif
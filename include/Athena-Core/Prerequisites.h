@@ -28,6 +28,14 @@
 #endif
 
 
+/// Used to declare thread-local variables
+#if (ATHENA_PLATFORM == ATHENA_PLATFORM_WIN32)
+#    define ATHENA_THREAD_LOCAL __declspec(thread)
+#else
+#    define ATHENA_THREAD_LOCAL __thread
+#endif
+
+
 //---------------------------------------------------------------------------------------
 /// @brief  Main namespace. All the components of the Athena engine belongs to this
 ///         namespace
@@ -39,9 +47,20 @@ namespace Athena
     //-----------------------------------------------------------------------------------
     namespace Data
     {
+        class Checksum;
+        class ChecksumDataStream;
+        class CompressedDataStream;
         class DataStream;
         class FileDataStream;
+        class FileRequest;
+        class Hash64;
+        class JSONDocument;
         class LocationManager;
+        class LZCodec;
+        class MemoryDataStream;
+        class PackFile;
+        class SharedBuffer;
+        class WriteBehindDataStream;
     }
 
     //-----------------------------------------------------------------------------------
@@ -71,12 +90,30 @@ namespace Athena
     //-----------------------------------------------------------------------------------
     namespace Utils
     {
+        class Condition;
+        class Counter;
         class Describable;
+        class Gauge;
+        class Histogram;
+        class Metric;
+        class MetricsRegistry;
+        class Mutex;
         class Path;
+        class PerfCounters;
+        class PoolAllocator;
+        class ProfileScope;
+        class Profiler;
         class PropertiesList;
+        class PropertiesSource;
+        class PropertiesTable;
+        class PropertyHandle;
         class StringsMap;
         class StringUtils;
         class StringConverter;
+        class StringReplacer;
+        class StringTokenizer;
+        class StringView;
+        class Thread;
         class Timer;
         class Variant;
 
@@ -0,0 +1,81 @@
+/** @file   Atomic.h
+    @author Philip Abbet
+
+    Declaration of the atomic operations
+*/
+
+#ifndef _ATHENA_UTILS_ATOMIC_H
+#define _ATHENA_UTILS_ATOMIC_H
+
+#include <Athena-Core/Prerequisites.h>
+
+#if ATHENA_PLATFORM == ATHENA_PLATFORM_WIN32
+#   ifndef WIN32_LEAN_AND_MEAN
+#       define WIN32_LEAN_AND_MEAN
+#   endif
+#   if !defined(NOMINMAX) && defined(_MSC_VER)
+#       define NOMINMAX // required to stop windows.h messing up std::min
+#   endif
+#   include <windows.h>
+#endif
+
+
+namespace Athena {
+namespace Utils {
+
+//----------------------------------------------------------------------------------------
+/// @brief  Atomically increments a value
+/// @return The new value
+//----------------------------------------------------------------------------------------
+inline int atomicIncrement(volatile int* pValue)
+{
+#if ATHENA_PLATFORM == ATHENA_PLATFORM_WIN32
+    return (int) InterlockedIncrement((volatile LONG*) pValue);
+#else
+    return __sync_add_and_fetch(pValue, 1);
+#endif
+}
+
+//----------------------------------------------------------------------------------------
+/// @brief  Atomically decrements a value
+/// @return The new value
+//----------------------------------------------------------------------------------------
+inline int atomicDecrement(volatile int* pValue)
+{
+#if ATHENA_PLATFORM == ATHENA_PLATFORM_WIN32
+    return (int) InterlockedDecrement((volatile LONG*) pValue);
+#else
+    return __sync_sub_and_fetch(pValue, 1);
+#endif
+}
+
+//----------------------------------------------------------------------------------------
+/// @brief  Atomically adds a number to a 64-bit value
+/// @return The new value
+//----------------------------------------------------------------------------------------
+inline long long atomicAdd(volatile long long* pValue, long long value)
+{
+#if ATHENA_PLATFORM == ATHENA_PLATFORM_WIN32
+    return (long long) InterlockedExchangeAdd64((volatile LONGLONG*) pValue, value) + value;
+#else
+    return __sync_add_and_fetch(pValue, value);
+#endif
+}
+
+//----------------------------------------------------------------------------------------
+/// @brief  Full memory barrier: the memory accesses before it are completed before the
+///         ones following it
+//----------------------------------------------------------------------------------------
+inline void memoryBarrier()
+{
+#if ATHENA_PLATFORM == ATHENA_PLATFORM_WIN32
+    MemoryBarrier();
+#else
+    __sync_synchronize();
+#endif
+}
+
+}
+}
+
+#endif
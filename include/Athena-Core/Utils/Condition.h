@@ -0,0 +1,70 @@
+/** @file   Condition.h
+    @author Philip Abbet
+
+    Declaration of the class 'Athena::Utils::Condition'
+*/
+
+#ifndef _ATHENA_UTILS_CONDITION_H
+#define _ATHENA_UTILS_CONDITION_H
+
+#include <Athena-Core/Prerequisites.h>
+#include <Athena-Core/Utils/Mutex.h>
+
+
+namespace Athena {
+namespace Utils {
+
+//----------------------------------------------------------------------------------------
+/// @brief  Represents a condition variable, used to wait until another thread signals
+///         that something happened
+//----------------------------------------------------------------------------------------
+class ATHENA_CORE_SYMBOL Condition
+{
+    //_____ Construction / Destruction __________
+public:
+    Condition();
+    ~Condition();
+
+private:
+    // Not copiable
+    Condition(const Condition&);
+    Condition& operator=(const Condition&);
+
+
+    //_____ Methods __________
+public:
+    //------------------------------------------------------------------------------------
+    /// @brief  Wait until the condition is signaled
+    ///
+    /// @param  mutex   The mutex protecting the condition, locked by the caller. It is
+    ///                 unlocked during the wait, and locked again before returning.
+    ///
+    /// @remark Spurious wakeups are possible: the caller must check its condition in a
+    ///         loop
+    //------------------------------------------------------------------------------------
+    void wait(Mutex& mutex);
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Wake up one of the waiting threads
+    //------------------------------------------------------------------------------------
+    void signal();
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Wake up all the waiting threads
+    //------------------------------------------------------------------------------------
+    void broadcast();
+
+
+    //_____ Attributes __________
+private:
+#if ATHENA_PLATFORM == ATHENA_PLATFORM_WIN32
+    CONDITION_VARIABLE  m_condition;
+#else
+    pthread_cond_t      m_condition;
+#endif
+};
+
+}
+}
+
+#endif
@@ -35,6 +35,11 @@ namespace Utils {
 /// that it is assumed that those 'unknown categories' are the first of the list (ie.
 /// if a category is known by one of the class in the inheritance tree of the object,
 /// all the following categories are known by this class or by one of its base ones).
+///
+/// The values of the properties declared in the table of the describable (@see
+/// PropertiesTable) can also be 'pending': they are kept in their original
+/// representation (for instance by Data::fromJSON()) and only converted when first
+/// accessed through the methods of this class, or by materializeAll().
 //---------------------------------------------------------------------------------------
 class ATHENA_CORE_SYMBOL Describable
 {
@@ -61,7 +66,7 @@ public:
     ///         obtained list, containing the properties related to this describable type.
     /// @return The list of properties
     //-----------------------------------------------------------------------------------
-    virtual Utils::PropertiesList* getProperties() const { return new PropertiesList(); }
+    virtual Utils::PropertiesList* getProperties() const;
 
     //-----------------------------------------------------------------------------------
     /// @brief  Returns a list containing the unknown properties of the describable
@@ -79,7 +84,8 @@ public:
     ///                             already created is needed) are put into that list by
     ///                             the describable
     //-----------------------------------------------------------------------------------
-    void setProperties(PropertiesList* pProperties, PropertiesList* pDelayedProperties = 0);
+    void setProperties(const PropertiesList* pProperties,
+                       PropertiesList* pDelayedProperties = 0);
 
     //-----------------------------------------------------------------------------------
     /// @brief  Set the value of a property of the describable
@@ -98,10 +104,212 @@ public:
     virtual bool setProperty(const std::string& strCategory, const std::string& strName,
                              Variant* pValue);
 
+    //-----------------------------------------------------------------------------------
+    /// @brief  Returns the table describing the properties of the last derived class of
+    ///         the describable (0 if it doesn't use one)
+    ///
+    /// @remark Implemented by the ATHENA_DESCRIBABLE() macro, @see PropertiesTable
+    //-----------------------------------------------------------------------------------
+    virtual const PropertiesTable* getPropertiesTable() const { return 0; }
+
+    //-----------------------------------------------------------------------------------
+    /// @brief  Returns the table describing the properties of the class (0 here, as
+    ///         this class doesn't have any property)
+    //-----------------------------------------------------------------------------------
+    static const PropertiesTable* staticPropertiesTable() { return 0; }
+
+    //-----------------------------------------------------------------------------------
+    /// @brief  Returns a handle to a property of the describable (an invalid one if not
+    ///         found, or if the describable doesn't use a table of properties)
+    ///
+    /// @remark The handle can be kept and used with all the describables of the same
+    ///         class, @see PropertyHandle
+    //-----------------------------------------------------------------------------------
+    PropertyHandle resolveProperty(const std::string& strCategory,
+                                   const std::string& strName) const;
+
+    //-----------------------------------------------------------------------------------
+    /// @brief  Retrieve the value of a property, without searching it
+    ///
+    /// @param  handle  The handle of the property
+    /// @retval value   The value of the property
+    /// @return         'false' if the property has no value
+    //-----------------------------------------------------------------------------------
+    bool getPropertyValue(const PropertyHandle& handle, Variant& value) const;
+
+    //-----------------------------------------------------------------------------------
+    /// @brief  Set the value of a property, without searching it
+    ///
+    /// @param  handle  The handle of the property
+    /// @param  value   The value of the property (converted to the type of the property
+    ///                 if necessary)
+    /// @return         'false' if the property must be delayed (@see setProperty())
+    //-----------------------------------------------------------------------------------
+    bool setPropertyValue(const PropertyHandle& handle, const Variant& value);
+
+    //-----------------------------------------------------------------------------------
+    /// @brief  Retrieve the value of a property, without searching it nor using a
+    ///         variant if it has the same type
+    ///
+    /// @remark Defined in PropertiesTable.h
+    //-----------------------------------------------------------------------------------
+    template<typename T>
+    bool getPropertyValue(const PropertyHandle& handle, T& value) const;
+
+    //-----------------------------------------------------------------------------------
+    /// @brief  Set the value of a property, without searching it nor using a variant if
+    ///         it has the same type
+    ///
+    /// @remark Defined in PropertiesTable.h
+    //-----------------------------------------------------------------------------------
+    template<typename T>
+    bool setPropertyValue(const PropertyHandle& handle, const T& value);
+
+
+    //_____ Tracking of the changes __________
+public:
+    //-----------------------------------------------------------------------------------
+    /// @brief  Enable or disable the tracking of the changes of the properties (disabled
+    ///         by default)
+    ///
+    /// When enabled, the describable remembers which ones of the properties declared in
+    /// its table (@see PropertiesTable) were modified since the last call to
+    /// clearChangedProperties(). The properties set with setProperty() (by name) or
+    /// setPropertyValue() (by handle) are marked automatically, the other modifications
+    /// must be reported with markPropertyChanged().
+    ///
+    /// @remark Disabling the tracking forgets the changes
+    //-----------------------------------------------------------------------------------
+    void setChangesTracking(bool bEnabled);
+
+    //-----------------------------------------------------------------------------------
+    /// @brief  Indicates if the changes of the properties are tracked
+    //-----------------------------------------------------------------------------------
+    inline bool isTrackingChanges() const { return (m_pChangedProperties != 0); }
+
+    //-----------------------------------------------------------------------------------
+    /// @brief  Mark a property as modified (ignored if the changes aren't tracked)
+    //-----------------------------------------------------------------------------------
+    void markPropertyChanged(const PropertyHandle& handle);
+
+    //-----------------------------------------------------------------------------------
+    /// @brief  Mark a property as modified (ignored if the changes aren't tracked)
+    ///
+    /// @return 'false' if the property isn't declared in the table of the describable
+    //-----------------------------------------------------------------------------------
+    bool markPropertyChanged(const std::string& strCategory, const std::string& strName);
+
+    //-----------------------------------------------------------------------------------
+    /// @brief  Indicates if a property was modified
+    //-----------------------------------------------------------------------------------
+    bool isPropertyChanged(const PropertyHandle& handle) const;
+
+    //-----------------------------------------------------------------------------------
+    /// @brief  Indicates if at least one property was modified
+    //-----------------------------------------------------------------------------------
+    bool hasChangedProperties() const;
+
+    //-----------------------------------------------------------------------------------
+    /// @brief  Returns the number of modified properties
+    //-----------------------------------------------------------------------------------
+    unsigned int nbChangedProperties() const;
+
+    //-----------------------------------------------------------------------------------
+    /// @brief  Returns a list containing only the modified properties (in the same order
+    ///         than the one returned by getProperties())
+    //-----------------------------------------------------------------------------------
+    Utils::PropertiesList* getChangedProperties() const;
+
+    //-----------------------------------------------------------------------------------
+    /// @brief  Returns the handles of the modified properties
+    ///
+    /// @retval handles The handles, ordered by their global index
+    //-----------------------------------------------------------------------------------
+    void getChangedProperties(std::vector<PropertyHandle>& handles) const;
+
+    //-----------------------------------------------------------------------------------
+    /// @brief  Forget all the changes (for instance once they were saved or sent)
+    //-----------------------------------------------------------------------------------
+    void clearChangedProperties();
+
+
+    //_____ Pending properties __________
+public:
+    //-----------------------------------------------------------------------------------
+    /// @brief  Set the value of a property, to be converted only when needed
+    ///
+    /// The value is converted and assigned to the describable by the first method
+    /// accessing the property (getProperties(), getPropertyValue(), ...), discarded if
+    /// the property is modified before, or converted by materializeAll().
+    ///
+    /// @param  handle  The handle of the property (its type must be known, since the
+    ///                 conversion can't be delayed)
+    /// @param  pSource The source of the value (all the pending values of a describable
+    ///                 must come from the same source, the ones from another source are
+    ///                 materialized first)
+    /// @param  pValue  The value, in the representation of the source
+    ///
+    /// @remark The code of the describable accessing its attributes directly must call
+    ///         materializeAll() first
+    //-----------------------------------------------------------------------------------
+    void addPendingProperty(const PropertyHandle& handle, PropertiesSource* pSource,
+                            const void* pValue);
+
+    //-----------------------------------------------------------------------------------
+    /// @brief  Indicates if some values of properties weren't converted yet
+    //-----------------------------------------------------------------------------------
+    inline bool hasPendingProperties() const { return (m_pPendingProperties != 0); }
+
+    //-----------------------------------------------------------------------------------
+    /// @brief  Returns the number of values of properties that weren't converted yet
+    //-----------------------------------------------------------------------------------
+    unsigned int nbPendingProperties() const;
+
+    //-----------------------------------------------------------------------------------
+    /// @brief  Indicates if the value of a property wasn't converted yet
+    //-----------------------------------------------------------------------------------
+    bool isPropertyPending(const PropertyHandle& handle) const;
+
+    //-----------------------------------------------------------------------------------
+    /// @brief  Convert the value of a property, if it is pending
+    //-----------------------------------------------------------------------------------
+    void materializeProperty(const PropertyHandle& handle);
+
+    //-----------------------------------------------------------------------------------
+    /// @brief  Convert the values of all the pending properties
+    //-----------------------------------------------------------------------------------
+    void materializeAll();
+
+    //-----------------------------------------------------------------------------------
+    /// @brief  Forget the value of a property, if it is pending (called when the
+    ///         property is modified)
+    //-----------------------------------------------------------------------------------
+    void discardPendingProperty(const PropertyHandle& handle);
+
+private:
+    //-----------------------------------------------------------------------------------
+    /// @brief  Release the pending properties
+    //-----------------------------------------------------------------------------------
+    void clearPendingProperties();
+
+
+    //_____ Internal types __________
+private:
+    struct tPendingProperties
+    {
+        PropertiesSource*           pSource;    ///< Source of the values
+        std::vector<const void*>    values;     ///< Values, by global index of the properties (0 if not pending)
+        unsigned int                nbValues;   ///< Number of pending values
+    };
+
 
     //_____ Attributes __________
 protected:
     PropertiesList*  m_pUnknownProperties;    ///< List of the properties that aren't known by the describable object
+    std::vector<unsigned int>* m_pChangedProperties; ///< Bits indicating which properties were modified (0 if not tracked)
+
+private:
+    tPendingProperties* m_pPendingProperties; ///< Values of properties not converted yet (0 if none)
 };
 
 }
@@ -11,6 +11,7 @@
 #define _ATHENA_UTILS_LISTITERATOR_H_
 
 #include <Athena-Core/Prerequisites.h>
+#include <iterator>
 
 
 namespace Athena {
@@ -42,7 +43,7 @@ class ValuesIterator
     //_____ Internal types __________
 public:
     typedef typename T::value_type   ValueType;      /// Type returned by peekNext
-    typedef typename T::value_type*  PointerType;    /// Type returned by peekNextPtr
+    typedef typename std::iterator_traits<IteratorType>::pointer PointerType; /// Type returned by peekNextPtr
 
 
     //_____ Construction / Destruction __________
@@ -184,6 +185,70 @@ public:
 };
 
 
+//---------------------------------------------------------------------------------------
+/// @brief  Iterator over a container of pointers, giving access to the pointed values
+///
+/// @param  V               Type of the pointed values (const or not)
+/// @param  IteratorType    Iterator of the container (vector, list)
+//---------------------------------------------------------------------------------------
+template <typename V, typename IteratorType>
+class PointersIterator
+{
+    //_____ Internal types __________
+public:
+    typedef V   ValueType;      /// Type returned by peekNext
+    typedef V*  PointerType;    /// Type returned by peekNextPtr
+
+
+    //_____ Construction / Destruction __________
+public:
+    //-----------------------------------------------------------------------------------
+    /// @brief  Constructor
+    ///
+    /// @param  start   Where to start the iteration
+    /// @param  end     Where to end the iteration
+    //-----------------------------------------------------------------------------------
+    PointersIterator(IteratorType start, IteratorType end)
+    : mCurrent(start), mEnd(end)
+    {
+    }
+
+
+    //_____ Methods __________
+public:
+    bool hasMoreElements() const
+    {
+        return mCurrent != mEnd;
+    }
+
+    ValueType peekNext() const
+    {
+        return **mCurrent;
+    }
+
+    PointerType peekNextPtr() const
+    {
+        return *mCurrent;
+    }
+
+    ValueType getNext()
+    {
+        return **(mCurrent++);
+    }
+
+    void moveNext()
+    {
+        ++mCurrent;
+    }
+
+
+    //_____ Attributes __________
+protected:
+    IteratorType mCurrent;
+    IteratorType mEnd;
+};
+
+
 
 //---------------------------------------------------------------------------------------
 /// @brief  Base functionality for the iterators over a key-value container
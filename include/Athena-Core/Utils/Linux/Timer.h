@@ -0,0 +1,124 @@
+/** @file   Timer.h
+    @author Philip Abbet
+
+    Declaration of the Linux-specific class 'Athena::Utils::Timer'
+*/
+
+#ifndef _ATHENA_UTILS_LINUX_TIMER_H
+#define _ATHENA_UTILS_LINUX_TIMER_H
+
+#include <Athena-Core/Prerequisites.h>
+
+namespace Athena {
+namespace Utils {
+
+//----------------------------------------------------------------------------------------
+/// @brief  Represents a timer
+///
+/// By default, the elapsed time is measured with the raw monotonic clock of the kernel
+/// (CLOCK_MONOTONIC_RAW, not affected by the adjustments of the system time), and the CPU
+/// time with the CPU-time clock of the calling thread.
+///
+/// On x86 CPUs with an invariant time-stamp counter, the timers can instead read the
+/// counter directly (see enableTSC()), which is cheaper than a call to clock_gettime().
+/// The frequency of the counter is calibrated against the monotonic clock.
+///
+/// @remark The CPU time is the one of the thread that called reset(): a timer must not
+///         be shared between threads to measure it
+//----------------------------------------------------------------------------------------
+class ATHENA_CORE_SYMBOL Timer
+{
+    //_____ Construction / Destruction __________
+public:
+    Timer();
+    ~Timer();
+
+
+    //_____ Management of the timer __________
+public:
+    //------------------------------------------------------------------------------------
+    /// @brief  Resets the timer
+    //------------------------------------------------------------------------------------
+    void reset();
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Returns the number of milliseconds elapsed since the last reset
+    /// @return The number of milliseconds
+    //------------------------------------------------------------------------------------
+    unsigned long getMilliseconds();
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Returns the number of microseconds elapsed since the last reset
+    /// @return The number of microseconds
+    //------------------------------------------------------------------------------------
+    unsigned long getMicroseconds();
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Returns the number of nanoseconds elapsed since the last reset
+    /// @return The number of nanoseconds
+    //------------------------------------------------------------------------------------
+    unsigned long long getNanoseconds();
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Returns the number of milliseconds elapsed since the last reset, only CPU
+    ///         time measured
+    /// @return The number of milliseconds
+    //------------------------------------------------------------------------------------
+    unsigned long getMillisecondsCPU();
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Returns the number of microseconds elapsed since the last reset, only CPU
+    ///         time measured
+    /// @return The number of microseconds
+    //------------------------------------------------------------------------------------
+    unsigned long getMicrosecondsCPU();
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Returns the number of nanoseconds elapsed since the last reset, only CPU
+    ///         time measured
+    /// @return The number of nanoseconds
+    //------------------------------------------------------------------------------------
+    unsigned long long getNanosecondsCPU();
+
+
+    //_____ Static methods __________
+public:
+    //------------------------------------------------------------------------------------
+    /// @brief  Returns the current value of a 64-bit cycle counter
+    ///
+    /// This is the time-stamp counter on x86 CPUs, and the monotonic clock (in
+    /// nanoseconds) on the other ones. Only the differences between two values are
+    /// meaningful, and only on the same CPU if the counter isn't invariant.
+    //------------------------------------------------------------------------------------
+    static unsigned long long getCycles();
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Enable or disable the use of the time-stamp counter to measure the elapsed
+    ///         time (affects all the timers, must be called before resetting them)
+    ///
+    /// The counter is calibrated the first time it is enabled (which takes a few
+    /// milliseconds).
+    ///
+    /// @param  bEnabled    Indicates if the counter must be used
+    /// @return             'true' if the counter is used, 'false' if it isn't (it isn't
+    ///                     invariant, or the CPU isn't a x86 one)
+    //------------------------------------------------------------------------------------
+    static bool enableTSC(bool bEnabled);
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Indicates if the time-stamp counter is used to measure the elapsed time
+    //------------------------------------------------------------------------------------
+    static bool isTSCEnabled();
+
+
+    //_____ Attributes __________
+private:
+    unsigned long long  m_start;        ///< Value of the clock at the last reset
+    unsigned long long  m_startCPU;     ///< Value of the CPU-time clock at the last reset
+    bool                m_bTSC;         ///< Indicates if m_start is a time-stamp counter
+};
+
+}
+}
+
+#endif
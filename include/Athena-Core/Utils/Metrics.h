@@ -0,0 +1,394 @@
+/** @file   Metrics.h
+    @author Philip Abbet
+
+    Declaration of the classes 'Athena::Utils::Metric', 'Athena::Utils::Counter',
+    'Athena::Utils::Gauge', 'Athena::Utils::Histogram' and
+    'Athena::Utils::MetricsRegistry'
+*/
+
+#ifndef _ATHENA_UTILS_METRICS_H
+#define _ATHENA_UTILS_METRICS_H
+
+#include <Athena-Core/Prerequisites.h>
+#include <Athena-Core/Utils/Atomic.h>
+
+
+namespace Athena {
+namespace Utils {
+
+//----------------------------------------------------------------------------------------
+/// @brief  Base class for the metrics
+///
+/// The metrics register themselves in the registry (see MetricsRegistry) at their
+/// construction, and are usually declared as global variables of the modules they
+/// measure:
+/// @code
+///     static Counter g_nbFiredSignals("signals.fired", "Number of signals fired");
+///
+///     void Signal::fire(Variant* pValue)
+///     {
+///         g_nbFiredSignals.increment();
+///         ...
+///     }
+/// @endcode
+///
+/// They can be updated by several threads concurrently: the values are split into shards
+/// (one per thread, modulo NB_SHARDS), each one in its own cache line, and updated with
+/// atomic operations. Their sum is only computed when a snapshot is taken.
+//----------------------------------------------------------------------------------------
+class ATHENA_CORE_SYMBOL Metric
+{
+    //_____ Internal types __________
+public:
+    /// Types of metrics
+    enum tType
+    {
+        COUNTER,        ///< Value that only increases
+        GAUGE,          ///< Value that can increase or decrease
+        HISTOGRAM       ///< Distribution of values
+    };
+
+    enum
+    {
+        NB_SHARDS = 16,         ///< Number of shards of the values
+        NB_BUCKETS = 65         ///< Number of buckets of the histograms
+    };
+
+
+    //_____ Construction / Destruction __________
+public:
+    //------------------------------------------------------------------------------------
+    /// @brief  Constructor (registers the metric)
+    ///
+    /// @param  strName         Name of the metric (must be unique)
+    /// @param  strDescription  Description of the metric
+    /// @param  type            Type of the metric
+    //------------------------------------------------------------------------------------
+    Metric(const std::string& strName, const std::string& strDescription, tType type);
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Destructor (unregisters the metric)
+    //------------------------------------------------------------------------------------
+    virtual ~Metric();
+
+private:
+    // Not copiable
+    Metric(const Metric&);
+    Metric& operator=(const Metric&);
+
+
+    //_____ Methods __________
+public:
+    //------------------------------------------------------------------------------------
+    /// @brief  Returns the name of the metric
+    //------------------------------------------------------------------------------------
+    inline const std::string& name() const
+    {
+        return m_strName;
+    }
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Returns the description of the metric
+    //------------------------------------------------------------------------------------
+    inline const std::string& description() const
+    {
+        return m_strDescription;
+    }
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Returns the type of the metric
+    //------------------------------------------------------------------------------------
+    inline tType type() const
+    {
+        return m_type;
+    }
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Reset the metric
+    //------------------------------------------------------------------------------------
+    virtual void reset() = 0;
+
+protected:
+    //------------------------------------------------------------------------------------
+    /// @brief  Returns the index of the shard used by the current thread
+    //------------------------------------------------------------------------------------
+    static unsigned int shard();
+
+
+    //_____ Attributes __________
+private:
+    std::string m_strName;          ///< Name of the metric
+    std::string m_strDescription;   ///< Description of the metric
+    tType       m_type;             ///< Type of the metric
+};
+
+
+//----------------------------------------------------------------------------------------
+/// @brief  Metric counting events (its value only increases)
+//----------------------------------------------------------------------------------------
+class ATHENA_CORE_SYMBOL Counter: public Metric
+{
+    //_____ Construction / Destruction __________
+public:
+    Counter(const std::string& strName, const std::string& strDescription = "");
+
+
+    //_____ Methods __________
+public:
+    //------------------------------------------------------------------------------------
+    /// @brief  Increment the counter
+    //------------------------------------------------------------------------------------
+    inline void increment()
+    {
+        atomicAdd(&m_shards[shard()].value, 1);
+    }
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Add a number to the counter
+    //------------------------------------------------------------------------------------
+    inline void add(unsigned long long value)
+    {
+        atomicAdd(&m_shards[shard()].value, (long long) value);
+    }
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Returns the value of the counter
+    //------------------------------------------------------------------------------------
+    unsigned long long value() const;
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Reset the counter
+    //------------------------------------------------------------------------------------
+    virtual void reset();
+
+
+    //_____ Internal types __________
+private:
+    struct tShard
+    {
+        volatile long long  value;
+        char                padding[64 - sizeof(long long)];
+    };
+
+
+    //_____ Attributes __________
+private:
+    tShard m_shards[NB_SHARDS];
+};
+
+
+//----------------------------------------------------------------------------------------
+/// @brief  Metric representing a value that can increase or decrease (for instance, a
+///         number of objects alive)
+//----------------------------------------------------------------------------------------
+class ATHENA_CORE_SYMBOL Gauge: public Metric
+{
+    //_____ Construction / Destruction __________
+public:
+    Gauge(const std::string& strName, const std::string& strDescription = "");
+
+
+    //_____ Methods __________
+public:
+    //------------------------------------------------------------------------------------
+    /// @brief  Increment the gauge
+    //------------------------------------------------------------------------------------
+    inline void increment()
+    {
+        atomicAdd(&m_shards[shard()].value, 1);
+    }
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Decrement the gauge
+    //------------------------------------------------------------------------------------
+    inline void decrement()
+    {
+        atomicAdd(&m_shards[shard()].value, -1);
+    }
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Add a (possibly negative) number to the gauge
+    //------------------------------------------------------------------------------------
+    inline void add(long long value)
+    {
+        atomicAdd(&m_shards[shard()].value, value);
+    }
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Set the value of the gauge
+    ///
+    /// @remark Must not be used while other threads modify the gauge
+    //------------------------------------------------------------------------------------
+    void set(long long value);
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Returns the value of the gauge
+    //------------------------------------------------------------------------------------
+    long long value() const;
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Reset the gauge
+    //------------------------------------------------------------------------------------
+    virtual void reset();
+
+
+    //_____ Internal types __________
+private:
+    struct tShard
+    {
+        volatile long long  value;
+        char                padding[64 - sizeof(long long)];
+    };
+
+
+    //_____ Attributes __________
+private:
+    tShard m_shards[NB_SHARDS];
+};
+
+
+//----------------------------------------------------------------------------------------
+/// @brief  Metric recording the distribution of some values (for instance, durations)
+///
+/// The values are counted in buckets of exponential sizes: the bucket 0 contains the
+/// value 0, and the bucket i (i > 0) the values in [2^(i-1), 2^i - 1].
+//----------------------------------------------------------------------------------------
+class ATHENA_CORE_SYMBOL Histogram: public Metric
+{
+    //_____ Construction / Destruction __________
+public:
+    Histogram(const std::string& strName, const std::string& strDescription = "");
+
+
+    //_____ Methods __________
+public:
+    //------------------------------------------------------------------------------------
+    /// @brief  Record a value
+    //------------------------------------------------------------------------------------
+    void record(unsigned long long value);
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Returns the number of values recorded
+    //------------------------------------------------------------------------------------
+    unsigned long long count() const;
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Returns the sum of the values recorded
+    //------------------------------------------------------------------------------------
+    unsigned long long sum() const;
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Returns the number of values recorded in each bucket
+    //------------------------------------------------------------------------------------
+    std::vector<unsigned long long> buckets() const;
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Reset the histogram
+    //------------------------------------------------------------------------------------
+    virtual void reset();
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Returns the index of the bucket of a value
+    //------------------------------------------------------------------------------------
+    static unsigned int bucket(unsigned long long value);
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Returns the greatest value of a bucket
+    //------------------------------------------------------------------------------------
+    static unsigned long long bucketUpperBound(unsigned int bucket);
+
+
+    //_____ Internal types __________
+private:
+    struct tShard
+    {
+        volatile long long  sum;
+        volatile long long  buckets[NB_BUCKETS];
+        char                padding[64 - (NB_BUCKETS + 1) * sizeof(long long) % 64];
+    };
+
+
+    //_____ Attributes __________
+private:
+    tShard m_shards[NB_SHARDS];
+};
+
+
+//----------------------------------------------------------------------------------------
+/// @brief  Registry of all the metrics
+///
+/// Gives access to the current values of all the metrics, for instance to display them
+/// on a dashboard:
+/// @code
+///     MetricsRegistry::tSnapshot snapshot = MetricsRegistry::snapshot();
+///
+///     for (unsigned int i = 0; i < snapshot.size(); ++i)
+///         printf("%s: %lld\n", snapshot[i].strName.c_str(), snapshot[i].value);
+/// @endcode
+///
+/// Taking a snapshot doesn't block the threads updating the metrics (but the values of
+/// different metrics aren't guaranteed to be consistent between themselves).
+//----------------------------------------------------------------------------------------
+class ATHENA_CORE_SYMBOL MetricsRegistry
+{
+    friend class Metric;
+
+    //_____ Internal types __________
+public:
+    /// Value of a metric
+    struct tMetricValue
+    {
+        std::string                     strName;        ///< Name of the metric
+        std::string                     strDescription; ///< Description of the metric
+        Metric::tType                   type;           ///< Type of the metric
+        long long                       value;          ///< Value (count for histograms)
+        unsigned long long              sum;            ///< Sum of the values (histograms)
+        std::vector<unsigned long long> buckets;        ///< Buckets (histograms)
+    };
+
+    typedef std::vector<tMetricValue> tSnapshot;
+
+
+    //_____ Static methods __________
+public:
+    //------------------------------------------------------------------------------------
+    /// @brief  Returns the current values of all the metrics (sorted by name)
+    //------------------------------------------------------------------------------------
+    static tSnapshot snapshot();
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Returns the current values of all the metrics, as a JSON string
+    ///
+    /// The counters and gauges are represented by their value, the histograms by an
+    /// object containing their count, sum and non-empty buckets.
+    //------------------------------------------------------------------------------------
+    static std::string toJSON();
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Returns the metric with the given name (0 if not found)
+    //------------------------------------------------------------------------------------
+    static Metric* find(const std::string& strName);
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Reset all the metrics
+    //------------------------------------------------------------------------------------
+    static void reset();
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Returns an estimation of a percentile of a histogram (the upper bound of
+    ///         the bucket containing it)
+    ///
+    /// @param  value       The value of the histogram
+    /// @param  percentile  The percentile (between 0 and 100)
+    //------------------------------------------------------------------------------------
+    static unsigned long long percentile(const tMetricValue& value, double percentile);
+
+private:
+    static void add(Metric* pMetric);
+    static void remove(Metric* pMetric);
+};
+
+}
+}
+
+#endif
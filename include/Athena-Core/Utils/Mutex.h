@@ -0,0 +1,107 @@
+/** @file   Mutex.h
+    @author Philip Abbet
+
+    Declaration of the classes 'Athena::Utils::Mutex' and 'Athena::Utils::ScopedLock'
+*/
+
+#ifndef _ATHENA_UTILS_MUTEX_H
+#define _ATHENA_UTILS_MUTEX_H
+
+#include <Athena-Core/Prerequisites.h>
+
+#if ATHENA_PLATFORM == ATHENA_PLATFORM_WIN32
+#   ifndef WIN32_LEAN_AND_MEAN
+#       define WIN32_LEAN_AND_MEAN
+#   endif
+#   if !defined(NOMINMAX) && defined(_MSC_VER)
+#       define NOMINMAX // required to stop windows.h messing up std::min
+#   endif
+#   include <windows.h>
+#else
+#   include <pthread.h>
+#endif
+
+
+namespace Athena {
+namespace Utils {
+
+//----------------------------------------------------------------------------------------
+/// @brief  Represents a (non-recursive) mutex
+//----------------------------------------------------------------------------------------
+class ATHENA_CORE_SYMBOL Mutex
+{
+    friend class Condition;
+
+    //_____ Construction / Destruction __________
+public:
+    Mutex();
+    ~Mutex();
+
+private:
+    // Not copiable
+    Mutex(const Mutex&);
+    Mutex& operator=(const Mutex&);
+
+
+    //_____ Methods __________
+public:
+    //------------------------------------------------------------------------------------
+    /// @brief  Lock the mutex, waiting until it is available
+    //------------------------------------------------------------------------------------
+    void lock();
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Try to lock the mutex, without waiting
+    /// @return 'true' if the mutex was locked
+    //------------------------------------------------------------------------------------
+    bool tryLock();
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Unlock the mutex
+    //------------------------------------------------------------------------------------
+    void unlock();
+
+
+    //_____ Attributes __________
+private:
+#if ATHENA_PLATFORM == ATHENA_PLATFORM_WIN32
+    CRITICAL_SECTION    m_mutex;
+#else
+    pthread_mutex_t     m_mutex;
+#endif
+};
+
+
+//----------------------------------------------------------------------------------------
+/// @brief  Locks a mutex during its lifetime
+//----------------------------------------------------------------------------------------
+class ScopedLock
+{
+    //_____ Construction / Destruction __________
+public:
+    ScopedLock(Mutex& mutex)
+    : m_mutex(mutex)
+    {
+        m_mutex.lock();
+    }
+
+    ~ScopedLock()
+    {
+        m_mutex.unlock();
+    }
+
+private:
+    // Not copiable
+    ScopedLock(const ScopedLock&);
+    ScopedLock& operator=(const ScopedLock&);
+
+
+    //_____ Attributes __________
+private:
+    Mutex& m_mutex;
+};
+
+}
+}
+
+#endif
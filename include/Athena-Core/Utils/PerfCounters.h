@@ -0,0 +1,159 @@
+/** @file   PerfCounters.h
+    @author Philip Abbet
+
+    Declaration of the class 'Athena::Utils::PerfCounters'
+*/
+
+#ifndef _ATHENA_UTILS_PERFCOUNTERS_H
+#define _ATHENA_UTILS_PERFCOUNTERS_H
+
+#include <Athena-Core/Prerequisites.h>
+
+
+namespace Athena {
+namespace Utils {
+
+//----------------------------------------------------------------------------------------
+/// @brief  Reads the hardware performance counters of the CPU around some code
+///
+/// Companion of the Timer class, for when the elapsed time isn't enough to understand
+/// the performances of some code:
+/// @code
+///     PerfCounters counters(PerfCounters::INSTRUCTIONS | PerfCounters::CYCLES);
+///
+///     counters.start();
+///     ...
+///     counters.stop();
+///
+///     printf("IPC: %.2f\n", counters.ipc());
+/// @endcode
+///
+/// On Linux, the counters are read with perf_event_open(), as a group (so their values
+/// are consistent between themselves). If the kernel doesn't allow it (for instance,
+/// because of the value of /proc/sys/kernel/perf_event_paranoid, or in a virtual
+/// machine), or on the other platforms, the counters aren't available: all their values
+/// are 0, and isAvailable() returns 'false'.
+///
+/// @remark Only the events of the thread that created the object are counted (and only
+///         the ones in user mode)
+//----------------------------------------------------------------------------------------
+class ATHENA_CORE_SYMBOL PerfCounters
+{
+    //_____ Internal types __________
+public:
+    /// The counters
+    enum tCounter
+    {
+        INSTRUCTIONS        = 0x01,     ///< Instructions retired
+        CYCLES              = 0x02,     ///< CPU cycles
+        CACHE_REFERENCES    = 0x04,     ///< Accesses to the last level cache
+        CACHE_MISSES        = 0x08,     ///< Misses of the last level cache
+        BRANCHES            = 0x10,     ///< Branch instructions retired
+        BRANCH_MISSES       = 0x20,     ///< Mispredicted branches
+
+        ALL_COUNTERS        = 0x3F
+    };
+
+    enum
+    {
+        NB_COUNTERS = 6
+    };
+
+
+    //_____ Construction / Destruction __________
+public:
+    //------------------------------------------------------------------------------------
+    /// @brief  Constructor
+    ///
+    /// @param  counters    The counters to read (combination of tCounter values)
+    //------------------------------------------------------------------------------------
+    PerfCounters(unsigned int counters = ALL_COUNTERS);
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Destructor
+    //------------------------------------------------------------------------------------
+    ~PerfCounters();
+
+private:
+    // Not copiable
+    PerfCounters(const PerfCounters&);
+    PerfCounters& operator=(const PerfCounters&);
+
+
+    //_____ Methods __________
+public:
+    //------------------------------------------------------------------------------------
+    /// @brief  Indicates if at least one of the counters can be read
+    //------------------------------------------------------------------------------------
+    inline bool isAvailable() const
+    {
+        return (m_available != 0);
+    }
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Indicates if a counter can be read
+    //------------------------------------------------------------------------------------
+    inline bool isAvailable(tCounter counter) const
+    {
+        return ((m_available & counter) != 0);
+    }
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Reset the counters to 0 and start counting
+    //------------------------------------------------------------------------------------
+    void start();
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Stop counting, and retrieve the values of the counters
+    //------------------------------------------------------------------------------------
+    void stop();
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Returns the value of a counter between the last calls to start() and
+    ///         stop() (0 if the counter isn't available)
+    ///
+    /// If the kernel had to share the hardware counters with other users, the value is
+    /// extrapolated from the time the counters were really running.
+    //------------------------------------------------------------------------------------
+    unsigned long long value(tCounter counter) const;
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Returns the number of instructions per cycle (0 if unknown)
+    //------------------------------------------------------------------------------------
+    double ipc() const;
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Returns the ratio of the accesses to the last level cache that were
+    ///         misses (0 if unknown)
+    //------------------------------------------------------------------------------------
+    double cacheMissRate() const;
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Returns the ratio of the branches that were mispredicted (0 if unknown)
+    //------------------------------------------------------------------------------------
+    double branchMissRate() const;
+
+
+    //_____ Static methods __________
+public:
+    //------------------------------------------------------------------------------------
+    /// @brief  Returns the name of a counter (for instance, "cache-misses")
+    //------------------------------------------------------------------------------------
+    static const char* name(tCounter counter);
+
+private:
+    static unsigned int index(tCounter counter);
+
+
+    //_____ Attributes __________
+private:
+    int                 m_descriptors[NB_COUNTERS]; ///< File descriptors of the counters
+    unsigned long long  m_values[NB_COUNTERS];      ///< Values of the counters
+    unsigned int        m_available;                ///< The counters that can be read
+    int                 m_leader;                   ///< Descriptor of the group leader
+};
+
+}
+}
+
+#endif
@@ -0,0 +1,84 @@
+/** @file   PoolAllocator.h
+    @author Philip Abbet
+
+    Declaration of the class 'Athena::Utils::PoolAllocator'
+*/
+
+#ifndef _ATHENA_UTILS_POOLALLOCATOR_H
+#define _ATHENA_UTILS_POOLALLOCATOR_H
+
+#include <Athena-Core/Prerequisites.h>
+
+namespace Athena {
+namespace Utils {
+
+//----------------------------------------------------------------------------------------
+/// @brief  Allocator of small objects, backed by free lists
+///
+/// The sizes are rounded up to a multiple of GRANULARITY, each of them having its own
+/// free lists (the bigger objects are allocated by the global operator new). Each
+/// thread allocates from and releases to its own free lists, without locking: the
+/// blocks are exchanged with a global reserve, protected by a mutex, by batches of
+/// BATCH_SIZE blocks (when a list of the thread is empty, or contains too many blocks).
+///
+/// A block can be released by another thread than the one which allocated it.
+///
+/// The memory is never returned to the system, but the blocks of the threads are put
+/// back into the global reserve by releaseThreadCache() (called automatically at the
+/// end of the threads created with Athena::Utils::Thread).
+///
+/// Usually used by the classes that are allocated a lot, through their operator new
+/// and delete:
+/// @code
+///     static void* operator new(size_t size) { return PoolAllocator::allocate(size); }
+///     static void operator delete(void* p, size_t size) { PoolAllocator::deallocate(p, size); }
+/// @endcode
+//----------------------------------------------------------------------------------------
+class ATHENA_CORE_SYMBOL PoolAllocator
+{
+    //_____ Constants __________
+public:
+    static const size_t         GRANULARITY     = 16;   ///< Size of the blocks are multiple of this one
+    static const size_t         MAX_SIZE        = 256;  ///< Maximum size handled by the pool
+    static const unsigned int   NB_SIZE_CLASSES = MAX_SIZE / GRANULARITY;
+    static const unsigned int   BATCH_SIZE      = 64;   ///< Number of blocks exchanged with the reserve
+
+
+    //_____ Methods __________
+public:
+    //------------------------------------------------------------------------------------
+    /// @brief  Allocate a block of memory
+    //------------------------------------------------------------------------------------
+    static void* allocate(size_t size);
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Release a block of memory
+    ///
+    /// @param  p       The block (can be 0)
+    /// @param  size    The size given to allocate()
+    //------------------------------------------------------------------------------------
+    static void deallocate(void* p, size_t size);
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Put the free blocks of the current thread back into the global reserve
+    ///
+    /// @remark Must be called by the threads not created with Athena::Utils::Thread
+    ///         before they end, otherwise their free blocks are lost
+    //------------------------------------------------------------------------------------
+    static void releaseThreadCache();
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Returns the number of bytes obtained from the system by the pool
+    //------------------------------------------------------------------------------------
+    static size_t nbReservedBytes();
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Returns the number of free blocks in the global reserve
+    //------------------------------------------------------------------------------------
+    static size_t nbReserveBlocks();
+};
+
+}
+}
+
+#endif
@@ -0,0 +1,180 @@
+/** @file   Profiler.h
+    @author Philip Abbet
+
+    Declaration of the classes 'Athena::Utils::Profiler' and 'Athena::Utils::ProfileScope'
+*/
+
+#ifndef _ATHENA_UTILS_PROFILER_H
+#define _ATHENA_UTILS_PROFILER_H
+
+#include <Athena-Core/Prerequisites.h>
+
+
+namespace Athena {
+namespace Utils {
+
+//----------------------------------------------------------------------------------------
+/// @brief  Hierarchical profiler measuring the time spent in some scopes of the code
+///
+/// The scopes are declared with the ATHENA_PROFILE_SCOPE macro:
+/// @code
+///     void Scene::update()
+///     {
+///         ATHENA_PROFILE_SCOPE("Scene::update");
+///         ...
+///     }
+/// @endcode
+///
+/// When the profiler is enabled, each scope writes a 'begin' and an 'end' event in a
+/// ring buffer owned by the current thread (no lock is taken). When it is disabled (the
+/// default), a scope only costs the test of a flag.
+///
+/// The events are processed by collect(), which must be called regularly (for instance
+/// once per frame) so the buffers don't overflow (the events that don't fit are lost).
+/// They are aggregated per scope (number of calls, total/min/max duration), the scopes
+/// being identified by their path in the hierarchy (for instance "Frame/Update/Physics"),
+/// and kept to be exported in the trace event format of Chrome (chrome://tracing).
+///
+/// @remark The names of the scopes must be strings that remain valid until the events
+///         are exported (in practice: string literals)
+//----------------------------------------------------------------------------------------
+class ATHENA_CORE_SYMBOL Profiler
+{
+    //_____ Internal types __________
+public:
+    /// Statistics of a scope
+    struct tScopeStatistics
+    {
+        std::string         strName;    ///< Name of the scope
+        std::string         strPath;    ///< Path of the scope ("parent/child")
+        unsigned int        depth;      ///< Depth of the scope in the hierarchy
+        unsigned long long  count;      ///< Number of executions of the scope
+        unsigned long long  total;      ///< Total duration (in nanoseconds)
+        unsigned long long  min;        ///< Minimum duration (in nanoseconds)
+        unsigned long long  max;        ///< Maximum duration (in nanoseconds)
+    };
+
+    typedef std::vector<tScopeStatistics> tStatisticsList;
+
+
+    //_____ Static methods __________
+public:
+    //------------------------------------------------------------------------------------
+    /// @brief  Enable or disable the profiler
+    //------------------------------------------------------------------------------------
+    static void enable(bool bEnabled);
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Indicates if the profiler is enabled
+    //------------------------------------------------------------------------------------
+    static inline bool isEnabled()
+    {
+        return s_bEnabled;
+    }
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Record the beginning of a scope (in the current thread)
+    //------------------------------------------------------------------------------------
+    static void begin(const char* strName);
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Record the end of the last scope begun in the current thread
+    //------------------------------------------------------------------------------------
+    static void end();
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Process the events recorded by all the threads since the last call
+    //------------------------------------------------------------------------------------
+    static void collect();
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Returns the statistics of the scopes (sorted by path)
+    ///
+    /// The events not processed yet are collected first.
+    //------------------------------------------------------------------------------------
+    static tStatisticsList getStatistics();
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Returns the events collected so far in the trace event format of Chrome
+    ///
+    /// The events not processed yet are collected first.
+    //------------------------------------------------------------------------------------
+    static std::string toChromeTrace();
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Write the events collected so far in a file, in the trace event format of
+    ///         Chrome
+    ///
+    /// @param  strFileName     Path to the file
+    /// @return                 'true' if successful
+    //------------------------------------------------------------------------------------
+    static bool exportChromeTrace(const std::string& strFileName);
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Discard the statistics and the events collected so far (and the ones not
+    ///         processed yet)
+    //------------------------------------------------------------------------------------
+    static void reset();
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Returns the number of events lost since the last reset (because a buffer
+    ///         was full)
+    //------------------------------------------------------------------------------------
+    static unsigned long long nbDroppedEvents();
+
+
+    //_____ Attributes __________
+private:
+    static volatile bool s_bEnabled;    ///< Indicates if the profiler is enabled
+};
+
+
+//----------------------------------------------------------------------------------------
+/// @brief  Records a scope in the profiler (from its construction to its destruction)
+///
+/// @see ATHENA_PROFILE_SCOPE
+//----------------------------------------------------------------------------------------
+class ProfileScope
+{
+    //_____ Construction / Destruction __________
+public:
+    inline ProfileScope(const char* strName)
+    : m_bActive(Profiler::isEnabled())
+    {
+        if (m_bActive)
+            Profiler::begin(strName);
+    }
+
+    inline ~ProfileScope()
+    {
+        if (m_bActive)
+            Profiler::end();
+    }
+
+private:
+    // Not copiable
+    ProfileScope(const ProfileScope&);
+    ProfileScope& operator=(const ProfileScope&);
+
+
+    //_____ Attributes __________
+private:
+    bool m_bActive;     ///< Indicates if the beginning of the scope was recorded
+};
+
+}
+}
+
+
+#if ATHENA_CORE_PROFILING
+    #define ATHENA_PROFILE_CONCAT2(a, b)    a##b
+    #define ATHENA_PROFILE_CONCAT(a, b)     ATHENA_PROFILE_CONCAT2(a, b)
+
+    /// Profile the current scope (see Athena::Utils::Profiler)
+    #define ATHENA_PROFILE_SCOPE(name)      Athena::Utils::ProfileScope ATHENA_PROFILE_CONCAT(__profileScope, __LINE__)(name)
+#else
+    /// Profile the current scope (see Athena::Utils::Profiler)
+    #define ATHENA_PROFILE_SCOPE(name)
+#endif
+
+#endif
@@ -20,6 +20,16 @@ namespace Utils {
 ///
 /// @remark    The categories and properties aren't sorted by name, so the user can rely
 ///            on their order if needed
+///
+/// The categories are shared between the copies of a list (and with the lists to which
+/// they are appended), until one of the copies modifies them: this allows to create
+/// many objects from one template without duplicating all its values. A category is
+/// copied (only for the list modifying it) by all the methods giving a non-const access
+/// to it, so the read-only code should use the const methods.
+///
+/// A value or an iterator returned by a non-const method can be used to modify the
+/// category later, so that category is never shared again: the copies of the list (and
+/// the lists to which it is appended) receive their own copy of it.
 //-----------------------------------------------------------------------------------
 class ATHENA_CORE_SYMBOL PropertiesList
 {
@@ -31,8 +41,9 @@ public:
         Variant*    pValue;
     };
 
-    typedef std::vector<tProperty>          tPropertiesList;
-    typedef VectorIterator<tPropertiesList> tPropertiesIterator;
+    typedef std::vector<tProperty>                  tPropertiesList;
+    typedef VectorIterator<tPropertiesList>         tPropertiesIterator;
+    typedef ConstVectorIterator<tPropertiesList>    tConstPropertiesIterator;
 
     // We don't use a map here because the order of the categories matters
     struct tCategory
@@ -41,8 +52,19 @@ public:
         tPropertiesList values;
     };
 
-    typedef std::vector<tCategory>          tCategoriesList;
-    typedef VectorIterator<tCategoriesList> tCategoriesIterator;
+private:
+    // Category shared between several lists
+    struct tSharedCategory: public tCategory
+    {
+        volatile int nbReferences;
+        bool         bSharable;     ///< 'false' once a non-const access was given to it
+    };
+
+    typedef std::vector<tSharedCategory*>           tCategoriesList;
+
+public:
+    typedef PointersIterator<tCategory, tCategoriesList::iterator>               tCategoriesIterator;
+    typedef PointersIterator<const tCategory, tCategoriesList::const_iterator>   tConstCategoriesIterator;
 
 
     //_____ Construction / Destruction __________
@@ -52,11 +74,21 @@ public:
     //-----------------------------------------------------------------------------------
     PropertiesList();
 
+    //-----------------------------------------------------------------------------------
+    /// @brief  Copy constructor (the categories are shared until modified)
+    //-----------------------------------------------------------------------------------
+    PropertiesList(const PropertiesList& list);
+
     //-----------------------------------------------------------------------------------
     /// @brief  Destructor
     //-----------------------------------------------------------------------------------
     ~PropertiesList();
 
+    //-----------------------------------------------------------------------------------
+    /// @brief  Assignment operator (the categories are shared until modified)
+    //-----------------------------------------------------------------------------------
+    PropertiesList& operator=(const PropertiesList& list);
+
 
     //_____ Management of the list __________
 public:
@@ -102,6 +134,15 @@ public:
     //-----------------------------------------------------------------------------------
     Variant* get(const std::string& strCategory, const std::string& strName);
 
+    //-----------------------------------------------------------------------------------
+    /// @brief  Get a value from the list, without modifying it
+    ///
+    /// @param  strCategory    Name of the category
+    /// @param  strName        Name of the value
+    /// @return                The value, 0 if not found
+    //-----------------------------------------------------------------------------------
+    const Variant* get(const std::string& strCategory, const std::string& strName) const;
+
     //-----------------------------------------------------------------------------------
     /// @brief  Get a value from the list, in the selected category
     ///
@@ -135,11 +176,22 @@ public:
     //-----------------------------------------------------------------------------------
     tCategoriesIterator getCategoriesIterator();
 
+    //-----------------------------------------------------------------------------------
+    /// @brief  Returns an iterator over the categories, without modifying them
+    //-----------------------------------------------------------------------------------
+    tConstCategoriesIterator getCategoriesIterator() const;
+
     //-----------------------------------------------------------------------------------
     /// @brief  Returns an iterator over the properties of a category
     //-----------------------------------------------------------------------------------
     tPropertiesIterator getPropertiesIterator(const std::string& strCategory);
 
+    //-----------------------------------------------------------------------------------
+    /// @brief  Returns an iterator over the properties of a category, without modifying
+    ///         them
+    //-----------------------------------------------------------------------------------
+    tConstPropertiesIterator getPropertiesIterator(const std::string& strCategory) const;
+
     //-----------------------------------------------------------------------------------
     /// @brief  Returns an iterator over the properties of the selected category
     //-----------------------------------------------------------------------------------
@@ -150,8 +202,11 @@ public:
     ///
     /// @param  pList   The list to append
     /// @param  bAtEnd  'true' to append at the end, 'false' for the beginning
+    ///
+    /// @remark The categories that don't exist in this list are shared with the other
+    ///         one (until modified), the others are merged
     //-----------------------------------------------------------------------------------
-    void append(PropertiesList* pList, bool bAtEnd = true);
+    void append(const PropertiesList* pList, bool bAtEnd = true);
 
     //-----------------------------------------------------------------------------------
     /// @brief  Returns the number of categories
@@ -164,16 +219,59 @@ public:
     //-----------------------------------------------------------------------------------
     /// @brief  Returns the number of properties in the specified category
     //-----------------------------------------------------------------------------------
-    unsigned int nbProperties(const std::string& strCategory);
+    unsigned int nbProperties(const std::string& strCategory) const;
 
     //-----------------------------------------------------------------------------------
     /// @brief  Returns the total number of properties in the list
     //-----------------------------------------------------------------------------------
-    unsigned int nbTotalProperties();
+    unsigned int nbTotalProperties() const;
+
+    //-----------------------------------------------------------------------------------
+    /// @brief  Indicates if a category is shared with another list
+    //-----------------------------------------------------------------------------------
+    bool isShared(const std::string& strCategory) const;
 
 private:
     void selectCategory(const std::string& strCategory, tCategoriesList::iterator position);
 
+    //-----------------------------------------------------------------------------------
+    /// @brief  Returns the category with the specified name (end() if not found)
+    //-----------------------------------------------------------------------------------
+    tCategoriesList::const_iterator findCategory(const std::string& strCategory) const;
+
+    //-----------------------------------------------------------------------------------
+    /// @brief  Make a copy of a category if it is shared with another list, before
+    ///         modifying it
+    //-----------------------------------------------------------------------------------
+    void detach(tCategoriesList::iterator category);
+
+    //-----------------------------------------------------------------------------------
+    /// @brief  Make a copy of a category if it is shared with another list, and prevent
+    ///         it to be shared again (before giving a non-const access to it)
+    //-----------------------------------------------------------------------------------
+    void unshare(tCategoriesList::iterator category);
+
+    //-----------------------------------------------------------------------------------
+    /// @brief  Release the categories (deleted if not shared anymore)
+    //-----------------------------------------------------------------------------------
+    void clear();
+
+    //-----------------------------------------------------------------------------------
+    /// @brief  Release a category (deleted if not shared anymore)
+    //-----------------------------------------------------------------------------------
+    static void release(tSharedCategory* pCategory);
+
+    //-----------------------------------------------------------------------------------
+    /// @brief  Returns a category to use in another list: either the same one (shared),
+    ///         or a copy if it can't be shared anymore
+    //-----------------------------------------------------------------------------------
+    static tSharedCategory* share(tSharedCategory* pCategory);
+
+    //-----------------------------------------------------------------------------------
+    /// @brief  Returns a copy of a category (not shared)
+    //-----------------------------------------------------------------------------------
+    static tSharedCategory* copy(const tSharedCategory* pCategory);
+
 
     //_____ Attributes __________
 private:
@@ -0,0 +1,77 @@
+/** @file   PropertiesSource.h
+    @author Philip Abbet
+
+    Declaration of the class 'Athena::Utils::PropertiesSource'
+*/
+
+#ifndef _ATHENA_UTILS_PROPERTIESSOURCE_H_
+#define _ATHENA_UTILS_PROPERTIESSOURCE_H_
+
+#include <Athena-Core/Prerequisites.h>
+
+
+namespace Athena {
+namespace Utils {
+
+//----------------------------------------------------------------------------------------
+/// @brief  Base class for the sources of values of properties that are only converted
+///         when needed (@see Describable::addPendingProperty())
+///
+/// A source holds the values in their original representation (for instance a parsed
+/// JSON document), and is usually shared by several describables (for instance all the
+/// objects loaded from the same file): it is destroyed once all the values it contains
+/// were converted (or discarded) by all of them.
+///
+/// @remark The reference count is thread-safe: the source can be shared between threads
+//----------------------------------------------------------------------------------------
+class ATHENA_CORE_SYMBOL PropertiesSource
+{
+    //_____ Construction / Destruction __________
+protected:
+    //------------------------------------------------------------------------------------
+    /// @brief  Constructor (the reference count of the source is 1)
+    //------------------------------------------------------------------------------------
+    PropertiesSource();
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Destructor
+    //------------------------------------------------------------------------------------
+    virtual ~PropertiesSource();
+
+private:
+    // Not copiable
+    PropertiesSource(const PropertiesSource&);
+    PropertiesSource& operator=(const PropertiesSource&);
+
+
+    //_____ Methods __________
+public:
+    //------------------------------------------------------------------------------------
+    /// @brief  Increments the reference count of the source
+    //------------------------------------------------------------------------------------
+    void addRef();
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Decrements the reference count of the source, destroying it when it
+    ///         reaches 0
+    //------------------------------------------------------------------------------------
+    void release();
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Converts a value of the source
+    ///
+    /// @param  pValue  The value, in the representation of the source
+    /// @retval value   The converted value
+    //------------------------------------------------------------------------------------
+    virtual void convert(const void* pValue, Variant& value) const = 0;
+
+
+    //_____ Attributes __________
+private:
+    volatile int m_nbRefs;  ///< Reference count
+};
+
+}
+}
+
+#endif
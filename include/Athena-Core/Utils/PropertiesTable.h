@@ -0,0 +1,633 @@
+/** @file   PropertiesTable.h
+    @author Philip Abbet
+
+    Declaration of the class 'Athena::Utils::PropertiesTable'
+*/
+
+#ifndef _ATHENA_UTILS_PROPERTIESTABLE_H
+#define _ATHENA_UTILS_PROPERTIESTABLE_H
+
+#include <Athena-Core/Prerequisites.h>
+#include <Athena-Core/Utils/Describable.h>
+#include <Athena-Math/Vector3.h>
+#include <Athena-Math/Quaternion.h>
+#include <Athena-Math/Color.h>
+
+
+namespace Athena {
+namespace Utils {
+
+//----------------------------------------------------------------------------------------
+/// @brief  Table describing the properties of a category of a describable class (see
+///         Describable)
+///
+/// Instead of implementing getProperties() and setProperty() by hand, a describable
+/// class can declare its properties once, and let the macros generate those methods:
+/// @code
+///     // In the header file
+///     class Light: public Describable
+///     {
+///         ATHENA_DESCRIBABLE(Light, Describable)
+///
+///     public:
+///         const std::string& getName() const;
+///         void setName(const std::string& strName);
+///
+///     private:
+///         Math::Color m_color;
+///         ...
+///     };
+///
+///     // In the source file
+///     ATHENA_PROPERTIES_BEGIN(Light, "Light")
+///         ATHENA_PROPERTY("color", Math::Color, m_color)
+///         ATHENA_PROPERTY_ACCESSORS("name", const std::string&, getName, setName)
+///     ATHENA_PROPERTIES_END()
+/// @endcode
+///
+/// The table is built once (the first time it is used), and:
+///   - setProperty() finds the property in O(1) (with a hash table), instead of
+///     comparing its name with the ones of all the properties
+///   - the properties can be enumerated without allocating anything (see nbProperties(),
+///     property() and base())
+///
+/// The properties of the category of the class are handled by the table, the other
+/// ones are forwarded to the base class (which doesn't need to use a table itself). The
+/// values of the properties of the category not declared in the table are ignored.
+///
+/// Three kinds of properties can be declared:
+///   - ATHENA_PROPERTY(NAME, TYPE, MEMBER): an attribute of the class
+///   - ATHENA_PROPERTY_ACCESSORS(NAME, TYPE, GETTER, SETTER): a value read and written
+///     by two methods (of signatures 'TYPE GETTER() const' and 'void SETTER(TYPE)')
+///   - ATHENA_PROPERTY_HANDLERS(NAME, GETTER, SETTER): a value read and written by two
+///     methods handling the variants themselves (of signatures 'Variant* GETTER() const'
+///     and 'bool SETTER(Variant* pValue)', with the same semantic than
+///     Describable::setProperty(), for instance to delay the property)
+///
+/// The types supported by the attributes and accessors are the ones of Variant.
+///
+/// A property that is accessed often (for instance by an animation, every frame) can be
+/// resolved once into a PropertyHandle, which is then used to access it without any
+/// string comparison (and without allocating a variant, for the types stored directly
+/// in a variant):
+/// @code
+///     PropertyHandle handle = Light::staticPropertiesTable()->resolve("Light", "color");
+///
+///     pLight->setPropertyValue(handle, Math::Color(1.0f, 0.0f, 0.0f, 1.0f));
+/// @endcode
+//----------------------------------------------------------------------------------------
+class ATHENA_CORE_SYMBOL PropertiesTable
+{
+    //_____ Internal types __________
+public:
+    /// Function returning the value of a property (as a new variant)
+    typedef Variant* (*tGetFunction)(const Describable* pDescribable);
+
+    /// Function setting the value of a property (taking the ownership of the variant),
+    /// with the same semantic than Describable::setProperty()
+    typedef bool (*tSetFunction)(Describable* pDescribable, Variant* pValue);
+
+    /// Function copying the value of a property into a variable of its type
+    typedef void (*tGetValueFunction)(const Describable* pDescribable, void* pValue);
+
+    /// Function setting the value of a property from a variable of its type
+    typedef void (*tSetValueFunction)(Describable* pDescribable, const void* pValue);
+
+    /// Description of a property
+    struct tDescriptor
+    {
+        const char*         strName;    ///< Name of the property
+        Variant::tType      type;       ///< Type of the property (NONE if unknown)
+        tGetFunction        get;        ///< Returns the value of the property
+        tSetFunction        set;        ///< Sets the value of the property
+        tGetValueFunction   getValue;   ///< Copies the value of the property (0 if the
+                                        ///  type is unknown)
+        tSetValueFunction   setValue;   ///< Sets the value of the property (0 if the type
+                                        ///  is unknown)
+    };
+
+
+    //_____ Construction / Destruction __________
+public:
+    //------------------------------------------------------------------------------------
+    /// @brief  Constructor
+    ///
+    /// @param  strCategory     Category of the properties
+    /// @param  descriptors     Descriptions of the properties (must stay valid)
+    /// @param  nbDescriptors   Number of properties
+    /// @param  pBase           Table of the base class (0 if none)
+    //------------------------------------------------------------------------------------
+    PropertiesTable(const char* strCategory, const tDescriptor* descriptors,
+                    unsigned int nbDescriptors, const PropertiesTable* pBase);
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Destructor
+    //------------------------------------------------------------------------------------
+    ~PropertiesTable();
+
+private:
+    // Not copiable
+    PropertiesTable(const PropertiesTable&);
+    PropertiesTable& operator=(const PropertiesTable&);
+
+
+    //_____ Methods __________
+public:
+    //------------------------------------------------------------------------------------
+    /// @brief  Returns the category of the properties
+    //------------------------------------------------------------------------------------
+    inline const std::string& category() const
+    {
+        return m_strCategory;
+    }
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Returns the table of the base class (0 if none, or if the base class
+    ///         doesn't use a table)
+    //------------------------------------------------------------------------------------
+    inline const PropertiesTable* base() const
+    {
+        return m_pBase;
+    }
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Returns the number of properties
+    //------------------------------------------------------------------------------------
+    inline unsigned int nbProperties() const
+    {
+        return m_nbDescriptors;
+    }
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Returns the index of the first property of the table among all the
+    ///         properties of the class (the ones of the tables of its base classes come
+    ///         first)
+    //------------------------------------------------------------------------------------
+    inline unsigned int offset() const
+    {
+        return m_offset;
+    }
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Returns the number of properties of the class (including the ones of the
+    ///         tables of its base classes)
+    //------------------------------------------------------------------------------------
+    inline unsigned int nbTotalProperties() const
+    {
+        return m_offset + m_nbDescriptors;
+    }
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Returns a hash of the layout of the properties of the class (the
+    ///         categories, names and types of the properties of this table and of the
+    ///         ones of its base classes, in order)
+    ///
+    /// Two classes with different layouts (for instance two versions of the same class)
+    /// almost certainly have different hashes, so the indices of the properties of one
+    /// class can be checked before being used with another one.
+    //------------------------------------------------------------------------------------
+    inline unsigned long long layoutHash() const
+    {
+        return m_layoutHash;
+    }
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Returns the description of a property
+    //------------------------------------------------------------------------------------
+    inline const tDescriptor& property(unsigned int index) const
+    {
+        assert(index < m_nbDescriptors);
+        return m_descriptors[index];
+    }
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Returns the index of a property (-1 if not found)
+    //------------------------------------------------------------------------------------
+    int find(const std::string& strName) const;
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Add the category of the properties (with their values) at the beginning
+    ///         of a list
+    //------------------------------------------------------------------------------------
+    void addProperties(const Describable* pDescribable, PropertiesList* pList) const;
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Set the value of a property of the category
+    ///
+    /// @param  pDescribable    The describable
+    /// @param  strName         The name of the property
+    /// @param  pValue          The value of the property (the table takes care of its
+    ///                         destruction)
+    /// @return                 'false' if the property must be delayed (see
+    ///                         Describable::setProperty())
+    //------------------------------------------------------------------------------------
+    bool setProperty(Describable* pDescribable, const std::string& strName,
+                     Variant* pValue) const;
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Returns a handle to a property, searched in this table and in the ones of
+    ///         the base classes (an invalid handle if not found)
+    //------------------------------------------------------------------------------------
+    PropertyHandle resolve(const std::string& strCategory,
+                           const std::string& strName) const;
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Returns a handle to a property from its index among all the properties of
+    ///         the class (an invalid handle if out of range, @see offset())
+    //------------------------------------------------------------------------------------
+    PropertyHandle resolve(unsigned int index) const;
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Copy the value of a property into a variant
+    ///
+    /// @remark The variant isn't allocated, and only allocates memory itself for the
+    ///         types it doesn't store directly (strings, vectors, ...)
+    /// @return 'false' if the property has no value
+    //------------------------------------------------------------------------------------
+    bool getValue(const Describable* pDescribable, unsigned int index,
+                  Variant& value) const;
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Set the value of a property from a variant (converted to the type of the
+    ///         property if necessary)
+    ///
+    /// @return 'false' if the property must be delayed (see Describable::setProperty())
+    //------------------------------------------------------------------------------------
+    bool setValue(Describable* pDescribable, unsigned int index,
+                  const Variant& value) const;
+
+
+    //_____ Attributes __________
+private:
+    std::string         m_strCategory;      ///< Category of the properties
+    const tDescriptor*  m_descriptors;      ///< Descriptions of the properties
+    unsigned int        m_nbDescriptors;    ///< Number of properties
+    const PropertiesTable* m_pBase;         ///< Table of the base class
+    unsigned int        m_offset;           ///< Index of the first property among all the
+                                            ///  properties of the class
+    unsigned long long  m_layoutHash;       ///< Hash of the layout of the properties
+    std::vector<int>    m_buckets;          ///< Hash table of the indices of the properties
+                                            ///  (-1 for the empty buckets)
+};
+
+
+//----------------------------------------------------------------------------------------
+/// @brief  Reference to a property of a describable class, resolved once and usable
+///         without string comparison (see Describable::getPropertyValue() and
+///         Describable::setPropertyValue())
+///
+/// A handle resolved from the table of a class is usable with the instances of this
+/// class and of the classes derived from it.
+//----------------------------------------------------------------------------------------
+class ATHENA_CORE_SYMBOL PropertyHandle
+{
+    //_____ Construction / Destruction __________
+public:
+    //------------------------------------------------------------------------------------
+    /// @brief  Constructs an invalid handle
+    //------------------------------------------------------------------------------------
+    inline PropertyHandle()
+    : m_pTable(0), m_index(0)
+    {
+    }
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Constructor
+    ///
+    /// @param  pTable  The table containing the property
+    /// @param  index   Index of the property in the table
+    //------------------------------------------------------------------------------------
+    inline PropertyHandle(const PropertiesTable* pTable, unsigned int index)
+    : m_pTable(pTable), m_index(index)
+    {
+        assert(pTable && (index < pTable->nbProperties()));
+    }
+
+
+    //_____ Methods __________
+public:
+    inline bool isValid() const { return (m_pTable != 0); }
+    inline const PropertiesTable* table() const { return m_pTable; }
+    inline unsigned int index() const { return m_index; }
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Returns the index of the property among all the properties of the class
+    ///         (@see PropertiesTable::offset())
+    //------------------------------------------------------------------------------------
+    inline unsigned int globalIndex() const
+    {
+        assert(m_pTable);
+        return m_pTable->offset() + m_index;
+    }
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Returns the description of the property
+    //------------------------------------------------------------------------------------
+    inline const PropertiesTable::tDescriptor& descriptor() const
+    {
+        assert(m_pTable);
+        return m_pTable->property(m_index);
+    }
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Indicates if the handle can be used with a describable (the property is
+    ///         one of the properties of its class or of one of its base classes)
+    //------------------------------------------------------------------------------------
+    bool isValidFor(const Describable* pDescribable) const;
+
+    inline bool operator==(const PropertyHandle& handle) const
+    {
+        return (m_pTable == handle.m_pTable) && (m_index == handle.m_index);
+    }
+
+    inline bool operator!=(const PropertyHandle& handle) const
+    {
+        return !(*this == handle);
+    }
+
+
+    //_____ Attributes __________
+private:
+    const PropertiesTable*  m_pTable;   ///< The table containing the property
+    unsigned int            m_index;    ///< Index of the property in the table
+};
+
+
+//----------------------------------------------------------------------------------------
+/// @brief  Conversions between the types of the properties and Variant
+//----------------------------------------------------------------------------------------
+template<typename T> struct PropertyTraits;
+
+#define ATHENA_PROPERTY_TRAITS(TYPE, TYPE_ID, METHOD)                                      \
+    template<> struct PropertyTraits<TYPE>                                                 \
+    {                                                                                      \
+        typedef TYPE tValue;                                                              \
+        static const Variant::tType TYPE_IDENTIFIER = Variant::TYPE_ID;                   \
+        static inline TYPE fromVariant(const Variant& value) { return value.METHOD(); }    \
+    };
+
+ATHENA_PROPERTY_TRAITS(int,              INTEGER,          toInt)
+ATHENA_PROPERTY_TRAITS(short,            SHORT,            toShort)
+ATHENA_PROPERTY_TRAITS(char,             CHAR,             toChar)
+ATHENA_PROPERTY_TRAITS(unsigned int,     UNSIGNED_INTEGER, toUInt)
+ATHENA_PROPERTY_TRAITS(unsigned short,   UNSIGNED_SHORT,   toUShort)
+ATHENA_PROPERTY_TRAITS(unsigned char,    UNSIGNED_CHAR,    toUChar)
+ATHENA_PROPERTY_TRAITS(float,            FLOAT,            toFloat)
+ATHENA_PROPERTY_TRAITS(double,           DOUBLE,           toDouble)
+ATHENA_PROPERTY_TRAITS(bool,             BOOLEAN,          toBool)
+ATHENA_PROPERTY_TRAITS(std::string,      STRING,           toString)
+ATHENA_PROPERTY_TRAITS(Math::Vector3,    VECTOR3,          toVector3)
+ATHENA_PROPERTY_TRAITS(Math::Quaternion, QUATERNION,       toQuaternion)
+ATHENA_PROPERTY_TRAITS(Math::Color,      COLOR,            toColor)
+ATHENA_PROPERTY_TRAITS(Math::Radian,     RADIAN,           toRadian)
+ATHENA_PROPERTY_TRAITS(Math::Degree,     DEGREE,           toDegree)
+
+#undef ATHENA_PROPERTY_TRAITS
+
+// The accessors can use references
+template<typename T> struct PropertyTraits<const T&>: public PropertyTraits<T> {};
+
+
+//----------------------------------------------------------------------------------------
+/// @brief  Implementation of the functions of a property that is an attribute
+//----------------------------------------------------------------------------------------
+template<class C, typename T, T C::*MEMBER>
+struct PropertyMember
+{
+    static Variant* get(const Describable* pDescribable)
+    {
+        return new Variant(static_cast<const C*>(pDescribable)->*MEMBER);
+    }
+
+    static bool set(Describable* pDescribable, Variant* pValue)
+    {
+        static_cast<C*>(pDescribable)->*MEMBER = PropertyTraits<T>::fromVariant(*pValue);
+        delete pValue;
+        return true;
+    }
+
+    static void getValue(const Describable* pDescribable, void* pValue)
+    {
+        *static_cast<T*>(pValue) = static_cast<const C*>(pDescribable)->*MEMBER;
+    }
+
+    static void setValue(Describable* pDescribable, const void* pValue)
+    {
+        static_cast<C*>(pDescribable)->*MEMBER = *static_cast<const T*>(pValue);
+    }
+};
+
+
+//----------------------------------------------------------------------------------------
+/// @brief  Implementation of the functions of a property that is accessed by methods
+//----------------------------------------------------------------------------------------
+template<class C, typename T, T (C::*GETTER)() const, void (C::*SETTER)(T)>
+struct PropertyAccessors
+{
+    typedef typename PropertyTraits<T>::tValue tValue;
+
+    static Variant* get(const Describable* pDescribable)
+    {
+        return new Variant((static_cast<const C*>(pDescribable)->*GETTER)());
+    }
+
+    static bool set(Describable* pDescribable, Variant* pValue)
+    {
+        (static_cast<C*>(pDescribable)->*SETTER)(PropertyTraits<T>::fromVariant(*pValue));
+        delete pValue;
+        return true;
+    }
+
+    static void getValue(const Describable* pDescribable, void* pValue)
+    {
+        *static_cast<tValue*>(pValue) = (static_cast<const C*>(pDescribable)->*GETTER)();
+    }
+
+    static void setValue(Describable* pDescribable, const void* pValue)
+    {
+        (static_cast<C*>(pDescribable)->*SETTER)(*static_cast<const tValue*>(pValue));
+    }
+};
+
+
+//----------------------------------------------------------------------------------------
+/// @brief  Implementation of the functions of a property that is handled by methods
+//----------------------------------------------------------------------------------------
+template<class C, Variant* (C::*GETTER)() const, bool (C::*SETTER)(Variant*)>
+struct PropertyHandlers
+{
+    static Variant* get(const Describable* pDescribable)
+    {
+        return (static_cast<const C*>(pDescribable)->*GETTER)();
+    }
+
+    static bool set(Describable* pDescribable, Variant* pValue)
+    {
+        return (static_cast<C*>(pDescribable)->*SETTER)(pValue);
+    }
+};
+
+
+//----------------------------------------------------------------------------------------
+
+template<typename T>
+bool Describable::getPropertyValue(const PropertyHandle& handle, T& value) const
+{
+    assert(handle.isValidFor(this));
+
+    if (m_pPendingProperties)
+        const_cast<Describable*>(this)->materializeProperty(handle);
+
+    const PropertiesTable::tDescriptor& descriptor = handle.descriptor();
+
+    if (descriptor.type == PropertyTraits<T>::TYPE_IDENTIFIER)
+    {
+        descriptor.getValue(this, &value);
+        return true;
+    }
+
+    // The property has another type, or is handled by methods
+    Variant* pValue = descriptor.get(this);
+    if (!pValue)
+        return false;
+
+    value = PropertyTraits<T>::fromVariant(*pValue);
+    delete pValue;
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------
+
+template<typename T>
+bool Describable::setPropertyValue(const PropertyHandle& handle, const T& value)
+{
+    assert(handle.isValidFor(this));
+
+    if (m_pPendingProperties)
+        discardPendingProperty(handle);
+
+    const PropertiesTable::tDescriptor& descriptor = handle.descriptor();
+
+    bool bUsed = true;
+
+    if (descriptor.type == PropertyTraits<T>::TYPE_IDENTIFIER)
+        descriptor.setValue(this, &value);
+
+    // The property has another type, or is handled by methods
+    else
+        bUsed = descriptor.set(this, new Variant(value));
+
+    if (bUsed && m_pChangedProperties)
+        markPropertyChanged(handle);
+
+    return bUsed;
+}
+
+}
+}
+
+
+//----------------------------------------------------------------------------------------
+/// @brief  Declare that a describable class uses a table of properties (in the
+///         declaration of the class)
+///
+/// @param  CLASS   The class
+/// @param  BASE    Its base class (Describable or one of its subclasses)
+//----------------------------------------------------------------------------------------
+#define ATHENA_DESCRIBABLE(CLASS, BASE)                                                    \
+public:                                                                                    \
+    static const Athena::Utils::PropertiesTable* staticPropertiesTable();                 \
+                                                                                           \
+    virtual const Athena::Utils::PropertiesTable* getPropertiesTable() const              \
+    {                                                                                      \
+        return CLASS::staticPropertiesTable();                                            \
+    }                                                                                      \
+                                                                                           \
+    virtual Athena::Utils::PropertiesList* getProperties() const                          \
+    {                                                                                      \
+        Athena::Utils::PropertiesList* pList = BASE::getProperties();                     \
+        CLASS::staticPropertiesTable()->addProperties(this, pList);                       \
+        return pList;                                                                      \
+    }                                                                                      \
+                                                                                           \
+    virtual bool setProperty(const std::string& strCategory, const std::string& strName,  \
+                             Athena::Utils::Variant* pValue)                              \
+    {                                                                                      \
+        const Athena::Utils::PropertiesTable* pTable = CLASS::staticPropertiesTable();    \
+        if (strCategory == pTable->category())                                             \
+            return pTable->setProperty(this, strName, pValue);                             \
+                                                                                           \
+        return BASE::setProperty(strCategory, strName, pValue);                            \
+    }                                                                                      \
+                                                                                           \
+private:                                                                                   \
+    typedef BASE tDescribableBase;
+
+
+//----------------------------------------------------------------------------------------
+/// @brief  Begin the table of properties of a describable class (in a source file)
+///
+/// @param  CLASS       The class
+/// @param  CATEGORY    The category of its properties
+//----------------------------------------------------------------------------------------
+#define ATHENA_PROPERTIES_BEGIN(CLASS, CATEGORY)                                           \
+    const Athena::Utils::PropertiesTable* CLASS::staticPropertiesTable()                  \
+    {                                                                                      \
+        typedef CLASS tClass;                                                              \
+        static const char* strCategory = CATEGORY;                                         \
+        static const Athena::Utils::PropertiesTable::tDescriptor descriptors[] = {
+
+
+//----------------------------------------------------------------------------------------
+/// @brief  Declare a property that is an attribute of the class
+//----------------------------------------------------------------------------------------
+#define ATHENA_PROPERTY(NAME, TYPE, MEMBER)                                                \
+            { NAME, Athena::Utils::PropertyTraits<TYPE >::TYPE_IDENTIFIER,                \
+              &Athena::Utils::PropertyMember<tClass, TYPE, &tClass::MEMBER>::get,          \
+              &Athena::Utils::PropertyMember<tClass, TYPE, &tClass::MEMBER>::set,          \
+              &Athena::Utils::PropertyMember<tClass, TYPE, &tClass::MEMBER>::getValue,     \
+              &Athena::Utils::PropertyMember<tClass, TYPE, &tClass::MEMBER>::setValue },
+
+
+//----------------------------------------------------------------------------------------
+/// @brief  Declare a property accessed by methods of the class
+//----------------------------------------------------------------------------------------
+#define ATHENA_PROPERTY_ACCESSORS(NAME, TYPE, GETTER, SETTER)                              \
+            { NAME, Athena::Utils::PropertyTraits<TYPE >::TYPE_IDENTIFIER,                \
+              &Athena::Utils::PropertyAccessors<tClass, TYPE, &tClass::GETTER,             \
+                                                &tClass::SETTER>::get,                     \
+              &Athena::Utils::PropertyAccessors<tClass, TYPE, &tClass::GETTER,             \
+                                                &tClass::SETTER>::set,                     \
+              &Athena::Utils::PropertyAccessors<tClass, TYPE, &tClass::GETTER,             \
+                                                &tClass::SETTER>::getValue,                \
+              &Athena::Utils::PropertyAccessors<tClass, TYPE, &tClass::GETTER,             \
+                                                &tClass::SETTER>::setValue },
+
+
+//----------------------------------------------------------------------------------------
+/// @brief  Declare a property handled by methods of the class
+//----------------------------------------------------------------------------------------
+#define ATHENA_PROPERTY_HANDLERS(NAME, GETTER, SETTER)                                     \
+            { NAME, Athena::Utils::Variant::NONE,                                         \
+              &Athena::Utils::PropertyHandlers<tClass, &tClass::GETTER,                    \
+                                               &tClass::SETTER>::get,                      \
+              &Athena::Utils::PropertyHandlers<tClass, &tClass::GETTER,                    \
+                                               &tClass::SETTER>::set,                      \
+              0, 0 },
+
+
+//----------------------------------------------------------------------------------------
+/// @brief  End the table of properties of a describable class
+//----------------------------------------------------------------------------------------
+#define ATHENA_PROPERTIES_END()                                                            \
+        };                                                                                 \
+                                                                                           \
+        static const Athena::Utils::PropertiesTable table(                                 \
+            strCategory, descriptors, sizeof(descriptors) / sizeof(descriptors[0]),        \
+            tClass::tDescribableBase::staticPropertiesTable());                            \
+                                                                                           \
+        return &table;                                                                     \
+    }
+
+#endif
@@ -19,10 +19,42 @@ namespace Utils {
 
 //---------------------------------------------------------------------------------------
 /// @brief  Contains conversions methods to/from string
+///
+/// The numbers are formatted without using the streams of the standard library (so
+/// without allocating memory or looking up the locale, except for the final string): the
+/// toChars() methods write them in a buffer provided by the caller, and the toString()
+/// ones add the width, fill and flags semantics of the streams on top of them.
+///
+/// In the same way, the numbers are parsed by the fromChars() methods, which don't
+/// depend on the locale either (the decimal point is always '.') and report the errors.
+/// The parseXXX() methods are built on top of them.
 //---------------------------------------------------------------------------------------
 class ATHENA_CORE_SYMBOL StringConverter
 {
 public:
+    enum
+    {
+        /// Size of a buffer large enough for any integer, or any real formatted in its
+        /// shortest form
+        MAX_NUMBER_LENGTH = 32
+    };
+
+    /// Errors reported by fromChars()
+    enum tParseError
+    {
+        PARSE_SUCCESS,          ///< The number was parsed
+        PARSE_INVALID,          ///< The text doesn't begin with a number
+        PARSE_OUT_OF_RANGE      ///< The number can't be represented by the type
+    };
+
+    /// Result of fromChars()
+    struct tParseResult
+    {
+        const char*     pEnd;   ///< End of the number (beginning of the text if invalid)
+        tParseError     error;  ///< The error
+    };
+
+
     //-----------------------------------------------------------------------------------
     /// @brief  Converts a Real to a string
     //-----------------------------------------------------------------------------------
@@ -61,9 +93,159 @@ public:
     //-----------------------------------------------------------------------------------
     static std::string toString(bool val, bool yesNo = false);
 
+    //-----------------------------------------------------------------------------------
+    /// @brief  Writes an int in a buffer (in base 10)
+    ///
+    /// @param  pFirst  Beginning of the buffer
+    /// @param  pLast   End of the buffer
+    /// @param  val     The value
+    /// @return         Pointer to the end of the characters written (no null character
+    ///                 is added), 0 if the buffer is too small
+    //-----------------------------------------------------------------------------------
+    static char* toChars(char* pFirst, char* pLast, int val);
+
+    //-----------------------------------------------------------------------------------
+    /// @brief  Writes an unsigned int in a buffer (in base 10)
+    ///
+    /// @see    toChars(char*, char*, int)
+    //-----------------------------------------------------------------------------------
+    static char* toChars(char* pFirst, char* pLast, unsigned int val);
+
+    //-----------------------------------------------------------------------------------
+    /// @brief  Writes a long in a buffer (in base 10)
+    ///
+    /// @see    toChars(char*, char*, int)
+    //-----------------------------------------------------------------------------------
+    static char* toChars(char* pFirst, char* pLast, long val);
+
+    //-----------------------------------------------------------------------------------
+    /// @brief  Writes an unsigned long in a buffer (in base 10)
+    ///
+    /// @see    toChars(char*, char*, int)
+    //-----------------------------------------------------------------------------------
+    static char* toChars(char* pFirst, char* pLast, unsigned long val);
+
+    //-----------------------------------------------------------------------------------
+    /// @brief  Writes a Real in a buffer, in the shortest form that gives back the same
+    ///         value when parsed
+    ///
+    /// The scientific notation is used for the values below 1e-4 or above 1e17. The
+    /// infinite values are written as "inf" and "-inf", and the NaN ones as "nan".
+    ///
+    /// @param  pFirst  Beginning of the buffer
+    /// @param  pLast   End of the buffer
+    /// @param  val     The value
+    /// @return         Pointer to the end of the characters written (no null character
+    ///                 is added), 0 if the buffer is too small
+    //-----------------------------------------------------------------------------------
+    static char* toChars(char* pFirst, char* pLast, Math::Real val);
+
+    //-----------------------------------------------------------------------------------
+    /// @brief  Writes a Real in a buffer, with a given precision
+    ///
+    /// The result is the same as the one of a stream (with the "C" locale), but only
+    /// the 'floatfield', 'showpoint', 'showpos' and 'uppercase' flags are used (the
+    /// width isn't).
+    ///
+    /// @param  pFirst      Beginning of the buffer
+    /// @param  pLast       End of the buffer
+    /// @param  val         The value
+    /// @param  precision   The precision
+    /// @param  flags       The flags
+    /// @return             Pointer to the end of the characters written (no null
+    ///                     character is added), 0 if the buffer is too small
+    //-----------------------------------------------------------------------------------
+    static char* toChars(char* pFirst, char* pLast, Math::Real val,
+                         unsigned short precision,
+                         std::ios::fmtflags flags = std::ios::fmtflags(0));
+
+    //-----------------------------------------------------------------------------------
+    /// @brief  Parses an int at the beginning of a text
+    ///
+    /// The number is made of an optional sign ('+' or '-') followed by decimal digits.
+    /// No whitespace is skipped, and the characters following the number are ignored.
+    ///
+    /// @param  pFirst  Beginning of the text
+    /// @param  pLast   End of the text
+    /// @param  val     The parsed value (not modified in case of error)
+    /// @return         The end of the number and the error
+    //-----------------------------------------------------------------------------------
+    static tParseResult fromChars(const char* pFirst, const char* pLast, int& val);
+
+    //-----------------------------------------------------------------------------------
+    /// @brief  Parses a short at the beginning of a text
+    ///
+    /// @see    fromChars(const char*, const char*, int&)
+    //-----------------------------------------------------------------------------------
+    static tParseResult fromChars(const char* pFirst, const char* pLast, short& val);
+
+    //-----------------------------------------------------------------------------------
+    /// @brief  Parses a long at the beginning of a text
+    ///
+    /// @see    fromChars(const char*, const char*, int&)
+    //-----------------------------------------------------------------------------------
+    static tParseResult fromChars(const char* pFirst, const char* pLast, long& val);
+
+    //-----------------------------------------------------------------------------------
+    /// @brief  Parses an unsigned int at the beginning of a text
+    ///
+    /// Negative numbers are invalid.
+    ///
+    /// @see    fromChars(const char*, const char*, int&)
+    //-----------------------------------------------------------------------------------
+    static tParseResult fromChars(const char* pFirst, const char* pLast, unsigned int& val);
+
+    //-----------------------------------------------------------------------------------
+    /// @brief  Parses an unsigned short at the beginning of a text
+    ///
+    /// @see    fromChars(const char*, const char*, unsigned int&)
+    //-----------------------------------------------------------------------------------
+    static tParseResult fromChars(const char* pFirst, const char* pLast,
+                                  unsigned short& val);
+
+    //-----------------------------------------------------------------------------------
+    /// @brief  Parses an unsigned long at the beginning of a text
+    ///
+    /// @see    fromChars(const char*, const char*, unsigned int&)
+    //-----------------------------------------------------------------------------------
+    static tParseResult fromChars(const char* pFirst, const char* pLast,
+                                  unsigned long& val);
+
+    //-----------------------------------------------------------------------------------
+    /// @brief  Parses a float at the beginning of a text
+    ///
+    /// The number is made of an optional sign ('+' or '-'), decimal digits with an
+    /// optional decimal point ('.', whatever the locale), and an optional exponent ('e'
+    /// or 'E' followed by an optional sign and decimal digits). No whitespace is
+    /// skipped, and the characters following the number are ignored. The infinite and
+    /// NaN values aren't supported.
+    ///
+    /// The result is correctly rounded. Most of the numbers with few digits are
+    /// converted exactly with a few floating-point operations, the other ones by the C
+    /// library.
+    ///
+    /// @param  pFirst  Beginning of the text
+    /// @param  pLast   End of the text
+    /// @param  val     The parsed value (not modified in case of error)
+    /// @return         The end of the number and the error (PARSE_OUT_OF_RANGE if the
+    ///                 number is too large for the type, or too small: a non-zero
+    ///                 number that would be rounded to zero)
+    //-----------------------------------------------------------------------------------
+    static tParseResult fromChars(const char* pFirst, const char* pLast, float& val);
+
+    //-----------------------------------------------------------------------------------
+    /// @brief  Parses a double at the beginning of a text
+    ///
+    /// @see    fromChars(const char*, const char*, float&)
+    //-----------------------------------------------------------------------------------
+    static tParseResult fromChars(const char* pFirst, const char* pLast, double& val);
+
     //-----------------------------------------------------------------------------------
     /// @brief  Converts a string to a Real
     ///
+    /// The leading whitespaces are skipped, and the characters following the number are
+    /// ignored.
+    ///
     /// @return 0.0 if the value could not be parsed, otherwise the Real version of the
     ///         string
     //-----------------------------------------------------------------------------------
@@ -72,6 +254,9 @@ public:
     //-----------------------------------------------------------------------------------
     /// @brief  Converts a string to an int
     ///
+    /// The leading whitespaces are skipped, and the characters following the number are
+    /// ignored.
+    ///
     /// @return 0 if the value could not be parsed, otherwise the Real version of the
     ///         string
     //-----------------------------------------------------------------------------------
@@ -80,6 +265,8 @@ public:
     //-----------------------------------------------------------------------------------
     /// @brief  Converts a string to an unsigned int
     ///
+    /// @see    parseInt()
+    ///
     /// @return 0 if the value could not be parsed, otherwise the Real version of the
     ///         string
     //-----------------------------------------------------------------------------------
@@ -88,6 +275,8 @@ public:
     //-----------------------------------------------------------------------------------
     /// @brief  Converts a string to a long
     ///
+    /// @see    parseInt()
+    ///
     /// @return 0 if the value could not be parsed, otherwise the Real version of the
     ///         string
     //-----------------------------------------------------------------------------------
@@ -96,6 +285,8 @@ public:
     //-----------------------------------------------------------------------------------
     /// @brief  Converts a string to an unsigned long
     ///
+    /// @see    parseInt()
+    ///
     /// @return 0 if the value could not be parsed, otherwise the Real version of the
     ///         string
     //-----------------------------------------------------------------------------------
@@ -110,7 +301,8 @@ public:
     static bool parseBool(const std::string& val);
 
     //-----------------------------------------------------------------------------------
-    /// @brief  Indicates if the string contains a number
+    /// @brief  Indicates if the string contains a number (and nothing else, except
+    ///         leading whitespaces)
     //-----------------------------------------------------------------------------------
     static bool isNumber(const std::string& val);
 };
@@ -0,0 +1,105 @@
+/** @file   StringReplacer.h
+    @author Philip Abbet
+
+    Declaration of the class 'Athena::Utils::StringReplacer'
+*/
+
+#ifndef _ATHENA_UTILS_STRINGREPLACER_H
+#define _ATHENA_UTILS_STRINGREPLACER_H
+
+#include <Athena-Core/Prerequisites.h>
+#include <Athena-Core/Utils/StringUtils.h>
+
+
+namespace Athena {
+namespace Utils {
+
+//----------------------------------------------------------------------------------------
+/// @brief  Replaces several sub-strings in a text, in one pass
+///
+/// Meant to expand templates (for instance, generated shaders) with a set of
+/// replacements known in advance:
+/// @code
+///     StringUtils::tReplacementsList replacements;
+///     replacements.push_back(std::make_pair("$(LIGHTS)", "4"));
+///     replacements.push_back(std::make_pair("$(COLOR)", "vec4(1.0)"));
+///
+///     StringReplacer replacer(replacements);
+///
+///     std::string strShader = replacer.replace(strTemplate);
+/// @endcode
+///
+/// The sub-strings are searched all at once by an automaton (Aho-Corasick) built by the
+/// constructor, so the time taken by the replacement doesn't depend on their number.
+/// The parts of the text that can't contain any sub-string (because none of the
+/// characters there can begin one) are skipped several characters at a time.
+///
+/// The text is scanned from left to right: when several sub-strings are found at the
+/// same position, the longest one is replaced. The replacements aren't scanned again.
+/// The object isn't modified by the replacements, so it can be shared by several
+/// threads.
+//----------------------------------------------------------------------------------------
+class ATHENA_CORE_SYMBOL StringReplacer
+{
+    //_____ Construction / Destruction __________
+public:
+    //------------------------------------------------------------------------------------
+    /// @brief  Constructor
+    ///
+    /// @param  replacements    The sub-strings to find, and the ones to replace them
+    ///                         with (the empty sub-strings are ignored, and only the
+    ///                         first replacement of a sub-string is used)
+    //------------------------------------------------------------------------------------
+    StringReplacer(const StringUtils::tReplacementsList& replacements);
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Destructor
+    //------------------------------------------------------------------------------------
+    ~StringReplacer();
+
+
+    //_____ Methods __________
+public:
+    //------------------------------------------------------------------------------------
+    /// @brief  Returns a copy of a text, in which the sub-strings were replaced
+    //------------------------------------------------------------------------------------
+    std::string replace(const StringView& text) const;
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Replace the sub-strings in a string
+    ///
+    /// @return The number of replacements
+    //------------------------------------------------------------------------------------
+    unsigned int replaceAll(std::string& str) const;
+
+private:
+    //------------------------------------------------------------------------------------
+    /// @brief  Append a text to a string, replacing the sub-strings
+    ///
+    /// @param          text    The text
+    /// @param[in/out]  result  The string
+    /// @return                 The number of replacements
+    //------------------------------------------------------------------------------------
+    unsigned int replace(const StringView& text, std::string& result) const;
+
+
+    //_____ Attributes __________
+private:
+    StringUtils::tReplacementsList  m_replacements;     ///< The replacements
+    unsigned short                  m_classes[256];     ///< Index of each character in
+                                                        ///  the alphabet of the automaton
+    unsigned int                    m_nbClasses;        ///< Size of the alphabet
+    std::vector<int>                m_transitions;      ///< Transitions between the states
+                                                        ///  (m_nbClasses per state)
+    std::vector<int>                m_matches;          ///< Longest replacement ending at
+                                                        ///  each state (or -1)
+    std::vector<unsigned int>       m_depths;           ///< Length of the prefix
+                                                        ///  represented by each state
+    std::string                     m_strFirstCharacters;   ///< The characters beginning
+                                                            ///  the sub-strings
+};
+
+}
+}
+
+#endif
@@ -0,0 +1,121 @@
+/** @file   StringTokenizer.h
+    @author Philip Abbet
+
+    Declaration of the class 'Athena::Utils::StringTokenizer'
+*/
+
+#ifndef _ATHENA_UTILS_STRINGTOKENIZER_H
+#define _ATHENA_UTILS_STRINGTOKENIZER_H
+
+#include <Athena-Core/Prerequisites.h>
+#include <Athena-Core/Utils/StringView.h>
+
+
+namespace Athena {
+namespace Utils {
+
+//----------------------------------------------------------------------------------------
+/// @brief  Splits a text into tokens delimited by some characters, one at a time and
+///         without copying them
+///
+/// The tokens are the same than the ones returned by StringUtils::split(): two
+/// consecutive delimiters produce an empty token, and there is always one token more
+/// than the number of delimiters.
+/// @code
+///     StringTokenizer tokenizer(strText, ";,");
+///
+///     StringView token;
+///     while (tokenizer.next(token))
+///         ...
+/// @endcode
+///
+/// The text can be read from a stream, by chunks: in this case, a token is only valid
+/// until the next call to next() (it references the internal buffer of the tokenizer,
+/// which grows when a token is bigger than it).
+//----------------------------------------------------------------------------------------
+class ATHENA_CORE_SYMBOL StringTokenizer
+{
+    //_____ Construction / Destruction __________
+public:
+    //------------------------------------------------------------------------------------
+    /// @brief  Constructor
+    ///
+    /// @param  text    The text to split (must stay valid while the tokenizer is used)
+    /// @param  delims  The delimiter characters
+    //------------------------------------------------------------------------------------
+    StringTokenizer(const StringView& text, const StringView& delims = "\t\n ");
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Constructor
+    ///
+    /// @param  pStream     The stream from which the text is read (must stay valid while
+    ///                     the tokenizer is used)
+    /// @param  delims      The delimiter characters
+    /// @param  bufferSize  Initial size of the buffer in which the text is read
+    //------------------------------------------------------------------------------------
+    StringTokenizer(Data::DataStream* pStream, const StringView& delims = "\t\n ",
+                    size_t bufferSize = 64 * 1024);
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Destructor
+    //------------------------------------------------------------------------------------
+    ~StringTokenizer();
+
+private:
+    // Not copiable
+    StringTokenizer(const StringTokenizer&);
+    StringTokenizer& operator=(const StringTokenizer&);
+
+
+    //_____ Methods __________
+public:
+    //------------------------------------------------------------------------------------
+    /// @brief  Retrieve the next token
+    ///
+    /// @param[out] token   The token
+    /// @return             'false' if there is no more token
+    //------------------------------------------------------------------------------------
+    bool next(StringView& token);
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Indicates if a character is one of the delimiters
+    //------------------------------------------------------------------------------------
+    inline bool isDelimiter(char c) const
+    {
+        return m_delimiters[(unsigned char) c];
+    }
+
+private:
+    //------------------------------------------------------------------------------------
+    /// @brief  Initialise the table of delimiters
+    //------------------------------------------------------------------------------------
+    void setDelimiters(const StringView& delims);
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Returns the first delimiter in [pStart, m_pEnd) (0 if none)
+    //------------------------------------------------------------------------------------
+    const char* findDelimiter(const char* pStart) const;
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Read more text from the stream, after the characters not processed yet
+    ///
+    /// @return 'false' if the end of the stream was reached
+    //------------------------------------------------------------------------------------
+    bool refill();
+
+
+    //_____ Attributes __________
+private:
+    bool                m_delimiters[256];  ///< Indicates which characters are delimiters
+    std::string         m_strDelimiters;    ///< The delimiters (without duplicates)
+    const char*         m_pCurrent;         ///< Start of the next token
+    const char*         m_pEnd;             ///< End of the text available
+    bool                m_bFinished;        ///< Indicates if the last token was returned
+    Data::DataStream*   m_pStream;          ///< The stream (if any)
+    std::vector<char>   m_buffer;           ///< Buffer in which the stream is read
+};
+
+}
+}
+
+#endif
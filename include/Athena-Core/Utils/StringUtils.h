@@ -11,6 +11,7 @@
 #define _ATHENA_UTILS_STRINGUTILS_H
 
 #include <Athena-Core/Prerequisites.h>
+#include <Athena-Core/Utils/StringView.h>
 
 
 namespace Athena {
@@ -18,6 +19,10 @@ namespace Utils {
 
 //----------------------------------------------------------------------------------------
 /// @brief  Contains utility methods to manipulate strings
+///
+/// The case conversions, the search of delimiters and the trimming process several
+/// characters at once with SSE2 or AVX2 instructions when the CPU supports them (the
+/// best implementation is selected when the library is loaded).
 //----------------------------------------------------------------------------------------
 class ATHENA_CORE_SYMBOL StringUtils
 {
@@ -25,6 +30,17 @@ class ATHENA_CORE_SYMBOL StringUtils
 public:
     typedef std::vector<std::string> tStringsList;
 
+    /// List of replacements (sub-string to find, sub-string to replace it with)
+    typedef std::vector<std::pair<std::string, std::string> > tReplacementsList;
+
+    /// Instruction sets used by the implementations of the methods
+    enum tInstructionSet
+    {
+        INSTRUCTIONS_SCALAR,    ///< One character at a time
+        INSTRUCTIONS_SSE2,      ///< 16 characters at a time
+        INSTRUCTIONS_AVX2,      ///< 32 characters at a time
+    };
+
 
     //_____ Static methods __________
 public:
@@ -34,10 +50,25 @@ public:
     /// @param[in/out]  strSource   The string we work on
     /// @param          strWhat     Sub-string to find and replace
     /// @param          strWith     Sub-string to replace with (the new sub-string)
+    ///
+    /// @remark The result is built in one pass, so the time taken doesn't depend on the
+    ///         number of replacements. The replacements aren't scanned again.
     //------------------------------------------------------------------------------------
     static void replaceAll(std::string &strSource, const std::string& strWhat,
                            const std::string& strWith);
 
+    //------------------------------------------------------------------------------------
+    /// @brief  Replace all instances of several sub-strings, in one pass
+    ///
+    /// @param[in/out]  strSource       The string we work on
+    /// @param          replacements    The sub-strings to find and the ones to replace
+    ///                                 them with
+    ///
+    /// @remark Use a StringReplacer to apply the same replacements to several strings
+    /// @see    StringReplacer
+    //------------------------------------------------------------------------------------
+    static void replaceAll(std::string &strSource, const tReplacementsList& replacements);
+
     //------------------------------------------------------------------------------------
     /// @brief  Returns a list of strings containing all the substrings delimited by the
     ///         characters in the passed <code>delims</code> argument
@@ -45,16 +76,29 @@ public:
     /// @param str      Source string
     /// @param delims   A list of delimiter characters to split by
     /// @return         The list of substrings
+    ///
+    /// @remark Each substring is copied: use a StringTokenizer to iterate over them
+    ///         without allocating memory
     //------------------------------------------------------------------------------------
     static tStringsList split(const std::string& str, const std::string& delims = "\t\n ");
 
     //------------------------------------------------------------------------------------
-    /// @brief  Upper-cases all the characters in the string
+    /// @brief  Returns the position of the first character of a string that is one of
+    ///         the delimiters (StringView::npos if none)
     //------------------------------------------------------------------------------------
-    static void toLowerCase(std::string& str);
+    static size_t findFirstOf(const StringView& str, const StringView& delims);
 
     //------------------------------------------------------------------------------------
     /// @brief  Lower-cases all the characters in the string
+    ///
+    /// @remark Only the ASCII characters are converted
+    //------------------------------------------------------------------------------------
+    static void toLowerCase(std::string& str);
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Upper-cases all the characters in the string
+    ///
+    /// @remark Only the ASCII characters are converted
     //------------------------------------------------------------------------------------
     static void toUpperCase(std::string& str);
 
@@ -69,6 +113,18 @@ public:
     static bool startsWith(const std::string& str, const std::string& pattern,
                            bool lowerCase = true);
 
+    //------------------------------------------------------------------------------------
+    /// @brief  Indicates whether the characters begin with the pattern passed in
+    ///
+    /// @param str          Source characters
+    /// @param pattern      The pattern to compare with
+    /// @param lowerCase    If true, the start of the characters will be lower cased
+    ///                     during the comparison (without copying them), pattern should
+    ///                     also be in lower case.
+    //------------------------------------------------------------------------------------
+    static bool startsWith(const StringView& str, const StringView& pattern,
+                           bool lowerCase = true);
+
     //------------------------------------------------------------------------------------
     /// @brief  Indicates whether the string ends with the pattern passed in
     ///
@@ -80,6 +136,18 @@ public:
     static bool endsWith(const std::string& str, const std::string& pattern,
                          bool lowerCase = true);
 
+    //------------------------------------------------------------------------------------
+    /// @brief  Indicates whether the characters end with the pattern passed in
+    ///
+    /// @param str          Source characters
+    /// @param pattern      The pattern to compare with
+    /// @param lowerCase    If true, the end of the characters will be lower cased
+    ///                     during the comparison (without copying them), pattern should
+    ///                     also be in lower case.
+    //------------------------------------------------------------------------------------
+    static bool endsWith(const StringView& str, const StringView& pattern,
+                         bool lowerCase = true);
+
     //------------------------------------------------------------------------------------
     /// @brief  Removes any whitespace characters, be it standard space or TABs and so on
     ///
@@ -87,6 +155,22 @@ public:
     ///         end of the String (the default action is to trim both).
     //------------------------------------------------------------------------------------
     static void trim(std::string& str, bool left = true, bool right = true);
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Returns the instruction set used by the implementations of the methods
+    //------------------------------------------------------------------------------------
+    static tInstructionSet instructionSet();
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Change the instruction set used by the implementations of the methods
+    ///
+    /// @return 'false' if the CPU doesn't support it
+    ///
+    /// @remark Only meant to be used by the tests and the benchmarks. The table of
+    ///         implementations (g_kernels) is written without any synchronisation, so
+    ///         this method must not be called while other threads use StringUtils.
+    //------------------------------------------------------------------------------------
+    static bool setInstructionSet(tInstructionSet instructionSet);
 };
 
 }
@@ -0,0 +1,162 @@
+/** @file   StringView.h
+    @author Philip Abbet
+
+    Declaration of the class 'Athena::Utils::StringView'
+*/
+
+#ifndef _ATHENA_UTILS_STRINGVIEW_H
+#define _ATHENA_UTILS_STRINGVIEW_H
+
+#include <Athena-Core/Prerequisites.h>
+#include <string.h>
+
+
+namespace Athena {
+namespace Utils {
+
+//----------------------------------------------------------------------------------------
+/// @brief  Non-owning reference to a sequence of characters
+///
+/// Gives read access to a part of a string (or of any buffer of characters) without
+/// copying it. The characters aren't necessarily followed by a '\\0'.
+///
+/// @remark The referenced characters must stay valid while the view is used
+//----------------------------------------------------------------------------------------
+class ATHENA_CORE_SYMBOL StringView
+{
+    //_____ Internal types __________
+public:
+    typedef const char* const_iterator;
+
+    static const size_t npos = (size_t) -1;
+
+
+    //_____ Construction / Destruction __________
+public:
+    //------------------------------------------------------------------------------------
+    /// @brief  Constructs an empty view
+    //------------------------------------------------------------------------------------
+    inline StringView()
+    : m_pData(""), m_length(0)
+    {
+    }
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Constructs a view of a null-terminated string
+    //------------------------------------------------------------------------------------
+    inline StringView(const char* strText)
+    : m_pData(strText), m_length(strlen(strText))
+    {
+    }
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Constructs a view of a buffer of characters
+    //------------------------------------------------------------------------------------
+    inline StringView(const char* pData, size_t length)
+    : m_pData(pData), m_length(length)
+    {
+    }
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Constructs a view of a string
+    //------------------------------------------------------------------------------------
+    inline StringView(const std::string& str)
+    : m_pData(str.data()), m_length(str.length())
+    {
+    }
+
+
+    //_____ Methods __________
+public:
+    inline const char* data() const { return m_pData; }
+    inline size_t size() const { return m_length; }
+    inline size_t length() const { return m_length; }
+    inline bool empty() const { return (m_length == 0); }
+
+    inline const_iterator begin() const { return m_pData; }
+    inline const_iterator end() const { return m_pData + m_length; }
+
+    inline char operator[](size_t index) const
+    {
+        assert(index < m_length);
+        return m_pData[index];
+    }
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Returns a view of a part of the characters (clamped to the end of the
+    ///         view)
+    //------------------------------------------------------------------------------------
+    inline StringView substr(size_t pos, size_t count = npos) const
+    {
+        if (pos > m_length)
+            pos = m_length;
+
+        if (count > m_length - pos)
+            count = m_length - pos;
+
+        return StringView(m_pData + pos, count);
+    }
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Returns the position of the first occurrence of a character (npos if not
+    ///         found)
+    //------------------------------------------------------------------------------------
+    inline size_t find(char c, size_t pos = 0) const
+    {
+        if (pos >= m_length)
+            return npos;
+
+        const void* p = memchr(m_pData + pos, c, m_length - pos);
+        return (p ? (const char*) p - m_pData : npos);
+    }
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Compares the characters with the ones of another view
+    ///
+    /// @return A negative value, zero or a positive value, like strcmp()
+    //------------------------------------------------------------------------------------
+    inline int compare(const StringView& view) const
+    {
+        int result = memcmp(m_pData, view.m_pData,
+                            (m_length < view.m_length ? m_length : view.m_length));
+        if (result != 0)
+            return result;
+
+        return (m_length < view.m_length ? -1 : (m_length > view.m_length ? 1 : 0));
+    }
+
+    inline bool operator==(const StringView& view) const
+    {
+        return (m_length == view.m_length) &&
+               (memcmp(m_pData, view.m_pData, m_length) == 0);
+    }
+
+    inline bool operator!=(const StringView& view) const
+    {
+        return !(*this == view);
+    }
+
+    inline bool operator<(const StringView& view) const
+    {
+        return (compare(view) < 0);
+    }
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Returns a copy of the characters
+    //------------------------------------------------------------------------------------
+    inline std::string toString() const
+    {
+        return std::string(m_pData, m_length);
+    }
+
+
+    //_____ Attributes __________
+private:
+    const char* m_pData;    ///< The characters
+    size_t      m_length;   ///< Number of characters
+};
+
+}
+}
+
+#endif
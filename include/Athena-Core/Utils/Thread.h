@@ -0,0 +1,90 @@
+/** @file   Thread.h
+    @author Philip Abbet
+
+    Declaration of the class 'Athena::Utils::Thread'
+*/
+
+#ifndef _ATHENA_UTILS_THREAD_H
+#define _ATHENA_UTILS_THREAD_H
+
+#include <Athena-Core/Prerequisites.h>
+#include <Athena-Core/Utils/Mutex.h>
+
+
+namespace Athena {
+namespace Utils {
+
+//----------------------------------------------------------------------------------------
+/// @brief  Base class for a thread
+///
+/// Subclasses implement run(), which is executed in the new thread once start() is
+/// called.
+//----------------------------------------------------------------------------------------
+class ATHENA_CORE_SYMBOL Thread
+{
+    //_____ Construction / Destruction __________
+public:
+    Thread();
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Destructor
+    ///
+    /// @remark The thread must have been joined before its destruction
+    //------------------------------------------------------------------------------------
+    virtual ~Thread();
+
+private:
+    // Not copiable
+    Thread(const Thread&);
+    Thread& operator=(const Thread&);
+
+
+    //_____ Methods __________
+public:
+    //------------------------------------------------------------------------------------
+    /// @brief  Start the thread
+    /// @return 'true' if successful
+    //------------------------------------------------------------------------------------
+    bool start();
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Wait until the thread is finished
+    //------------------------------------------------------------------------------------
+    void join();
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Indicates if the thread was started (and not joined yet)
+    //------------------------------------------------------------------------------------
+    inline bool isRunning() const
+    {
+        return m_bRunning;
+    }
+
+protected:
+    //------------------------------------------------------------------------------------
+    /// @brief  Called in the new thread
+    //------------------------------------------------------------------------------------
+    virtual void run() = 0;
+
+private:
+#if ATHENA_PLATFORM == ATHENA_PLATFORM_WIN32
+    static unsigned int __stdcall entryPoint(void* pThread);
+#else
+    static void* entryPoint(void* pThread);
+#endif
+
+
+    //_____ Attributes __________
+private:
+#if ATHENA_PLATFORM == ATHENA_PLATFORM_WIN32
+    HANDLE      m_thread;
+#else
+    pthread_t   m_thread;
+#endif
+    bool        m_bRunning;
+};
+
+}
+}
+
+#endif
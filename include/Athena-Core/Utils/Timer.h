@@ -14,7 +14,9 @@
 // Bring in the specific platform's header file
 #if ATHENA_PLATFORM == ATHENA_PLATFORM_WIN32
     #include "WIN32/Timer.h"
-#elif (ATHENA_PLATFORM == ATHENA_PLATFORM_LINUX) || (ATHENA_PLATFORM == ATHENA_PLATFORM_APPLE)
+#elif ATHENA_PLATFORM == ATHENA_PLATFORM_LINUX
+    #include "Linux/Timer.h"
+#elif ATHENA_PLATFORM == ATHENA_PLATFORM_APPLE
     #include "OSX/Timer.h"
 #else
     #error Unknown platform
@@ -10,6 +10,10 @@
 #include <Athena-Core/Prerequisites.h>
 #include <Athena-Core/Utils/Iterators.h>
 
+#if ATHENA_CORE_VARIANT_POOL
+#   include <Athena-Core/Utils/PoolAllocator.h>
+#endif
+
 namespace Athena {
 namespace Utils {
 
@@ -78,6 +82,25 @@ protected:
     void clear();
 
 
+#if ATHENA_CORE_VARIANT_POOL
+    //_____ Memory management __________
+public:
+    //-----------------------------------------------------------------------------------
+    /// @brief  Allocate the variants from a pool, since they are created (and destroyed)
+    ///         in great numbers by the lists of properties, the structs, ...
+    //-----------------------------------------------------------------------------------
+    static void* operator new(size_t size)
+    {
+        return PoolAllocator::allocate(size);
+    }
+
+    static void operator delete(void* p, size_t size)
+    {
+        PoolAllocator::deallocate(p, size);
+    }
+#endif
+
+
     //_____ Management of the type __________
 public:
     inline tType getType() const
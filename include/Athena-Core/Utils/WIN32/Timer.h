@@ -55,6 +55,12 @@ public:
     //------------------------------------------------------------------------------------
     unsigned long getMicroseconds();
 
+    //------------------------------------------------------------------------------------
+    /// @brief  Returns the number of nanoseconds elapsed since the last reset
+    /// @return The number of nanoseconds
+    //------------------------------------------------------------------------------------
+    unsigned long long getNanoseconds();
+
     //------------------------------------------------------------------------------------
     /// @brief  Returns the number of milliseconds elapsed since the last reset, only CPU
     ///         time measured
@@ -0,0 +1,541 @@
+/** @file   Checksum.cpp
+    @author Philip Abbet
+
+    Implementation of the classes 'Athena::Data::Checksum' and 'Athena::Data::Hash64'
+*/
+
+#include <Athena-Core/Data/Checksum.h>
+#include <string.h>
+
+#if defined(__x86_64__) || defined(_M_X64)
+    #define HAS_SSE42_CRC32
+
+    #if defined(_MSC_VER)
+        #include <intrin.h>
+        #include <nmmintrin.h>
+        #define TARGET_SSE42
+    #else
+        #include <cpuid.h>
+        #include <nmmintrin.h>
+        #define TARGET_SSE42 __attribute__((target("sse4.2")))
+    #endif
+#endif
+
+using namespace Athena::Data;
+
+
+/************************************** CONSTANTS **************************************/
+
+/// CRC32C polynomial (reversed)
+static const unsigned int CRC32C_POLYNOMIAL = 0x82F63B78;
+
+/// Size of the blocks processed in parallel by the hardware implementation of the CRC
+static const size_t LONG_BLOCK  = 8192;
+static const size_t SHORT_BLOCK = 256;
+
+/// Primes used by the 64-bit hash
+static const unsigned long long PRIME1 = 11400714785074694791ULL;
+static const unsigned long long PRIME2 = 14029467366897019727ULL;
+static const unsigned long long PRIME3 = 1609587929392839161ULL;
+static const unsigned long long PRIME4 = 9650029242287828579ULL;
+static const unsigned long long PRIME5 = 2870177450012600261ULL;
+
+
+/************************************* CRC32C TABLES ************************************/
+
+//----------------------------------------------------------------------------------------
+/// @brief  Tables used by the CRC32C implementations, filled once when the library is
+///         loaded
+//----------------------------------------------------------------------------------------
+struct tCRC32CTables
+{
+    tCRC32CTables();
+
+    /// Multiply a 32x32 matrix over GF(2) by a vector
+    static unsigned int multiply(const unsigned int* matrix, unsigned int vector);
+
+    /// Build the tables used to shift a CRC by a number of zero bytes
+    static void buildShiftTables(unsigned int tables[4][256], size_t nbBytes);
+
+    unsigned int    software[8][256];   ///< Tables of the software implementation (slicing-by-8)
+    unsigned int    shiftLong[4][256];  ///< Shift a CRC by LONG_BLOCK zero bytes
+    unsigned int    shiftShort[4][256]; ///< Shift a CRC by SHORT_BLOCK zero bytes
+    bool            bHardware;          ///< Indicates if the CPU supports the crc32 instruction
+};
+
+static tCRC32CTables tables;
+
+//-----------------------------------------------------------------------
+
+tCRC32CTables::tCRC32CTables()
+: bHardware(false)
+{
+    for (unsigned int n = 0; n < 256; ++n)
+    {
+        unsigned int crc = n;
+        for (unsigned int k = 0; k < 8; ++k)
+            crc = (crc & 1) ? (crc >> 1) ^ CRC32C_POLYNOMIAL : crc >> 1;
+
+        software[0][n] = crc;
+    }
+
+    for (unsigned int n = 0; n < 256; ++n)
+    {
+        unsigned int crc = software[0][n];
+        for (unsigned int k = 1; k < 8; ++k)
+        {
+            crc = software[0][crc & 0xFF] ^ (crc >> 8);
+            software[k][n] = crc;
+        }
+    }
+
+    buildShiftTables(shiftLong, LONG_BLOCK);
+    buildShiftTables(shiftShort, SHORT_BLOCK);
+
+#ifdef HAS_SSE42_CRC32
+    #if defined(_MSC_VER)
+        int info[4];
+        __cpuid(info, 1);
+        bHardware = ((info[2] & (1 << 20)) != 0);
+    #else
+        unsigned int eax, ebx, ecx, edx;
+        if (__get_cpuid(1, &eax, &ebx, &ecx, &edx))
+            bHardware = ((ecx & bit_SSE4_2) != 0);
+    #endif
+#endif
+}
+
+//-----------------------------------------------------------------------
+
+unsigned int tCRC32CTables::multiply(const unsigned int* matrix, unsigned int vector)
+{
+    unsigned int sum = 0;
+
+    while (vector)
+    {
+        if (vector & 1)
+            sum ^= *matrix;
+
+        vector >>= 1;
+        ++matrix;
+    }
+
+    return sum;
+}
+
+//-----------------------------------------------------------------------
+
+void tCRC32CTables::buildShiftTables(unsigned int tables[4][256], size_t nbBytes)
+{
+    unsigned int op[32];
+    unsigned int square[32];
+
+    // Operator shifting a CRC by one zero bit
+    op[0] = CRC32C_POLYNOMIAL;
+    for (unsigned int n = 1; n < 32; ++n)
+        op[n] = 1U << (n - 1);
+
+    // Square it 3 times: operator for one zero byte
+    for (unsigned int i = 0; i < 3; ++i)
+    {
+        for (unsigned int n = 0; n < 32; ++n)
+            square[n] = multiply(op, op[n]);
+
+        memcpy(op, square, sizeof(op));
+    }
+
+    // Combine the operators of the powers of two making nbBytes
+    unsigned int result[32];
+    for (unsigned int n = 0; n < 32; ++n)
+        result[n] = 1U << n;
+
+    while (nbBytes > 0)
+    {
+        if (nbBytes & 1)
+        {
+            for (unsigned int n = 0; n < 32; ++n)
+                square[n] = multiply(op, result[n]);
+
+            memcpy(result, square, sizeof(result));
+        }
+
+        nbBytes >>= 1;
+        if (nbBytes == 0)
+            break;
+
+        for (unsigned int n = 0; n < 32; ++n)
+            square[n] = multiply(op, op[n]);
+
+        memcpy(op, square, sizeof(op));
+    }
+
+    // Tables applying the operator byte by byte
+    for (unsigned int n = 0; n < 256; ++n)
+    {
+        tables[0][n] = multiply(result, n);
+        tables[1][n] = multiply(result, n << 8);
+        tables[2][n] = multiply(result, n << 16);
+        tables[3][n] = multiply(result, n << 24);
+    }
+}
+
+
+/*********************************** STATIC FUNCTIONS ***********************************/
+
+static inline unsigned long long read64(const unsigned char* ptr)
+{
+    unsigned long long value;
+    memcpy(&value, ptr, sizeof(value));
+    return value;
+}
+
+//-----------------------------------------------------------------------
+
+static inline unsigned int read32(const unsigned char* ptr)
+{
+    unsigned int value;
+    memcpy(&value, ptr, sizeof(value));
+    return value;
+}
+
+//-----------------------------------------------------------------------
+
+static inline unsigned long long rotateLeft(unsigned long long value, unsigned int count)
+{
+    return (value << count) | (value >> (64 - count));
+}
+
+//-----------------------------------------------------------------------
+
+static inline unsigned long long hashRound(unsigned long long accumulator,
+                                           unsigned long long input)
+{
+    accumulator += input * PRIME2;
+    accumulator = rotateLeft(accumulator, 31);
+    return accumulator * PRIME1;
+}
+
+//-----------------------------------------------------------------------
+
+static inline unsigned long long mergeRound(unsigned long long hash,
+                                            unsigned long long accumulator)
+{
+    hash ^= hashRound(0, accumulator);
+    return hash * PRIME1 + PRIME4;
+}
+
+//-----------------------------------------------------------------------
+
+/// Process the remaining bytes (less than 32) and mix the bits of the hash
+static unsigned long long finalizeHash(unsigned long long hash, const unsigned char* pData,
+                                       size_t size)
+{
+    while (size >= 8)
+    {
+        hash ^= hashRound(0, read64(pData));
+        hash = rotateLeft(hash, 27) * PRIME1 + PRIME4;
+        pData += 8;
+        size -= 8;
+    }
+
+    if (size >= 4)
+    {
+        hash ^= (unsigned long long) read32(pData) * PRIME1;
+        hash = rotateLeft(hash, 23) * PRIME2 + PRIME3;
+        pData += 4;
+        size -= 4;
+    }
+
+    while (size > 0)
+    {
+        hash ^= (*pData) * PRIME5;
+        hash = rotateLeft(hash, 11) * PRIME1;
+        ++pData;
+        --size;
+    }
+
+    hash ^= hash >> 33;
+    hash *= PRIME2;
+    hash ^= hash >> 29;
+    hash *= PRIME3;
+    hash ^= hash >> 32;
+
+    return hash;
+}
+
+//-----------------------------------------------------------------------
+
+static unsigned int crc32cSoftware(unsigned int crc, const unsigned char* pData, size_t size)
+{
+    unsigned long long crc64 = crc ^ 0xFFFFFFFF;
+
+    while ((size > 0) && (((size_t) pData & 7) != 0))
+    {
+        crc64 = tables.software[0][(crc64 ^ *pData) & 0xFF] ^ (crc64 >> 8);
+        ++pData;
+        --size;
+    }
+
+    while (size >= 8)
+    {
+        crc64 ^= read64(pData);
+        crc64 = tables.software[7][crc64 & 0xFF] ^
+                tables.software[6][(crc64 >> 8) & 0xFF] ^
+                tables.software[5][(crc64 >> 16) & 0xFF] ^
+                tables.software[4][(crc64 >> 24) & 0xFF] ^
+                tables.software[3][(crc64 >> 32) & 0xFF] ^
+                tables.software[2][(crc64 >> 40) & 0xFF] ^
+                tables.software[1][(crc64 >> 48) & 0xFF] ^
+                tables.software[0][crc64 >> 56];
+        pData += 8;
+        size -= 8;
+    }
+
+    while (size > 0)
+    {
+        crc64 = tables.software[0][(crc64 ^ *pData) & 0xFF] ^ (crc64 >> 8);
+        ++pData;
+        --size;
+    }
+
+    return (unsigned int) crc64 ^ 0xFFFFFFFF;
+}
+
+//-----------------------------------------------------------------------
+
+#ifdef HAS_SSE42_CRC32
+
+static inline unsigned int shiftCRC(const unsigned int table[4][256], unsigned int crc)
+{
+    return table[0][crc & 0xFF] ^ table[1][(crc >> 8) & 0xFF] ^
+           table[2][(crc >> 16) & 0xFF] ^ table[3][crc >> 24];
+}
+
+//-----------------------------------------------------------------------
+
+/// Compute the CRC of 3 consecutive blocks in parallel (the latency of the crc32
+/// instruction is 3 cycles, but a new one can start at each cycle), then combine them
+TARGET_SSE42 static inline const unsigned char* crc32cBlocks(unsigned long long& crc0,
+                                                             const unsigned char* pData,
+                                                             size_t blockSize,
+                                                             const unsigned int shift[4][256])
+{
+    unsigned long long crc1 = 0;
+    unsigned long long crc2 = 0;
+    const unsigned char* pEnd = pData + blockSize;
+
+    do
+    {
+        crc0 = _mm_crc32_u64(crc0, read64(pData));
+        crc1 = _mm_crc32_u64(crc1, read64(pData + blockSize));
+        crc2 = _mm_crc32_u64(crc2, read64(pData + 2 * blockSize));
+        pData += 8;
+    }
+    while (pData < pEnd);
+
+    crc0 = shiftCRC(shift, (unsigned int) crc0) ^ crc1;
+    crc0 = shiftCRC(shift, (unsigned int) crc0) ^ crc2;
+
+    return pData + 2 * blockSize;
+}
+
+//-----------------------------------------------------------------------
+
+TARGET_SSE42 static unsigned int crc32cHardware(unsigned int crc, const unsigned char* pData,
+                                                size_t size)
+{
+    unsigned long long crc0 = crc ^ 0xFFFFFFFF;
+
+    while ((size > 0) && (((size_t) pData & 7) != 0))
+    {
+        crc0 = _mm_crc32_u8((unsigned int) crc0, *pData);
+        ++pData;
+        --size;
+    }
+
+    while (size >= 3 * LONG_BLOCK)
+    {
+        pData = crc32cBlocks(crc0, pData, LONG_BLOCK, tables.shiftLong);
+        size -= 3 * LONG_BLOCK;
+    }
+
+    while (size >= 3 * SHORT_BLOCK)
+    {
+        pData = crc32cBlocks(crc0, pData, SHORT_BLOCK, tables.shiftShort);
+        size -= 3 * SHORT_BLOCK;
+    }
+
+    while (size >= 8)
+    {
+        crc0 = _mm_crc32_u64(crc0, read64(pData));
+        pData += 8;
+        size -= 8;
+    }
+
+    while (size > 0)
+    {
+        crc0 = _mm_crc32_u8((unsigned int) crc0, *pData);
+        ++pData;
+        --size;
+    }
+
+    return (unsigned int) crc0 ^ 0xFFFFFFFF;
+}
+
+#endif
+
+
+/************************************ STATIC METHODS ************************************/
+
+unsigned int Checksum::crc32c(const void* pData, size_t size, unsigned int crc)
+{
+    const unsigned char* pBytes = static_cast<const unsigned char*>(pData);
+
+#ifdef HAS_SSE42_CRC32
+    if (tables.bHardware)
+        return crc32cHardware(crc, pBytes, size);
+#endif
+
+    return crc32cSoftware(crc, pBytes, size);
+}
+
+//-----------------------------------------------------------------------
+
+unsigned long long Checksum::hash64(const void* pData, size_t size, unsigned long long seed)
+{
+    const unsigned char* pBytes = static_cast<const unsigned char*>(pData);
+    const unsigned char* pEnd = pBytes + size;
+    unsigned long long hash;
+
+    if (size >= 32)
+    {
+        unsigned long long v1 = seed + PRIME1 + PRIME2;
+        unsigned long long v2 = seed + PRIME2;
+        unsigned long long v3 = seed;
+        unsigned long long v4 = seed - PRIME1;
+
+        const unsigned char* pLimit = pEnd - 32;
+        do
+        {
+            v1 = hashRound(v1, read64(pBytes));
+            v2 = hashRound(v2, read64(pBytes + 8));
+            v3 = hashRound(v3, read64(pBytes + 16));
+            v4 = hashRound(v4, read64(pBytes + 24));
+            pBytes += 32;
+        }
+        while (pBytes <= pLimit);
+
+        hash = rotateLeft(v1, 1) + rotateLeft(v2, 7) + rotateLeft(v3, 12) + rotateLeft(v4, 18);
+        hash = mergeRound(hash, v1);
+        hash = mergeRound(hash, v2);
+        hash = mergeRound(hash, v3);
+        hash = mergeRound(hash, v4);
+    }
+    else
+    {
+        hash = seed + PRIME5;
+    }
+
+    hash += (unsigned long long) size;
+
+    return finalizeHash(hash, pBytes, (size_t) (pEnd - pBytes));
+}
+
+//-----------------------------------------------------------------------
+
+bool Checksum::isCRC32CAccelerated()
+{
+    return tables.bHardware;
+}
+
+
+/****************************** CONSTRUCTION / DESTRUCTION ******************************/
+
+Hash64::Hash64(unsigned long long seed)
+{
+    reset(seed);
+}
+
+
+/*************************************** METHODS ****************************************/
+
+void Hash64::reset(unsigned long long seed)
+{
+    m_accumulators[0] = seed + PRIME1 + PRIME2;
+    m_accumulators[1] = seed + PRIME2;
+    m_accumulators[2] = seed;
+    m_accumulators[3] = seed - PRIME1;
+
+    m_seed = seed;
+    m_totalSize = 0;
+    m_bufferSize = 0;
+}
+
+//-----------------------------------------------------------------------
+
+void Hash64::update(const void* pData, size_t size)
+{
+    const unsigned char* pBytes = static_cast<const unsigned char*>(pData);
+    const unsigned char* pEnd = pBytes + size;
+
+    m_totalSize += size;
+
+    // Complete the pending stripe
+    if (m_bufferSize + size < 32)
+    {
+        if (size > 0)
+            memcpy(m_buffer + m_bufferSize, pBytes, size);
+
+        m_bufferSize += (unsigned int) size;
+        return;
+    }
+
+    if (m_bufferSize > 0)
+    {
+        memcpy(m_buffer + m_bufferSize, pBytes, 32 - m_bufferSize);
+        pBytes += 32 - m_bufferSize;
+
+        for (unsigned int i = 0; i < 4; ++i)
+            m_accumulators[i] = hashRound(m_accumulators[i], read64(m_buffer + i * 8));
+
+        m_bufferSize = 0;
+    }
+
+    // Process the complete stripes
+    while (pEnd - pBytes >= 32)
+    {
+        for (unsigned int i = 0; i < 4; ++i)
+            m_accumulators[i] = hashRound(m_accumulators[i], read64(pBytes + i * 8));
+
+        pBytes += 32;
+    }
+
+    // Keep the rest for later
+    m_bufferSize = (unsigned int) (pEnd - pBytes);
+    if (m_bufferSize > 0)
+        memcpy(m_buffer, pBytes, m_bufferSize);
+}
+
+//-----------------------------------------------------------------------
+
+unsigned long long Hash64::value() const
+{
+    unsigned long long hash;
+
+    if (m_totalSize >= 32)
+    {
+        hash = rotateLeft(m_accumulators[0], 1) + rotateLeft(m_accumulators[1], 7) +
+               rotateLeft(m_accumulators[2], 12) + rotateLeft(m_accumulators[3], 18);
+
+        for (unsigned int i = 0; i < 4; ++i)
+            hash = mergeRound(hash, m_accumulators[i]);
+    }
+    else
+    {
+        hash = m_seed + PRIME5;
+    }
+
+    hash += m_totalSize;
+
+    return finalizeHash(hash, m_buffer, m_bufferSize);
+}
@@ -0,0 +1,166 @@
+/** @file   ChecksumDataStream.cpp
+    @author Philip Abbet
+
+    Implementation of the class 'Athena::Data::ChecksumDataStream'
+*/
+
+#include <Athena-Core/Data/ChecksumDataStream.h>
+
+using namespace Athena::Data;
+
+
+/****************************** CONSTRUCTION / DESTRUCTION ******************************/
+
+ChecksumDataStream::ChecksumDataStream(DataStream* pStream)
+: DataStream(pStream ? pStream->getMode() : READ), m_pStream(pStream), m_crc(0), m_nbBytes(0),
+  m_end(0)
+{
+    assert(pStream);
+
+    m_end = pStream->tell();
+}
+
+//-----------------------------------------------------------------------
+
+ChecksumDataStream::~ChecksumDataStream()
+{
+    close();
+}
+
+
+/*************************************** METHODS ****************************************/
+
+void ChecksumDataStream::reset()
+{
+    m_crc = 0;
+    m_hash.reset();
+    m_nbBytes = 0;
+    m_end = (m_pStream ? m_pStream->tell() : 0);
+}
+
+//-----------------------------------------------------------------------
+
+void ChecksumDataStream::process(size_t position, const void* pData, size_t size)
+{
+    // Only process the data following the one already processed: the data read again
+    // (after a rewind, for instance by getLine()) is ignored
+    size_t offset = 0;
+    if (position < m_end)
+    {
+        if (position + size <= m_end)
+            return;
+
+        offset = m_end - position;
+    }
+
+    const char* pBytes = static_cast<const char*>(pData) + offset;
+
+    m_crc = Checksum::crc32c(pBytes, size - offset, m_crc);
+    m_hash.update(pBytes, size - offset);
+    m_nbBytes += size - offset;
+    m_end = position + size;
+}
+
+//-----------------------------------------------------------------------
+
+size_t ChecksumDataStream::readToEnd()
+{
+    const size_t BUFFER_SIZE = 64 * 1024;
+    char* buffer = new char[BUFFER_SIZE];
+    size_t total = 0;
+    size_t count;
+
+    while ((count = read(buffer, BUFFER_SIZE)) > 0)
+        total += count;
+
+    delete[] buffer;
+
+    return total;
+}
+
+
+/**************************** IMPLEMENTATION OF DataStream ******************************/
+
+size_t ChecksumDataStream::read(void* buf, size_t count)
+{
+    if (!m_pStream)
+        return 0;
+
+    size_t position = m_pStream->tell();
+    size_t nbRead = m_pStream->read(buf, count);
+
+    process(position, buf, nbRead);
+
+    return nbRead;
+}
+
+//-----------------------------------------------------------------------
+
+size_t ChecksumDataStream::write(const void* buf, size_t count)
+{
+    if (!m_pStream)
+        return 0;
+
+    size_t position = m_pStream->tell();
+    size_t nbWritten = m_pStream->write(buf, count);
+
+    process(position, buf, nbWritten);
+
+    return nbWritten;
+}
+
+//-----------------------------------------------------------------------
+
+void ChecksumDataStream::skip(long count)
+{
+    if (m_pStream)
+        m_pStream->skip(count);
+}
+
+//-----------------------------------------------------------------------
+
+void ChecksumDataStream::seek(size_t pos)
+{
+    if (m_pStream)
+        m_pStream->seek(pos);
+}
+
+//-----------------------------------------------------------------------
+
+size_t ChecksumDataStream::tell()
+{
+    return (m_pStream ? m_pStream->tell() : 0);
+}
+
+//-----------------------------------------------------------------------
+
+bool ChecksumDataStream::eof() const
+{
+    return (m_pStream ? m_pStream->eof() : true);
+}
+
+//-----------------------------------------------------------------------
+
+void ChecksumDataStream::close()
+{
+    if (!m_pStream)
+        return;
+
+    m_pStream->close();
+    delete m_pStream;
+    m_pStream = 0;
+}
+
+//-----------------------------------------------------------------------
+
+bool ChecksumDataStream::flush()
+{
+    return (m_pStream ? m_pStream->flush() : false);
+}
+
+//-----------------------------------------------------------------------
+
+bool ChecksumDataStream::sync()
+{
+    return (m_pStream ? m_pStream->sync() : false);
+}
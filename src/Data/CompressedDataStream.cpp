@@ -0,0 +1,520 @@
+/** @file   CompressedDataStream.cpp
+    @author Philip Abbet
+
+    Implementation of the class 'Athena::Data::CompressedDataStream'
+*/
+
+#include <Athena-Core/Data/CompressedDataStream.h>
+#include <Athena-Core/Data/LZCodec.h>
+#include <Athena-Core/Log/LogManager.h>
+#include <string.h>
+#include <algorithm>
+
+using namespace Athena::Data;
+using namespace Athena::Log;
+using namespace std;
+
+
+/************************************** CONSTANTS **************************************/
+
+/// Context used for logging
+static const char* __CONTEXT__ = "Compressed data stream";
+
+/// Magic number of the compressed streams
+static const char MAGIC[4] = { 'A', 'C', 'M', 'P' };
+
+/// Version of the format
+static const unsigned int VERSION = 1;
+
+/// Size of the header
+static const size_t HEADER_SIZE = 32;
+
+/// Size of an entry of the seek table
+static const size_t ENTRY_SIZE = 16;
+
+/// Flag set in the stored size of the blocks that aren't compressed
+static const unsigned int UNCOMPRESSED_FLAG = 0x80000000;
+
+/// Maximum size of the blocks
+static const size_t MAX_BLOCK_SIZE = 16 * 1024 * 1024;
+
+
+/*********************************** STATIC FUNCTIONS ***********************************/
+
+static inline unsigned int readUInt32(const unsigned char* ptr)
+{
+    return (unsigned int) ptr[0] | ((unsigned int) ptr[1] << 8) |
+           ((unsigned int) ptr[2] << 16) | ((unsigned int) ptr[3] << 24);
+}
+
+//-----------------------------------------------------------------------
+
+static inline unsigned long long readUInt64(const unsigned char* ptr)
+{
+    return (unsigned long long) readUInt32(ptr) |
+           ((unsigned long long) readUInt32(ptr + 4) << 32);
+}
+
+//-----------------------------------------------------------------------
+
+static inline void writeUInt32(unsigned char* ptr, unsigned int value)
+{
+    for (int i = 0; i < 4; ++i)
+        ptr[i] = (unsigned char) ((value >> (i * 8)) & 0xFF);
+}
+
+//-----------------------------------------------------------------------
+
+static inline void writeUInt64(unsigned char* ptr, unsigned long long value)
+{
+    writeUInt32(ptr, (unsigned int) (value & 0xFFFFFFFF));
+    writeUInt32(ptr + 4, (unsigned int) (value >> 32));
+}
+
+
+/****************************** CONSTRUCTION / DESTRUCTION ******************************/
+
+CompressedDataStream::CompressedDataStream(DataStream* pStream, tMode mode, size_t blockSize)
+: DataStream(mode), m_pStream(pStream), m_blockSize(blockSize), m_current(-1), m_used(0),
+  m_position(0), m_totalSize(0), m_offset(HEADER_SIZE), m_bValid(false), m_bEOF(false)
+{
+    assert(pStream);
+    assert(mode != READ_WRITE);
+
+    if (mode == WRITE)
+    {
+        assert(blockSize > 0);
+        assert(blockSize <= MAX_BLOCK_SIZE);
+
+        m_block.resize(m_blockSize);
+        m_compressed.resize(LZCodec::maxCompressedSize(m_blockSize));
+
+        // Placeholder, written again once all the blocks are known
+        m_bValid = writeHeader(0);
+    }
+    else
+    {
+        m_bValid = readHeader();
+    }
+}
+
+//-----------------------------------------------------------------------
+
+CompressedDataStream::~CompressedDataStream()
+{
+    close();
+}
+
+
+/*************************************** METHODS ****************************************/
+
+size_t CompressedDataStream::compressedSize() const
+{
+    size_t size = 0;
+
+    for (tBlocksList::const_iterator iter = m_blocks.begin(); iter != m_blocks.end(); ++iter)
+        size += iter->storedSize;
+
+    return size;
+}
+
+//-----------------------------------------------------------------------
+
+bool CompressedDataStream::readHeader()
+{
+    unsigned char header[HEADER_SIZE];
+
+    if ((m_pStream->read(header, HEADER_SIZE) != HEADER_SIZE) ||
+        (memcmp(header, MAGIC, sizeof(MAGIC)) != 0))
+    {
+        ATHENA_LOG_ERROR("Not a compressed stream");
+        return false;
+    }
+
+    if (readUInt32(header + 4) != VERSION)
+    {
+        ATHENA_LOG_ERROR("Unsupported version of compressed stream");
+        return false;
+    }
+
+    m_blockSize = readUInt32(header + 8);
+    unsigned int nbBlocks = readUInt32(header + 12);
+    unsigned long long totalSize = readUInt64(header + 16);
+    unsigned long long tableOffset = readUInt64(header + 24);
+
+    // Each block contains between 1 and m_blockSize bytes
+    if ((m_blockSize == 0) || (m_blockSize > MAX_BLOCK_SIZE) || (nbBlocks > totalSize) ||
+        (totalSize > (unsigned long long) nbBlocks * m_blockSize))
+    {
+        ATHENA_LOG_ERROR("Corrupted header of compressed stream");
+        return false;
+    }
+
+    // Check that the seek table is in the stream before allocating anything: its size
+    // comes from the header, and can't be trusted
+    unsigned long long tableSize = (unsigned long long) nbBlocks * ENTRY_SIZE;
+
+    if (nbBlocks > 0)
+    {
+        unsigned char lastByte;
+
+        if (tableOffset > (unsigned long long) (size_t) -1 - tableSize)
+        {
+            ATHENA_LOG_ERROR("Corrupted header of compressed stream");
+            return false;
+        }
+
+        m_pStream->seek((size_t) (tableOffset + tableSize - 1));
+        if (m_pStream->read(&lastByte, 1) != 1)
+        {
+            ATHENA_LOG_ERROR("Corrupted header of compressed stream");
+            return false;
+        }
+    }
+
+    // Read the seek table
+    std::vector<unsigned char> table((size_t) tableSize);
+
+    if (nbBlocks > 0)
+    {
+        m_pStream->seek((size_t) tableOffset);
+        if (m_pStream->read(&table[0], table.size()) != table.size())
+        {
+            ATHENA_LOG_ERROR("Failed to read the seek table of compressed stream");
+            return false;
+        }
+    }
+
+    m_blocks.resize(nbBlocks);
+
+    size_t position = 0;
+    size_t maxStoredSize = LZCodec::maxCompressedSize(m_blockSize);
+
+    for (unsigned int i = 0; i < nbBlocks; ++i)
+    {
+        const unsigned char* pEntry = &table[i * ENTRY_SIZE];
+        tBlock& block = m_blocks[i];
+
+        unsigned int storedSize = readUInt32(pEntry + 8);
+
+        block.offset        = readUInt64(pEntry);
+        block.position      = position;
+        block.storedSize    = storedSize & ~UNCOMPRESSED_FLAG;
+        block.size          = readUInt32(pEntry + 12);
+        block.bCompressed   = ((storedSize & UNCOMPRESSED_FLAG) == 0);
+
+        if ((block.size == 0) || (block.size > m_blockSize) ||
+            (block.storedSize > maxStoredSize) ||
+            (!block.bCompressed && (block.storedSize != block.size)))
+        {
+            ATHENA_LOG_ERROR("Corrupted seek table of compressed stream");
+            m_blocks.clear();
+            return false;
+        }
+
+        position += block.size;
+    }
+
+    if (position != totalSize)
+    {
+        ATHENA_LOG_ERROR("Corrupted seek table of compressed stream");
+        m_blocks.clear();
+        return false;
+    }
+
+    m_totalSize = position;
+    m_block.resize(m_blockSize);
+    m_compressed.resize(maxStoredSize);
+
+    return true;
+}
+
+//-----------------------------------------------------------------------
+
+bool CompressedDataStream::writeHeader(unsigned long long tableOffset)
+{
+    unsigned char header[HEADER_SIZE];
+
+    memcpy(header, MAGIC, sizeof(MAGIC));
+    writeUInt32(header + 4, VERSION);
+    writeUInt32(header + 8, (unsigned int) m_blockSize);
+    writeUInt32(header + 12, (unsigned int) m_blocks.size());
+    writeUInt64(header + 16, m_totalSize);
+    writeUInt64(header + 24, tableOffset);
+
+    return (m_pStream->write(header, HEADER_SIZE) == HEADER_SIZE);
+}
+
+//-----------------------------------------------------------------------
+
+bool CompressedDataStream::loadBlock(unsigned int index)
+{
+    const tBlock& block = m_blocks[index];
+
+    m_current = -1;
+    m_pStream->seek((size_t) block.offset);
+
+    if (!block.bCompressed)
+    {
+        if (m_pStream->read(&m_block[0], block.size) != block.size)
+        {
+            ATHENA_LOG_ERROR("Failed to read a block of compressed stream");
+            return false;
+        }
+    }
+    else
+    {
+        if ((m_pStream->read(&m_compressed[0], block.storedSize) != block.storedSize) ||
+            !LZCodec::decompress(&m_compressed[0], block.storedSize, &m_block[0], block.size))
+        {
+            ATHENA_LOG_ERROR("Failed to decompress a block of compressed stream");
+            return false;
+        }
+    }
+
+    m_current = (int) index;
+
+    return true;
+}
+
+//-----------------------------------------------------------------------
+
+unsigned int CompressedDataStream::findBlock(size_t position) const
+{
+    // Sequential reads continue in the next block
+    if ((m_current >= 0) && ((size_t) m_current + 1 < m_blocks.size()) &&
+        (m_blocks[m_current + 1].position == position))
+    {
+        return (unsigned int) m_current + 1;
+    }
+
+    // Binary search in the seek table
+    unsigned int first = 0;
+    unsigned int last = (unsigned int) m_blocks.size();
+
+    while (last - first > 1)
+    {
+        unsigned int middle = (first + last) / 2;
+
+        if (m_blocks[middle].position <= position)
+            first = middle;
+        else
+            last = middle;
+    }
+
+    return first;
+}
+
+//-----------------------------------------------------------------------
+
+bool CompressedDataStream::writeBlock()
+{
+    if (m_used == 0)
+        return true;
+
+    tBlock block;
+    block.offset    = m_offset;
+    block.position  = m_totalSize;
+    block.size      = (unsigned int) m_used;
+
+    size_t compressedSize = LZCodec::compress(&m_block[0], m_used, &m_compressed[0],
+                                              m_compressed.size());
+
+    const unsigned char* pData;
+    if ((compressedSize > 0) && (compressedSize < m_used))
+    {
+        pData = &m_compressed[0];
+        block.storedSize = (unsigned int) compressedSize;
+        block.bCompressed = true;
+    }
+    else
+    {
+        pData = &m_block[0];
+        block.storedSize = (unsigned int) m_used;
+        block.bCompressed = false;
+    }
+
+    m_used = 0;
+
+    if (m_pStream->write(pData, block.storedSize) != block.storedSize)
+    {
+        ATHENA_LOG_ERROR("Failed to write a block of compressed stream");
+        m_bValid = false;
+        return false;
+    }
+
+    m_blocks.push_back(block);
+    m_offset += block.storedSize;
+    m_totalSize += block.size;
+
+    return true;
+}
+
+//-----------------------------------------------------------------------
+
+bool CompressedDataStream::finish()
+{
+    if (!writeBlock())
+        return false;
+
+    std::vector<unsigned char> table(m_blocks.size() * ENTRY_SIZE);
+
+    for (unsigned int i = 0; i < m_blocks.size(); ++i)
+    {
+        unsigned char* pEntry = &table[i * ENTRY_SIZE];
+        const tBlock& block = m_blocks[i];
+
+        writeUInt64(pEntry, block.offset);
+        writeUInt32(pEntry + 8, block.storedSize | (block.bCompressed ? 0 : UNCOMPRESSED_FLAG));
+        writeUInt32(pEntry + 12, block.size);
+    }
+
+    if (!table.empty() && (m_pStream->write(&table[0], table.size()) != table.size()))
+        return false;
+
+    m_pStream->seek(0);
+
+    return writeHeader(m_offset) && m_pStream->flush();
+}
+
+
+/**************************** IMPLEMENTATION OF DataStream ******************************/
+
+size_t CompressedDataStream::read(void* buf, size_t count)
+{
+    if (!m_pStream || !m_bValid || ((m_mode & READ) == 0))
+        return 0;
+
+    unsigned char* pDest = static_cast<unsigned char*>(buf);
+    size_t total = 0;
+
+    while (total < count)
+    {
+        if (m_position >= m_totalSize)
+        {
+            m_bEOF = true;
+            break;
+        }
+
+        if ((m_current < 0) || (m_position < m_blocks[m_current].position) ||
+            (m_position >= m_blocks[m_current].position + m_blocks[m_current].size))
+        {
+            if (!loadBlock(findBlock(m_position)))
+            {
+                m_bEOF = true;
+                break;
+            }
+        }
+
+        const tBlock& block = m_blocks[m_current];
+        size_t offset = m_position - block.position;
+        size_t size = std::min(count - total, block.size - offset);
+
+        memcpy(pDest + total, &m_block[offset], size);
+
+        total += size;
+        m_position += size;
+    }
+
+    return total;
+}
+
+//-----------------------------------------------------------------------
+
+size_t CompressedDataStream::write(const void* buf, size_t count)
+{
+    if (!m_pStream || !m_bValid || ((m_mode & WRITE) == 0))
+        return 0;
+
+    const unsigned char* pSrc = static_cast<const unsigned char*>(buf);
+    size_t total = 0;
+
+    while (total < count)
+    {
+        size_t size = std::min(count - total, m_blockSize - m_used);
+        memcpy(&m_block[m_used], pSrc + total, size);
+
+        m_used += size;
+        total += size;
+
+        if ((m_used == m_blockSize) && !writeBlock())
+            break;
+    }
+
+    m_position += total;
+
+    return total;
+}
+
+//-----------------------------------------------------------------------
+
+void CompressedDataStream::skip(long count)
+{
+    if ((m_mode & READ) == 0)
+        return;
+
+    if ((count < 0) && ((size_t) -count > m_position))
+        m_position = 0;
+    else
+        m_position += count;
+
+    m_bEOF = false;
+}
+
+//-----------------------------------------------------------------------
+
+void CompressedDataStream::seek(size_t pos)
+{
+    if ((m_mode & READ) == 0)
+        return;
+
+    m_position = pos;
+    m_bEOF = false;
+}
+
+//-----------------------------------------------------------------------
+
+size_t CompressedDataStream::tell()
+{
+    return m_position;
+}
+
+//-----------------------------------------------------------------------
+
+bool CompressedDataStream::eof() const
+{
+    return m_bEOF;
+}
+
+//-----------------------------------------------------------------------
+
+void CompressedDataStream::close()
+{
+    if (!m_pStream)
+        return;
+
+    if (((m_mode & WRITE) != 0) && m_bValid && !finish())
+        ATHENA_LOG_ERROR("Failed to write the end of the compressed stream");
+
+    m_pStream->close();
+    delete m_pStream;
+    m_pStream = 0;
+    m_current = -1;
+}
+
+//-----------------------------------------------------------------------
+
+bool CompressedDataStream::flush()
+{
+    if (!m_pStream)
+        return false;
+
+    // Nothing is buffered in READ mode
+    if ((m_mode & WRITE) == 0)
+        return true;
+
+    if (!m_bValid)
+        return false;
+
+    return writeBlock() && m_pStream->flush();
+}
@@ -8,6 +8,7 @@
 #include <Athena-Core/Utils/StringUtils.h>
 #include <memory.h>
 #include <string.h>
+#include <algorithm>
 
 using namespace Athena::Data;
 using namespace Athena::Utils;
@@ -19,6 +20,75 @@ using namespace std;
 
 /*************************************** METHODS ****************************************/
 
+size_t DataStream::readv(const tBuffer* buffers, unsigned int nbBuffers)
+{
+    size_t total = 0;
+
+    for (unsigned int i = 0; i < nbBuffers; ++i)
+    {
+        size_t count = read(buffers[i].pData, buffers[i].size);
+        total += count;
+
+        if (count < buffers[i].size)
+            break;
+    }
+
+    return total;
+}
+
+//-----------------------------------------------------------------------
+
+size_t DataStream::writev(const tConstBuffer* buffers, unsigned int nbBuffers)
+{
+    size_t total = 0;
+
+    for (unsigned int i = 0; i < nbBuffers; ++i)
+    {
+        size_t count = write(buffers[i].pData, buffers[i].size);
+        total += count;
+
+        if (count < buffers[i].size)
+            break;
+    }
+
+    return total;
+}
+
+//-----------------------------------------------------------------------
+
+size_t DataStream::writeSwapped(const void* values, size_t count, size_t size)
+{
+    // Assertions
+    assert(size <= ATHENA_STREAM_TEMP_SIZE);
+
+    if ((m_mode & WRITE) == 0)
+        return 0;
+
+    // Swap the values by chunks, in a temporary buffer
+    unsigned char tmpBuf[ATHENA_STREAM_TEMP_SIZE * 8];
+    const size_t chunkCount = sizeof(tmpBuf) / size;
+    const unsigned char* pSrc = static_cast<const unsigned char*>(values);
+    size_t total = 0;
+
+    while (total < count)
+    {
+        size_t nb = std::min(chunkCount, count - total);
+
+        memcpy(tmpBuf, pSrc + total * size, nb * size);
+        swapBytes(tmpBuf, nb, size);
+
+        size_t written = write(tmpBuf, nb * size) / size;
+        total += written;
+
+        if (written < nb)
+            break;
+    }
+
+    return total;
+}
+
+//-----------------------------------------------------------------------
+
 size_t DataStream::readLine(char* buf, size_t maxCount, const string& delim)
 {
     if ((m_mode & READ) == 0)
@@ -158,6 +228,46 @@ size_t DataStream::skipLine(const string& delim)
 
 //-----------------------------------------------------------------------
 
+void DataStream::swapBytes(void* values, size_t count, size_t size)
+{
+    unsigned char* p = static_cast<unsigned char*>(values);
+
+    switch (size)
+    {
+        case 1:
+            break;
+
+        case 2:
+            for (size_t i = 0; i < count; ++i, p += 2)
+                std::swap(p[0], p[1]);
+            break;
+
+        case 4:
+            for (size_t i = 0; i < count; ++i, p += 4)
+            {
+                std::swap(p[0], p[3]);
+                std::swap(p[1], p[2]);
+            }
+            break;
+
+        case 8:
+            for (size_t i = 0; i < count; ++i, p += 8)
+            {
+                std::swap(p[0], p[7]);
+                std::swap(p[1], p[6]);
+                std::swap(p[2], p[5]);
+                std::swap(p[3], p[4]);
+            }
+            break;
+
+        default:
+            for (size_t i = 0; i < count; ++i, p += size)
+                std::reverse(p, p + size);
+    }
+}
+
+//-----------------------------------------------------------------------
+
 template<typename T> DataStream& DataStream::operator>>(T& val)
 {
     if ((m_mode & READ) == 0)
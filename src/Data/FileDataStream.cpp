@@ -5,27 +5,377 @@
 */
 
 #include <Athena-Core/Data/FileDataStream.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <string.h>
+
+#if ATHENA_PLATFORM == ATHENA_PLATFORM_WIN32
+    #ifndef WIN32_LEAN_AND_MEAN
+        #define WIN32_LEAN_AND_MEAN
+    #endif
+    #if !defined(NOMINMAX) && defined(_MSC_VER)
+        #define NOMINMAX
+    #endif
+    #include <windows.h>
+    #include <io.h>
+#else
+    #include <unistd.h>
+    #include <sys/uio.h>
+#endif
 
 using namespace Athena::Data;
 using namespace std;
 
 
+/************************************** CONSTANTS **************************************/
+
+#if ATHENA_PLATFORM == ATHENA_PLATFORM_WIN32
+    #define open_file(PATH, FLAGS)      _open(PATH, (FLAGS) | _O_BINARY, _S_IREAD | _S_IWRITE)
+    #define close_file                  _close
+    #define sync_file                   _commit
+    #define FILE_READ_ONLY              _O_RDONLY
+    #define FILE_WRITE_ONLY             (_O_WRONLY | _O_CREAT | _O_TRUNC)
+    #define FILE_READ_WRITE             _O_RDWR
+#else
+    #define open_file(PATH, FLAGS)      ::open(PATH, (FLAGS) | O_CLOEXEC, 0666)
+    #define close_file                  ::close
+    #define sync_file                   ::fsync
+    #define FILE_READ_ONLY              O_RDONLY
+    #define FILE_WRITE_ONLY             (O_WRONLY | O_CREAT | O_TRUNC)
+    #define FILE_READ_WRITE             O_RDWR
+#endif
+
+#if ATHENA_PLATFORM == ATHENA_PLATFORM_LINUX
+    #define HAS_PREADV
+
+    /// Maximum number of buffers given to one call to preadv() or pwritev()
+    static const unsigned int MAX_VECTORS = 16;
+#endif
+
+/// Maximum number of bytes transferred by one system call
+static const size_t MAX_TRANSFER = 0x40000000;
+
+/// Size of the buffer used by the cursor API: larger transfers bypass it
+static const size_t BUFFER_SIZE = 8192;
+
+
+/*********************************** STATIC FUNCTIONS ***********************************/
+
+/// Read from a file at a given offset, without using (or modifying) its file pointer
+static long readFileAt(int file, void* buf, size_t count, size_t offset)
+{
+#if ATHENA_PLATFORM == ATHENA_PLATFORM_WIN32
+    OVERLAPPED overlapped;
+    memset(&overlapped, 0, sizeof(overlapped));
+    overlapped.Offset       = (DWORD) ((unsigned long long) offset & 0xFFFFFFFF);
+    overlapped.OffsetHigh   = (DWORD) ((unsigned long long) offset >> 32);
+
+    DWORD nbRead = 0;
+    if (!ReadFile((HANDLE) _get_osfhandle(file), buf, (DWORD) count, &nbRead, &overlapped))
+        return (GetLastError() == ERROR_HANDLE_EOF ? 0 : -1);
+
+    return (long) nbRead;
+#else
+    return (long) ::pread(file, buf, count, (off_t) offset);
+#endif
+}
+
+//-----------------------------------------------------------------------
+
+/// Write to a file at a given offset, without using (or modifying) its file pointer
+static long writeFileAt(int file, const void* buf, size_t count, size_t offset)
+{
+#if ATHENA_PLATFORM == ATHENA_PLATFORM_WIN32
+    OVERLAPPED overlapped;
+    memset(&overlapped, 0, sizeof(overlapped));
+    overlapped.Offset       = (DWORD) ((unsigned long long) offset & 0xFFFFFFFF);
+    overlapped.OffsetHigh   = (DWORD) ((unsigned long long) offset >> 32);
+
+    DWORD nbWritten = 0;
+    if (!WriteFile((HANDLE) _get_osfhandle(file), buf, (DWORD) count, &nbWritten, &overlapped))
+        return -1;
+
+    return (long) nbWritten;
+#else
+    return (long) ::pwrite(file, buf, count, (off_t) offset);
+#endif
+}
+
+//-----------------------------------------------------------------------
+
+/// Indicates if a failed transfer was interrupted by a signal, and must be retried. The
+/// Windows functions are never interrupted, and don't set errno.
+static inline bool isInterrupted()
+{
+#if ATHENA_PLATFORM == ATHENA_PLATFORM_WIN32
+    return false;
+#else
+    return (errno == EINTR);
+#endif
+}
+
+//-----------------------------------------------------------------------
+
+/// Write all the bytes to a file at a given offset, without using (or modifying) its file
+/// pointer
+static size_t writeAll(int file, const void* buf, size_t count, size_t offset)
+{
+    const char* pSrc = static_cast<const char*>(buf);
+    size_t total = 0;
+
+    while (total < count)
+    {
+        long result = writeFileAt(file, pSrc + total, std::min(count - total, MAX_TRANSFER),
+                                  offset + total);
+        if (result < 0)
+        {
+            if (isInterrupted())
+                continue;
+            break;
+        }
+        else if (result == 0)
+        {
+            break;
+        }
+
+        total += (size_t) result;
+    }
+
+    return total;
+}
+
+//-----------------------------------------------------------------------
+
+/// Called after a partial transfer of a list of buffers, to find where the next one must
+/// start
+static inline void advance(const size_t* sizes, size_t stride, unsigned int nbBuffers,
+                           size_t transferred, unsigned int& first, size_t& offset)
+{
+    while ((transferred > 0) && (first < nbBuffers))
+    {
+        size_t available = *(const size_t*) ((const char*) sizes + first * stride) - offset;
+        if (transferred < available)
+        {
+            offset += transferred;
+            return;
+        }
+
+        transferred -= available;
+        ++first;
+        offset = 0;
+    }
+}
+
+
 /****************************** CONSTRUCTION / DESTRUCTION ******************************/
 
 FileDataStream::FileDataStream(const std::string& strFileName, tMode mode)
-: DataStream(mode)
+: DataStream(mode), m_position(0), m_bEOF(false), m_pBuffer(0), m_bufferOffset(0),
+  m_bufferSize(0), m_bBufferDirty(false)
 {
-    m_stream.open(strFileName.c_str(), ios::binary |
-                                       (mode == READ ? ios::in :
-                                                       (mode == WRITE ? ios::out :
-                                                                        ios::in | ios::out)));
+    m_file = open_file(strFileName.c_str(), (mode == READ ? FILE_READ_ONLY :
+                                             (mode == WRITE ? FILE_WRITE_ONLY :
+                                                              FILE_READ_WRITE)));
 }
 
 //-----------------------------------------------------------------------
 
 FileDataStream::~FileDataStream()
 {
-    m_stream.close();
+    close();
+    delete[] m_pBuffer;
+}
+
+
+/*************************************** METHODS ****************************************/
+
+size_t FileDataStream::readAt(size_t offset, void* buf, size_t count) const
+{
+    if (((m_mode & READ) == 0) || (m_file < 0))
+        return 0;
+
+    char* pDest = static_cast<char*>(buf);
+    size_t total = 0;
+
+    while (total < count)
+    {
+        long result = readFileAt(m_file, pDest + total, std::min(count - total, MAX_TRANSFER),
+                                 offset + total);
+        if (result < 0)
+        {
+            if (isInterrupted())
+                continue;
+            break;
+        }
+        else if (result == 0)
+        {
+            break;
+        }
+
+        total += (size_t) result;
+    }
+
+    return total;
+}
+
+//-----------------------------------------------------------------------
+
+size_t FileDataStream::writeAt(size_t offset, const void* buf, size_t count)
+{
+    if (((m_mode & WRITE) == 0) || (m_file < 0))
+        return 0;
+
+    // Keep the buffer of the cursor API consistent with the file
+    if (!flush())
+        return 0;
+
+    m_bufferSize = 0;
+
+    return writeAll(m_file, buf, count, offset);
+}
+
+//-----------------------------------------------------------------------
+
+size_t FileDataStream::readvAt(size_t offset, const tBuffer* buffers,
+                               unsigned int nbBuffers) const
+{
+    if (((m_mode & READ) == 0) || (m_file < 0))
+        return 0;
+
+    size_t total = 0;
+
+#ifdef HAS_PREADV
+    unsigned int first = 0;
+    size_t bufferOffset = 0;    // Number of bytes already read in the first buffer
+
+    while (first < nbBuffers)
+    {
+        // Skip the empty buffers
+        if (buffers[first].size == bufferOffset)
+        {
+            ++first;
+            bufferOffset = 0;
+            continue;
+        }
+
+        struct iovec vectors[MAX_VECTORS];
+        unsigned int nb = 0;
+
+        vectors[0].iov_base = static_cast<char*>(buffers[first].pData) + bufferOffset;
+        vectors[0].iov_len  = buffers[first].size - bufferOffset;
+
+        for (nb = 1; (nb < MAX_VECTORS) && (first + nb < nbBuffers); ++nb)
+        {
+            vectors[nb].iov_base = buffers[first + nb].pData;
+            vectors[nb].iov_len  = buffers[first + nb].size;
+        }
+
+        ssize_t result = ::preadv(m_file, vectors, (int) nb, (off_t) (offset + total));
+        if (result < 0)
+        {
+            if (isInterrupted())
+                continue;
+            break;
+        }
+        else if (result == 0)
+        {
+            break;
+        }
+
+        total += (size_t) result;
+
+        advance(&buffers[0].size, sizeof(tBuffer), nbBuffers, (size_t) result, first,
+                bufferOffset);
+    }
+#else
+    for (unsigned int i = 0; i < nbBuffers; ++i)
+    {
+        size_t count = readAt(offset + total, buffers[i].pData, buffers[i].size);
+        total += count;
+
+        if (count < buffers[i].size)
+            break;
+    }
+#endif
+
+    return total;
+}
+
+//-----------------------------------------------------------------------
+
+size_t FileDataStream::writevAt(size_t offset, const tConstBuffer* buffers,
+                                unsigned int nbBuffers)
+{
+    if (((m_mode & WRITE) == 0) || (m_file < 0))
+        return 0;
+
+    // Keep the buffer of the cursor API consistent with the file
+    if (!flush())
+        return 0;
+
+    m_bufferSize = 0;
+
+    size_t total = 0;
+
+#ifdef HAS_PREADV
+    unsigned int first = 0;
+    size_t bufferOffset = 0;    // Number of bytes already written from the first buffer
+
+    while (first < nbBuffers)
+    {
+        // Skip the empty buffers
+        if (buffers[first].size == bufferOffset)
+        {
+            ++first;
+            bufferOffset = 0;
+            continue;
+        }
+
+        struct iovec vectors[MAX_VECTORS];
+        unsigned int nb = 0;
+
+        const char* pData = static_cast<const char*>(buffers[first].pData);
+
+        vectors[0].iov_base = const_cast<char*>(pData) + bufferOffset;
+        vectors[0].iov_len  = buffers[first].size - bufferOffset;
+
+        for (nb = 1; (nb < MAX_VECTORS) && (first + nb < nbBuffers); ++nb)
+        {
+            vectors[nb].iov_base = const_cast<void*>(buffers[first + nb].pData);
+            vectors[nb].iov_len  = buffers[first + nb].size;
+        }
+
+        ssize_t result = ::pwritev(m_file, vectors, (int) nb, (off_t) (offset + total));
+        if (result < 0)
+        {
+            if (isInterrupted())
+                continue;
+            break;
+        }
+        else if (result == 0)
+        {
+            break;
+        }
+
+        total += (size_t) result;
+
+        advance(&buffers[0].size, sizeof(tConstBuffer), nbBuffers, (size_t) result, first,
+                bufferOffset);
+    }
+#else
+    for (unsigned int i = 0; i < nbBuffers; ++i)
+    {
+        size_t count = writeAt(offset + total, buffers[i].pData, buffers[i].size);
+        total += count;
+
+        if (count < buffers[i].size)
+            break;
+    }
+#endif
+
+    return total;
 }
 
 
@@ -33,58 +383,200 @@ FileDataStream::~FileDataStream()
 
 size_t FileDataStream::read(void* buf, size_t count)
 {
-    if ((m_mode & READ) == 0)
+    if (((m_mode & READ) == 0) || (m_file < 0))
         return 0;
 
-    m_stream.read(static_cast<char*>(buf), static_cast<std::streamsize>(count));
-    return (size_t) m_stream.gcount();
+    if (m_bBufferDirty)
+        flush();
+
+    char* pDest = static_cast<char*>(buf);
+    size_t total = 0;
+
+    // Copy the bytes already in the buffer
+    if ((m_position >= m_bufferOffset) && (m_position < m_bufferOffset + m_bufferSize))
+    {
+        total = std::min(count, m_bufferOffset + m_bufferSize - m_position);
+        memcpy(pDest, m_pBuffer + (m_position - m_bufferOffset), total);
+    }
+
+    if (total < count)
+    {
+        size_t remaining = count - total;
+
+        if (remaining >= BUFFER_SIZE)
+        {
+            // Large transfers go directly to the destination
+            total += readAt(m_position + total, pDest + total, remaining);
+        }
+        else
+        {
+            if (!m_pBuffer)
+                m_pBuffer = new unsigned char[BUFFER_SIZE];
+
+            m_bufferOffset = m_position + total;
+            m_bufferSize = readAt(m_bufferOffset, m_pBuffer, BUFFER_SIZE);
+
+            size_t nb = std::min(remaining, m_bufferSize);
+            memcpy(pDest + total, m_pBuffer, nb);
+            total += nb;
+        }
+    }
+
+    m_position += total;
+    if (total < count)
+        m_bEOF = true;
+
+    return total;
 }
 
 //-----------------------------------------------------------------------
 
 size_t FileDataStream::write(const void* buf, size_t count)
 {
-    if ((m_mode & WRITE) == 0)
+    if (((m_mode & WRITE) == 0) || (m_file < 0))
         return 0;
 
-    m_stream.write(static_cast<const char*>(buf), static_cast<std::streamsize>(count));
-    return count;
+    // The bytes are only appended to the pending ones if they follow them; otherwise the
+    // buffer is emptied (this also drops the bytes read in advance)
+    if (!m_bBufferDirty || (m_position != m_bufferOffset + m_bufferSize) ||
+        (m_bufferSize + count > BUFFER_SIZE))
+    {
+        if (!flush())
+            return 0;
+
+        m_bufferSize = 0;
+    }
+
+    size_t total = count;
+
+    if (count >= BUFFER_SIZE)
+    {
+        // Large transfers go directly to the file
+        total = writeAll(m_file, buf, count, m_position);
+    }
+    else
+    {
+        if (!m_pBuffer)
+            m_pBuffer = new unsigned char[BUFFER_SIZE];
+
+        if (m_bufferSize == 0)
+            m_bufferOffset = m_position;
+
+        memcpy(m_pBuffer + m_bufferSize, buf, count);
+        m_bufferSize += count;
+        m_bBufferDirty = true;
+    }
+
+    m_position += total;
+
+    return total;
+}
+
+//-----------------------------------------------------------------------
+
+size_t FileDataStream::readv(const tBuffer* buffers, unsigned int nbBuffers)
+{
+    if (m_bBufferDirty)
+        flush();
+
+    size_t count = 0;
+    for (unsigned int i = 0; i < nbBuffers; ++i)
+        count += buffers[i].size;
+
+    size_t total = readvAt(m_position, buffers, nbBuffers);
+
+    m_position += total;
+    if (total < count)
+        m_bEOF = true;
+
+    return total;
+}
+
+//-----------------------------------------------------------------------
+
+size_t FileDataStream::writev(const tConstBuffer* buffers, unsigned int nbBuffers)
+{
+    size_t total = writevAt(m_position, buffers, nbBuffers);
+    m_position += total;
+
+    return total;
 }
 
 //-----------------------------------------------------------------------
 
 void FileDataStream::skip(long count)
 {
-    m_stream.clear();
-    m_stream.seekg(static_cast<std::ifstream::pos_type>(count), std::ios::cur);
+    if ((count < 0) && ((size_t) -count > m_position))
+        m_position = 0;
+    else
+        m_position += count;
+
+    m_bEOF = false;
+
+    if (m_bBufferDirty)
+        flush();
 }
 
 //-----------------------------------------------------------------------
 
 void FileDataStream::seek(size_t pos)
 {
-    m_stream.clear();
-    m_stream.seekg(static_cast<std::streamoff>(pos), std::ios::beg);
+    m_position = pos;
+    m_bEOF = false;
+
+    if (m_bBufferDirty)
+        flush();
 }
 
 //-----------------------------------------------------------------------
 
 size_t FileDataStream::tell()
 {
-    m_stream.clear();
-    return (size_t) m_stream.tellg();
+    return m_position;
 }
 
 //-----------------------------------------------------------------------
 
 bool FileDataStream::eof() const
 {
-    return m_stream.eof();
+    return m_bEOF;
 }
 
 //-----------------------------------------------------------------------
 
 void FileDataStream::close()
 {
-    m_stream.close();
+    if (m_file >= 0)
+    {
+        flush();
+        close_file(m_file);
+        m_file = -1;
+    }
+}
+
+//-----------------------------------------------------------------------
+
+bool FileDataStream::flush()
+{
+    if (!m_bBufferDirty)
+        return true;
+
+    bool bSuccess = (writeAll(m_file, m_pBuffer, m_bufferSize, m_bufferOffset) == m_bufferSize);
+
+    m_bufferSize = 0;
+    m_bBufferDirty = false;
+
+    return bSuccess;
+}
+
+//-----------------------------------------------------------------------
+
+bool FileDataStream::sync()
+{
+    if (((m_mode & WRITE) == 0) || (m_file < 0))
+        return false;
+
+    bool bSuccess = flush();
+
+    return (sync_file(m_file) == 0) && bSuccess;
 }
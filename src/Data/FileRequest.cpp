@@ -0,0 +1,212 @@
+/** @file   FileRequest.cpp
+    @author Philip Abbet
+
+    Implementation of the class 'Athena::Data::FileRequest'
+*/
+
+#include <Athena-Core/Data/FileRequest.h>
+#include <Athena-Core/Data/MemoryDataStream.h>
+#include <Athena-Core/Data/SharedBuffer.h>
+
+#if ATHENA_PLATFORM == ATHENA_PLATFORM_WIN32
+    #include <windows.h>
+#else
+    #include <sys/types.h>
+    #include <sys/stat.h>
+    #include <fcntl.h>
+    #include <unistd.h>
+    #include <errno.h>
+#endif
+
+using namespace Athena::Data;
+using namespace Athena::Utils;
+using namespace std;
+
+
+/****************************** CONSTRUCTION / DESTRUCTION ******************************/
+
+FileRequest::FileRequest(const std::string& strPath)
+: m_strPath(strPath), m_state(PENDING), m_pStream(0), m_nbRefs(1)
+{
+}
+
+//-----------------------------------------------------------------------
+
+FileRequest::FileRequest(const std::string& strPath, MemoryDataStream* pStream)
+: m_strPath(strPath), m_state(pStream ? SUCCEEDED : FAILED), m_pStream(pStream),
+  m_nbRefs(1)
+{
+}
+
+//-----------------------------------------------------------------------
+
+FileRequest::~FileRequest()
+{
+    delete m_pStream;
+}
+
+
+/*************************************** METHODS ****************************************/
+
+void FileRequest::addRef()
+{
+    ScopedLock lock(m_mutex);
+    ++m_nbRefs;
+}
+
+//-----------------------------------------------------------------------
+
+void FileRequest::release()
+{
+    bool bDestroy;
+
+    {
+        ScopedLock lock(m_mutex);
+
+        assert(m_nbRefs > 0);
+        bDestroy = (--m_nbRefs == 0);
+    }
+
+    if (bDestroy)
+        delete this;
+}
+
+//-----------------------------------------------------------------------
+
+FileRequest::tState FileRequest::state()
+{
+    ScopedLock lock(m_mutex);
+    return m_state;
+}
+
+//-----------------------------------------------------------------------
+
+FileRequest::tState FileRequest::wait()
+{
+    ScopedLock lock(m_mutex);
+
+    while (m_state == PENDING)
+        m_completed.wait(m_mutex);
+
+    return m_state;
+}
+
+//-----------------------------------------------------------------------
+
+MemoryDataStream* FileRequest::createStream()
+{
+    ScopedLock lock(m_mutex);
+
+    while (m_state == PENDING)
+        m_completed.wait(m_mutex);
+
+    if (!m_pStream)
+        return 0;
+
+    return m_pStream->slice(0);
+}
+
+//-----------------------------------------------------------------------
+
+void FileRequest::execute()
+{
+    SharedBuffer* pBuffer = 0;
+
+#if ATHENA_PLATFORM == ATHENA_PLATFORM_WIN32
+    HANDLE hFile = CreateFileA(m_strPath.c_str(), GENERIC_READ, FILE_SHARE_READ, 0,
+                               OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, 0);
+    if (hFile != INVALID_HANDLE_VALUE)
+    {
+        LARGE_INTEGER size;
+        if (GetFileSizeEx(hFile, &size))
+        {
+            pBuffer = SharedBuffer::create((size_t) size.QuadPart);
+
+            size_t offset = 0;
+            while (offset < pBuffer->size())
+            {
+                DWORD count = (DWORD) std::min(pBuffer->size() - offset, (size_t) 0x40000000);
+                DWORD nbRead = 0;
+                if (!ReadFile(hFile, pBuffer->writableData() + offset, count, &nbRead, 0) || (nbRead == 0))
+                    break;
+
+                offset += nbRead;
+            }
+
+            if (offset != pBuffer->size())
+            {
+                pBuffer->release();
+                pBuffer = 0;
+            }
+        }
+
+        CloseHandle(hFile);
+    }
+#else
+    int fd = ::open(m_strPath.c_str(), O_RDONLY);
+    if (fd >= 0)
+    {
+        struct stat info;
+        if ((fstat(fd, &info) == 0) && S_ISREG(info.st_mode))
+        {
+#ifdef POSIX_FADV_SEQUENTIAL
+            // Let the kernel read ahead the whole file
+            posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+            posix_fadvise(fd, 0, 0, POSIX_FADV_WILLNEED);
+#endif
+
+            pBuffer = SharedBuffer::create((size_t) info.st_size);
+
+            size_t offset = 0;
+            while (offset < pBuffer->size())
+            {
+                ssize_t count = ::read(fd, pBuffer->writableData() + offset, pBuffer->size() - offset);
+                if (count < 0)
+                {
+                    if (errno == EINTR)
+                        continue;
+                    break;
+                }
+                else if (count == 0)
+                {
+                    break;
+                }
+
+                offset += (size_t) count;
+            }
+
+            if (offset != pBuffer->size())
+            {
+                pBuffer->release();
+                pBuffer = 0;
+            }
+        }
+
+        ::close(fd);
+    }
+#endif
+
+    MemoryDataStream* pStream = 0;
+    if (pBuffer)
+    {
+        pStream = new MemoryDataStream(pBuffer);
+        pBuffer->release();
+    }
+
+    // Note: no logging here, the log manager can only be used from the main thread
+    complete(pStream);
+}
+
+//-----------------------------------------------------------------------
+
+void FileRequest::complete(MemoryDataStream* pStream)
+{
+    ScopedLock lock(m_mutex);
+
+    assert(m_state == PENDING);
+
+    m_pStream = pStream;
+    m_state = (pStream ? SUCCEEDED : FAILED);
+
+    m_completed.broadcast();
+}
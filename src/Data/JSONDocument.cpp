@@ -0,0 +1,41 @@
+/** @file   JSONDocument.cpp
+    @author Philip Abbet
+
+    Implementation of the class 'Athena::Data::JSONDocument'
+*/
+
+#include <Athena-Core/Data/JSONDocument.h>
+#include <Athena-Core/Data/Serialization.h>
+
+using namespace Athena::Data;
+using namespace Athena::Utils;
+
+
+/****************************** CONSTRUCTION / DESTRUCTION ******************************/
+
+JSONDocument* JSONDocument::create()
+{
+    return new JSONDocument();
+}
+
+//-----------------------------------------------------------------------
+
+JSONDocument::JSONDocument()
+{
+}
+
+//-----------------------------------------------------------------------
+
+JSONDocument::~JSONDocument()
+{
+}
+
+
+/*************************************** METHODS ****************************************/
+
+void JSONDocument::convert(const void* pValue, Variant& value) const
+{
+    assert(pValue);
+
+    fromJSON(*static_cast<const rapidjson::Value*>(pValue), &value);
+}
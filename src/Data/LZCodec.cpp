@@ -0,0 +1,245 @@
+/** @file   LZCodec.cpp
+    @author Philip Abbet
+
+    Implementation of the class 'Athena::Data::LZCodec'
+*/
+
+#include <Athena-Core/Data/LZCodec.h>
+#include <string.h>
+
+using namespace Athena::Data;
+
+
+/************************************** CONSTANTS **************************************/
+
+const size_t LZCodec::MAX_OFFSET;
+
+/// Minimum length of a match
+static const size_t MIN_MATCH = 4;
+
+/// Number of bits of the hash of a 4-byte prefix
+static const unsigned int HASH_BITS = 12;
+
+/// Value of a length field meaning that the length continues in the next bytes
+static const unsigned int LENGTH_MASK = 15;
+
+
+/*********************************** STATIC FUNCTIONS ***********************************/
+
+static inline unsigned int read32(const unsigned char* ptr)
+{
+    unsigned int value;
+    memcpy(&value, ptr, sizeof(value));
+    return value;
+}
+
+//-----------------------------------------------------------------------
+
+static inline unsigned int hashPrefix(unsigned int value)
+{
+    return (value * 2654435761U) >> (32 - HASH_BITS);
+}
+
+//-----------------------------------------------------------------------
+
+/// Write the extension bytes of a length (the part exceeding the 4 bits of the token)
+static inline bool writeLength(unsigned char*& pDest, const unsigned char* pDestEnd,
+                               size_t length)
+{
+    while (length >= 255)
+    {
+        if (pDest >= pDestEnd)
+            return false;
+
+        *pDest++ = 255;
+        length -= 255;
+    }
+
+    if (pDest >= pDestEnd)
+        return false;
+
+    *pDest++ = (unsigned char) length;
+    return true;
+}
+
+//-----------------------------------------------------------------------
+
+/// Read the extension bytes of a length
+static inline bool readLength(const unsigned char*& pSrc, const unsigned char* pSrcEnd,
+                              size_t& length)
+{
+    unsigned char value;
+
+    do
+    {
+        if (pSrc >= pSrcEnd)
+            return false;
+
+        value = *pSrc++;
+        length += value;
+    }
+    while (value == 255);
+
+    return true;
+}
+
+//-----------------------------------------------------------------------
+
+/// Write a sequence (literals followed by a match, or only literals if matchLength is 0)
+static bool writeSequence(unsigned char*& pDest, const unsigned char* pDestEnd,
+                          const unsigned char* pLiterals, size_t nbLiterals,
+                          size_t offset, size_t matchLength)
+{
+    if (pDest >= pDestEnd)
+        return false;
+
+    unsigned char* pToken = pDest++;
+    size_t matchCode = (matchLength > 0 ? matchLength - MIN_MATCH : 0);
+
+    *pToken = (unsigned char) (((nbLiterals >= LENGTH_MASK ? LENGTH_MASK : nbLiterals) << 4) |
+                               (matchCode >= LENGTH_MASK ? LENGTH_MASK : matchCode));
+
+    if ((nbLiterals >= LENGTH_MASK) && !writeLength(pDest, pDestEnd, nbLiterals - LENGTH_MASK))
+        return false;
+
+    if ((size_t) (pDestEnd - pDest) < nbLiterals)
+        return false;
+
+    memcpy(pDest, pLiterals, nbLiterals);
+    pDest += nbLiterals;
+
+    if (matchLength == 0)
+        return true;
+
+    if (pDestEnd - pDest < 2)
+        return false;
+
+    *pDest++ = (unsigned char) (offset & 0xFF);
+    *pDest++ = (unsigned char) (offset >> 8);
+
+    if ((matchCode >= LENGTH_MASK) && !writeLength(pDest, pDestEnd, matchCode - LENGTH_MASK))
+        return false;
+
+    return true;
+}
+
+
+/************************************ STATIC METHODS ************************************/
+
+size_t LZCodec::compress(const void* pSrc, size_t srcSize, void* pDest, size_t destCapacity)
+{
+    const unsigned char* src = static_cast<const unsigned char*>(pSrc);
+    unsigned char* dest = static_cast<unsigned char*>(pDest);
+    unsigned char* pOut = dest;
+    const unsigned char* pOutEnd = dest + destCapacity;
+
+    // Position (+1) of the last occurrence of each hashed 4-byte prefix, 0 if none
+    unsigned int table[1 << HASH_BITS];
+    memset(table, 0, sizeof(table));
+
+    size_t anchor = 0;      // Start of the pending literals
+    size_t pos = 0;
+
+    while (pos + MIN_MATCH <= srcSize)
+    {
+        unsigned int prefix = read32(src + pos);
+        unsigned int h = hashPrefix(prefix);
+        size_t candidate = table[h];
+        table[h] = (unsigned int) pos + 1;
+
+        if ((candidate == 0) || (pos - (candidate - 1) > MAX_OFFSET) ||
+            (read32(src + candidate - 1) != prefix))
+        {
+            // Skip faster in the data that doesn't compress
+            pos += 1 + ((pos - anchor) >> 6);
+            continue;
+        }
+
+        size_t match = candidate - 1;
+        size_t length = MIN_MATCH;
+
+        while ((pos + length < srcSize) && (src[match + length] == src[pos + length]))
+            ++length;
+
+        if (!writeSequence(pOut, pOutEnd, src + anchor, pos - anchor, pos - match, length))
+            return 0;
+
+        pos += length;
+        anchor = pos;
+
+        // Remember a position inside the match, to improve the ratio of repetitive data
+        if (pos + MIN_MATCH <= srcSize)
+            table[hashPrefix(read32(src + pos - 2))] = (unsigned int) (pos - 2) + 1;
+    }
+
+    if (!writeSequence(pOut, pOutEnd, src + anchor, srcSize - anchor, 0, 0))
+        return 0;
+
+    return (size_t) (pOut - dest);
+}
+
+//-----------------------------------------------------------------------
+
+bool LZCodec::decompress(const void* pSrc, size_t srcSize, void* pDest, size_t destSize)
+{
+    const unsigned char* pIn = static_cast<const unsigned char*>(pSrc);
+    const unsigned char* pInEnd = pIn + srcSize;
+    unsigned char* dest = static_cast<unsigned char*>(pDest);
+    unsigned char* pOut = dest;
+    unsigned char* pOutEnd = dest + destSize;
+
+    while (pIn < pInEnd)
+    {
+        unsigned char token = *pIn++;
+
+        // Literals
+        size_t nbLiterals = token >> 4;
+        if ((nbLiterals == LENGTH_MASK) && !readLength(pIn, pInEnd, nbLiterals))
+            return false;
+
+        if (((size_t) (pInEnd - pIn) < nbLiterals) || ((size_t) (pOutEnd - pOut) < nbLiterals))
+            return false;
+
+        memcpy(pOut, pIn, nbLiterals);
+        pIn += nbLiterals;
+        pOut += nbLiterals;
+
+        // The last sequence doesn't have a match
+        if (pIn == pInEnd)
+            break;
+
+        // Match
+        if (pInEnd - pIn < 2)
+            return false;
+
+        size_t offset = (size_t) pIn[0] | ((size_t) pIn[1] << 8);
+        pIn += 2;
+
+        size_t length = token & LENGTH_MASK;
+        if ((length == LENGTH_MASK) && !readLength(pIn, pInEnd, length))
+            return false;
+
+        length += MIN_MATCH;
+
+        if ((offset == 0) || (offset > (size_t) (pOut - dest)) ||
+            ((size_t) (pOutEnd - pOut) < length))
+        {
+            return false;
+        }
+
+        const unsigned char* pMatch = pOut - offset;
+        if (offset >= length)
+        {
+            memcpy(pOut, pMatch, length);
+            pOut += length;
+        }
+        else
+        {
+            // Overlapping copy (repeated pattern)
+            for (size_t i = 0; i < length; ++i)
+                *pOut++ = *pMatch++;
+        }
+    }
+
+    return (pOut == pOutEnd);
+}
@@ -6,9 +6,38 @@
 
 #include <Athena-Core/Data/LocationManager.h>
 #include <Athena-Core/Data/FileDataStream.h>
+#include <Athena-Core/Data/MemoryDataStream.h>
+#include <Athena-Core/Data/PackFile.h>
+#include <Athena-Core/Data/FileRequest.h>
+#include <Athena-Core/Utils/Thread.h>
+#include <Athena-Core/Utils/Condition.h>
+#include <Athena-Core/Utils/Metrics.h>
+#include <Athena-Core/Utils/Timer.h>
 #include <Athena-Core/Log/LogManager.h>
 #include <sys/types.h>
 #include <sys/stat.h>
+#include <set>
+#include <deque>
+#include <algorithm>
+
+#if ATHENA_PLATFORM == ATHENA_PLATFORM_WIN32
+    #ifndef WIN32_LEAN_AND_MEAN
+        #define WIN32_LEAN_AND_MEAN
+    #endif
+    #if !defined(NOMINMAX) && defined(_MSC_VER)
+        #define NOMINMAX
+    #endif
+    #include <windows.h>
+#else
+    #include <dirent.h>
+    #include <unistd.h>
+#endif
+
+#if ATHENA_PLATFORM == ATHENA_PLATFORM_LINUX
+    #include <sys/inotify.h>
+    #include <fcntl.h>
+    #include <errno.h>
+#endif
 
 using namespace Athena::Data;
 using namespace Athena::Log;
@@ -28,10 +57,309 @@ namespace Athena {
     }
 }
 
+/// Maximum number of files not found remembered by a group (any name can be searched, so
+/// they are forgotten once that number is reached)
+static const unsigned int MAX_FILES_NOT_FOUND = 1024;
+
+#if ATHENA_PLATFORM == ATHENA_PLATFORM_LINUX
+/// Events that invalidate the content of a watched directory
+static const uint32_t WATCHED_EVENTS = IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO |
+                                       IN_DELETE_SELF | IN_MOVE_SELF;
+#endif
+
+
+/*************************************** METRICS ****************************************/
+
+static Counter g_nbLookups("locations.lookups", "Number of files looked for");
+static Counter g_nbNotFound("locations.not_found", "Number of files not found");
+static Counter g_nbOpened("locations.opened", "Number of files opened");
+static Histogram g_openTime("locations.open_time_us", "Time taken to open a file (in microseconds)");
+
+
+/*********************************** STATIC FUNCTIONS ***********************************/
+
+typedef std::map<std::string, int>                      tIndex;
+typedef std::vector<std::string>                        tDirectoriesList;
+typedef std::set<std::pair<unsigned long long, unsigned long long> >  tVisitedSet;
+
+//-----------------------------------------------------------------------
+
+static inline bool isSeparator(char c)
+{
+#if ATHENA_PLATFORM == ATHENA_PLATFORM_WIN32
+    return (c == '/') || (c == '\\');
+#else
+    return (c == '/');
+#endif
+}
+
+//-----------------------------------------------------------------------
+
+/// Returns the key used in the index for a file name
+static inline string indexKey(const string& strFileName)
+{
+#if ATHENA_PLATFORM == ATHENA_PLATFORM_WIN32
+    // The file system is case-insensitive
+    string strKey = strFileName;
+    for (size_t i = 0; i < strKey.size(); ++i)
+    {
+        if ((strKey[i] >= 'A') && (strKey[i] <= 'Z'))
+            strKey[i] += 'a' - 'A';
+    }
+    return strKey;
+#else
+    return strFileName;
+#endif
+}
+
+//-----------------------------------------------------------------------
+
+/// Indicates if a file name is written exactly as it would appear in the index (no
+/// redundant separators, no '.' or '..' component, ...)
+static bool isIndexable(const string& strFileName)
+{
+    if (strFileName.empty() || isSeparator(strFileName[0]) ||
+        isSeparator(strFileName[strFileName.size() - 1]))
+    {
+        return false;
+    }
+
+#if ATHENA_PLATFORM == ATHENA_PLATFORM_WIN32
+    if (strFileName.find_first_of("\\:") != string::npos)
+        return false;
+#endif
+
+    size_t start = 0;
+    while (start < strFileName.size())
+    {
+        size_t end = strFileName.find('/', start);
+        if (end == string::npos)
+            end = strFileName.size();
+
+        size_t length = end - start;
+        if ((length == 0) ||
+            ((length == 1) && (strFileName[start] == '.')) ||
+            ((length == 2) && (strFileName[start] == '.') && (strFileName[start + 1] == '.')))
+        {
+            return false;
+        }
+
+        start = end + 1;
+    }
+
+    return true;
+}
+
+//-----------------------------------------------------------------------
+
+/// Recursively add the content of a directory to an index. The files already in the index
+/// are left untouched (the first location containing a file wins).
+static bool scanDirectory(const string& strRoot, const string& strRelativePath, int location,
+                          tIndex& index, tDirectoriesList& directories, tVisitedSet& visited)
+{
+    string strDirectory = strRoot + strRelativePath;
+
+#if ATHENA_PLATFORM == ATHENA_PLATFORM_WIN32
+    WIN32_FIND_DATAA entry;
+    HANDLE hFind = FindFirstFileA((strDirectory + "*").c_str(), &entry);
+    if (hFind == INVALID_HANDLE_VALUE)
+        return false;
+
+    directories.push_back(strDirectory);
+
+    do
+    {
+        string strName = entry.cFileName;
+        if ((strName == ".") || (strName == ".."))
+            continue;
+
+        index.insert(make_pair(indexKey(strRelativePath + strName), location));
+
+        if ((entry.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) &&
+            !(entry.dwFileAttributes & FILE_ATTRIBUTE_REPARSE_POINT))
+        {
+            scanDirectory(strRoot, strRelativePath + strName + "/", location, index,
+                          directories, visited);
+        }
+    }
+    while (FindNextFileA(hFind, &entry));
+
+    FindClose(hFind);
+#else
+    struct stat info;
+    if ((stat(strDirectory.c_str(), &info) != 0) || !S_ISDIR(info.st_mode))
+        return false;
+
+    // Protection against symbolic links loops
+    if (!visited.insert(make_pair((unsigned long long) info.st_dev,
+                                  (unsigned long long) info.st_ino)).second)
+    {
+        return true;
+    }
+
+    DIR* pDir = opendir(strDirectory.c_str());
+    if (!pDir)
+        return false;
+
+    directories.push_back(strDirectory);
+
+    struct dirent* pEntry;
+    while ((pEntry = readdir(pDir)) != 0)
+    {
+        string strName = pEntry->d_name;
+        if ((strName == ".") || (strName == ".."))
+            continue;
+
+        index.insert(make_pair(strRelativePath + strName, location));
+
+        bool bDirectory = false;
+
+#ifdef _DIRENT_HAVE_D_TYPE
+        if (pEntry->d_type == DT_DIR)
+            bDirectory = true;
+        else if ((pEntry->d_type == DT_LNK) || (pEntry->d_type == DT_UNKNOWN))
+#endif
+            bDirectory = (stat((strDirectory + strName).c_str(), &info) == 0) && S_ISDIR(info.st_mode);
+
+        if (bDirectory)
+        {
+            scanDirectory(strRoot, strRelativePath + strName + "/", location, index,
+                          directories, visited);
+        }
+    }
+
+    closedir(pDir);
+#endif
+
+    return true;
+}
+
+
+/************************************ IOThreadPool *************************************/
+
+namespace Athena {
+namespace Data {
+
+//----------------------------------------------------------------------------------------
+/// @brief  Pool of threads loading files in memory
+//----------------------------------------------------------------------------------------
+class IOThreadPool
+{
+public:
+    IOThreadPool(unsigned int nbThreads)
+    : m_bStopping(false)
+    {
+        for (unsigned int i = 0; i < nbThreads; ++i)
+        {
+            Worker* pWorker = new Worker(this);
+            if (pWorker->start())
+                m_workers.push_back(pWorker);
+            else
+                delete pWorker;
+        }
+
+        if (m_workers.empty())
+            ATHENA_LOG_ERROR("Failed to start the I/O threads, the files will be loaded synchronously");
+    }
+
+    ~IOThreadPool()
+    {
+        {
+            ScopedLock lock(m_mutex);
+            m_bStopping = true;
+            m_wakeUp.broadcast();
+        }
+
+        for (std::vector<Worker*>::iterator iter = m_workers.begin(); iter != m_workers.end(); ++iter)
+        {
+            (*iter)->join();
+            delete *iter;
+        }
+
+        // Cancel the requests not processed yet
+        while (!m_requests.empty())
+        {
+            m_requests.front()->complete(0);
+            m_requests.front()->release();
+            m_requests.pop_front();
+        }
+    }
+
+    void submit(FileRequest* pRequest)
+    {
+        pRequest->addRef();
+
+        if (m_workers.empty())
+        {
+            pRequest->execute();
+            pRequest->release();
+            return;
+        }
+
+        ScopedLock lock(m_mutex);
+        m_requests.push_back(pRequest);
+        m_wakeUp.signal();
+    }
+
+private:
+    class Worker: public Thread
+    {
+    public:
+        Worker(IOThreadPool* pPool)
+        : m_pPool(pPool)
+        {
+        }
+
+    protected:
+        virtual void run()
+        {
+            m_pPool->process();
+        }
+
+    private:
+        IOThreadPool* m_pPool;
+    };
+
+    void process()
+    {
+        while (true)
+        {
+            FileRequest* pRequest;
+
+            {
+                ScopedLock lock(m_mutex);
+
+                while (m_requests.empty() && !m_bStopping)
+                    m_wakeUp.wait(m_mutex);
+
+                if (m_bStopping)
+                    return;
+
+                pRequest = m_requests.front();
+                m_requests.pop_front();
+            }
+
+            pRequest->execute();
+            pRequest->release();
+        }
+    }
+
+private:
+    std::vector<Worker*>        m_workers;
+    std::deque<FileRequest*>    m_requests;
+    Mutex                       m_mutex;
+    Condition                   m_wakeUp;
+    bool                        m_bStopping;
+};
+
+}
+}
+
 
 /****************************** CONSTRUCTION / DESTRUCTION ******************************/
 
 LocationManager::LocationManager()
+: m_notifications(-1), m_pIOThreadPool(0), m_nbIOThreads(2)
 {
 }
 
@@ -39,6 +367,24 @@ LocationManager::LocationManager()
 
 LocationManager::~LocationManager()
 {
+    setAutoRefresh(false);
+
+    for (tRequestsMap::iterator iter = m_prefetched.begin(); iter != m_prefetched.end(); ++iter)
+        iter->second->release();
+
+    delete m_pIOThreadPool;
+
+    tGroupsNativeIterator iter, iterEnd;
+    for (iter = m_groups.begin(), iterEnd = m_groups.end(); iter != iterEnd; ++iter)
+    {
+        std::vector<PackFile*>::iterator iterPack, iterPackEnd;
+        for (iterPack = iter->second.packs.begin(), iterPackEnd = iter->second.packs.end();
+             iterPack != iterPackEnd; ++iterPack)
+        {
+            if (*iterPack)
+                (*iterPack)->release();
+        }
+    }
 }
 
 //-----------------------------------------------------------------------
@@ -106,11 +452,33 @@ void LocationManager::addLocation(const std::string& strGroup, const std::string
     assert(!strLocation.empty());
 
     // Ensure that the group exists
-    if (m_groups.find(strGroup) == m_groups.end())
-        m_groups[strGroup] = tLocationsList();
+    tGroupsNativeIterator iter = m_groups.find(strGroup);
+    if (iter == m_groups.end())
+    {
+        tGroup group;
+        group.nbNotFound    = 0;
+        group.bIndexed      = false;
+        group.bFullyIndexed = false;
+
+        iter = m_groups.insert(make_pair(strGroup, group)).first;
+    }
+
+    // Pack file?
+    PackFile* pPackFile = 0;
+    struct stat fileInfo;
+    if ((stat(strLocation.c_str(), &fileInfo) == 0) && ((fileInfo.st_mode & S_IFMT) == S_IFREG))
+    {
+        pPackFile = PackFile::load(strLocation);
+        if (!pPackFile)
+            ATHENA_LOG_WARNING("The location '" + strLocation + "' is a file, but not a valid pack file");
+    }
 
     // Add the location to the group
-    m_groups[strGroup].push_back(strLocation);
+    iter->second.locations.push_back(strLocation);
+    iter->second.packs.push_back(pPackFile);
+
+    // The known content of the group isn't valid anymore
+    refresh(strGroup);
 
     ATHENA_LOG_COMMENT("Location '" + strLocation + "' added to group '" + strGroup + "'");
 }
@@ -124,40 +492,80 @@ std::string LocationManager::path(const std::string& strGroup, const std::string
     assert(!strGroup.empty());
     assert(!strFileName.empty());
 
-    // Ensure that the group exists
-    tGroupsNativeIterator group = m_groups.find(strGroup);
-    if (group == m_groups.end())
-        return "";
+    g_nbLookups.increment();
 
-    // Search for the file in each location
-    struct stat fileInfo;
-    tLocationsIterator iter = tLocationsIterator(group->second.begin(), group->second.end());
-    while (iter.hasMoreElements())
+    int location;
+    tGroup* pGroup = findFile(strGroup, strFileName, location);
+    if (!pGroup || (location < 0))
     {
-        string strLocation = iter.getNext();
-
-        if (stat((strLocation + strFileName).c_str(), &fileInfo) == 0)
-            return strLocation + strFileName;
+        g_nbNotFound.increment();
+        return "";
     }
 
-    return "";
+    if (pGroup->packs[location])
+        return pGroup->locations[location] + "/" + strFileName;
+
+    return pGroup->locations[location] + strFileName;
 }
 
 //-----------------------------------------------------------------------
 
 DataStream* LocationManager::open(const std::string& strGroup, const std::string& strFileName)
 {
+    // Assertions
+    assert(getSingletonPtr());
+    assert(!strGroup.empty());
+    assert(!strFileName.empty());
+
+    Timer timer;
+
+    // Already loaded (or being loaded) by the I/O threads?
+    tRequestsMap::iterator iter = m_prefetched.find(make_pair(strGroup, strFileName));
+    if (iter != m_prefetched.end())
+    {
+        DataStream* pStream = iter->second->createStream();
+        if (pStream)
+        {
+            g_nbOpened.increment();
+            g_openTime.record(timer.getMicroseconds());
+            return pStream;
+        }
+    }
+
     // Find the file
-    string strPath = path(strGroup, strFileName);
-    if (strPath.empty())
+    g_nbLookups.increment();
+
+    int location;
+    tGroup* pGroup = findFile(strGroup, strFileName, location);
+    if (!pGroup || (location < 0))
+    {
+        g_nbNotFound.increment();
         return 0;
+    }
 
-    // Open it
-    FileDataStream* pStream = new FileDataStream(strPath, DataStream::READ);
-    if (!pStream->isOpen())
+    DataStream* pStream = 0;
+
+    // Files in a pack file are read from its memory mapping
+    if (pGroup->packs[location])
     {
-        delete pStream;
-        pStream = 0;
+        pStream = pGroup->packs[location]->open(strFileName);
+    }
+    else
+    {
+        // Open it
+        pStream = new FileDataStream(pGroup->locations[location] + strFileName,
+                                     DataStream::READ);
+        if (!static_cast<FileDataStream*>(pStream)->isOpen())
+        {
+            delete pStream;
+            pStream = 0;
+        }
+    }
+
+    if (pStream)
+    {
+        g_nbOpened.increment();
+        g_openTime.record(timer.getMicroseconds());
     }
 
     return pStream;
@@ -165,6 +573,84 @@ DataStream* LocationManager::open(const std::string& strGroup, const std::string
 
 //-----------------------------------------------------------------------
 
+FileRequest* LocationManager::openAsync(const std::string& strGroup,
+                                        const std::string& strFileName)
+{
+    // Assertions
+    assert(getSingletonPtr());
+    assert(!strGroup.empty());
+    assert(!strFileName.empty());
+
+    // Already prefetched?
+    tRequestsMap::iterator iter = m_prefetched.find(make_pair(strGroup, strFileName));
+    if (iter != m_prefetched.end())
+    {
+        iter->second->addRef();
+        return iter->second;
+    }
+
+    // Find the file
+    int location;
+    tGroup* pGroup = findFile(strGroup, strFileName, location);
+    if (!pGroup || (location < 0))
+        return 0;
+
+    // Files in a pack file don't need to be loaded
+    if (pGroup->packs[location])
+    {
+        return new FileRequest(pGroup->locations[location] + "/" + strFileName,
+                               pGroup->packs[location]->open(strFileName));
+    }
+
+    FileRequest* pRequest = new FileRequest(pGroup->locations[location] + strFileName);
+
+    if (!m_pIOThreadPool)
+        m_pIOThreadPool = new IOThreadPool(m_nbIOThreads);
+
+    m_pIOThreadPool->submit(pRequest);
+
+    return pRequest;
+}
+
+//-----------------------------------------------------------------------
+
+void LocationManager::prefetch(const std::string& strGroup, const tFilesList& files)
+{
+    // Assertions
+    assert(getSingletonPtr());
+    assert(!strGroup.empty());
+
+    tFilesList::const_iterator iter, iterEnd;
+    for (iter = files.begin(), iterEnd = files.end(); iter != iterEnd; ++iter)
+    {
+        if (m_prefetched.find(make_pair(strGroup, *iter)) != m_prefetched.end())
+            continue;
+
+        FileRequest* pRequest = openAsync(strGroup, *iter);
+        if (pRequest)
+            m_prefetched[make_pair(strGroup, *iter)] = pRequest;
+    }
+}
+
+//-----------------------------------------------------------------------
+
+void LocationManager::setNbIOThreads(unsigned int nbThreads)
+{
+    // Assertions
+    assert(getSingletonPtr());
+    assert(nbThreads > 0);
+
+    if (m_pIOThreadPool)
+    {
+        ATHENA_LOG_WARNING("The number of I/O threads can't be changed once they are started");
+        return;
+    }
+
+    m_nbIOThreads = nbThreads;
+}
+
+//-----------------------------------------------------------------------
+
 LocationManager::tLocationsList LocationManager::locations(const std::string& strGroup) const
 {
     // Assertions
@@ -176,7 +662,7 @@ LocationManager::tLocationsList LocationManager::locations(const std::string& st
     if (group == m_groups.end())
         return tLocationsList();
 
-    return group->second;
+    return group->second.locations;
 }
 
 //-----------------------------------------------------------------------
@@ -195,3 +681,284 @@ LocationManager::tGroupsList LocationManager::groups() const
 
     return list;
 }
+
+//-----------------------------------------------------------------------
+
+void LocationManager::refresh()
+{
+    // Assertions
+    assert(getSingletonPtr());
+
+    tGroupsNativeIterator iter, iterEnd;
+    for (iter = m_groups.begin(), iterEnd = m_groups.end(); iter != iterEnd; ++iter)
+        refresh(iter->first);
+}
+
+//-----------------------------------------------------------------------
+
+void LocationManager::refresh(const std::string& strGroup)
+{
+    // Assertions
+    assert(getSingletonPtr());
+    assert(!strGroup.empty());
+
+    tGroupsNativeIterator iter = m_groups.find(strGroup);
+    if (iter == m_groups.end())
+        return;
+
+    iter->second.files.clear();
+    iter->second.nbNotFound     = 0;
+    iter->second.bIndexed       = false;
+    iter->second.bFullyIndexed  = false;
+
+#if ATHENA_PLATFORM == ATHENA_PLATFORM_LINUX
+    // Stop watching the directories of the group (they are watched again when it is
+    // scanned)
+    tWatchesMap::iterator iterWatch = m_watches.begin();
+    while (iterWatch != m_watches.end())
+    {
+        std::vector<std::string>& groups = iterWatch->second;
+        groups.erase(std::remove(groups.begin(), groups.end(), strGroup), groups.end());
+
+        if (groups.empty())
+        {
+            inotify_rm_watch(m_notifications, iterWatch->first);
+            m_watches.erase(iterWatch++);
+        }
+        else
+        {
+            ++iterWatch;
+        }
+    }
+#endif
+
+    // Drop the prefetched files
+    tRequestsMap::iterator iterRequest = m_prefetched.lower_bound(make_pair(strGroup, string()));
+    while ((iterRequest != m_prefetched.end()) && (iterRequest->first.first == strGroup))
+    {
+        iterRequest->second->release();
+        m_prefetched.erase(iterRequest++);
+    }
+}
+
+//-----------------------------------------------------------------------
+
+bool LocationManager::setAutoRefresh(bool bEnabled)
+{
+    if (bEnabled == (m_notifications >= 0))
+        return true;
+
+#if ATHENA_PLATFORM == ATHENA_PLATFORM_LINUX
+    if (bEnabled)
+    {
+        m_notifications = inotify_init();
+        if (m_notifications < 0)
+        {
+            ATHENA_LOG_WARNING("Failed to enable the auto-refresh mode (inotify not available)");
+            return false;
+        }
+
+        fcntl(m_notifications, F_SETFL, fcntl(m_notifications, F_GETFL) | O_NONBLOCK);
+        fcntl(m_notifications, F_SETFD, FD_CLOEXEC);
+
+        // The groups must be scanned again to watch their directories
+        refresh();
+    }
+    else
+    {
+        close(m_notifications);
+        m_notifications = -1;
+        m_watches.clear();
+    }
+
+    return true;
+#else
+    if (bEnabled)
+        ATHENA_LOG_WARNING("The auto-refresh mode isn't supported on this platform");
+
+    return !bEnabled;
+#endif
+}
+
+
+/*********************************** INTERNAL METHODS ***********************************/
+
+LocationManager::tGroup* LocationManager::findFile(const std::string& strGroup,
+                                                   const std::string& strFileName,
+                                                   int& location)
+{
+    location = -1;
+
+    // Ensure that the group exists
+    tGroupsNativeIterator group = m_groups.find(strGroup);
+    if (group == m_groups.end())
+        return 0;
+
+    if (m_notifications >= 0)
+        processNotifications();
+
+    if (!group->second.bIndexed)
+        indexGroup(group->first, group->second);
+
+    location = resolve(group->second, strFileName);
+
+    return &group->second;
+}
+
+//-----------------------------------------------------------------------
+
+
+void LocationManager::indexGroup(const std::string& strGroup, tGroup& group)
+{
+    group.files.clear();
+    group.nbNotFound    = 0;
+    group.bIndexed      = true;
+    group.bFullyIndexed = true;
+
+    tIndex              index;
+    tDirectoriesList    directories;
+
+    for (int i = 0; i < (int) group.locations.size(); ++i)
+    {
+        const string& strLocation = group.locations[i];
+
+        if (group.packs[i])
+        {
+            PackFile* pPackFile = group.packs[i];
+            for (unsigned int j = 0; j < pPackFile->nbEntries(); ++j)
+                index.insert(make_pair(indexKey(pPackFile->entryName(j)), i));
+
+            continue;
+        }
+
+        // Only the locations ending with a separator can be scanned: the others are
+        // concatenated with the file names, which can result in a path outside of them
+        tVisitedSet visited;
+        if (!isSeparator(strLocation[strLocation.size() - 1]) ||
+            !scanDirectory(strLocation, "", i, index, directories, visited))
+        {
+            group.bFullyIndexed = false;
+        }
+    }
+
+    // If one location can't be scanned, the index can't be trusted (a file found in a
+    // location might be hidden by a file in a location before it)
+    if (group.bFullyIndexed)
+        group.files.swap(index);
+
+#if ATHENA_PLATFORM == ATHENA_PLATFORM_LINUX
+    if (m_notifications >= 0)
+    {
+        tDirectoriesList::iterator iter, iterEnd;
+        for (iter = directories.begin(), iterEnd = directories.end(); iter != iterEnd; ++iter)
+        {
+            int wd = inotify_add_watch(m_notifications, iter->c_str(), WATCHED_EVENTS);
+            if (wd < 0)
+                continue;
+
+            std::vector<std::string>& groups = m_watches[wd];
+            if (std::find(groups.begin(), groups.end(), strGroup) == groups.end())
+                groups.push_back(strGroup);
+        }
+    }
+#endif
+}
+
+//-----------------------------------------------------------------------
+
+int LocationManager::resolve(tGroup& group, const std::string& strFileName)
+{
+    bool bIndexable = isIndexable(strFileName);
+    string strKey = (bIndexable ? indexKey(strFileName) : strFileName);
+
+    // Already known?
+    tFilesNativeIterator iter = group.files.find(strKey);
+    if (iter != group.files.end())
+        return iter->second;
+
+    // If the file name can't be found in the index, it doesn't exist
+    if (group.bFullyIndexed && bIndexable)
+        return -1;
+
+    // Search for the file in each location
+    int location = -1;
+    struct stat fileInfo;
+    for (int i = 0; i < (int) group.locations.size(); ++i)
+    {
+        if (group.packs[i] ? group.packs[i]->contains(strFileName) :
+                             (stat((group.locations[i] + strFileName).c_str(), &fileInfo) == 0))
+        {
+            location = i;
+            break;
+        }
+    }
+
+    // Remember the result, even if the file wasn't found
+    if (location < 0)
+    {
+        if (group.nbNotFound >= MAX_FILES_NOT_FOUND)
+        {
+            tFilesNativeIterator iterFile = group.files.begin();
+            while (iterFile != group.files.end())
+            {
+                if (iterFile->second < 0)
+                    group.files.erase(iterFile++);
+                else
+                    ++iterFile;
+            }
+
+            group.nbNotFound = 0;
+        }
+
+        ++group.nbNotFound;
+    }
+
+    group.files[strKey] = location;
+
+    return location;
+}
+
+//-----------------------------------------------------------------------
+
+void LocationManager::processNotifications()
+{
+#if ATHENA_PLATFORM == ATHENA_PLATFORM_LINUX
+    char buffer[4096] __attribute__((aligned(__alignof__(struct inotify_event))));
+
+    while (true)
+    {
+        ssize_t length = read(m_notifications, buffer, sizeof(buffer));
+        if (length <= 0)
+            break;
+
+        for (char* ptr = buffer; ptr < buffer + length; )
+        {
+            const struct inotify_event* pEvent = (const struct inotify_event*) ptr;
+
+            if (pEvent->mask & IN_Q_OVERFLOW)
+            {
+                // Some events were lost
+                refresh();
+            }
+            else
+            {
+                tWatchesMap::iterator iter = m_watches.find(pEvent->wd);
+                if (iter != m_watches.end())
+                {
+                    // Copied, since refreshing a group removes its watches
+                    std::vector<std::string> groups = iter->second;
+
+                    std::vector<std::string>::iterator iterGroup, iterGroupEnd;
+                    for (iterGroup = groups.begin(), iterGroupEnd = groups.end();
+                         iterGroup != iterGroupEnd; ++iterGroup)
+                    {
+                        refresh(*iterGroup);
+                    }
+                }
+            }
+
+            ptr += sizeof(struct inotify_event) + pEvent->len;
+        }
+    }
+#endif
+}
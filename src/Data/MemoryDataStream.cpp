@@ -0,0 +1,137 @@
+/** @file   MemoryDataStream.cpp
+    @author Philip Abbet
+
+    Implementation of the class 'Athena::Data::MemoryDataStream'
+*/
+
+#include <Athena-Core/Data/MemoryDataStream.h>
+#include <Athena-Core/Data/SharedBuffer.h>
+#include <string.h>
+
+using namespace Athena::Data;
+using namespace std;
+
+
+/****************************** CONSTRUCTION / DESTRUCTION ******************************/
+
+MemoryDataStream::MemoryDataStream(const void* pData, size_t size)
+: DataStream(READ), m_pBuffer(0), m_pData(static_cast<const unsigned char*>(pData)),
+  m_size(size), m_pos(0), m_bEOF(false)
+{
+}
+
+//-----------------------------------------------------------------------
+
+MemoryDataStream::MemoryDataStream(unsigned char* pData, size_t size, tOwnership ownership)
+: DataStream(READ), m_pBuffer(0), m_pData(pData), m_size(size), m_pos(0), m_bEOF(false)
+{
+    // An owned buffer is shared with the slices
+    if (ownership == TAKE_OWNERSHIP)
+        m_pBuffer = SharedBuffer::wrap(pData, size);
+}
+
+//-----------------------------------------------------------------------
+
+MemoryDataStream::MemoryDataStream(SharedBuffer* pBuffer, size_t offset, size_t size)
+: DataStream(READ), m_pBuffer(pBuffer), m_pos(0), m_bEOF(false)
+{
+    // Assertions
+    assert(pBuffer);
+
+    offset = std::min(offset, pBuffer->size());
+
+    m_pData = pBuffer->data() + offset;
+    m_size  = std::min(size, pBuffer->size() - offset);
+
+    m_pBuffer->addRef();
+}
+
+//-----------------------------------------------------------------------
+
+MemoryDataStream::~MemoryDataStream()
+{
+    close();
+}
+
+
+/*************************************** METHODS ****************************************/
+
+MemoryDataStream* MemoryDataStream::slice(size_t offset, size_t size) const
+{
+    offset = std::min(offset, m_size);
+    size = std::min(size, m_size - offset);
+
+    if (m_pBuffer)
+        return new MemoryDataStream(m_pBuffer, (m_pData - m_pBuffer->data()) + offset, size);
+
+    return new MemoryDataStream(m_pData + offset, size);
+}
+
+
+/**************************** IMPLEMENTATION OF DataStream ******************************/
+
+size_t MemoryDataStream::read(void* buf, size_t count)
+{
+    if (count > m_size - m_pos)
+    {
+        count = m_size - m_pos;
+        m_bEOF = true;
+    }
+
+    if (count > 0)
+    {
+        memcpy(buf, m_pData + m_pos, count);
+        m_pos += count;
+    }
+
+    return count;
+}
+
+//-----------------------------------------------------------------------
+
+void MemoryDataStream::skip(long count)
+{
+    if ((count < 0) && ((size_t) -count > m_pos))
+        m_pos = 0;
+    else
+        m_pos = std::min(m_pos + count, m_size);
+
+    m_bEOF = false;
+}
+
+//-----------------------------------------------------------------------
+
+void MemoryDataStream::seek(size_t pos)
+{
+    m_pos = std::min(pos, m_size);
+    m_bEOF = false;
+}
+
+//-----------------------------------------------------------------------
+
+size_t MemoryDataStream::tell()
+{
+    return m_pos;
+}
+
+//-----------------------------------------------------------------------
+
+bool MemoryDataStream::eof() const
+{
+    return m_bEOF;
+}
+
+//-----------------------------------------------------------------------
+
+void MemoryDataStream::close()
+{
+    if (m_pBuffer)
+    {
+        m_pBuffer->release();
+        m_pBuffer = 0;
+    }
+
+    m_pData = 0;
+    m_size  = 0;
+    m_pos   = 0;
+}
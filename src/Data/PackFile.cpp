@@ -0,0 +1,616 @@
+/** @file   PackFile.cpp
+    @author Philip Abbet
+
+    Implementation of the class 'Athena::Data::PackFile'
+*/
+
+#include <Athena-Core/Data/PackFile.h>
+#include <Athena-Core/Data/MemoryDataStream.h>
+#include <Athena-Core/Data/FileDataStream.h>
+#include <Athena-Core/Data/Checksum.h>
+#include <Athena-Core/Log/LogManager.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <string.h>
+#include <stdio.h>
+#include <algorithm>
+
+#if ATHENA_PLATFORM == ATHENA_PLATFORM_WIN32
+    #ifndef WIN32_LEAN_AND_MEAN
+        #define WIN32_LEAN_AND_MEAN
+    #endif
+    #if !defined(NOMINMAX) && defined(_MSC_VER)
+        #define NOMINMAX
+    #endif
+    #include <windows.h>
+#else
+    #include <dirent.h>
+    #include <fcntl.h>
+    #include <unistd.h>
+    #include <sys/mman.h>
+#endif
+
+using namespace Athena::Data;
+using namespace Athena::Log;
+using namespace std;
+
+
+/************************************** CONSTANTS **************************************/
+
+/// Context used for logging
+static const char* __CONTEXT__ = "Pack file";
+
+/// Magic number of the pack files
+static const char MAGIC[4] = { 'A', 'P', 'A', 'K' };
+
+/// Version of the file format
+static const unsigned int VERSION = 1;
+
+/// Size of the header
+static const size_t HEADER_SIZE = 32;
+
+/// Size of an entry of the table of contents
+static const size_t ENTRY_SIZE = 32;
+
+/// Alignment of the content of the files
+static const size_t ALIGNMENT = 16;
+
+
+/*********************************** STATIC FUNCTIONS ***********************************/
+
+static inline unsigned int readUInt32(const unsigned char* ptr)
+{
+    return (unsigned int) ptr[0] | ((unsigned int) ptr[1] << 8) |
+           ((unsigned int) ptr[2] << 16) | ((unsigned int) ptr[3] << 24);
+}
+
+//-----------------------------------------------------------------------
+
+static inline unsigned long long readUInt64(const unsigned char* ptr)
+{
+    return (unsigned long long) readUInt32(ptr) |
+           ((unsigned long long) readUInt32(ptr + 4) << 32);
+}
+
+//-----------------------------------------------------------------------
+
+static inline void writeUInt32(std::string& buffer, unsigned int value)
+{
+    for (int i = 0; i < 4; ++i)
+        buffer += (char) ((value >> (i * 8)) & 0xFF);
+}
+
+//-----------------------------------------------------------------------
+
+static inline void writeUInt64(std::string& buffer, unsigned long long value)
+{
+    writeUInt32(buffer, (unsigned int) (value & 0xFFFFFFFF));
+    writeUInt32(buffer, (unsigned int) (value >> 32));
+}
+
+//-----------------------------------------------------------------------
+
+static inline size_t align(size_t value)
+{
+    return (value + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+}
+
+//-----------------------------------------------------------------------
+
+/// Indicates if two paths designate the same existing file
+static bool isSameFile(const string& strPath1, const string& strPath2)
+{
+#if ATHENA_PLATFORM == ATHENA_PLATFORM_WIN32
+    char path1[MAX_PATH];
+    char path2[MAX_PATH];
+
+    if (!_fullpath(path1, strPath1.c_str(), MAX_PATH) ||
+        !_fullpath(path2, strPath2.c_str(), MAX_PATH))
+    {
+        return false;
+    }
+
+    return (_stricmp(path1, path2) == 0);
+#else
+    struct stat info1;
+    struct stat info2;
+
+    if ((stat(strPath1.c_str(), &info1) != 0) || (stat(strPath2.c_str(), &info2) != 0))
+        return false;
+
+    return (info1.st_dev == info2.st_dev) && (info1.st_ino == info2.st_ino);
+#endif
+}
+
+//-----------------------------------------------------------------------
+
+/// List the files of a directory (and of its sub-directories), except the one designated
+/// by strExcluded
+static bool listFiles(const string& strRoot, const string& strRelativePath,
+                      const string& strExcluded, vector<string>& files,
+                      vector<unsigned long long>& sizes)
+{
+    string strDirectory = strRoot + strRelativePath;
+    string strExcludedName = strExcluded.substr(strExcluded.find_last_of("/\\") + 1);
+
+#if ATHENA_PLATFORM == ATHENA_PLATFORM_WIN32
+    WIN32_FIND_DATAA entry;
+    HANDLE hFind = FindFirstFileA((strDirectory + "*").c_str(), &entry);
+    if (hFind == INVALID_HANDLE_VALUE)
+        return false;
+
+    do
+    {
+        string strName = entry.cFileName;
+        if ((strName == ".") || (strName == ".."))
+            continue;
+
+        if (entry.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY)
+        {
+            if (!(entry.dwFileAttributes & FILE_ATTRIBUTE_REPARSE_POINT))
+                listFiles(strRoot, strRelativePath + strName + "/", strExcluded, files, sizes);
+        }
+        else if ((_stricmp(strName.c_str(), strExcludedName.c_str()) != 0) ||
+                 !isSameFile(strDirectory + strName, strExcluded))
+        {
+            files.push_back(strRelativePath + strName);
+            sizes.push_back(((unsigned long long) entry.nFileSizeHigh << 32) | entry.nFileSizeLow);
+        }
+    }
+    while (FindNextFileA(hFind, &entry));
+
+    FindClose(hFind);
+#else
+    DIR* pDir = opendir(strDirectory.c_str());
+    if (!pDir)
+        return false;
+
+    struct dirent* pEntry;
+    while ((pEntry = readdir(pDir)) != 0)
+    {
+        string strName = pEntry->d_name;
+        if ((strName == ".") || (strName == ".."))
+            continue;
+
+        // Symbolic links to directories aren't followed (to avoid loops)
+        struct stat info;
+        if (lstat((strDirectory + strName).c_str(), &info) != 0)
+            continue;
+
+        if (S_ISLNK(info.st_mode) && ((stat((strDirectory + strName).c_str(), &info) != 0) ||
+                                      S_ISDIR(info.st_mode)))
+        {
+            continue;
+        }
+
+        if (S_ISDIR(info.st_mode))
+        {
+            listFiles(strRoot, strRelativePath + strName + "/", strExcluded, files, sizes);
+        }
+        else if (S_ISREG(info.st_mode) &&
+                 ((strName != strExcludedName) || !isSameFile(strDirectory + strName, strExcluded)))
+        {
+            files.push_back(strRelativePath + strName);
+            sizes.push_back((unsigned long long) info.st_size);
+        }
+    }
+
+    closedir(pDir);
+#endif
+
+    return true;
+}
+
+
+/****************************** CONSTRUCTION / DESTRUCTION ******************************/
+
+PackFile* PackFile::load(const std::string& strFileName)
+{
+    // Assertions
+    assert(!strFileName.empty());
+
+    PackFile* pPackFile = new PackFile(strFileName);
+    if (!pPackFile->map())
+    {
+        delete pPackFile;
+        return 0;
+    }
+
+    return pPackFile;
+}
+
+//-----------------------------------------------------------------------
+
+PackFile::PackFile(const std::string& strFileName)
+: SharedBuffer(0, 0), m_strFileName(strFileName), m_nbEntries(0),
+  m_nbBuckets(0), m_pBuckets(0), m_pEntries(0), m_pNames(0), m_namesSize(0)
+#if ATHENA_PLATFORM == ATHENA_PLATFORM_WIN32
+  , m_hFile(INVALID_HANDLE_VALUE), m_hMapping(0)
+#endif
+{
+}
+
+//-----------------------------------------------------------------------
+
+PackFile::~PackFile()
+{
+#if ATHENA_PLATFORM == ATHENA_PLATFORM_WIN32
+    if (m_pData)
+        UnmapViewOfFile(m_pData);
+
+    if (m_hMapping)
+        CloseHandle((HANDLE) m_hMapping);
+
+    if (m_hFile != INVALID_HANDLE_VALUE)
+        CloseHandle((HANDLE) m_hFile);
+#else
+    if (m_pData)
+        munmap((void*) m_pData, m_size);
+#endif
+
+    m_pData = 0;
+}
+
+
+/*********************************** STATIC METHODS *************************************/
+
+bool PackFile::build(const std::string& strDirectory, const std::string& strFileName)
+{
+    // Assertions
+    assert(!strDirectory.empty());
+    assert(!strFileName.empty());
+
+    string strRoot = strDirectory;
+    if ((strRoot[strRoot.size() - 1] != '/') && (strRoot[strRoot.size() - 1] != '\\'))
+        strRoot += "/";
+
+    // Retrieve the files to pack
+    vector<string> files;
+    vector<unsigned long long> sizes;
+    if (!listFiles(strRoot, "", strFileName, files, sizes))
+    {
+        ATHENA_LOG_ERROR("Failed to read the directory '" + strDirectory + "'");
+        return false;
+    }
+
+    unsigned int nbEntries = (unsigned int) files.size();
+
+    unsigned int nbBuckets = 1;
+    while (nbBuckets < nbEntries)
+        nbBuckets <<= 1;
+
+    // Sort the files by bucket
+    vector<pair<pair<unsigned int, string>, unsigned int> > order;
+    vector<unsigned long long> hashes(nbEntries);
+    for (unsigned int i = 0; i < nbEntries; ++i)
+    {
+        hashes[i] = hash(files[i]);
+        order.push_back(make_pair(make_pair((unsigned int) (hashes[i] & (nbBuckets - 1)),
+                                            files[i]), i));
+    }
+
+    std::sort(order.begin(), order.end());
+
+    // Compute the layout of the pack file and the table of contents
+    vector<unsigned int> buckets(nbBuckets + 1, nbEntries);
+    vector<unsigned long long> offsets(nbEntries);
+    string entries;
+    string names;
+
+    unsigned long long offset = HEADER_SIZE;
+    for (unsigned int i = 0; i < nbEntries; ++i)
+    {
+        unsigned int index = order[i].second;
+        unsigned int bucket = order[i].first.first;
+
+        if (buckets[bucket] == nbEntries)
+            buckets[bucket] = i;
+
+        offsets[index] = offset;
+        offset = align((size_t) (offset + sizes[index]));
+
+        writeUInt64(entries, hashes[index]);
+        writeUInt64(entries, offsets[index]);
+        writeUInt64(entries, sizes[index]);
+        writeUInt32(entries, (unsigned int) names.size());
+        writeUInt32(entries, (unsigned int) files[index].size());
+
+        names += files[index];
+    }
+
+    // Empty buckets start where the next non-empty one does
+    for (int bucket = (int) nbBuckets - 1; bucket >= 0; --bucket)
+        buckets[bucket] = std::min(buckets[bucket], buckets[bucket + 1]);
+
+    string toc;
+    for (unsigned int i = 0; i <= nbBuckets; ++i)
+        writeUInt32(toc, buckets[i]);
+
+    toc += entries;
+    toc += names;
+
+    // Header
+    string header(MAGIC, 4);
+    writeUInt32(header, VERSION);
+    writeUInt32(header, nbEntries);
+    writeUInt32(header, nbBuckets);
+    writeUInt64(header, offset);
+    writeUInt64(header, 0);
+
+    // Write the pack file
+    FileDataStream output(strFileName, DataStream::WRITE);
+    if (!output.isOpen())
+    {
+        ATHENA_LOG_ERROR("Failed to create the pack file '" + strFileName + "'");
+        return false;
+    }
+
+    bool bSuccess = (output.write(header.data(), header.size()) == header.size());
+    bool bWriteFailed = !bSuccess;
+
+    const size_t BUFFER_SIZE = 64 * 1024;
+    char* buffer = new char[BUFFER_SIZE];
+    char padding[ALIGNMENT] = { 0 };
+    Hash64 checksum;
+
+    for (unsigned int i = 0; (i < nbEntries) && bSuccess; ++i)
+    {
+        unsigned int index = order[i].second;
+
+        FileDataStream input(strRoot + files[index], DataStream::READ);
+        if (!input.isOpen())
+        {
+            ATHENA_LOG_ERROR("Failed to open the file '" + strRoot + files[index] + "'");
+            bSuccess = false;
+            break;
+        }
+
+        unsigned long long remaining = sizes[index];
+        while (remaining > 0)
+        {
+            size_t count = (size_t) std::min(remaining, (unsigned long long) BUFFER_SIZE);
+            if (input.read(buffer, count) != count)
+            {
+                ATHENA_LOG_ERROR("Failed to read the file '" + strRoot + files[index] + "'");
+                bSuccess = false;
+                break;
+            }
+
+            if (output.write(buffer, count) != count)
+            {
+                bWriteFailed = true;
+                bSuccess = false;
+                break;
+            }
+
+            checksum.update(buffer, count);
+            remaining -= count;
+        }
+
+        unsigned long long end = offsets[index] + sizes[index];
+        size_t paddingSize = (size_t) (align((size_t) end) - end);
+
+        if (bSuccess && (output.write(padding, paddingSize) != paddingSize))
+        {
+            bWriteFailed = true;
+            bSuccess = false;
+        }
+
+        checksum.update(padding, paddingSize);
+    }
+
+    delete[] buffer;
+
+    if (bSuccess)
+    {
+        checksum.update(toc.data(), toc.size());
+
+        // Now that everything is known, fill the checksum of the header
+        string value;
+        writeUInt64(value, checksum.value());
+
+        bSuccess = (output.write(toc.data(), toc.size()) == toc.size()) &&
+                   (output.writeAt(24, value.data(), value.size()) == value.size()) &&
+                   output.flush();
+        bWriteFailed = !bSuccess;
+    }
+
+    if (bWriteFailed)
+        ATHENA_LOG_ERROR("Failed to write the pack file '" + strFileName + "'");
+
+    output.close();
+
+    if (!bSuccess)
+        remove(strFileName.c_str());
+
+    return bSuccess;
+}
+
+//-----------------------------------------------------------------------
+
+unsigned long long PackFile::hash(const std::string& strName)
+{
+    // 64-bit FNV-1a
+    unsigned long long h = 14695981039346656037ULL;
+    for (size_t i = 0; i < strName.size(); ++i)
+    {
+        h ^= (unsigned char) strName[i];
+        h *= 1099511628211ULL;
+    }
+
+    return h;
+}
+
+
+/*************************************** METHODS ****************************************/
+
+bool PackFile::verify() const
+{
+    unsigned long long checksum = readUInt64(m_pData + 24);
+
+    // Not computed
+    if (checksum == 0)
+        return true;
+
+    return (Checksum::hash64(m_pData + HEADER_SIZE, m_size - HEADER_SIZE) == checksum);
+}
+
+//-----------------------------------------------------------------------
+
+bool PackFile::contains(const std::string& strName) const
+{
+    return (findEntry(strName) != 0);
+}
+
+//-----------------------------------------------------------------------
+
+MemoryDataStream* PackFile::open(const std::string& strName)
+{
+    const unsigned char* pEntry = findEntry(strName);
+    if (!pEntry)
+        return 0;
+
+    return new MemoryDataStream(this, (size_t) readUInt64(pEntry + 8),
+                                (size_t) readUInt64(pEntry + 16));
+}
+
+//-----------------------------------------------------------------------
+
+std::string PackFile::entryName(unsigned int index) const
+{
+    // Assertions
+    assert(index < m_nbEntries);
+
+    const unsigned char* pEntry = m_pEntries + index * ENTRY_SIZE;
+
+    return string((const char*) m_pNames + readUInt32(pEntry + 24), readUInt32(pEntry + 28));
+}
+
+//-----------------------------------------------------------------------
+
+bool PackFile::map()
+{
+#if ATHENA_PLATFORM == ATHENA_PLATFORM_WIN32
+    HANDLE hFile = CreateFileA(m_strFileName.c_str(), GENERIC_READ, FILE_SHARE_READ, 0,
+                               OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, 0);
+    if (hFile == INVALID_HANDLE_VALUE)
+        return false;
+
+    m_hFile = hFile;
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(hFile, &size) || (size.QuadPart < (LONGLONG) HEADER_SIZE))
+        return false;
+
+    m_size = (size_t) size.QuadPart;
+
+    m_hMapping = CreateFileMappingA(hFile, 0, PAGE_READONLY, 0, 0, 0);
+    if (!m_hMapping)
+        return false;
+
+    m_pData = (const unsigned char*) MapViewOfFile((HANDLE) m_hMapping, FILE_MAP_READ, 0, 0, 0);
+    if (!m_pData)
+        return false;
+#else
+    int fd = ::open(m_strFileName.c_str(), O_RDONLY);
+    if (fd < 0)
+        return false;
+
+    struct stat info;
+    if ((fstat(fd, &info) != 0) || !S_ISREG(info.st_mode) || (info.st_size < (off_t) HEADER_SIZE))
+    {
+        ::close(fd);
+        return false;
+    }
+
+    m_size = (size_t) info.st_size;
+
+    void* pData = mmap(0, m_size, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+
+    if (pData == MAP_FAILED)
+        return false;
+
+    m_pData = (const unsigned char*) pData;
+#endif
+
+    // Check the header
+    if ((memcmp(m_pData, MAGIC, 4) != 0) || (readUInt32(m_pData + 4) != VERSION))
+        return false;
+
+    m_nbEntries = readUInt32(m_pData + 8);
+    m_nbBuckets = readUInt32(m_pData + 12);
+
+    unsigned long long tocOffset = readUInt64(m_pData + 16);
+
+    if ((m_nbBuckets == 0) || ((m_nbBuckets & (m_nbBuckets - 1)) != 0))
+        return false;
+
+    unsigned long long tocSize = (unsigned long long) (m_nbBuckets + 1) * 4 +
+                                 (unsigned long long) m_nbEntries * ENTRY_SIZE;
+
+    if ((tocOffset > m_size) || (tocSize > m_size - tocOffset))
+    {
+        ATHENA_LOG_ERROR("Invalid table of contents in '" + m_strFileName + "'");
+        return false;
+    }
+
+    m_pBuckets  = m_pData + tocOffset;
+    m_pEntries  = m_pBuckets + (m_nbBuckets + 1) * 4;
+    m_pNames    = m_pEntries + m_nbEntries * ENTRY_SIZE;
+    m_namesSize = m_size - (size_t) (tocOffset + tocSize);
+
+    // Check the table of contents, so the lookups don't need to
+    for (unsigned int i = 0; i <= m_nbBuckets; ++i)
+    {
+        unsigned int index = readUInt32(m_pBuckets + i * 4);
+        if ((index > m_nbEntries) || ((i > 0) && (index < readUInt32(m_pBuckets + (i - 1) * 4))))
+        {
+            ATHENA_LOG_ERROR("Invalid table of contents in '" + m_strFileName + "'");
+            return false;
+        }
+    }
+
+    for (unsigned int i = 0; i < m_nbEntries; ++i)
+    {
+        const unsigned char* pEntry = m_pEntries + i * ENTRY_SIZE;
+
+        unsigned long long offset = readUInt64(pEntry + 8);
+        unsigned long long size = readUInt64(pEntry + 16);
+        unsigned int nameOffset = readUInt32(pEntry + 24);
+        unsigned int nameLength = readUInt32(pEntry + 28);
+
+        if ((offset > tocOffset) || (size > tocOffset - offset) ||
+            (nameOffset > m_namesSize) || (nameLength > m_namesSize - nameOffset))
+        {
+            ATHENA_LOG_ERROR("Invalid table of contents in '" + m_strFileName + "'");
+            return false;
+        }
+    }
+
+    return true;
+}
+
+//-----------------------------------------------------------------------
+
+const unsigned char* PackFile::findEntry(const std::string& strName) const
+{
+    unsigned long long h = hash(strName);
+    unsigned int bucket = (unsigned int) (h & (m_nbBuckets - 1));
+
+    unsigned int first = readUInt32(m_pBuckets + bucket * 4);
+    unsigned int last = readUInt32(m_pBuckets + (bucket + 1) * 4);
+
+    for (unsigned int i = first; i < last; ++i)
+    {
+        const unsigned char* pEntry = m_pEntries + i * ENTRY_SIZE;
+
+        if ((readUInt64(pEntry) == h) && (readUInt32(pEntry + 28) == strName.size()) &&
+            (memcmp(m_pNames + readUInt32(pEntry + 24), strName.data(), strName.size()) == 0))
+        {
+            return pEntry;
+        }
+    }
+
+    return 0;
+}
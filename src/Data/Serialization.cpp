@@ -6,8 +6,12 @@
 
 #include <Athena-Core/Data/Serialization.h>
 #include <Athena-Core/Data/FileDataStream.h>
+#include <Athena-Core/Data/JSONDocument.h>
 #include <Athena-Core/Utils/Describable.h>
 #include <Athena-Core/Utils/PropertiesList.h>
+#include <Athena-Core/Utils/PropertiesTable.h>
+#include <Athena-Core/Utils/Metrics.h>
+#include <Athena-Core/Utils/Timer.h>
 #include <Athena-Math/Vector3.h>
 #include <Athena-Math/Quaternion.h>
 #include <Athena-Math/Color.h>
@@ -28,6 +32,299 @@ using namespace rapidjson;
 /// Context used for logging
 static const char* __CONTEXT__ = "Serialization";
 
+/// Maximum number of bytes allocated at once when reading a string from a binary stream
+static const size_t STRING_CHUNK_SIZE = 4096;
+
+
+/*************************************** METRICS ****************************************/
+
+static Counter g_nbLoadedFiles("json.files_loaded", "Number of JSON files loaded");
+static Counter g_nbFailures("json.load_failures", "Number of JSON files that failed to load");
+static Counter g_nbLoadedBytes("json.bytes_loaded", "Number of bytes of JSON loaded");
+static Histogram g_loadTime("json.load_time_us", "Time taken to load a JSON file (in microseconds)");
+
+
+/*********************************** STATIC FUNCTIONS ***********************************/
+
+template<typename T>
+static bool writeValue(DataStream* pStream, T value)
+{
+    return (pStream->writeArray(&value, 1, DataStream::ENDIAN_LITTLE) == 1);
+}
+
+//-----------------------------------------------------------------------
+
+template<typename T>
+static bool readValue(DataStream* pStream, T& value)
+{
+    return (pStream->readArray(&value, 1, DataStream::ENDIAN_LITTLE) == 1);
+}
+
+//-----------------------------------------------------------------------
+
+static bool writeFloats(DataStream* pStream, float a, float b, float c, float d = 0.0f,
+                        unsigned int count = 3)
+{
+    float values[4] = { a, b, c, d };
+    return (pStream->writeArray(values, count, DataStream::ENDIAN_LITTLE) == count);
+}
+
+//-----------------------------------------------------------------------
+
+/// Write a variant in the binary format of the changes (the null variants and the
+/// structures aren't supported)
+static bool writeVariant(DataStream* pStream, const Variant& value)
+{
+    if (!writeValue(pStream, (unsigned char) value.getType()))
+        return false;
+
+    switch (value.getType())
+    {
+        case Variant::INTEGER:          return writeValue(pStream, (int) value.toInt());
+        case Variant::SHORT:            return writeValue(pStream, (short) value.toShort());
+        case Variant::CHAR:             return writeValue(pStream, (char) value.toChar());
+        case Variant::UNSIGNED_INTEGER: return writeValue(pStream, value.toUInt());
+        case Variant::UNSIGNED_SHORT:   return writeValue(pStream, value.toUShort());
+        case Variant::UNSIGNED_CHAR:    return writeValue(pStream, value.toUChar());
+        case Variant::FLOAT:            return writeValue(pStream, value.toFloat());
+        case Variant::DOUBLE:           return writeValue(pStream, value.toDouble());
+        case Variant::BOOLEAN:          return writeValue(pStream, (unsigned char) value.toBool());
+
+        case Variant::STRING:
+        {
+            std::string str = value.toString();
+            return writeValue(pStream, (unsigned int) str.size()) &&
+                   (pStream->write(str.data(), str.size()) == str.size());
+        }
+
+        case Variant::VECTOR3:
+        {
+            Vector3 v = value.toVector3();
+            return writeFloats(pStream, v.x, v.y, v.z);
+        }
+
+        case Variant::QUATERNION:
+        {
+            Quaternion q = value.toQuaternion();
+            return writeFloats(pStream, q.w, q.x, q.y, q.z, 4);
+        }
+
+        case Variant::COLOR:
+        {
+            Color c = value.toColor();
+            return writeFloats(pStream, c.r, c.g, c.b, c.a, 4);
+        }
+
+        case Variant::RADIAN:   return writeValue(pStream, (float) value.toRadian().valueRadians());
+        case Variant::DEGREE:   return writeValue(pStream, (float) value.toDegree().valueDegrees());
+
+        default:
+            return false;
+    }
+}
+
+//-----------------------------------------------------------------------
+
+/// Read a variant written by writeVariant()
+static bool readVariant(DataStream* pStream, Variant& value)
+{
+    unsigned char type;
+    if (!readValue(pStream, type))
+        return false;
+
+    #define READ_VALUE(TYPE_ID, TYPE)                                           \
+        case Variant::TYPE_ID:                                                  \
+        {                                                                       \
+            TYPE v;                                                             \
+            if (!readValue(pStream, v))                                         \
+                return false;                                                   \
+            value = Variant(v);                                                 \
+            return true;                                                        \
+        }
+
+    float v[4];
+
+    switch (type)
+    {
+        READ_VALUE(INTEGER,             int)
+        READ_VALUE(SHORT,               short)
+        READ_VALUE(CHAR,                char)
+        READ_VALUE(UNSIGNED_INTEGER,    unsigned int)
+        READ_VALUE(UNSIGNED_SHORT,      unsigned short)
+        READ_VALUE(UNSIGNED_CHAR,       unsigned char)
+        READ_VALUE(FLOAT,               float)
+        READ_VALUE(DOUBLE,              double)
+
+        case Variant::BOOLEAN:
+        {
+            unsigned char b;
+            if (!readValue(pStream, b))
+                return false;
+            value = Variant(b != 0);
+            return true;
+        }
+
+        case Variant::STRING:
+        {
+            unsigned int length;
+            if (!readValue(pStream, length))
+                return false;
+
+            // The length can't be trusted: the string grows as its content is read,
+            // so a corrupted one can't allocate more than what remains in the stream
+            std::string str;
+            while (str.size() < length)
+            {
+                size_t offset = str.size();
+                size_t chunk = std::min((size_t) length - offset, STRING_CHUNK_SIZE);
+
+                str.resize(offset + chunk);
+                if (pStream->read(&str[offset], chunk) != chunk)
+                    return false;
+            }
+
+            value = Variant(str);
+            return true;
+        }
+
+        case Variant::VECTOR3:
+            if (pStream->readArray(v, 3, DataStream::ENDIAN_LITTLE) != 3)
+                return false;
+            value = Variant(Vector3(v[0], v[1], v[2]));
+            return true;
+
+        case Variant::QUATERNION:
+            if (pStream->readArray(v, 4, DataStream::ENDIAN_LITTLE) != 4)
+                return false;
+            value = Variant(Quaternion(v[0], v[1], v[2], v[3]));
+            return true;
+
+        case Variant::COLOR:
+            if (pStream->readArray(v, 4, DataStream::ENDIAN_LITTLE) != 4)
+                return false;
+            value = Variant(Color(v[0], v[1], v[2], v[3]));
+            return true;
+
+        case Variant::RADIAN:
+            if (!readValue(pStream, v[0]))
+                return false;
+            value = Variant(Radian(v[0]));
+            return true;
+
+        case Variant::DEGREE:
+            if (!readValue(pStream, v[0]))
+                return false;
+            value = Variant(Degree(v[0]));
+            return true;
+
+        default:
+            return false;
+    }
+
+    #undef READ_VALUE
+}
+
+//-----------------------------------------------------------------------
+
+static void propertiesToJSON(const PropertiesList* pProperties,
+                             rapidjson::Value &json_properties,
+                             rapidjson::Value::AllocatorType &allocator)
+{
+    json_properties.SetArray();
+
+    PropertiesList::tConstCategoriesIterator categIter = pProperties->getCategoriesIterator();
+    Value name;
+    Value value;
+    while (categIter.hasMoreElements())
+    {
+        const PropertiesList::tCategory* pCategory = categIter.peekNextPtr();
+
+        Value category;
+        category.SetObject();
+
+        value.SetString(pCategory->strName.c_str(), allocator);
+        category.AddMember("__category__", value, allocator);
+
+        PropertiesList::tConstPropertiesIterator propIter(pCategory->values.begin(),
+                                                          pCategory->values.end());
+        while (propIter.hasMoreElements())
+        {
+            const PropertiesList::tProperty* pProperty = propIter.peekNextPtr();
+
+            toJSON(pProperty->pValue, value, allocator);
+
+            name.SetString(pProperty->strName.c_str(), allocator);
+            category.AddMember(name, value, allocator);
+
+            propIter.moveNext();
+        }
+
+        json_properties.PushBack(category, allocator);
+
+        categIter.moveNext();
+    }
+}
+
+
+//-----------------------------------------------------------------------
+
+static void propertiesFromJSON(const rapidjson::Value& json_describable,
+                               Describable* pDescribable, JSONDocument* pDocument,
+                               PropertiesList* pDelayedProperties)
+{
+    // Assertions
+    assert(pDescribable);
+
+    if (!json_describable.IsArray())
+        return;
+
+    // Only the properties declared in the tables of the describable can be pending
+    const PropertiesTable* pTables = (pDocument ? pDescribable->getPropertiesTable() : 0);
+
+    // Create the properties of the describable that must be assigned now
+    PropertiesList* pProperties = new PropertiesList();
+
+    Value::ConstValueIterator iter, iterEnd;
+    for (iter = json_describable.Begin(), iterEnd = json_describable.End();
+         iter != iterEnd; ++iter)
+    {
+        const char* strCategory = (*iter)["__category__"].GetString();
+
+        const PropertiesTable* pTable = pTables;
+        while (pTable && (pTable->category() != strCategory))
+            pTable = pTable->base();
+
+        pProperties->selectCategory(strCategory);
+
+        Value::ConstMemberIterator iter2, iterEnd2;
+        for (iter2 = iter->MemberBegin(), iterEnd2 = iter->MemberEnd();
+             iter2 != iterEnd2; ++iter2)
+        {
+            if (iter2->name.GetString() == std::string("__category__"))
+                continue;
+
+            if (pTable)
+            {
+                int index = pTable->find(iter2->name.GetString());
+                if ((index != -1) && pTable->property(index).setValue)
+                {
+                    pDescribable->addPendingProperty(PropertyHandle(pTable, index),
+                                                     pDocument, &iter2->value);
+                    continue;
+                }
+            }
+
+            Variant* pField = new Variant();
+            fromJSON(iter2->value, pField);
+            pProperties->set(iter2->name.GetString(), pField);
+        }
+    }
+
+    // Assign the properties to the describable
+    pDescribable->setProperties(pProperties, pDelayedProperties);
+
+    delete pProperties;
+}
 
 /************************************** FUNCTIONS ***************************************/
 
@@ -253,81 +550,147 @@ void Athena::Data::toJSON(Utils::Describable* pDescribable, rapidjson::Value &js
         pProperties->append(pUnknownProperties, false);
 
     // Create the JSON representation
-    json_describable.SetArray();
+    propertiesToJSON(pProperties, json_describable, allocator);
 
-    PropertiesList::tCategoriesIterator categIter = pProperties->getCategoriesIterator();
-    Value name;
-    Value value;
-    while (categIter.hasMoreElements())
-    {
-        PropertiesList::tCategory* pCategory = categIter.peekNextPtr();
+    delete pProperties;
+}
 
-        Value category;
-        category.SetObject();
+//-----------------------------------------------------------------------
 
-        value.SetString(pCategory->strName.c_str(), allocator);
-        category.AddMember("__category__", value, allocator);
+void Athena::Data::changesToJSON(Utils::Describable* pDescribable,
+                                 rapidjson::Value &json_changes,
+                                 rapidjson::Value::AllocatorType &allocator)
+{
+    // Assertions
+    assert(pDescribable);
 
-        PropertiesList::tPropertiesIterator propIter(pCategory->values.begin(),
-                                                     pCategory->values.end());
-        while (propIter.hasMoreElements())
-        {
-            PropertiesList::tProperty* pProperty = propIter.peekNextPtr();
+    PropertiesList* pProperties = pDescribable->getChangedProperties();
+    propertiesToJSON(pProperties, json_changes, allocator);
+    delete pProperties;
+}
 
-            toJSON(pProperty->pValue, value, allocator);
+//-----------------------------------------------------------------------
 
-            name.SetString(pProperty->strName.c_str(), allocator);
-            category.AddMember(name, value, allocator);
+bool Athena::Data::writeChanges(Utils::Describable* pDescribable, DataStream* pStream)
+{
+    // Assertions
+    assert(pDescribable);
+    assert(pStream);
 
-            propIter.moveNext();
+    const PropertiesTable* pTable = pDescribable->getPropertiesTable();
+
+    // Retrieve the values of the changed properties (the ones without a value, or with
+    // an unsupported one, are ignored)
+    std::vector<PropertyHandle> handles;
+    pDescribable->getChangedProperties(handles);
+
+    std::vector<Variant> values(handles.size());
+    std::vector<unsigned int> indices;
+    indices.reserve(handles.size());
+
+    for (unsigned int i = 0; i < handles.size(); ++i)
+    {
+        Variant& value = values[indices.size()];
+
+        if (!pDescribable->getPropertyValue(handles[i], value) || value.isNull() ||
+            (value.getType() == Variant::STRUCT))
+        {
+            continue;
         }
 
-        json_describable.PushBack(category, allocator);
+        indices.push_back(handles[i].globalIndex());
+    }
 
-        categIter.moveNext();
+    // Layout: hash of the layout of the properties of the class (to detect the
+    // mismatches), number of changes, then for each change: index of the property, type,
+    // value
+    if (!writeValue(pStream, pTable ? pTable->layoutHash() : 0ULL) ||
+        !writeValue(pStream, (unsigned int) indices.size()))
+    {
+        return false;
     }
 
-    delete pProperties;
+    for (unsigned int i = 0; i < indices.size(); ++i)
+    {
+        if (!writeValue(pStream, indices[i]) || !writeVariant(pStream, values[i]))
+            return false;
+    }
+
+    return true;
 }
 
 //-----------------------------------------------------------------------
 
-void Athena::Data::fromJSON(const rapidjson::Value& json_describable,
-                            Utils::Describable* pDescribable,
-                            PropertiesList* pDelayedProperties)
+bool Athena::Data::readChanges(DataStream* pStream, Utils::Describable* pDescribable,
+                               PropertiesList* pDelayedProperties)
 {
     // Assertions
+    assert(pStream);
     assert(pDescribable);
 
-    if (!json_describable.IsArray())
-        return;
+    const PropertiesTable* pTable = pDescribable->getPropertiesTable();
 
-    // Create the properties of the describable
-    PropertiesList* pProperties = new PropertiesList();
+    unsigned long long layoutHash;
+    unsigned int nbChanges;
 
-    Value::ConstValueIterator iter, iterEnd;
-    for (iter = json_describable.Begin(), iterEnd = json_describable.End();
-         iter != iterEnd; ++iter)
+    if (!readValue(pStream, layoutHash) || !readValue(pStream, nbChanges))
+        return false;
+
+    if (layoutHash != (pTable ? pTable->layoutHash() : 0ULL))
     {
-        pProperties->selectCategory((*iter)["__category__"].GetString());
+        ATHENA_LOG_ERROR("The changes were written by a describable of another class");
+        return false;
+    }
 
-        Value::ConstMemberIterator iter2, iterEnd2;
-        for (iter2 = iter->MemberBegin(), iterEnd2 = iter->MemberEnd();
-             iter2 != iterEnd2; ++iter2)
-        {
-            if (iter2->name.GetString() == std::string("__category__"))
-                continue;
+    if (!pTable && (nbChanges != 0))
+    {
+        ATHENA_LOG_ERROR("The changes were written by a describable of another class");
+        return false;
+    }
 
-            Variant* pField = new Variant();
-            fromJSON(iter2->value, pField);
-            pProperties->set(iter2->name.GetString(), pField);
+    Variant value;
+
+    for (unsigned int i = 0; i < nbChanges; ++i)
+    {
+        unsigned int index;
+
+        if (!readValue(pStream, index) || !readVariant(pStream, value))
+            return false;
+
+        PropertyHandle handle = pTable->resolve(index);
+        if (!handle.isValid())
+            return false;
+
+        if (!pDescribable->setPropertyValue(handle, value) && pDelayedProperties)
+        {
+            pDelayedProperties->set(handle.table()->category(), handle.descriptor().strName,
+                                    new Variant(value));
         }
     }
 
-    // Assign the properties to the describable
-    pDescribable->setProperties(pProperties, pDelayedProperties);
+    return true;
+}
 
-    delete pProperties;
+//-----------------------------------------------------------------------
+
+void Athena::Data::fromJSON(const rapidjson::Value& json_describable,
+                            Utils::Describable* pDescribable,
+                            PropertiesList* pDelayedProperties)
+{
+    propertiesFromJSON(json_describable, pDescribable, 0, pDelayedProperties);
+}
+
+//-----------------------------------------------------------------------
+
+void Athena::Data::fromJSON(const rapidjson::Value& json_describable,
+                            Utils::Describable* pDescribable,
+                            JSONDocument* pDocument,
+                            PropertiesList* pDelayedProperties)
+{
+    // Assertions
+    assert(pDocument);
+
+    propertiesFromJSON(json_describable, pDescribable, pDocument, pDelayedProperties);
 }
 
 //-----------------------------------------------------------------------
@@ -351,13 +714,50 @@ std::string Athena::Data::toJSON(Utils::Describable* pDescribable)
 
 //-----------------------------------------------------------------------
 
+std::string Athena::Data::changesToJSON(Utils::Describable* pDescribable)
+{
+    // Assertions
+    assert(pDescribable);
+
+    // Retrieve the JSON representation
+    Document document;
+    changesToJSON(pDescribable, document, document.GetAllocator());
+
+    // Convert it to string (the changes are usually sent or saved, not read)
+    StringBuffer s;
+    Writer<StringBuffer> writer(s);
+    document.Accept(writer);
+
+    return s.GetString();
+}
+
+//-----------------------------------------------------------------------
+
 bool Athena::Data::fromJSON(const std::string& json_describable,
                             Utils::Describable* pDescribable,
-                            PropertiesList* pDelayedProperties)
+                            PropertiesList* pDelayedProperties, bool bLazy)
 {
     // Assertions
     assert(pDescribable);
 
+    // The document must be kept by the describable
+    if (bLazy)
+    {
+        JSONDocument* pDocument = JSONDocument::create();
+
+        if (pDocument->document().Parse<0>(json_describable.c_str()).HasParseError())
+        {
+            ATHENA_LOG_ERROR(pDocument->document().GetParseError());
+            pDocument->release();
+            return false;
+        }
+
+        fromJSON(pDocument->document(), pDescribable, pDocument, pDelayedProperties);
+
+        pDocument->release();
+        return true;
+    }
+
     // Convert to a JSON representation
     Document document;
 	if (document.Parse<0>(json_describable.c_str()).HasParseError())
@@ -379,10 +779,13 @@ bool Athena::Data::loadJSONFile(const std::string& strFileName,
     // Assertions
     assert(!strFileName.empty());
 
+    Timer timer;
+
     // Read the content of the file
     FileDataStream stream(strFileName, DataStream::READ);
     if (!stream.isOpen())
     {
+        g_nbFailures.increment();
         ATHENA_LOG_ERROR("File not found: " + strFileName);
         return false;
     }
@@ -403,9 +806,14 @@ bool Athena::Data::loadJSONFile(const std::string& strFileName,
     // Convert to a JSON representation
 	if (document.Parse<0>(content.c_str()).HasParseError())
     {
+        g_nbFailures.increment();
         ATHENA_LOG_ERROR(document.GetParseError());
         return false;
     }
 
+    g_nbLoadedFiles.increment();
+    g_nbLoadedBytes.add(content.size());
+    g_loadTime.record(timer.getMicroseconds());
+
     return true;
 }
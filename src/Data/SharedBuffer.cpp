@@ -0,0 +1,61 @@
+/** @file   SharedBuffer.cpp
+    @author Philip Abbet
+
+    Implementation of the class 'Athena::Data::SharedBuffer'
+*/
+
+#include <Athena-Core/Data/SharedBuffer.h>
+#include <Athena-Core/Utils/Atomic.h>
+
+using namespace Athena::Data;
+using namespace Athena::Utils;
+
+
+/****************************** CONSTRUCTION / DESTRUCTION ******************************/
+
+SharedBuffer* SharedBuffer::create(size_t size)
+{
+    return wrap(new unsigned char[size], size);
+}
+
+//-----------------------------------------------------------------------
+
+SharedBuffer* SharedBuffer::wrap(unsigned char* pData, size_t size)
+{
+    SharedBuffer* pBuffer = new SharedBuffer(pData, size);
+    pBuffer->m_pWritableData = pData;
+
+    return pBuffer;
+}
+
+//-----------------------------------------------------------------------
+
+SharedBuffer::SharedBuffer(const unsigned char* pData, size_t size)
+: m_pData(pData), m_size(size), m_pWritableData(0), m_nbRefs(1)
+{
+}
+
+//-----------------------------------------------------------------------
+
+SharedBuffer::~SharedBuffer()
+{
+    delete[] m_pWritableData;
+}
+
+
+/*************************************** METHODS ****************************************/
+
+void SharedBuffer::addRef()
+{
+    atomicIncrement(&m_nbRefs);
+}
+
+//-----------------------------------------------------------------------
+
+void SharedBuffer::release()
+{
+    assert(m_nbRefs > 0);
+
+    if (atomicDecrement(&m_nbRefs) == 0)
+        delete this;
+}
@@ -0,0 +1,356 @@
+/** @file   WriteBehindDataStream.cpp
+    @author Philip Abbet
+
+    Implementation of the class 'Athena::Data::WriteBehindDataStream'
+*/
+
+#include <Athena-Core/Data/WriteBehindDataStream.h>
+#include <Athena-Core/Utils/Thread.h>
+#include <Athena-Core/Log/LogManager.h>
+#include <string.h>
+#include <algorithm>
+
+using namespace Athena::Data;
+using namespace Athena::Utils;
+using namespace Athena::Log;
+using namespace std;
+
+
+/************************************** CONSTANTS **************************************/
+
+/// Context used for logging
+static const char* __CONTEXT__ = "Write-behind data stream";
+
+
+/********************************** WriteBehindThread ***********************************/
+
+namespace Athena {
+namespace Data {
+
+//----------------------------------------------------------------------------------------
+/// @brief  Thread writing the buffers of a write-behind stream
+//----------------------------------------------------------------------------------------
+class WriteBehindThread: public Thread
+{
+public:
+    WriteBehindThread(WriteBehindDataStream* pStream)
+    : m_pStream(pStream)
+    {
+    }
+
+protected:
+    virtual void run()
+    {
+        m_pStream->process();
+    }
+
+private:
+    WriteBehindDataStream* m_pStream;
+};
+
+}
+}
+
+
+/****************************** CONSTRUCTION / DESTRUCTION ******************************/
+
+WriteBehindDataStream::WriteBehindDataStream(DataStream* pStream, size_t bufferSize,
+                                             unsigned int nbBuffers)
+: DataStream(WRITE), m_pStream(pStream), m_pThread(0), m_bufferSize(bufferSize),
+  m_pCurrent(0), m_used(0), m_position(0), m_bWriting(false), m_bFailed(false),
+  m_bStopping(false)
+{
+    assert(pStream);
+    assert(bufferSize > 0);
+    assert(nbBuffers >= 2);
+
+    for (unsigned int i = 0; i < nbBuffers; ++i)
+    {
+        char* pBuffer = new char[bufferSize];
+        m_buffers.push_back(pBuffer);
+        m_free.push_back(pBuffer);
+    }
+
+    m_pThread = new WriteBehindThread(this);
+    if (!m_pThread->start())
+    {
+        ATHENA_LOG_WARNING("Failed to start the writer thread, the data will be written synchronously");
+        delete m_pThread;
+        m_pThread = 0;
+    }
+}
+
+//-----------------------------------------------------------------------
+
+WriteBehindDataStream::~WriteBehindDataStream()
+{
+    close();
+}
+
+
+/*************************************** METHODS ****************************************/
+
+bool WriteBehindDataStream::hasFailed() const
+{
+    ScopedLock lock(m_mutex);
+    return m_bFailed;
+}
+
+//-----------------------------------------------------------------------
+
+void WriteBehindDataStream::submit()
+{
+    if (!m_pCurrent)
+        return;
+
+    char* pBuffer = m_pCurrent;
+    size_t size = m_used;
+
+    m_pCurrent = 0;
+    m_used = 0;
+
+    if ((size > 0) && !m_pThread)
+    {
+        if (m_pStream->write(pBuffer, size) < size)
+        {
+            ScopedLock lock(m_mutex);
+            m_bFailed = true;
+        }
+
+        size = 0;
+    }
+
+    ScopedLock lock(m_mutex);
+
+    if (size > 0)
+    {
+        m_pending.push_back(make_pair(pBuffer, size));
+        m_submitted.signal();
+    }
+    else
+    {
+        m_free.push_back(pBuffer);
+    }
+}
+
+//-----------------------------------------------------------------------
+
+void WriteBehindDataStream::process()
+{
+    while (true)
+    {
+        pair<char*, size_t> buffer;
+        bool bDiscard;
+
+        {
+            ScopedLock lock(m_mutex);
+
+            while (m_pending.empty() && !m_bStopping)
+                m_submitted.wait(m_mutex);
+
+            // The pending buffers are always written before stopping
+            if (m_pending.empty())
+                return;
+
+            buffer = m_pending.front();
+            m_pending.pop_front();
+
+            m_bWriting = true;
+            bDiscard = m_bFailed;
+        }
+
+        bool bSuccess = !bDiscard &&
+                        (m_pStream->write(buffer.first, buffer.second) == buffer.second);
+
+        {
+            ScopedLock lock(m_mutex);
+
+            m_bWriting = false;
+            if (!bSuccess)
+                m_bFailed = true;
+
+            m_free.push_back(buffer.first);
+            m_written.broadcast();
+        }
+    }
+}
+
+
+/**************************** IMPLEMENTATION OF DataStream ******************************/
+
+size_t WriteBehindDataStream::read(void*, size_t)
+{
+    // Not supported
+    return 0;
+}
+
+//-----------------------------------------------------------------------
+
+size_t WriteBehindDataStream::write(const void* buf, size_t count)
+{
+    if (!m_pStream)
+        return 0;
+
+    const char* pSrc = static_cast<const char*>(buf);
+    size_t total = 0;
+
+    while (total < count)
+    {
+        {
+            ScopedLock lock(m_mutex);
+
+            if (!m_pCurrent)
+            {
+                // Only blocks if all the buffers are waiting to be written
+                while (m_free.empty() && !m_bFailed)
+                    m_written.wait(m_mutex);
+
+                if (!m_bFailed)
+                {
+                    m_pCurrent = m_free.front();
+                    m_free.pop_front();
+                }
+            }
+
+            // The data not yet written is discarded once the destination failed
+            if (m_bFailed)
+            {
+                if (m_pCurrent)
+                {
+                    m_free.push_back(m_pCurrent);
+                    m_pCurrent = 0;
+                    m_used = 0;
+                }
+
+                return 0;
+            }
+        }
+
+        size_t size = std::min(count - total, m_bufferSize - m_used);
+        memcpy(m_pCurrent + m_used, pSrc + total, size);
+
+        m_used += size;
+        total += size;
+
+        if (m_used == m_bufferSize)
+            submit();
+    }
+
+    m_position += total;
+
+    return total;
+}
+
+//-----------------------------------------------------------------------
+
+void WriteBehindDataStream::skip(long count)
+{
+    if (!m_pStream)
+        return;
+
+    flush();
+
+    m_pStream->skip(count);
+    m_position = m_pStream->tell();
+}
+
+//-----------------------------------------------------------------------
+
+void WriteBehindDataStream::seek(size_t pos)
+{
+    if (!m_pStream)
+        return;
+
+    flush();
+
+    m_pStream->seek(pos);
+    m_position = m_pStream->tell();
+}
+
+//-----------------------------------------------------------------------
+
+size_t WriteBehindDataStream::tell()
+{
+    return m_position;
+}
+
+//-----------------------------------------------------------------------
+
+bool WriteBehindDataStream::eof() const
+{
+    return false;
+}
+
+//-----------------------------------------------------------------------
+
+void WriteBehindDataStream::close()
+{
+    if (!m_pStream)
+        return;
+
+    if (!flush())
+        ATHENA_LOG_ERROR("Failed to write some data");
+
+    if (m_pThread)
+    {
+        {
+            ScopedLock lock(m_mutex);
+            m_bStopping = true;
+            m_submitted.signal();
+        }
+
+        m_pThread->join();
+        delete m_pThread;
+        m_pThread = 0;
+    }
+
+    m_pStream->close();
+    delete m_pStream;
+    m_pStream = 0;
+
+    for (std::vector<char*>::iterator iter = m_buffers.begin(); iter != m_buffers.end(); ++iter)
+        delete[] *iter;
+
+    m_buffers.clear();
+    m_free.clear();
+}
+
+//-----------------------------------------------------------------------
+
+bool WriteBehindDataStream::flush()
+{
+    if (!m_pStream)
+        return false;
+
+    submit();
+
+    {
+        ScopedLock lock(m_mutex);
+
+        while (!m_pending.empty() || m_bWriting)
+            m_written.wait(m_mutex);
+
+        if (m_bFailed)
+            return false;
+    }
+
+    // The writer thread is idle, the destination stream can be used from here
+    if (!m_pStream->flush())
+    {
+        ScopedLock lock(m_mutex);
+        m_bFailed = true;
+        return false;
+    }
+
+    return true;
+}
+
+//-----------------------------------------------------------------------
+
+bool WriteBehindDataStream::sync()
+{
+    if (!flush())
+        return false;
+
+    return m_pStream->sync();
+}
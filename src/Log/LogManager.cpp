@@ -7,6 +7,7 @@
 #include <Athena-Core/Log/LogManager.h>
 #include <Athena-Core/Log/ILogListener.h>
 #include <Athena-Core/Utils/StringConverter.h>
+#include <Athena-Core/Utils/Metrics.h>
 
 using namespace Athena::Log;
 using namespace Athena::Utils;
@@ -25,6 +26,13 @@ namespace Athena {
 }
 
 
+/*************************************** METRICS ****************************************/
+
+static Counter g_nbMessages("log.messages", "Number of messages logged");
+static Counter g_nbWarnings("log.warnings", "Number of warnings logged");
+static Counter g_nbErrors("log.errors", "Number of errors logged");
+
+
 /****************************** CONSTRUCTION / DESTRUCTION ******************************/
 
 LogManager::LogManager()
@@ -106,6 +114,13 @@ void LogManager::log(tMessageType type, const char* strContext, const std::strin
     // Assertions
     assert(getSingletonPtr());
 
+    g_nbMessages.increment();
+
+    if (type == LOG_WARNING)
+        g_nbWarnings.increment();
+    else if (type == LOG_ERROR)
+        g_nbErrors.increment();
+
     // Optimisation
     if (!m_listeners.empty())
     {
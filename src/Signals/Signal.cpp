@@ -6,6 +6,7 @@
 
 #include <Athena-Core/Signals/Signal.h>
 #include <Athena-Core/Utils/Variant.h>
+#include <Athena-Core/Utils/Metrics.h>
 
 #if ATHENA_CORE_SCRIPTING
     #include <Athena-Core/Scripting.h>
@@ -20,6 +21,12 @@ using namespace Athena::Utils;
 #endif
 
 
+/*************************************** METRICS ****************************************/
+
+static Counter g_nbFiredSignals("signals.fired", "Number of signals fired");
+static Counter g_nbCalledSlots("signals.slots_called", "Number of slots called by the signals");
+
+
 /****************************** CONSTRUCTION / DESTRUCTION *****************************/
 
 Signal::Signal()
@@ -254,6 +261,9 @@ void Signal::disconnect(v8::Persistent<v8::Object> object, v8::Persistent<v8::Ob
 
 void Signal::fire(Variant* pValue)
 {
+    g_nbFiredSignals.increment();
+    g_nbCalledSlots.add(m_slots.size());
+
     // Fire the signal
     m_bFiring = true;
 
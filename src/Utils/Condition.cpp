@@ -0,0 +1,64 @@
+/** @file   Condition.cpp
+    @author Philip Abbet
+
+    Implementation of the class 'Athena::Utils::Condition'
+*/
+
+#include <Athena-Core/Utils/Condition.h>
+
+using namespace Athena::Utils;
+
+
+/****************************** CONSTRUCTION / DESTRUCTION ******************************/
+
+Condition::Condition()
+{
+#if ATHENA_PLATFORM == ATHENA_PLATFORM_WIN32
+    InitializeConditionVariable(&m_condition);
+#else
+    pthread_cond_init(&m_condition, 0);
+#endif
+}
+
+//-----------------------------------------------------------------------
+
+Condition::~Condition()
+{
+#if ATHENA_PLATFORM != ATHENA_PLATFORM_WIN32
+    pthread_cond_destroy(&m_condition);
+#endif
+}
+
+
+/*************************************** METHODS ****************************************/
+
+void Condition::wait(Mutex& mutex)
+{
+#if ATHENA_PLATFORM == ATHENA_PLATFORM_WIN32
+    SleepConditionVariableCS(&m_condition, &mutex.m_mutex, INFINITE);
+#else
+    pthread_cond_wait(&m_condition, &mutex.m_mutex);
+#endif
+}
+
+//-----------------------------------------------------------------------
+
+void Condition::signal()
+{
+#if ATHENA_PLATFORM == ATHENA_PLATFORM_WIN32
+    WakeConditionVariable(&m_condition);
+#else
+    pthread_cond_signal(&m_condition);
+#endif
+}
+
+//-----------------------------------------------------------------------
+
+void Condition::broadcast()
+{
+#if ATHENA_PLATFORM == ATHENA_PLATFORM_WIN32
+    WakeAllConditionVariable(&m_condition);
+#else
+    pthread_cond_broadcast(&m_condition);
+#endif
+}
@@ -5,6 +5,8 @@
 */
 
 #include <Athena-Core/Utils/Describable.h>
+#include <Athena-Core/Utils/PropertiesTable.h>
+#include <Athena-Core/Utils/PropertiesSource.h>
 
 
 using namespace Athena;
@@ -15,7 +17,7 @@ using namespace std;
 /***************************** CONSTRUCTION / DESTRUCTION ******************************/
 
 Describable::Describable()
-: m_pUnknownProperties(0)
+: m_pUnknownProperties(0), m_pChangedProperties(0), m_pPendingProperties(0)
 {
 }
 
@@ -23,30 +25,49 @@ Describable::Describable()
 
 Describable::~Describable()
 {
+    clearPendingProperties();
+
     delete m_pUnknownProperties;
+    delete m_pChangedProperties;
 }
 
 
 /**************************** MANAGEMENT OF THE PROPERTIES *****************************/
 
-void Describable::setProperties(PropertiesList* pProperties,
+PropertiesList* Describable::getProperties() const
+{
+    // The implementations of the derived classes call this one first, so they can read
+    // their attributes afterward
+    if (m_pPendingProperties)
+        const_cast<Describable*>(this)->materializeAll();
+
+    return new PropertiesList();
+}
+
+//-----------------------------------------------------------------------
+
+
+void Describable::setProperties(const PropertiesList* pProperties,
                                 PropertiesList* pDelayedProperties)
 {
     assert(pProperties);
 
-    PropertiesList::tCategoriesIterator catIter = pProperties->getCategoriesIterator();
+    // Only read the list, so the categories shared with other lists aren't copied
+    PropertiesList::tConstCategoriesIterator catIter = pProperties->getCategoriesIterator();
     while (catIter.hasMoreElements())
     {
-        PropertiesList::tPropertiesIterator propIter =
-            pProperties->getPropertiesIterator(catIter.peekNextPtr()->strName);
+        const PropertiesList::tCategory* pCategory = catIter.peekNextPtr();
+
+        PropertiesList::tConstPropertiesIterator propIter(pCategory->values.begin(),
+                                                          pCategory->values.end());
         while (propIter.hasMoreElements())
         {
-            bool bUsed = setProperty(catIter.peekNextPtr()->strName, propIter.peekNextPtr()->strName,
+            bool bUsed = setProperty(pCategory->strName, propIter.peekNextPtr()->strName,
                                      new Variant(*(propIter.peekNextPtr()->pValue)));
 
             if (!bUsed && pDelayedProperties)
             {
-                pDelayedProperties->set(catIter.peekNextPtr()->strName, propIter.peekNextPtr()->strName,
+                pDelayedProperties->set(pCategory->strName, propIter.peekNextPtr()->strName,
                                         new Variant(*(propIter.peekNextPtr()->pValue)));
             }
 
@@ -74,3 +95,330 @@ bool Describable::setProperty(const string& strCategory, const string& strName,
 
     return true;
 }
+
+//-----------------------------------------------------------------------
+
+PropertyHandle Describable::resolveProperty(const string& strCategory,
+                                            const string& strName) const
+{
+    const PropertiesTable* pTable = getPropertiesTable();
+    if (!pTable)
+        return PropertyHandle();
+
+    return pTable->resolve(strCategory, strName);
+}
+
+//-----------------------------------------------------------------------
+
+bool Describable::getPropertyValue(const PropertyHandle& handle, Variant& value) const
+{
+    assert(handle.isValidFor(this));
+
+    if (m_pPendingProperties)
+        const_cast<Describable*>(this)->materializeProperty(handle);
+
+    return handle.table()->getValue(this, handle.index(), value);
+}
+
+//-----------------------------------------------------------------------
+
+bool Describable::setPropertyValue(const PropertyHandle& handle, const Variant& value)
+{
+    assert(handle.isValidFor(this));
+
+    return handle.table()->setValue(this, handle.index(), value);
+}
+
+
+/******************************* TRACKING OF THE CHANGES ******************************/
+
+void Describable::setChangesTracking(bool bEnabled)
+{
+    if (bEnabled && !m_pChangedProperties)
+    {
+        m_pChangedProperties = new vector<unsigned int>();
+    }
+    else if (!bEnabled)
+    {
+        delete m_pChangedProperties;
+        m_pChangedProperties = 0;
+    }
+}
+
+//-----------------------------------------------------------------------
+
+void Describable::markPropertyChanged(const PropertyHandle& handle)
+{
+    assert(handle.isValidFor(this));
+
+    if (!m_pChangedProperties)
+        return;
+
+    // The bits are allocated when needed (the table isn't known by the constructor)
+    unsigned int index = handle.globalIndex();
+    if (index / 32 >= m_pChangedProperties->size())
+        m_pChangedProperties->resize(index / 32 + 1, 0);
+
+    (*m_pChangedProperties)[index / 32] |= (1u << (index % 32));
+}
+
+//-----------------------------------------------------------------------
+
+bool Describable::markPropertyChanged(const string& strCategory, const string& strName)
+{
+    PropertyHandle handle = resolveProperty(strCategory, strName);
+    if (!handle.isValid())
+        return false;
+
+    markPropertyChanged(handle);
+    return true;
+}
+
+//-----------------------------------------------------------------------
+
+bool Describable::isPropertyChanged(const PropertyHandle& handle) const
+{
+    assert(handle.isValidFor(this));
+
+    if (!m_pChangedProperties)
+        return false;
+
+    unsigned int index = handle.globalIndex();
+    if (index / 32 >= m_pChangedProperties->size())
+        return false;
+
+    return ((*m_pChangedProperties)[index / 32] & (1u << (index % 32))) != 0;
+}
+
+//-----------------------------------------------------------------------
+
+bool Describable::hasChangedProperties() const
+{
+    if (!m_pChangedProperties)
+        return false;
+
+    for (unsigned int i = 0; i < m_pChangedProperties->size(); ++i)
+    {
+        if ((*m_pChangedProperties)[i] != 0)
+            return true;
+    }
+
+    return false;
+}
+
+//-----------------------------------------------------------------------
+
+unsigned int Describable::nbChangedProperties() const
+{
+    if (!m_pChangedProperties)
+        return 0;
+
+    unsigned int count = 0;
+
+    for (unsigned int i = 0; i < m_pChangedProperties->size(); ++i)
+    {
+        for (unsigned int bits = (*m_pChangedProperties)[i]; bits; bits &= bits - 1)
+            ++count;
+    }
+
+    return count;
+}
+
+//-----------------------------------------------------------------------
+
+PropertiesList* Describable::getChangedProperties() const
+{
+    PropertiesList* pList = new PropertiesList();
+
+    vector<PropertyHandle> handles;
+    getChangedProperties(handles);
+
+    // The handles are ordered by global index, so the categories of the base classes
+    // come first: they are inserted at the beginning of the list, like in getProperties()
+    const PropertiesTable* pCurrentTable = 0;
+
+    for (vector<PropertyHandle>::iterator iter = handles.begin(); iter != handles.end(); ++iter)
+    {
+        if (iter->table() != pCurrentTable)
+        {
+            pCurrentTable = iter->table();
+            pList->selectCategory(pCurrentTable->category(), false);
+        }
+
+        if (m_pPendingProperties)
+            const_cast<Describable*>(this)->materializeProperty(*iter);
+
+        Variant* pValue = iter->descriptor().get(this);
+        if (pValue)
+            pList->set(iter->descriptor().strName, pValue);
+    }
+
+    return pList;
+}
+
+//-----------------------------------------------------------------------
+
+void Describable::getChangedProperties(vector<PropertyHandle>& handles) const
+{
+    handles.clear();
+
+    const PropertiesTable* pTable = getPropertiesTable();
+    if (!m_pChangedProperties || !pTable)
+        return;
+
+    for (unsigned int i = 0; i < m_pChangedProperties->size(); ++i)
+    {
+        unsigned int bits = (*m_pChangedProperties)[i];
+
+        while (bits)
+        {
+            unsigned int bit = 0;
+            while ((bits & (1u << bit)) == 0)
+                ++bit;
+
+            bits &= bits - 1;
+
+            PropertyHandle handle = pTable->resolve(i * 32 + bit);
+            if (handle.isValid())
+                handles.push_back(handle);
+        }
+    }
+}
+
+//-----------------------------------------------------------------------
+
+void Describable::clearChangedProperties()
+{
+    if (m_pChangedProperties)
+        m_pChangedProperties->assign(m_pChangedProperties->size(), 0);
+}
+
+
+/******************************** PENDING PROPERTIES **********************************/
+
+void Describable::addPendingProperty(const PropertyHandle& handle, PropertiesSource* pSource,
+                                     const void* pValue)
+{
+    assert(handle.isValidFor(this));
+    assert(handle.descriptor().setValue);
+    assert(pSource);
+    assert(pValue);
+
+    // All the pending values must come from the same source
+    if (m_pPendingProperties && (m_pPendingProperties->pSource != pSource))
+        materializeAll();
+
+    if (!m_pPendingProperties)
+    {
+        pSource->addRef();
+
+        m_pPendingProperties = new tPendingProperties();
+        m_pPendingProperties->pSource = pSource;
+        m_pPendingProperties->values.resize(getPropertiesTable()->nbTotalProperties(), 0);
+        m_pPendingProperties->nbValues = 0;
+    }
+
+    const void*& pPending = m_pPendingProperties->values[handle.globalIndex()];
+    if (!pPending)
+        ++m_pPendingProperties->nbValues;
+
+    pPending = pValue;
+
+    // The property is modified now, even if its value is only assigned later
+    if (m_pChangedProperties)
+        markPropertyChanged(handle);
+}
+
+//-----------------------------------------------------------------------
+
+unsigned int Describable::nbPendingProperties() const
+{
+    return (m_pPendingProperties ? m_pPendingProperties->nbValues : 0);
+}
+
+//-----------------------------------------------------------------------
+
+bool Describable::isPropertyPending(const PropertyHandle& handle) const
+{
+    assert(handle.isValidFor(this));
+
+    return m_pPendingProperties && (m_pPendingProperties->values[handle.globalIndex()] != 0);
+}
+
+//-----------------------------------------------------------------------
+
+void Describable::materializeProperty(const PropertyHandle& handle)
+{
+    assert(handle.isValidFor(this));
+
+    if (!m_pPendingProperties)
+        return;
+
+    const void* pPending = m_pPendingProperties->values[handle.globalIndex()];
+    if (!pPending)
+        return;
+
+    Variant value;
+    m_pPendingProperties->pSource->convert(pPending, value);
+
+    // Forget the value first: the source might be destroyed, and assigning it must not
+    // discard it again
+    discardPendingProperty(handle);
+
+    // The property was already marked as modified when it was added
+    vector<unsigned int>* pChangedProperties = m_pChangedProperties;
+    m_pChangedProperties = 0;
+
+    handle.table()->setValue(this, handle.index(), value);
+
+    m_pChangedProperties = pChangedProperties;
+}
+
+//-----------------------------------------------------------------------
+
+void Describable::materializeAll()
+{
+    if (!m_pPendingProperties)
+        return;
+
+    const PropertiesTable* pTable = getPropertiesTable();
+
+    for (unsigned int i = 0; m_pPendingProperties && (i < m_pPendingProperties->values.size()); ++i)
+    {
+        if (m_pPendingProperties->values[i])
+            materializeProperty(pTable->resolve(i));
+    }
+}
+
+//-----------------------------------------------------------------------
+
+void Describable::discardPendingProperty(const PropertyHandle& handle)
+{
+    assert(handle.isValidFor(this));
+
+    if (!m_pPendingProperties)
+        return;
+
+    const void*& pPending = m_pPendingProperties->values[handle.globalIndex()];
+    if (!pPending)
+        return;
+
+    pPending = 0;
+
+    // Release the source as soon as possible
+    if (--m_pPendingProperties->nbValues == 0)
+        clearPendingProperties();
+}
+
+//-----------------------------------------------------------------------
+
+void Describable::clearPendingProperties()
+{
+    if (!m_pPendingProperties)
+        return;
+
+    m_pPendingProperties->pSource->release();
+
+    delete m_pPendingProperties;
+    m_pPendingProperties = 0;
+}
@@ -0,0 +1,234 @@
+/** @file   Timer.cpp
+    @author Philip Abbet
+
+    Implementation of the Linux-specific class 'Athena::Utils::Timer'
+*/
+
+#include <Athena-Core/Utils/Timer.h>
+#include <time.h>
+
+#if defined(__i386__) || defined(__x86_64__)
+    #include <cpuid.h>
+    #define HAS_TSC 1
+#endif
+
+#ifndef CLOCK_MONOTONIC_RAW
+    #define CLOCK_MONOTONIC_RAW CLOCK_MONOTONIC
+#endif
+
+using namespace Athena::Utils;
+
+
+/************************************** CONSTANTS ***************************************/
+
+/// Duration of the calibration of the time-stamp counter (in nanoseconds)
+static const unsigned long long CALIBRATION_DURATION = 20000000ULL;
+
+
+/********************************** STATIC ATTRIBUTES ***********************************/
+
+/// Indicates if the time-stamp counter is used
+static bool g_bTSCEnabled = false;
+
+/// Indicates if the time-stamp counter was calibrated
+static bool g_bTSCCalibrated = false;
+
+/// Number of nanoseconds per tick of the time-stamp counter (fixed-point, 32 bits of
+/// fractional part)
+static unsigned long long g_nsPerTick = 0;
+
+
+/*********************************** STATIC FUNCTIONS ***********************************/
+
+static inline unsigned long long readClock(clockid_t clock)
+{
+    struct timespec now;
+    clock_gettime(clock, &now);
+    return (unsigned long long) now.tv_sec * 1000000000ULL + now.tv_nsec;
+}
+
+//-----------------------------------------------------------------------
+
+#if HAS_TSC
+
+static inline unsigned long long readTSC()
+{
+    unsigned int low, high;
+    __asm__ __volatile__("rdtsc" : "=a"(low), "=d"(high));
+    return ((unsigned long long) high << 32) | low;
+}
+
+//-----------------------------------------------------------------------
+
+static bool isTSCInvariant()
+{
+    unsigned int eax, ebx, ecx, edx;
+
+    if (!__get_cpuid(0x80000000, &eax, &ebx, &ecx, &edx) || (eax < 0x80000007))
+        return false;
+
+    __get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx);
+
+    return (edx & (1 << 8)) != 0;
+}
+
+//-----------------------------------------------------------------------
+
+static bool calibrateTSC()
+{
+    if (!isTSCInvariant())
+        return false;
+
+    unsigned long long startTime = readClock(CLOCK_MONOTONIC_RAW);
+    unsigned long long startTicks = readTSC();
+    unsigned long long time;
+
+    do
+    {
+        time = readClock(CLOCK_MONOTONIC_RAW);
+    }
+    while (time - startTime < CALIBRATION_DURATION);
+
+    unsigned long long ticks = readTSC() - startTicks;
+    if (ticks == 0)
+        return false;
+
+    g_nsPerTick = (unsigned long long) ((double) (time - startTime) / ticks * 4294967296.0);
+
+    return (g_nsPerTick > 0);
+}
+
+//-----------------------------------------------------------------------
+
+static inline unsigned long long ticksToNanoseconds(unsigned long long ticks)
+{
+    // 64x64 multiplication of the fixed-point number, without overflow
+    unsigned long long high = (ticks >> 32) * g_nsPerTick;
+    unsigned long long low  = ((ticks & 0xFFFFFFFFULL) * g_nsPerTick) >> 32;
+
+    return high + low;
+}
+
+#endif
+
+
+/***************************** CONSTRUCTION / DESTRUCTION ******************************/
+
+Timer::Timer()
+{
+    reset();
+}
+
+//-----------------------------------------------------------------------
+
+Timer::~Timer()
+{
+}
+
+
+/*************************************** METHODS ****************************************/
+
+void Timer::reset()
+{
+    m_startCPU = readClock(CLOCK_THREAD_CPUTIME_ID);
+
+#if HAS_TSC
+    m_bTSC = g_bTSCEnabled;
+    if (m_bTSC)
+    {
+        m_start = readTSC();
+        return;
+    }
+#else
+    m_bTSC = false;
+#endif
+
+    m_start = readClock(CLOCK_MONOTONIC_RAW);
+}
+
+//-----------------------------------------------------------------------
+
+unsigned long Timer::getMilliseconds()
+{
+    return (unsigned long) (getNanoseconds() / 1000000ULL);
+}
+
+//-----------------------------------------------------------------------
+
+unsigned long Timer::getMicroseconds()
+{
+    return (unsigned long) (getNanoseconds() / 1000ULL);
+}
+
+//-----------------------------------------------------------------------
+
+unsigned long long Timer::getNanoseconds()
+{
+#if HAS_TSC
+    if (m_bTSC)
+        return ticksToNanoseconds(readTSC() - m_start);
+#endif
+
+    return readClock(CLOCK_MONOTONIC_RAW) - m_start;
+}
+
+//-----------------------------------------------------------------------
+
+unsigned long Timer::getMillisecondsCPU()
+{
+    return (unsigned long) (getNanosecondsCPU() / 1000000ULL);
+}
+
+//-----------------------------------------------------------------------
+
+unsigned long Timer::getMicrosecondsCPU()
+{
+    return (unsigned long) (getNanosecondsCPU() / 1000ULL);
+}
+
+//-----------------------------------------------------------------------
+
+unsigned long long Timer::getNanosecondsCPU()
+{
+    return readClock(CLOCK_THREAD_CPUTIME_ID) - m_startCPU;
+}
+
+
+/************************************ STATIC METHODS ************************************/
+
+unsigned long long Timer::getCycles()
+{
+#if HAS_TSC
+    return readTSC();
+#else
+    return readClock(CLOCK_MONOTONIC_RAW);
+#endif
+}
+
+//-----------------------------------------------------------------------
+
+bool Timer::enableTSC(bool bEnabled)
+{
+#if HAS_TSC
+    if (bEnabled && !g_bTSCCalibrated)
+    {
+        if (!calibrateTSC())
+            return false;
+
+        g_bTSCCalibrated = true;
+    }
+
+    g_bTSCEnabled = bEnabled;
+
+    return g_bTSCEnabled;
+#else
+    return false;
+#endif
+}
+
+//-----------------------------------------------------------------------
+
+bool Timer::isTSCEnabled()
+{
+    return g_bTSCEnabled;
+}
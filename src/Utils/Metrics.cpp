@@ -0,0 +1,417 @@
+/** @file   Metrics.cpp
+    @author Philip Abbet
+
+    Implementation of the classes 'Athena::Utils::Metric', 'Athena::Utils::Counter',
+    'Athena::Utils::Gauge', 'Athena::Utils::Histogram' and
+    'Athena::Utils::MetricsRegistry'
+*/
+
+#include <Athena-Core/Utils/Metrics.h>
+#include <Athena-Core/Utils/Mutex.h>
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/writer.h>
+#include <string.h>
+
+using namespace Athena::Utils;
+using namespace rapidjson;
+
+
+/*********************************** INTERNAL TYPES *************************************/
+
+typedef std::map<std::string, Metric*> tMetricsMap;
+
+
+/********************************** STATIC ATTRIBUTES ***********************************/
+
+/// Index of the shard of the current thread (+1, 0 if not assigned yet)
+static ATHENA_THREAD_LOCAL unsigned int t_shard = 0;
+
+/// Number of threads that used the metrics
+static volatile int g_nbThreads = 0;
+
+
+/*********************************** STATIC FUNCTIONS ***********************************/
+
+/// Returns the registered metrics (constructed on first use, since the metrics are
+/// usually global variables of other modules)
+static tMetricsMap& metrics()
+{
+    static tMetricsMap metrics;
+    return metrics;
+}
+
+//-----------------------------------------------------------------------
+
+/// Returns the mutex protecting the registered metrics
+static Mutex& mutex()
+{
+    static Mutex mutex;
+    return mutex;
+}
+
+//-----------------------------------------------------------------------
+
+static long long sumShards(const volatile long long* pValues, size_t stride)
+{
+    long long total = 0;
+
+    for (unsigned int i = 0; i < Metric::NB_SHARDS; ++i)
+        total += pValues[i * stride];
+
+    return total;
+}
+
+
+/****************************** CONSTRUCTION / DESTRUCTION ******************************/
+
+Metric::Metric(const std::string& strName, const std::string& strDescription, tType type)
+: m_strName(strName), m_strDescription(strDescription), m_type(type)
+{
+    MetricsRegistry::add(this);
+}
+
+//-----------------------------------------------------------------------
+
+Metric::~Metric()
+{
+    MetricsRegistry::remove(this);
+}
+
+//-----------------------------------------------------------------------
+
+Counter::Counter(const std::string& strName, const std::string& strDescription)
+: Metric(strName, strDescription, COUNTER)
+{
+    memset(m_shards, 0, sizeof(m_shards));
+}
+
+//-----------------------------------------------------------------------
+
+Gauge::Gauge(const std::string& strName, const std::string& strDescription)
+: Metric(strName, strDescription, GAUGE)
+{
+    memset(m_shards, 0, sizeof(m_shards));
+}
+
+//-----------------------------------------------------------------------
+
+Histogram::Histogram(const std::string& strName, const std::string& strDescription)
+: Metric(strName, strDescription, HISTOGRAM)
+{
+    memset(m_shards, 0, sizeof(m_shards));
+}
+
+
+/*************************************** METHODS ****************************************/
+
+unsigned int Metric::shard()
+{
+    unsigned int shard = t_shard;
+    if (shard == 0)
+    {
+        shard = (unsigned int) atomicIncrement(&g_nbThreads);
+        t_shard = shard;
+    }
+
+    return (shard - 1) % NB_SHARDS;
+}
+
+//-----------------------------------------------------------------------
+
+unsigned long long Counter::value() const
+{
+    return (unsigned long long) sumShards(&m_shards[0].value, sizeof(tShard) / sizeof(long long));
+}
+
+//-----------------------------------------------------------------------
+
+void Counter::reset()
+{
+    for (unsigned int i = 0; i < NB_SHARDS; ++i)
+        m_shards[i].value = 0;
+}
+
+//-----------------------------------------------------------------------
+
+void Gauge::set(long long value)
+{
+    for (unsigned int i = 1; i < NB_SHARDS; ++i)
+        m_shards[i].value = 0;
+
+    m_shards[0].value = value;
+}
+
+//-----------------------------------------------------------------------
+
+long long Gauge::value() const
+{
+    return sumShards(&m_shards[0].value, sizeof(tShard) / sizeof(long long));
+}
+
+//-----------------------------------------------------------------------
+
+void Gauge::reset()
+{
+    set(0);
+}
+
+//-----------------------------------------------------------------------
+
+void Histogram::record(unsigned long long value)
+{
+    tShard& shard = m_shards[Metric::shard()];
+
+    atomicAdd(&shard.sum, (long long) value);
+    atomicAdd(&shard.buckets[bucket(value)], 1);
+}
+
+//-----------------------------------------------------------------------
+
+unsigned long long Histogram::count() const
+{
+    unsigned long long total = 0;
+
+    for (unsigned int i = 0; i < NB_BUCKETS; ++i)
+        total += sumShards(&m_shards[0].buckets[i], sizeof(tShard) / sizeof(long long));
+
+    return total;
+}
+
+//-----------------------------------------------------------------------
+
+unsigned long long Histogram::sum() const
+{
+    return (unsigned long long) sumShards(&m_shards[0].sum, sizeof(tShard) / sizeof(long long));
+}
+
+//-----------------------------------------------------------------------
+
+std::vector<unsigned long long> Histogram::buckets() const
+{
+    std::vector<unsigned long long> buckets(NB_BUCKETS);
+
+    for (unsigned int i = 0; i < NB_BUCKETS; ++i)
+    {
+        buckets[i] = (unsigned long long) sumShards(&m_shards[0].buckets[i],
+                                                    sizeof(tShard) / sizeof(long long));
+    }
+
+    return buckets;
+}
+
+//-----------------------------------------------------------------------
+
+void Histogram::reset()
+{
+    for (unsigned int i = 0; i < NB_SHARDS; ++i)
+    {
+        m_shards[i].sum = 0;
+
+        for (unsigned int j = 0; j < NB_BUCKETS; ++j)
+            m_shards[i].buckets[j] = 0;
+    }
+}
+
+
+/************************************ STATIC METHODS ************************************/
+
+unsigned int Histogram::bucket(unsigned long long value)
+{
+    if (value == 0)
+        return 0;
+
+#if defined(__GNUC__)
+    return 64 - __builtin_clzll(value);
+#else
+    unsigned int bucket = 0;
+    while (value)
+    {
+        ++bucket;
+        value >>= 1;
+    }
+
+    return bucket;
+#endif
+}
+
+//-----------------------------------------------------------------------
+
+unsigned long long Histogram::bucketUpperBound(unsigned int bucket)
+{
+    if (bucket == 0)
+        return 0;
+
+    if (bucket >= 64)
+        return ~0ULL;
+
+    return (1ULL << bucket) - 1;
+}
+
+//-----------------------------------------------------------------------
+
+void MetricsRegistry::add(Metric* pMetric)
+{
+    ScopedLock lock(mutex());
+
+    assert(metrics().find(pMetric->name()) == metrics().end());
+
+    metrics()[pMetric->name()] = pMetric;
+}
+
+//-----------------------------------------------------------------------
+
+void MetricsRegistry::remove(Metric* pMetric)
+{
+    ScopedLock lock(mutex());
+
+    tMetricsMap::iterator iter = metrics().find(pMetric->name());
+    if ((iter != metrics().end()) && (iter->second == pMetric))
+        metrics().erase(iter);
+}
+
+//-----------------------------------------------------------------------
+
+MetricsRegistry::tSnapshot MetricsRegistry::snapshot()
+{
+    ScopedLock lock(mutex());
+
+    tSnapshot snapshot;
+    snapshot.reserve(metrics().size());
+
+    for (tMetricsMap::iterator iter = metrics().begin(); iter != metrics().end(); ++iter)
+    {
+        Metric* pMetric = iter->second;
+
+        tMetricValue value;
+        value.strName        = pMetric->name();
+        value.strDescription = pMetric->description();
+        value.type           = pMetric->type();
+        value.value          = 0;
+        value.sum            = 0;
+
+        switch (pMetric->type())
+        {
+            case Metric::COUNTER:
+                value.value = (long long) static_cast<Counter*>(pMetric)->value();
+                break;
+
+            case Metric::GAUGE:
+                value.value = static_cast<Gauge*>(pMetric)->value();
+                break;
+
+            case Metric::HISTOGRAM:
+            {
+                Histogram* pHistogram = static_cast<Histogram*>(pMetric);
+
+                value.buckets = pHistogram->buckets();
+                value.sum     = pHistogram->sum();
+
+                for (unsigned int i = 0; i < value.buckets.size(); ++i)
+                    value.value += (long long) value.buckets[i];
+
+                break;
+            }
+        }
+
+        snapshot.push_back(value);
+    }
+
+    return snapshot;
+}
+
+//-----------------------------------------------------------------------
+
+std::string MetricsRegistry::toJSON()
+{
+    tSnapshot values = snapshot();
+
+    StringBuffer s;
+    Writer<StringBuffer> writer(s);
+
+    writer.StartObject();
+
+    for (tSnapshot::iterator iter = values.begin(); iter != values.end(); ++iter)
+    {
+        writer.String(iter->strName.c_str());
+
+        if (iter->type != Metric::HISTOGRAM)
+        {
+            writer.Int64(iter->value);
+            continue;
+        }
+
+        writer.StartObject();
+
+        writer.String("count");
+        writer.Int64(iter->value);
+
+        writer.String("sum");
+        writer.Uint64(iter->sum);
+
+        // Non-empty buckets, identified by their upper bound
+        writer.String("buckets");
+        writer.StartArray();
+
+        for (unsigned int i = 0; i < iter->buckets.size(); ++i)
+        {
+            if (iter->buckets[i] == 0)
+                continue;
+
+            writer.StartArray();
+            writer.Uint64(Histogram::bucketUpperBound(i));
+            writer.Uint64(iter->buckets[i]);
+            writer.EndArray();
+        }
+
+        writer.EndArray();
+
+        writer.EndObject();
+    }
+
+    writer.EndObject();
+
+    return s.GetString();
+}
+
+//-----------------------------------------------------------------------
+
+Metric* MetricsRegistry::find(const std::string& strName)
+{
+    ScopedLock lock(mutex());
+
+    tMetricsMap::iterator iter = metrics().find(strName);
+    if (iter == metrics().end())
+        return 0;
+
+    return iter->second;
+}
+
+//-----------------------------------------------------------------------
+
+void MetricsRegistry::reset()
+{
+    ScopedLock lock(mutex());
+
+    for (tMetricsMap::iterator iter = metrics().begin(); iter != metrics().end(); ++iter)
+        iter->second->reset();
+}
+
+//-----------------------------------------------------------------------
+
+unsigned long long MetricsRegistry::percentile(const tMetricValue& value, double percentile)
+{
+    if ((value.type != Metric::HISTOGRAM) || (value.value <= 0))
+        return 0;
+
+    double threshold = value.value * percentile / 100.0;
+    unsigned long long count = 0;
+
+    for (unsigned int i = 0; i < value.buckets.size(); ++i)
+    {
+        count += value.buckets[i];
+        if ((count > 0) && (count >= threshold))
+            return Histogram::bucketUpperBound(i);
+    }
+
+    return Histogram::bucketUpperBound((unsigned int) value.buckets.size() - 1);
+}
@@ -0,0 +1,66 @@
+/** @file   Mutex.cpp
+    @author Philip Abbet
+
+    Implementation of the class 'Athena::Utils::Mutex'
+*/
+
+#include <Athena-Core/Utils/Mutex.h>
+
+using namespace Athena::Utils;
+
+
+/****************************** CONSTRUCTION / DESTRUCTION ******************************/
+
+Mutex::Mutex()
+{
+#if ATHENA_PLATFORM == ATHENA_PLATFORM_WIN32
+    InitializeCriticalSection(&m_mutex);
+#else
+    pthread_mutex_init(&m_mutex, 0);
+#endif
+}
+
+//-----------------------------------------------------------------------
+
+Mutex::~Mutex()
+{
+#if ATHENA_PLATFORM == ATHENA_PLATFORM_WIN32
+    DeleteCriticalSection(&m_mutex);
+#else
+    pthread_mutex_destroy(&m_mutex);
+#endif
+}
+
+
+/*************************************** METHODS ****************************************/
+
+void Mutex::lock()
+{
+#if ATHENA_PLATFORM == ATHENA_PLATFORM_WIN32
+    EnterCriticalSection(&m_mutex);
+#else
+    pthread_mutex_lock(&m_mutex);
+#endif
+}
+
+//-----------------------------------------------------------------------
+
+bool Mutex::tryLock()
+{
+#if ATHENA_PLATFORM == ATHENA_PLATFORM_WIN32
+    return (TryEnterCriticalSection(&m_mutex) != 0);
+#else
+    return (pthread_mutex_trylock(&m_mutex) == 0);
+#endif
+}
+
+//-----------------------------------------------------------------------
+
+void Mutex::unlock()
+{
+#if ATHENA_PLATFORM == ATHENA_PLATFORM_WIN32
+    LeaveCriticalSection(&m_mutex);
+#else
+    pthread_mutex_unlock(&m_mutex);
+#endif
+}
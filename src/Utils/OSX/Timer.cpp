@@ -59,6 +59,15 @@ unsigned long Timer::getMicroseconds()
 
 //-----------------------------------------------------------------------
 
+unsigned long long Timer::getNanoseconds()
+{
+    struct timeval now;
+    gettimeofday(&now, NULL);
+    return ((unsigned long long) (now.tv_sec - start.tv_sec) * 1000000 + (now.tv_usec - start.tv_usec)) * 1000;
+}
+
+//-----------------------------------------------------------------------
+
 unsigned long Timer::getMillisecondsCPU()
 {
     clock_t newClock = clock();
@@ -0,0 +1,227 @@
+/** @file   PerfCounters.cpp
+    @author Philip Abbet
+
+    Implementation of the class 'Athena::Utils::PerfCounters'
+*/
+
+#include <Athena-Core/Utils/PerfCounters.h>
+
+#if ATHENA_PLATFORM == ATHENA_PLATFORM_LINUX
+    #include <linux/perf_event.h>
+    #include <sys/ioctl.h>
+    #include <sys/syscall.h>
+    #include <string.h>
+    #include <unistd.h>
+#endif
+
+using namespace Athena::Utils;
+
+
+/************************************** CONSTANTS ***************************************/
+
+static const char* COUNTER_NAMES[PerfCounters::NB_COUNTERS] =
+{
+    "instructions",
+    "cycles",
+    "cache-references",
+    "cache-misses",
+    "branches",
+    "branch-misses",
+};
+
+#if ATHENA_PLATFORM == ATHENA_PLATFORM_LINUX
+
+/// Hardware events corresponding to the counters
+static const unsigned long long COUNTER_EVENTS[PerfCounters::NB_COUNTERS] =
+{
+    PERF_COUNT_HW_INSTRUCTIONS,
+    PERF_COUNT_HW_CPU_CYCLES,
+    PERF_COUNT_HW_CACHE_REFERENCES,
+    PERF_COUNT_HW_CACHE_MISSES,
+    PERF_COUNT_HW_BRANCH_INSTRUCTIONS,
+    PERF_COUNT_HW_BRANCH_MISSES,
+};
+
+
+/*********************************** STATIC FUNCTIONS ***********************************/
+
+static int openCounter(unsigned long long event, int leader)
+{
+    struct perf_event_attr attributes;
+    memset(&attributes, 0, sizeof(attributes));
+
+    attributes.size             = sizeof(attributes);
+    attributes.type             = PERF_TYPE_HARDWARE;
+    attributes.config           = event;
+    attributes.disabled         = (leader == -1 ? 1 : 0);
+    attributes.exclude_kernel   = 1;
+    attributes.exclude_hv       = 1;
+    attributes.read_format      = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED |
+                                  PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+    // Current thread, any CPU
+    return (int) syscall(__NR_perf_event_open, &attributes, 0, -1, leader, 0);
+}
+
+#endif
+
+
+/****************************** CONSTRUCTION / DESTRUCTION ******************************/
+
+PerfCounters::PerfCounters(unsigned int counters)
+: m_available(0), m_leader(-1)
+{
+    for (unsigned int i = 0; i < NB_COUNTERS; ++i)
+    {
+        m_descriptors[i] = -1;
+        m_values[i] = 0;
+    }
+
+#if ATHENA_PLATFORM == ATHENA_PLATFORM_LINUX
+    // The counters not supported by the CPU (or not allowed by the kernel) are ignored
+    for (unsigned int i = 0; i < NB_COUNTERS; ++i)
+    {
+        if ((counters & (1 << i)) == 0)
+            continue;
+
+        int descriptor = openCounter(COUNTER_EVENTS[i], m_leader);
+        if (descriptor == -1)
+            continue;
+
+        m_descriptors[i] = descriptor;
+        m_available |= (1 << i);
+
+        if (m_leader == -1)
+            m_leader = descriptor;
+    }
+#endif
+}
+
+//-----------------------------------------------------------------------
+
+PerfCounters::~PerfCounters()
+{
+#if ATHENA_PLATFORM == ATHENA_PLATFORM_LINUX
+    // The group leader must be closed last
+    for (unsigned int i = 0; i < NB_COUNTERS; ++i)
+    {
+        if ((m_descriptors[i] != -1) && (m_descriptors[i] != m_leader))
+            close(m_descriptors[i]);
+    }
+
+    if (m_leader != -1)
+        close(m_leader);
+#endif
+}
+
+
+/*************************************** METHODS ****************************************/
+
+void PerfCounters::start()
+{
+    for (unsigned int i = 0; i < NB_COUNTERS; ++i)
+        m_values[i] = 0;
+
+#if ATHENA_PLATFORM == ATHENA_PLATFORM_LINUX
+    if (m_leader == -1)
+        return;
+
+    ioctl(m_leader, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(m_leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+#endif
+}
+
+//-----------------------------------------------------------------------
+
+void PerfCounters::stop()
+{
+#if ATHENA_PLATFORM == ATHENA_PLATFORM_LINUX
+    if (m_leader == -1)
+        return;
+
+    ioctl(m_leader, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+
+    // Layout: number of counters, time enabled, time running, values (in the order of
+    // creation of the counters)
+    unsigned long long data[3 + NB_COUNTERS];
+
+    ssize_t size = read(m_leader, data, sizeof(data));
+    if ((size < (ssize_t) (3 * sizeof(unsigned long long))) || (data[0] > NB_COUNTERS))
+        return;
+
+    // The counters were never scheduled (too many of them for the hardware)
+    if (data[2] == 0)
+        return;
+
+    double scale = (double) data[1] / (double) data[2];
+
+    unsigned int value = 0;
+    for (unsigned int i = 0; (i < NB_COUNTERS) && (value < data[0]); ++i)
+    {
+        if (m_descriptors[i] == -1)
+            continue;
+
+        m_values[i] = (unsigned long long) (data[3 + value] * scale + 0.5);
+        ++value;
+    }
+#endif
+}
+
+//-----------------------------------------------------------------------
+
+unsigned long long PerfCounters::value(tCounter counter) const
+{
+    return m_values[index(counter)];
+}
+
+//-----------------------------------------------------------------------
+
+double PerfCounters::ipc() const
+{
+    unsigned long long cycles = value(CYCLES);
+    if (cycles == 0)
+        return 0.0;
+
+    return (double) value(INSTRUCTIONS) / cycles;
+}
+
+//-----------------------------------------------------------------------
+
+double PerfCounters::cacheMissRate() const
+{
+    unsigned long long references = value(CACHE_REFERENCES);
+    if (references == 0)
+        return 0.0;
+
+    return (double) value(CACHE_MISSES) / references;
+}
+
+//-----------------------------------------------------------------------
+
+double PerfCounters::branchMissRate() const
+{
+    unsigned long long branches = value(BRANCHES);
+    if (branches == 0)
+        return 0.0;
+
+    return (double) value(BRANCH_MISSES) / branches;
+}
+
+
+/************************************ STATIC METHODS ************************************/
+
+const char* PerfCounters::name(tCounter counter)
+{
+    return COUNTER_NAMES[index(counter)];
+}
+
+//-----------------------------------------------------------------------
+
+unsigned int PerfCounters::index(tCounter counter)
+{
+    unsigned int index = 0;
+    while ((index < NB_COUNTERS - 1) && ((counter & (1 << index)) == 0))
+        ++index;
+
+    return index;
+}
@@ -0,0 +1,248 @@
+/** @file   PoolAllocator.cpp
+    @author Philip Abbet
+
+    Implementation of the class 'Athena::Utils::PoolAllocator'
+*/
+
+#include <Athena-Core/Utils/PoolAllocator.h>
+#include <Athena-Core/Utils/Mutex.h>
+#include <new>
+
+using namespace Athena::Utils;
+
+
+/*********************************** INTERNAL TYPES *************************************/
+
+namespace {
+
+/// A free block (the link is stored in the block itself)
+struct tBlock
+{
+    tBlock* pNext;
+};
+
+
+/// A list of free blocks
+struct tFreeList
+{
+    tBlock*         pHead;
+    unsigned int    nbBlocks;
+};
+
+
+/// The free lists of a thread
+struct tThreadCache
+{
+    tFreeList lists[PoolAllocator::NB_SIZE_CLASSES];
+};
+
+
+/// The global reserve of free blocks, shared by all the threads
+struct tReserve
+{
+    tReserve()
+    : nbBlocks(0), nbReservedBytes(0)
+    {
+    }
+
+    Mutex                   mutex;
+    std::vector<tFreeList>  batches[PoolAllocator::NB_SIZE_CLASSES];
+    size_t                  nbBlocks;           ///< Number of blocks in the batches
+    size_t                  nbReservedBytes;    ///< Memory obtained from the system
+};
+
+}
+
+
+/********************************** STATIC ATTRIBUTES ***********************************/
+
+/// Free lists of the current thread
+static ATHENA_THREAD_LOCAL tThreadCache* t_pCache = 0;
+
+
+/*********************************** STATIC FUNCTIONS ***********************************/
+
+/// Returns the global reserve (never destroyed, since the destructors of other global
+/// objects might still release some blocks)
+static tReserve& reserve()
+{
+    static tReserve* pReserve = new tReserve();
+    return *pReserve;
+}
+
+//-----------------------------------------------------------------------
+
+static inline tThreadCache* threadCache()
+{
+    tThreadCache* pCache = t_pCache;
+
+    if (!pCache)
+    {
+        pCache = new tThreadCache();
+
+        for (unsigned int i = 0; i < PoolAllocator::NB_SIZE_CLASSES; ++i)
+        {
+            pCache->lists[i].pHead = 0;
+            pCache->lists[i].nbBlocks = 0;
+        }
+
+        t_pCache = pCache;
+    }
+
+    return pCache;
+}
+
+//-----------------------------------------------------------------------
+
+/// Fill an empty list of the current thread, from the reserve or with new blocks
+static void refill(unsigned int sizeClass, tFreeList& list)
+{
+    tReserve& r = reserve();
+
+    {
+        ScopedLock lock(r.mutex);
+
+        std::vector<tFreeList>& batches = r.batches[sizeClass];
+        if (!batches.empty())
+        {
+            list = batches.back();
+            batches.pop_back();
+            r.nbBlocks -= list.nbBlocks;
+            return;
+        }
+
+        r.nbReservedBytes += (sizeClass + 1) * PoolAllocator::GRANULARITY *
+                             PoolAllocator::BATCH_SIZE;
+    }
+
+    // Split a new chunk of memory into blocks
+    const size_t blockSize = (sizeClass + 1) * PoolAllocator::GRANULARITY;
+
+    unsigned char* pChunk = static_cast<unsigned char*>(
+                                ::operator new(blockSize * PoolAllocator::BATCH_SIZE));
+
+    for (unsigned int i = 0; i < PoolAllocator::BATCH_SIZE - 1; ++i)
+    {
+        reinterpret_cast<tBlock*>(pChunk + i * blockSize)->pNext =
+                reinterpret_cast<tBlock*>(pChunk + (i + 1) * blockSize);
+    }
+
+    reinterpret_cast<tBlock*>(pChunk + (PoolAllocator::BATCH_SIZE - 1) * blockSize)->pNext = 0;
+
+    list.pHead = reinterpret_cast<tBlock*>(pChunk);
+    list.nbBlocks = PoolAllocator::BATCH_SIZE;
+}
+
+//-----------------------------------------------------------------------
+
+/// Move a list of blocks into the reserve
+static void giveBack(unsigned int sizeClass, const tFreeList& batch)
+{
+    tReserve& r = reserve();
+
+    ScopedLock lock(r.mutex);
+
+    r.batches[sizeClass].push_back(batch);
+    r.nbBlocks += batch.nbBlocks;
+}
+
+
+/*************************************** METHODS ****************************************/
+
+void* PoolAllocator::allocate(size_t size)
+{
+    if (size > MAX_SIZE)
+        return ::operator new(size);
+
+    const unsigned int sizeClass = (size > 0 ? (unsigned int) ((size - 1) / GRANULARITY) : 0);
+
+    tFreeList& list = threadCache()->lists[sizeClass];
+
+    if (!list.pHead)
+        refill(sizeClass, list);
+
+    tBlock* pBlock = list.pHead;
+    list.pHead = pBlock->pNext;
+    --list.nbBlocks;
+
+    return pBlock;
+}
+
+//-----------------------------------------------------------------------
+
+void PoolAllocator::deallocate(void* p, size_t size)
+{
+    if (!p)
+        return;
+
+    if (size > MAX_SIZE)
+    {
+        ::operator delete(p);
+        return;
+    }
+
+    const unsigned int sizeClass = (size > 0 ? (unsigned int) ((size - 1) / GRANULARITY) : 0);
+
+    tFreeList& list = threadCache()->lists[sizeClass];
+
+    tBlock* pBlock = static_cast<tBlock*>(p);
+    pBlock->pNext = list.pHead;
+    list.pHead = pBlock;
+    ++list.nbBlocks;
+
+    // Keep one batch for the next allocations, give the other one to the other threads
+    if (list.nbBlocks >= 2 * BATCH_SIZE)
+    {
+        tFreeList batch;
+        batch.pHead = list.pHead;
+        batch.nbBlocks = BATCH_SIZE;
+
+        tBlock* pLast = list.pHead;
+        for (unsigned int i = 0; i < BATCH_SIZE - 1; ++i)
+            pLast = pLast->pNext;
+
+        list.pHead = pLast->pNext;
+        list.nbBlocks -= BATCH_SIZE;
+        pLast->pNext = 0;
+
+        giveBack(sizeClass, batch);
+    }
+}
+
+//-----------------------------------------------------------------------
+
+void PoolAllocator::releaseThreadCache()
+{
+    tThreadCache* pCache = t_pCache;
+    if (!pCache)
+        return;
+
+    for (unsigned int i = 0; i < NB_SIZE_CLASSES; ++i)
+    {
+        if (pCache->lists[i].pHead)
+            giveBack(i, pCache->lists[i]);
+    }
+
+    t_pCache = 0;
+    delete pCache;
+}
+
+//-----------------------------------------------------------------------
+
+size_t PoolAllocator::nbReservedBytes()
+{
+    tReserve& r = reserve();
+
+    ScopedLock lock(r.mutex);
+    return r.nbReservedBytes;
+}
+
+//-----------------------------------------------------------------------
+
+size_t PoolAllocator::nbReserveBlocks()
+{
+    tReserve& r = reserve();
+
+    ScopedLock lock(r.mutex);
+    return r.nbBlocks;
+}
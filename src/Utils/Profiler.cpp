@@ -0,0 +1,453 @@
+/** @file   Profiler.cpp
+    @author Philip Abbet
+
+    Implementation of the class 'Athena::Utils::Profiler'
+*/
+
+#include <Athena-Core/Utils/Profiler.h>
+#include <Athena-Core/Utils/Atomic.h>
+#include <Athena-Core/Utils/Mutex.h>
+#include <Athena-Core/Utils/Timer.h>
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/writer.h>
+#include <stdio.h>
+
+using namespace Athena::Utils;
+using namespace rapidjson;
+
+
+/************************************** CONSTANTS ***************************************/
+
+/// Number of events of the buffer of each thread (must be a power of two)
+static const unsigned int BUFFER_SIZE = 16384;
+
+/// Maximum number of events kept for the trace
+static const size_t MAX_TRACE_EVENTS = 1000000;
+
+
+/*********************************** INTERNAL TYPES *************************************/
+
+namespace {
+
+/// An event recorded by a thread
+struct tEvent
+{
+    const char*         strName;    ///< Name of the scope (0 for an 'end' event)
+    unsigned long long  timestamp;  ///< Timestamp (in nanoseconds)
+    unsigned int        depth;      ///< Depth of the scope
+};
+
+
+/// A scope begun (during the processing of the events)
+struct tOpenScope
+{
+    const char*         strName;    ///< Name of the scope
+    unsigned long long  start;      ///< Timestamp of the beginning
+    unsigned int        depth;      ///< Depth of the scope
+    unsigned int        node;       ///< Index of the statistics of the scope
+};
+
+
+/// Buffer of the events of a thread.
+///
+/// The events are written by the thread (the only one modifying 'head') and read by the
+/// profiler, under the lock of g_mutex (the only one modifying 'tail').
+struct tThreadBuffer
+{
+    tThreadBuffer(unsigned int index)
+    : head(0), tail(0), depth(0), dropped(0), droppedAtReset(0), index(index)
+    {
+    }
+
+    tEvent                  events[BUFFER_SIZE];
+    volatile unsigned int   head;           ///< Number of events written so far
+    volatile unsigned int   tail;           ///< Number of events read so far
+    unsigned int            depth;          ///< Current depth (used by the thread)
+    unsigned int            dropped;        ///< Number of events lost (written by the
+                                            ///  thread)
+    unsigned int            droppedAtReset; ///< Value of 'dropped' at the last reset
+                                            ///  (used by the profiler)
+    unsigned int            index;          ///< Index of the thread
+
+    std::vector<tOpenScope> scopes;         ///< Scopes begun (used by the profiler)
+};
+
+
+/// An event of the trace (a complete scope)
+struct tTraceEvent
+{
+    const char*         strName;    ///< Name of the scope
+    unsigned int        thread;     ///< Index of the thread
+    unsigned long long  start;      ///< Timestamp of the beginning
+    unsigned long long  duration;   ///< Duration
+};
+
+typedef std::vector<tThreadBuffer*>                             tBuffersList;
+typedef std::map<std::pair<int, const char*>, unsigned int>     tNodesMap;
+typedef std::map<std::string, unsigned int>                     tPathsMap;
+typedef std::vector<tTraceEvent>                                tTraceEventsList;
+
+}
+
+
+/********************************** STATIC ATTRIBUTES ***********************************/
+
+volatile bool Profiler::s_bEnabled = false;
+
+/// Buffer of the current thread
+static ATHENA_THREAD_LOCAL tThreadBuffer* t_pBuffer = 0;
+
+/// Protects the following variables
+static Mutex g_mutex;
+
+/// Buffers of all the threads (never destroyed, since a thread might still use it)
+static tBuffersList g_buffers;
+
+/// Statistics of the scopes
+static Profiler::tStatisticsList g_statistics;
+
+/// Indices of the statistics of the scopes (key: index of the parent and name)
+static tNodesMap g_nodes;
+
+/// Indices of the statistics of the scopes (key: path)
+static tPathsMap g_paths;
+
+/// Events of the trace
+static tTraceEventsList g_traceEvents;
+
+/// Number of events dropped by the trace
+static unsigned long long g_nbDroppedTraceEvents = 0;
+
+/// Reference timer
+static Timer g_timer;
+
+
+/*********************************** STATIC FUNCTIONS ***********************************/
+
+static tThreadBuffer* createThreadBuffer()
+{
+    ScopedLock lock(g_mutex);
+
+    tThreadBuffer* pBuffer = new tThreadBuffer((unsigned int) g_buffers.size());
+    g_buffers.push_back(pBuffer);
+
+    return pBuffer;
+}
+
+//-----------------------------------------------------------------------
+
+static inline void record(tThreadBuffer* pBuffer, const char* strName, unsigned int depth)
+{
+    unsigned int head = pBuffer->head;
+
+    if (head - pBuffer->tail >= BUFFER_SIZE)
+    {
+        ++pBuffer->dropped;
+        return;
+    }
+
+    tEvent& event = pBuffer->events[head & (BUFFER_SIZE - 1)];
+    event.strName   = strName;
+    event.timestamp = g_timer.getNanoseconds();
+    event.depth     = depth;
+
+    // The event must be written before being published
+    memoryBarrier();
+    pBuffer->head = head + 1;
+}
+
+//-----------------------------------------------------------------------
+
+/// Returns the index of the statistics of a scope (g_mutex must be locked)
+static unsigned int findNode(int parent, const char* strName, unsigned int depth)
+{
+    // Fast path: the scope was already encountered (with the same name pointer)
+    std::pair<int, const char*> key(parent, strName);
+
+    tNodesMap::iterator iter = g_nodes.find(key);
+    if (iter != g_nodes.end())
+        return iter->second;
+
+    // The name might be a different pointer to the same text
+    std::string strPath = (parent >= 0 ? g_statistics[parent].strPath + "/" + strName :
+                                         std::string(strName));
+
+    tPathsMap::iterator iter2 = g_paths.find(strPath);
+    if (iter2 != g_paths.end())
+    {
+        g_nodes[key] = iter2->second;
+        return iter2->second;
+    }
+
+    Profiler::tScopeStatistics statistics;
+    statistics.strName = strName;
+    statistics.strPath = strPath;
+    statistics.depth   = depth;
+    statistics.count   = 0;
+    statistics.total   = 0;
+    statistics.min     = 0;
+    statistics.max     = 0;
+
+    unsigned int node = (unsigned int) g_statistics.size();
+    g_statistics.push_back(statistics);
+
+    g_nodes[key] = node;
+    g_paths[strPath] = node;
+
+    return node;
+}
+
+//-----------------------------------------------------------------------
+
+/// Process the events of a buffer (g_mutex must be locked)
+static void processBuffer(tThreadBuffer* pBuffer)
+{
+    unsigned int head = pBuffer->head;
+    memoryBarrier();
+
+    unsigned int tail = pBuffer->tail;
+
+    for (; tail != head; ++tail)
+    {
+        const tEvent& event = pBuffer->events[tail & (BUFFER_SIZE - 1)];
+
+        if (event.strName)
+        {
+            tOpenScope scope;
+            scope.strName = event.strName;
+            scope.start   = event.timestamp;
+            scope.depth   = event.depth;
+            scope.node    = findNode(pBuffer->scopes.empty() ? -1 : (int) pBuffer->scopes.back().node,
+                                     event.strName, event.depth);
+
+            pBuffer->scopes.push_back(scope);
+            continue;
+        }
+
+        // Discard the scopes whose 'end' event was lost
+        while (!pBuffer->scopes.empty() && (pBuffer->scopes.back().depth > event.depth))
+            pBuffer->scopes.pop_back();
+
+        // Ignore the 'end' events whose 'begin' event was lost
+        if (pBuffer->scopes.empty() || (pBuffer->scopes.back().depth != event.depth))
+            continue;
+
+        const tOpenScope& scope = pBuffer->scopes.back();
+        unsigned long long duration = event.timestamp - scope.start;
+
+        Profiler::tScopeStatistics& statistics = g_statistics[scope.node];
+
+        if ((statistics.count == 0) || (duration < statistics.min))
+            statistics.min = duration;
+
+        ++statistics.count;
+        statistics.total += duration;
+
+        if (duration > statistics.max)
+            statistics.max = duration;
+
+        if (g_traceEvents.size() < MAX_TRACE_EVENTS)
+        {
+            tTraceEvent traceEvent;
+            traceEvent.strName  = scope.strName;
+            traceEvent.thread   = pBuffer->index;
+            traceEvent.start    = scope.start;
+            traceEvent.duration = duration;
+
+            g_traceEvents.push_back(traceEvent);
+        }
+        else
+        {
+            ++g_nbDroppedTraceEvents;
+        }
+
+        pBuffer->scopes.pop_back();
+    }
+
+    // The events must be read before their slots are released
+    memoryBarrier();
+    pBuffer->tail = tail;
+}
+
+//-----------------------------------------------------------------------
+
+/// Process the events of all the buffers (g_mutex must be locked)
+static void processBuffers()
+{
+    for (tBuffersList::iterator iter = g_buffers.begin(); iter != g_buffers.end(); ++iter)
+        processBuffer(*iter);
+}
+
+
+/************************************ STATIC METHODS ************************************/
+
+void Profiler::enable(bool bEnabled)
+{
+    s_bEnabled = bEnabled;
+}
+
+//-----------------------------------------------------------------------
+
+void Profiler::begin(const char* strName)
+{
+    assert(strName);
+
+    tThreadBuffer* pBuffer = t_pBuffer;
+    if (!pBuffer)
+    {
+        pBuffer = createThreadBuffer();
+        t_pBuffer = pBuffer;
+    }
+
+    record(pBuffer, strName, ++pBuffer->depth);
+}
+
+//-----------------------------------------------------------------------
+
+void Profiler::end()
+{
+    tThreadBuffer* pBuffer = t_pBuffer;
+    if (!pBuffer || (pBuffer->depth == 0))
+        return;
+
+    record(pBuffer, 0, pBuffer->depth--);
+}
+
+//-----------------------------------------------------------------------
+
+void Profiler::collect()
+{
+    ScopedLock lock(g_mutex);
+    processBuffers();
+}
+
+//-----------------------------------------------------------------------
+
+Profiler::tStatisticsList Profiler::getStatistics()
+{
+    ScopedLock lock(g_mutex);
+    processBuffers();
+
+    tStatisticsList statistics;
+    statistics.reserve(g_statistics.size());
+
+    // Sorted by path (the scopes still running for the first time are ignored)
+    for (tPathsMap::iterator iter = g_paths.begin(); iter != g_paths.end(); ++iter)
+    {
+        if (g_statistics[iter->second].count > 0)
+            statistics.push_back(g_statistics[iter->second]);
+    }
+
+    return statistics;
+}
+
+//-----------------------------------------------------------------------
+
+std::string Profiler::toChromeTrace()
+{
+    ScopedLock lock(g_mutex);
+    processBuffers();
+
+    StringBuffer s;
+    Writer<StringBuffer> writer(s);
+
+    writer.StartObject();
+
+    writer.String("traceEvents");
+    writer.StartArray();
+
+    for (tTraceEventsList::iterator iter = g_traceEvents.begin();
+         iter != g_traceEvents.end(); ++iter)
+    {
+        writer.StartObject();
+
+        writer.String("name");
+        writer.String(iter->strName);
+
+        writer.String("cat");
+        writer.String("athena");
+
+        writer.String("ph");
+        writer.String("X");
+
+        // The timestamps are in microseconds
+        writer.String("ts");
+        writer.Double(iter->start / 1000.0);
+
+        writer.String("dur");
+        writer.Double(iter->duration / 1000.0);
+
+        writer.String("pid");
+        writer.Uint(1);
+
+        writer.String("tid");
+        writer.Uint(iter->thread);
+
+        writer.EndObject();
+    }
+
+    writer.EndArray();
+
+    writer.String("displayTimeUnit");
+    writer.String("ns");
+
+    writer.EndObject();
+
+    return s.GetString();
+}
+
+//-----------------------------------------------------------------------
+
+bool Profiler::exportChromeTrace(const std::string& strFileName)
+{
+    std::string strTrace = toChromeTrace();
+
+    FILE* pFile = fopen(strFileName.c_str(), "wb");
+    if (!pFile)
+        return false;
+
+    bool bSuccess = (fwrite(strTrace.data(), 1, strTrace.size(), pFile) == strTrace.size());
+
+    return (fclose(pFile) == 0) && bSuccess;
+}
+
+//-----------------------------------------------------------------------
+
+void Profiler::reset()
+{
+    ScopedLock lock(g_mutex);
+
+    for (tBuffersList::iterator iter = g_buffers.begin(); iter != g_buffers.end(); ++iter)
+    {
+        tThreadBuffer* pBuffer = *iter;
+
+        unsigned int head = pBuffer->head;
+        memoryBarrier();
+
+        pBuffer->tail = head;
+        pBuffer->scopes.clear();
+
+        // 'dropped' is only modified by the thread
+        pBuffer->droppedAtReset = pBuffer->dropped;
+    }
+
+    g_statistics.clear();
+    g_nodes.clear();
+    g_paths.clear();
+    g_traceEvents.clear();
+    g_nbDroppedTraceEvents = 0;
+}
+
+//-----------------------------------------------------------------------
+
+unsigned long long Profiler::nbDroppedEvents()
+{
+    ScopedLock lock(g_mutex);
+
+    unsigned long long nbEvents = g_nbDroppedTraceEvents;
+
+    for (tBuffersList::iterator iter = g_buffers.begin(); iter != g_buffers.end(); ++iter)
+        nbEvents += (*iter)->dropped - (*iter)->droppedAtReset;
+
+    return nbEvents;
+}
@@ -5,6 +5,7 @@
 */
 
 #include <Athena-Core/Utils/PropertiesList.h>
+#include <Athena-Core/Utils/Atomic.h>
 
 using namespace Athena;
 using namespace Athena::Utils;
@@ -23,19 +24,41 @@ PropertiesList::PropertiesList()
 
 //-----------------------------------------------------------------------
 
+PropertiesList::PropertiesList(const PropertiesList& list)
+: m_categories(list.m_categories)
+{
+    for (tCategoriesList::iterator iter = m_categories.begin(); iter != m_categories.end(); ++iter)
+        *iter = share(*iter);
+
+    m_selectedCategory = m_categories.begin() +
+                         (list.m_selectedCategory - list.m_categories.begin());
+}
+
+//-----------------------------------------------------------------------
+
 PropertiesList::~PropertiesList()
 {
-    tCategoriesIterator catIter(m_categories.begin(), m_categories.end());
-    while (catIter.hasMoreElements())
-    {
-        tPropertiesList* pProperties = &(catIter.peekNextPtr()->values);
+    clear();
+}
 
-        tPropertiesIterator propIter(pProperties->begin(), pProperties->end());
-        while (propIter.hasMoreElements())
-            delete propIter.getNext().pValue;
+//-----------------------------------------------------------------------
 
-        catIter.moveNext();
-    }
+PropertiesList& PropertiesList::operator=(const PropertiesList& list)
+{
+    if (this == &list)
+        return *this;
+
+    tCategoriesList categories = list.m_categories;
+    for (tCategoriesList::iterator iter = categories.begin(); iter != categories.end(); ++iter)
+        *iter = share(*iter);
+
+    clear();
+
+    m_categories.swap(categories);
+    m_selectedCategory = m_categories.begin() +
+                         (list.m_selectedCategory - list.m_categories.begin());
+
+    return *this;
 }
 
 
@@ -60,14 +83,17 @@ void PropertiesList::selectCategory(const std::string& strCategory, tCategoriesL
     for (m_selectedCategory = m_categories.begin(); m_selectedCategory != m_categories.end();
          ++m_selectedCategory)
     {
-        if (m_selectedCategory->strName == strCategory)
+        if ((*m_selectedCategory)->strName == strCategory)
             return;
     }
 
     // Not found, create it
-    tCategory category;
-    category.strName = strCategory;
-    m_selectedCategory = m_categories.insert(position, category);
+    tSharedCategory* pCategory = new tSharedCategory();
+    pCategory->strName = strCategory;
+    pCategory->nbReferences = 1;
+    pCategory->bSharable = true;
+
+    m_selectedCategory = m_categories.insert(position, pCategory);
 }
 
 //-----------------------------------------------------------------------
@@ -82,9 +108,11 @@ void PropertiesList::set(const std::string& strName, Variant* pValue)
     if (m_selectedCategory == m_categories.end())
         selectCategory("DEFAULT");
 
+    detach(m_selectedCategory);
+
     // Search the value
-    PropertiesList::tPropertiesIterator iter(m_selectedCategory->values.begin(),
-                                             m_selectedCategory->values.end());
+    PropertiesList::tPropertiesIterator iter((*m_selectedCategory)->values.begin(),
+                                             (*m_selectedCategory)->values.end());
     while (iter.hasMoreElements())
     {
         if (iter.peekNextPtr()->strName == strName)
@@ -101,7 +129,7 @@ void PropertiesList::set(const std::string& strName, Variant* pValue)
     tProperty prop;
     prop.strName = strName;
     prop.pValue = pValue;
-    m_selectedCategory->values.push_back(prop);
+    (*m_selectedCategory)->values.push_back(prop);
 }
 
 //-----------------------------------------------------------------------
@@ -129,7 +157,7 @@ Variant* PropertiesList::get(const std::string& strName)
     assert(!strName.empty());
 
     // Search the value
-    PropertiesList::tPropertiesIterator iter(m_selectedCategory->values.begin(), m_selectedCategory->values.end());
+    PropertiesList::tPropertiesIterator iter = getPropertiesIterator();
     while (iter.hasMoreElements())
     {
         if (iter.peekNextPtr()->strName == strName)
@@ -165,6 +193,28 @@ Variant* PropertiesList::get(const std::string& strCategory, const std::string&
 
 //-----------------------------------------------------------------------
 
+const Variant* PropertiesList::get(const std::string& strCategory,
+                                   const std::string& strName) const
+{
+    assert(!strCategory.empty());
+    assert(!strName.empty());
+
+    // Search the value
+    PropertiesList::tConstPropertiesIterator iter = getPropertiesIterator(strCategory);
+    while (iter.hasMoreElements())
+    {
+        if (iter.peekNextPtr()->strName == strName)
+            return iter.peekNextPtr()->pValue;
+
+        iter.moveNext();
+    }
+
+    // Not found
+    return 0;
+}
+
+//-----------------------------------------------------------------------
+
 void PropertiesList::remove(const std::string& strCategory, const std::string& strName)
 {
     // Assertions
@@ -174,13 +224,14 @@ void PropertiesList::remove(const std::string& strCategory, const std::string& s
     tPropertiesList::iterator iterProp, iterPropEnd;
 
     // Search the category
-    tCategoriesIterator iter = getCategoriesIterator();
-    while (iter.hasMoreElements())
+    for (tCategoriesList::iterator iter = m_categories.begin(); iter != m_categories.end(); ++iter)
     {
-        if (iter.peekNextPtr()->strName == strCategory)
+        if ((*iter)->strName == strCategory)
         {
-            tCategory* pCategory = iter.peekNextPtr();
-            
+            detach(iter);
+
+            tCategory* pCategory = *iter;
+
             for (iterProp = pCategory->values.begin(), iterPropEnd = pCategory->values.end();
                  iterProp != iterPropEnd; ++iterProp)
             {
@@ -194,8 +245,6 @@ void PropertiesList::remove(const std::string& strCategory, const std::string& s
 
             return;
         }
-
-        iter.moveNext();
     }
 }
 
@@ -207,16 +256,19 @@ void PropertiesList::remove(const std::string& strName)
     assert(m_selectedCategory != m_categories.end());
     assert(!strName.empty());
 
+    detach(m_selectedCategory);
+
     tPropertiesList::iterator iterProp, iterPropEnd;
+    tCategory* pCategory = *m_selectedCategory;
 
     // Search the property
-    for (iterProp = m_selectedCategory->values.begin(), iterPropEnd = m_selectedCategory->values.end();
+    for (iterProp = pCategory->values.begin(), iterPropEnd = pCategory->values.end();
          iterProp != iterPropEnd; ++iterProp)
     {
         if (iterProp->strName == strName)
         {
             delete iterProp->pValue;
-            m_selectedCategory->values.erase(iterProp);
+            pCategory->values.erase(iterProp);
             break;
         }
     }
@@ -226,33 +278,54 @@ void PropertiesList::remove(const std::string& strName)
 
 void PropertiesList::removeEmptyCategories()
 {
-    tCategoriesList::iterator iter, current, iterEnd;
+    tCategoriesList::iterator iter;
 
-    for (int i = 0; i < m_categories.size(); )
+    for (unsigned int i = 0; i < m_categories.size(); )
     {
         iter = m_categories.begin() + i;
 
-        if (iter->values.empty())
+        if ((*iter)->values.empty())
+        {
+            release(*iter);
             m_categories.erase(iter);
+        }
         else
+        {
             ++i;
+        }
     }
+
+    m_selectedCategory = m_categories.end();
 }
 
 //-----------------------------------------------------------------------
 
 PropertiesList::tCategoriesIterator PropertiesList::getCategoriesIterator()
 {
+    // The categories can be modified through the iterator
+    for (tCategoriesList::iterator iter = m_categories.begin(); iter != m_categories.end(); ++iter)
+        unshare(iter);
+
     return tCategoriesIterator(m_categories.begin(), m_categories.end());
 }
 
 //-----------------------------------------------------------------------
 
+PropertiesList::tConstCategoriesIterator PropertiesList::getCategoriesIterator() const
+{
+    return tConstCategoriesIterator(m_categories.begin(), m_categories.end());
+}
+
+//-----------------------------------------------------------------------
+
 PropertiesList::tPropertiesIterator PropertiesList::getPropertiesIterator()
 {
     assert(m_selectedCategory != m_categories.end());
 
-    return tPropertiesIterator(m_selectedCategory->values.begin(), m_selectedCategory->values.end());
+    unshare(m_selectedCategory);
+
+    return tPropertiesIterator((*m_selectedCategory)->values.begin(),
+                               (*m_selectedCategory)->values.end());
 }
 
 //-----------------------------------------------------------------------
@@ -262,13 +335,13 @@ PropertiesList::tPropertiesIterator PropertiesList::getPropertiesIterator(const
     assert(!strCategory.empty());
 
     // Search the category
-    PropertiesList::tCategoriesIterator iter = getCategoriesIterator();
-    while (iter.hasMoreElements())
+    for (tCategoriesList::iterator iter = m_categories.begin(); iter != m_categories.end(); ++iter)
     {
-        if (iter.peekNextPtr()->strName == strCategory)
-            return tPropertiesIterator(iter.peekNextPtr()->values.begin(), iter.peekNextPtr()->values.end());
-
-        iter.moveNext();
+        if ((*iter)->strName == strCategory)
+        {
+            unshare(iter);
+            return tPropertiesIterator((*iter)->values.begin(), (*iter)->values.end());
+        }
     }
 
     // Not found
@@ -277,7 +350,21 @@ PropertiesList::tPropertiesIterator PropertiesList::getPropertiesIterator(const
 
 //-----------------------------------------------------------------------
 
-void PropertiesList::append(PropertiesList* pList, bool bAtEnd)
+PropertiesList::tConstPropertiesIterator PropertiesList::getPropertiesIterator(
+                                                    const std::string& strCategory) const
+{
+    assert(!strCategory.empty());
+
+    tCategoriesList::const_iterator iter = findCategory(strCategory);
+    if (iter == m_categories.end())
+        return tConstPropertiesIterator(empty.begin(), empty.end());
+
+    return tConstPropertiesIterator((*iter)->values.begin(), (*iter)->values.end());
+}
+
+//-----------------------------------------------------------------------
+
+void PropertiesList::append(const PropertiesList* pList, bool bAtEnd)
 {
     // Assertions
     assert(pList);
@@ -285,60 +372,176 @@ void PropertiesList::append(PropertiesList* pList, bool bAtEnd)
     // Declarations
     tCategoriesList::iterator position = bAtEnd ? m_categories.end() : m_categories.begin();
 
-    PropertiesList::tCategoriesIterator iter = pList->getCategoriesIterator();
-    while (iter.hasMoreElements())
+    // Copy the list of categories first, in case pList is this list
+    tCategoriesList categories = pList->m_categories;
+
+    for (tCategoriesList::iterator iter = categories.begin(); iter != categories.end(); ++iter)
     {
-        // Select the category
-        selectCategory(iter.peekNextPtr()->strName, position);
-        position = m_selectedCategory;
-        ++position;
+        tSharedCategory* pCategory = *iter;
 
-        tPropertiesIterator propIter = tPropertiesIterator(iter.peekNextPtr()->values.begin(), iter.peekNextPtr()->values.end());
-        while (propIter.hasMoreElements())
+        // Search the category
+        for (m_selectedCategory = m_categories.begin(); m_selectedCategory != m_categories.end();
+             ++m_selectedCategory)
         {
-            // Set the value
-            set(propIter.peekNextPtr()->strName, new Variant(*(propIter.peekNextPtr()->pValue)));
+            if ((*m_selectedCategory)->strName == pCategory->strName)
+                break;
+        }
 
-            propIter.moveNext();
+        // Not found: share it
+        if (m_selectedCategory == m_categories.end())
+        {
+            m_selectedCategory = m_categories.insert(position, share(pCategory));
+            position = m_selectedCategory;
+            ++position;
+            continue;
         }
 
-        iter.moveNext();
+        position = m_selectedCategory;
+        ++position;
+
+        if (*m_selectedCategory == pCategory)
+            continue;
+
+        // Found: merge the values
+        tPropertiesList::const_iterator propIter, propIterEnd;
+        for (propIter = pCategory->values.begin(), propIterEnd = pCategory->values.end();
+             propIter != propIterEnd; ++propIter)
+        {
+            set(propIter->strName, new Variant(*(propIter->pValue)));
+        }
     }
 }
 
 //-----------------------------------------------------------------------
 
-unsigned int PropertiesList::nbProperties(const std::string& strCategory)
+unsigned int PropertiesList::nbProperties(const std::string& strCategory) const
 {
     assert(!strCategory.empty());
 
-    // Search the category
-    PropertiesList::tCategoriesIterator iter = getCategoriesIterator();
-    while (iter.hasMoreElements())
-    {
-        if (iter.peekNextPtr()->strName == strCategory)
-            return iter.peekNextPtr()->values.size();
+    tCategoriesList::const_iterator iter = findCategory(strCategory);
+    if (iter == m_categories.end())
+        return 0;
 
-        iter.moveNext();
-    }
-
-    // Not found
-    return 0;
+    return (*iter)->values.size();
 }
 
 //-----------------------------------------------------------------------
 
-unsigned int PropertiesList::nbTotalProperties()
+unsigned int PropertiesList::nbTotalProperties() const
 {
     unsigned int nb = 0;
 
     // Iterate through the categories
-    PropertiesList::tCategoriesIterator iter = getCategoriesIterator();
-    while (iter.hasMoreElements())
+    tCategoriesList::const_iterator iter, iterEnd;
+    for (iter = m_categories.begin(), iterEnd = m_categories.end(); iter != iterEnd; ++iter)
+        nb += (*iter)->values.size();
+
+    return nb;
+}
+
+//-----------------------------------------------------------------------
+
+bool PropertiesList::isShared(const std::string& strCategory) const
+{
+    tCategoriesList::const_iterator iter = findCategory(strCategory);
+    if (iter == m_categories.end())
+        return false;
+
+    return ((*iter)->nbReferences > 1);
+}
+
+//-----------------------------------------------------------------------
+
+PropertiesList::tCategoriesList::const_iterator PropertiesList::findCategory(
+                                                    const std::string& strCategory) const
+{
+    tCategoriesList::const_iterator iter, iterEnd;
+    for (iter = m_categories.begin(), iterEnd = m_categories.end(); iter != iterEnd; ++iter)
     {
-        nb += iter.peekNextPtr()->values.size();
-        iter.moveNext();
+        if ((*iter)->strName == strCategory)
+            break;
     }
 
-    return nb;
+    return iter;
+}
+
+//-----------------------------------------------------------------------
+
+void PropertiesList::detach(tCategoriesList::iterator category)
+{
+    tSharedCategory* pCategory = *category;
+
+    if (pCategory->nbReferences == 1)
+        return;
+
+    // Copy the category: the other lists keep using the original one
+    *category = copy(pCategory);
+
+    release(pCategory);
+}
+
+//-----------------------------------------------------------------------
+
+void PropertiesList::unshare(tCategoriesList::iterator category)
+{
+    detach(category);
+    (*category)->bSharable = false;
+}
+
+//-----------------------------------------------------------------------
+
+void PropertiesList::clear()
+{
+    for (tCategoriesList::iterator iter = m_categories.begin(); iter != m_categories.end(); ++iter)
+        release(*iter);
+
+    m_categories.clear();
+    m_selectedCategory = m_categories.end();
+}
+
+//-----------------------------------------------------------------------
+
+void PropertiesList::release(tSharedCategory* pCategory)
+{
+    if (atomicDecrement(&pCategory->nbReferences) > 0)
+        return;
+
+    tPropertiesList::iterator iter, iterEnd;
+    for (iter = pCategory->values.begin(), iterEnd = pCategory->values.end(); iter != iterEnd; ++iter)
+        delete iter->pValue;
+
+    delete pCategory;
+}
+
+//-----------------------------------------------------------------------
+
+PropertiesList::tSharedCategory* PropertiesList::share(tSharedCategory* pCategory)
+{
+    if (!pCategory->bSharable)
+        return copy(pCategory);
+
+    atomicIncrement(&pCategory->nbReferences);
+    return pCategory;
+}
+
+//-----------------------------------------------------------------------
+
+PropertiesList::tSharedCategory* PropertiesList::copy(const tSharedCategory* pCategory)
+{
+    tSharedCategory* pCopy = new tSharedCategory();
+    pCopy->strName = pCategory->strName;
+    pCopy->nbReferences = 1;
+    pCopy->bSharable = true;
+    pCopy->values.reserve(pCategory->values.size());
+
+    tPropertiesList::const_iterator iter, iterEnd;
+    for (iter = pCategory->values.begin(), iterEnd = pCategory->values.end(); iter != iterEnd; ++iter)
+    {
+        tProperty prop;
+        prop.strName = iter->strName;
+        prop.pValue = new Variant(*(iter->pValue));
+        pCopy->values.push_back(prop);
+    }
+
+    return pCopy;
 }
@@ -0,0 +1,42 @@
+/** @file   PropertiesSource.cpp
+    @author Philip Abbet
+
+    Implementation of the class 'Athena::Utils::PropertiesSource'
+*/
+
+#include <Athena-Core/Utils/PropertiesSource.h>
+#include <Athena-Core/Utils/Atomic.h>
+
+using namespace Athena::Utils;
+
+
+/****************************** CONSTRUCTION / DESTRUCTION ******************************/
+
+PropertiesSource::PropertiesSource()
+: m_nbRefs(1)
+{
+}
+
+//-----------------------------------------------------------------------
+
+PropertiesSource::~PropertiesSource()
+{
+}
+
+
+/*************************************** METHODS ****************************************/
+
+void PropertiesSource::addRef()
+{
+    atomicIncrement(&m_nbRefs);
+}
+
+//-----------------------------------------------------------------------
+
+void PropertiesSource::release()
+{
+    assert(m_nbRefs > 0);
+
+    if (atomicDecrement(&m_nbRefs) == 0)
+        delete this;
+}
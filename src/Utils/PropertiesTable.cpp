@@ -0,0 +1,320 @@
+/** @file   PropertiesTable.cpp
+    @author Philip Abbet
+
+    Implementation of the class 'Athena::Utils::PropertiesTable'
+*/
+
+#include <Athena-Core/Utils/PropertiesTable.h>
+#include <Athena-Core/Data/Checksum.h>
+#include <string.h>
+
+using namespace Athena::Data;
+using namespace Athena::Utils;
+using namespace Athena::Math;
+using namespace std;
+
+
+/*********************************** STATIC FUNCTIONS ***********************************/
+
+/// FNV-1a hash of a name
+static unsigned int hashName(const char* pName, size_t length)
+{
+    unsigned int hash = 2166136261u;
+
+    for (size_t i = 0; i < length; ++i)
+    {
+        hash ^= (unsigned char) pName[i];
+        hash *= 16777619u;
+    }
+
+    return hash;
+}
+
+
+/****************************** CONSTRUCTION / DESTRUCTION ******************************/
+
+PropertiesTable::PropertiesTable(const char* strCategory, const tDescriptor* descriptors,
+                                 unsigned int nbDescriptors, const PropertiesTable* pBase)
+: m_strCategory(strCategory), m_descriptors(descriptors), m_nbDescriptors(nbDescriptors),
+  m_pBase(pBase), m_offset(pBase ? pBase->nbTotalProperties() : 0), m_layoutHash(0)
+{
+    assert(strCategory && *strCategory);
+    assert(descriptors || (nbDescriptors == 0));
+
+    // The layout of the base classes is used as the seed, so the hash covers all the
+    // properties of the class in the order of their indices (the names are hashed with
+    // their null terminator, to separate them)
+    Hash64 layout(pBase ? pBase->layoutHash() : 0);
+    layout.update(strCategory, strlen(strCategory) + 1);
+
+    for (unsigned int i = 0; i < nbDescriptors; ++i)
+    {
+        const unsigned char type = (unsigned char) descriptors[i].type;
+
+        layout.update(descriptors[i].strName, strlen(descriptors[i].strName) + 1);
+        layout.update(&type, 1);
+    }
+
+    m_layoutHash = layout.value();
+
+    // At most half of the buckets are used, so the probe sequences stay short
+    size_t nbBuckets = 4;
+    while (nbBuckets < 2 * nbDescriptors)
+        nbBuckets *= 2;
+
+    m_buckets.resize(nbBuckets, -1);
+
+    for (unsigned int i = 0; i < nbDescriptors; ++i)
+    {
+        assert(descriptors[i].strName && descriptors[i].get && descriptors[i].set);
+
+        // The first declaration of a name wins
+        if (find(descriptors[i].strName) != -1)
+            continue;
+
+        size_t bucket = hashName(descriptors[i].strName, strlen(descriptors[i].strName)) &
+                        (nbBuckets - 1);
+
+        while (m_buckets[bucket] != -1)
+            bucket = (bucket + 1) & (nbBuckets - 1);
+
+        m_buckets[bucket] = (int) i;
+    }
+}
+
+//-----------------------------------------------------------------------
+
+PropertiesTable::~PropertiesTable()
+{
+}
+
+
+/*************************************** METHODS ****************************************/
+
+int PropertiesTable::find(const std::string& strName) const
+{
+    const size_t mask = m_buckets.size() - 1;
+
+    size_t bucket = hashName(strName.data(), strName.length()) & mask;
+
+    while (m_buckets[bucket] != -1)
+    {
+        int index = m_buckets[bucket];
+        if (strName == m_descriptors[index].strName)
+            return index;
+
+        bucket = (bucket + 1) & mask;
+    }
+
+    return -1;
+}
+
+//-----------------------------------------------------------------------
+
+void PropertiesTable::addProperties(const Describable* pDescribable,
+                                    PropertiesList* pList) const
+{
+    assert(pDescribable);
+    assert(pList);
+
+    pList->selectCategory(m_strCategory, false);
+
+    for (unsigned int i = 0; i < m_nbDescriptors; ++i)
+    {
+        Variant* pValue = m_descriptors[i].get(pDescribable);
+        if (pValue)
+            pList->set(m_descriptors[i].strName, pValue);
+    }
+}
+
+//-----------------------------------------------------------------------
+
+bool PropertiesTable::setProperty(Describable* pDescribable, const std::string& strName,
+                                  Variant* pValue) const
+{
+    assert(pDescribable);
+    assert(pValue);
+
+    int index = find(strName);
+
+    // The unknown properties of the category are ignored
+    if (index == -1)
+    {
+        delete pValue;
+        return true;
+    }
+
+    // The value loaded previously isn't needed anymore
+    if (pDescribable->hasPendingProperties())
+        pDescribable->discardPendingProperty(PropertyHandle(this, (unsigned int) index));
+
+    bool bUsed = m_descriptors[index].set(pDescribable, pValue);
+
+    if (bUsed && pDescribable->isTrackingChanges())
+        pDescribable->markPropertyChanged(PropertyHandle(this, (unsigned int) index));
+
+    return bUsed;
+}
+
+//-----------------------------------------------------------------------
+
+PropertyHandle PropertiesTable::resolve(const std::string& strCategory,
+                                        const std::string& strName) const
+{
+    const PropertiesTable* pTable = this;
+    while (pTable)
+    {
+        if (pTable->m_strCategory == strCategory)
+        {
+            int index = pTable->find(strName);
+            if (index == -1)
+                break;
+
+            return PropertyHandle(pTable, (unsigned int) index);
+        }
+
+        pTable = pTable->m_pBase;
+    }
+
+    return PropertyHandle();
+}
+
+//-----------------------------------------------------------------------
+
+PropertyHandle PropertiesTable::resolve(unsigned int index) const
+{
+    const PropertiesTable* pTable = this;
+    while (pTable && (index < pTable->m_offset))
+        pTable = pTable->m_pBase;
+
+    if (!pTable || (index >= pTable->nbTotalProperties()))
+        return PropertyHandle();
+
+    return PropertyHandle(pTable, index - pTable->m_offset);
+}
+
+//-----------------------------------------------------------------------
+
+bool PropertiesTable::getValue(const Describable* pDescribable, unsigned int index,
+                               Variant& value) const
+{
+    assert(pDescribable);
+    assert(index < m_nbDescriptors);
+
+    const tDescriptor& descriptor = m_descriptors[index];
+
+    #define GET_VALUE(TYPE_ID, TYPE)                                \
+        case Variant::TYPE_ID:                                      \
+        {                                                           \
+            TYPE v;                                                 \
+            descriptor.getValue(pDescribable, &v);                  \
+            value = Variant(v);                                     \
+            return true;                                            \
+        }
+
+    switch (descriptor.type)
+    {
+        GET_VALUE(INTEGER,          int)
+        GET_VALUE(SHORT,            short)
+        GET_VALUE(CHAR,             char)
+        GET_VALUE(UNSIGNED_INTEGER, unsigned int)
+        GET_VALUE(UNSIGNED_SHORT,   unsigned short)
+        GET_VALUE(UNSIGNED_CHAR,    unsigned char)
+        GET_VALUE(FLOAT,            float)
+        GET_VALUE(DOUBLE,           double)
+        GET_VALUE(BOOLEAN,          bool)
+        GET_VALUE(STRING,           string)
+        GET_VALUE(VECTOR3,          Vector3)
+        GET_VALUE(QUATERNION,       Quaternion)
+        GET_VALUE(COLOR,            Color)
+        GET_VALUE(RADIAN,           Radian)
+        GET_VALUE(DEGREE,           Degree)
+
+        default:
+            break;
+    }
+
+    #undef GET_VALUE
+
+    // The property is handled by methods
+    Variant* pValue = descriptor.get(pDescribable);
+    if (!pValue)
+        return false;
+
+    value = *pValue;
+    delete pValue;
+
+    return true;
+}
+
+//-----------------------------------------------------------------------
+
+bool PropertiesTable::setValue(Describable* pDescribable, unsigned int index,
+                               const Variant& value) const
+{
+    assert(pDescribable);
+    assert(index < m_nbDescriptors);
+
+    if (pDescribable->hasPendingProperties())
+        pDescribable->discardPendingProperty(PropertyHandle(this, index));
+
+    const tDescriptor& descriptor = m_descriptors[index];
+    bool bUsed;
+
+    #define SET_VALUE(TYPE_ID, TYPE, METHOD)                        \
+        case Variant::TYPE_ID:                                      \
+        {                                                           \
+            TYPE v = value.METHOD();                                \
+            descriptor.setValue(pDescribable, &v);                  \
+            bUsed = true;                                           \
+            break;                                                  \
+        }
+
+    switch (descriptor.type)
+    {
+        SET_VALUE(INTEGER,          int,            toInt)
+        SET_VALUE(SHORT,            short,          toShort)
+        SET_VALUE(CHAR,             char,           toChar)
+        SET_VALUE(UNSIGNED_INTEGER, unsigned int,   toUInt)
+        SET_VALUE(UNSIGNED_SHORT,   unsigned short, toUShort)
+        SET_VALUE(UNSIGNED_CHAR,    unsigned char,  toUChar)
+        SET_VALUE(FLOAT,            float,          toFloat)
+        SET_VALUE(DOUBLE,           double,         toDouble)
+        SET_VALUE(BOOLEAN,          bool,           toBool)
+        SET_VALUE(STRING,           string,         toString)
+        SET_VALUE(VECTOR3,          Vector3,        toVector3)
+        SET_VALUE(QUATERNION,       Quaternion,     toQuaternion)
+        SET_VALUE(COLOR,            Color,          toColor)
+        SET_VALUE(RADIAN,           Radian,         toRadian)
+        SET_VALUE(DEGREE,           Degree,         toDegree)
+
+        // The property is handled by methods
+        default:
+            bUsed = descriptor.set(pDescribable, new Variant(value));
+            break;
+    }
+
+    #undef SET_VALUE
+
+    if (bUsed && pDescribable->isTrackingChanges())
+        pDescribable->markPropertyChanged(PropertyHandle(this, index));
+
+    return bUsed;
+}
+
+
+/********************************** PROPERTY HANDLE ***********************************/
+
+bool PropertyHandle::isValidFor(const Describable* pDescribable) const
+{
+    assert(pDescribable);
+
+    if (!m_pTable)
+        return false;
+
+    const PropertiesTable* pTable = pDescribable->getPropertiesTable();
+    while (pTable && (pTable != m_pTable))
+        pTable = pTable->base();
+
+    return (pTable != 0);
+}
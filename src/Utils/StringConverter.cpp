@@ -10,19 +10,816 @@
 #include <Athena-Core/Utils/StringConverter.h>
 #include <Athena-Core/Utils/StringUtils.h>
 #include <sstream>
+#include <limits>
+#include <float.h>
+#include <locale.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if ATHENA_PLATFORM == ATHENA_PLATFORM_WIN32
+    #define snprintf _snprintf
+#endif
 
 using namespace Athena::Utils;
 using namespace Athena::Math;
 using namespace std;
 
 
-/************************************* STATIC METHODS ***********************************/
+/************************************** CONSTANTS ***************************************/
 
-string StringConverter::toString(Real val, unsigned short precision, unsigned short width,
-                                 char fill, std::ios::fmtflags flags)
+/// The numbers from 00 to 99
+static const char DIGIT_PAIRS[201] =
+    "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+    "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+    "8081828384858687888990919293949596979899";
+
+/// Powers of ten fitting in 32 bits
+static const unsigned int POWERS_OF_TEN[10] =
+{
+    1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000
+};
+
+/// Normalized significands of the powers of ten from 10^-348 to 10^340 (step: 8)
+static const unsigned long long CACHED_POWERS_SIGNIFICANDS[87] =
+{
+    0xFA8FD5A0081C0288ULL, 0xBAAEE17FA23EBF76ULL, 0x8B16FB203055AC76ULL,
+    0xCF42894A5DCE35EAULL, 0x9A6BB0AA55653B2DULL, 0xE61ACF033D1A45DFULL,
+    0xAB70FE17C79AC6CAULL, 0xFF77B1FCBEBCDC4FULL, 0xBE5691EF416BD60CULL,
+    0x8DD01FAD907FFC3CULL, 0xD3515C2831559A83ULL, 0x9D71AC8FADA6C9B5ULL,
+    0xEA9C227723EE8BCBULL, 0xAECC49914078536DULL, 0x823C12795DB6CE57ULL,
+    0xC21094364DFB5637ULL, 0x9096EA6F3848984FULL, 0xD77485CB25823AC7ULL,
+    0xA086CFCD97BF97F4ULL, 0xEF340A98172AACE5ULL, 0xB23867FB2A35B28EULL,
+    0x84C8D4DFD2C63F3BULL, 0xC5DD44271AD3CDBAULL, 0x936B9FCEBB25C996ULL,
+    0xDBAC6C247D62A584ULL, 0xA3AB66580D5FDAF6ULL, 0xF3E2F893DEC3F126ULL,
+    0xB5B5ADA8AAFF80B8ULL, 0x87625F056C7C4A8BULL, 0xC9BCFF6034C13053ULL,
+    0x964E858C91BA2655ULL, 0xDFF9772470297EBDULL, 0xA6DFBD9FB8E5B88FULL,
+    0xF8A95FCF88747D94ULL, 0xB94470938FA89BCFULL, 0x8A08F0F8BF0F156BULL,
+    0xCDB02555653131B6ULL, 0x993FE2C6D07B7FACULL, 0xE45C10C42A2B3B06ULL,
+    0xAA242499697392D3ULL, 0xFD87B5F28300CA0EULL, 0xBCE5086492111AEBULL,
+    0x8CBCCC096F5088CCULL, 0xD1B71758E219652CULL, 0x9C40000000000000ULL,
+    0xE8D4A51000000000ULL, 0xAD78EBC5AC620000ULL, 0x813F3978F8940984ULL,
+    0xC097CE7BC90715B3ULL, 0x8F7E32CE7BEA5C70ULL, 0xD5D238A4ABE98068ULL,
+    0x9F4F2726179A2245ULL, 0xED63A231D4C4FB27ULL, 0xB0DE65388CC8ADA8ULL,
+    0x83C7088E1AAB65DBULL, 0xC45D1DF942711D9AULL, 0x924D692CA61BE758ULL,
+    0xDA01EE641A708DEAULL, 0xA26DA3999AEF774AULL, 0xF209787BB47D6B85ULL,
+    0xB454E4A179DD1877ULL, 0x865B86925B9BC5C2ULL, 0xC83553C5C8965D3DULL,
+    0x952AB45CFA97A0B3ULL, 0xDE469FBD99A05FE3ULL, 0xA59BC234DB398C25ULL,
+    0xF6C69A72A3989F5CULL, 0xB7DCBF5354E9BECEULL, 0x88FCF317F22241E2ULL,
+    0xCC20CE9BD35C78A5ULL, 0x98165AF37B2153DFULL, 0xE2A0B5DC971F303AULL,
+    0xA8D9D1535CE3B396ULL, 0xFB9B7CD9A4A7443CULL, 0xBB764C4CA7A44410ULL,
+    0x8BAB8EEFB6409C1AULL, 0xD01FEF10A657842CULL, 0x9B10A4E5E9913129ULL,
+    0xE7109BFBA19C0C9DULL, 0xAC2820D9623BF429ULL, 0x80444B5E7AA7CF85ULL,
+    0xBF21E44003ACDD2DULL, 0x8E679C2F5E44FF8FULL, 0xD433179D9C8CB841ULL,
+    0x9E19DB92B4E31BA9ULL, 0xEB96BF6EBADF77D9ULL, 0xAF87023B9BF0EE6BULL,
+};
+
+/// Binary exponents of the powers of ten from 10^-348 to 10^340 (step: 8)
+static const short CACHED_POWERS_EXPONENTS[87] =
+{
+    -1220, -1193, -1166, -1140, -1113, -1087, -1060, -1034, -1007,  -980,
+     -954,  -927,  -901,  -874,  -847,  -821,  -794,  -768,  -741,  -715,
+     -688,  -661,  -635,  -608,  -582,  -555,  -529,  -502,  -475,  -449,
+     -422,  -396,  -369,  -343,  -316,  -289,  -263,  -236,  -210,  -183,
+     -157,  -130,  -103,   -77,   -50,   -24,     3,    30,    56,    83,
+      109,   136,   162,   189,   216,   242,   269,   295,   322,   348,
+      375,   402,   428,   455,   481,   508,   534,   561,   588,   614,
+      641,   667,   694,   720,   747,   774,   800,   827,   853,   880,
+      907,   933,   960,   986,  1013,  1039,  1066,
+};
+
+/// Powers of ten exactly representable by a double
+static const double EXACT_POWERS_OF_TEN[23] =
+{
+    1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+/// Maximum number of significant digits kept when parsing a real
+static const int MAX_PARSED_DIGITS = 19;
+
+/// Maximum precision for which the shortest form of a real can be used to format it
+/// (rounding the shortest form or the exact value to that number of digits then gives
+/// the same result)
+static const unsigned short MAX_SHORTEST_PRECISION = std::numeric_limits<Real>::digits10;
+
+
+/*********************************** INTERNAL TYPES *************************************/
+
+namespace {
+
+/// A floating-point number with a 64-bit significand (value = f * 2^e)
+struct tDiyFp
+{
+    tDiyFp()
+    : f(0), e(0)
+    {
+    }
+
+    tDiyFp(unsigned long long f, int e)
+    : f(f), e(e)
+    {
+    }
+
+    tDiyFp operator-(const tDiyFp& rhs) const
+    {
+        return tDiyFp(f - rhs.f, e);
+    }
+
+    tDiyFp operator*(const tDiyFp& rhs) const
+    {
+        const unsigned long long M32 = 0xFFFFFFFFULL;
+
+        unsigned long long a = f >> 32;
+        unsigned long long b = f & M32;
+        unsigned long long c = rhs.f >> 32;
+        unsigned long long d = rhs.f & M32;
+
+        unsigned long long ac = a * c;
+        unsigned long long bc = b * c;
+        unsigned long long ad = a * d;
+        unsigned long long bd = b * d;
+
+        unsigned long long tmp = (bd >> 32) + (ad & M32) + (bc & M32);
+        tmp += 1ULL << 31;  // Round
+
+        return tDiyFp(ac + (ad >> 32) + (bc >> 32) + (tmp >> 32), e + rhs.e + 64);
+    }
+
+    tDiyFp normalize() const
+    {
+        tDiyFp result(f, e);
+
+        while ((result.f & (1ULL << 63)) == 0)
+        {
+            result.f <<= 1;
+            --result.e;
+        }
+
+        return result;
+    }
+
+    unsigned long long  f;
+    int                 e;
+};
+
+}
+
+
+/*********************************** STATIC FUNCTIONS ***********************************/
+
+/// Write a number in a buffer, returns the end of the characters written (0 if the
+/// buffer is too small)
+static char* writeUnsigned(char* pFirst, char* pLast, unsigned long val)
+{
+    char buffer[24];
+    char* p = buffer + sizeof(buffer);
+
+    while (val >= 100)
+    {
+        unsigned int index = (unsigned int) (val % 100) * 2;
+        val /= 100;
+
+        p -= 2;
+        p[0] = DIGIT_PAIRS[index];
+        p[1] = DIGIT_PAIRS[index + 1];
+    }
+
+    if (val >= 10)
+    {
+        unsigned int index = (unsigned int) val * 2;
+
+        p -= 2;
+        p[0] = DIGIT_PAIRS[index];
+        p[1] = DIGIT_PAIRS[index + 1];
+    }
+    else
+    {
+        *--p = (char) ('0' + val);
+    }
+
+    size_t length = buffer + sizeof(buffer) - p;
+    if ((size_t) (pLast - pFirst) < length)
+        return 0;
+
+    memcpy(pFirst, p, length);
+    return pFirst + length;
+}
+
+//-----------------------------------------------------------------------
+
+static char* writeSigned(char* pFirst, char* pLast, long val)
+{
+    if (val >= 0)
+        return writeUnsigned(pFirst, pLast, (unsigned long) val);
+
+    if (pFirst == pLast)
+        return 0;
+
+    *pFirst = '-';
+    return writeUnsigned(pFirst + 1, pLast, 0UL - (unsigned long) val);
+}
+
+//-----------------------------------------------------------------------
+
+static char* writeString(char* pFirst, char* pLast, const char* strText)
+{
+    size_t length = strlen(strText);
+    if ((size_t) (pLast - pFirst) < length)
+        return 0;
+
+    memcpy(pFirst, strText, length);
+    return pFirst + length;
+}
+
+//-----------------------------------------------------------------------
+
+/// Layout of the bits of the floating-point types
+template<typename T> struct tFloatLayout;
+
+template<> struct tFloatLayout<float>
+{
+    typedef unsigned int tBits;
+
+    static const unsigned int SIGNIFICAND_BITS = 23;
+    static const unsigned int EXPONENT_MASK = 0xFF;
+    static const int BIAS = 150;    ///< Exponent bias, including the significand bits
+};
+
+template<> struct tFloatLayout<double>
+{
+    typedef unsigned long long tBits;
+
+    static const unsigned int SIGNIFICAND_BITS = 52;
+    static const unsigned int EXPONENT_MASK = 0x7FF;
+    static const int BIAS = 1075;   ///< Exponent bias, including the significand bits
+};
+
+//-----------------------------------------------------------------------
+
+/// Decompose a floating-point value into its significand and exponent, returns 'true' if
+/// the lower boundary of the value is closer than the upper one
+template<typename T>
+static bool decompose(T val, unsigned long long &f, int &e)
+{
+    typedef tFloatLayout<T> tLayout;
+    typedef typename tLayout::tBits tBits;
+
+    tBits bits;
+    memcpy(&bits, &val, sizeof(bits));
+
+    const tBits hiddenBit = (tBits) 1 << tLayout::SIGNIFICAND_BITS;
+
+    unsigned int exponent = (unsigned int) (bits >> tLayout::SIGNIFICAND_BITS) &
+                            tLayout::EXPONENT_MASK;
+    tBits significand = bits & (hiddenBit - 1);
+
+    if (exponent == 0)
+    {
+        f = significand;
+        e = 1 - tLayout::BIAS;
+    }
+    else
+    {
+        f = significand | hiddenBit;
+        e = (int) exponent - tLayout::BIAS;
+    }
+
+    return (significand == 0) && (exponent > 1);
+}
+
+//-----------------------------------------------------------------------
+
+static unsigned int countDigits(unsigned int val)
+{
+    unsigned int nbDigits = 1;
+    while ((nbDigits < 10) && (val >= POWERS_OF_TEN[nbDigits]))
+        ++nbDigits;
+
+    return nbDigits;
+}
+
+//-----------------------------------------------------------------------
+
+static void roundDigits(char* digits, int length, unsigned long long delta,
+                        unsigned long long rest, unsigned long long tenKappa,
+                        unsigned long long distance)
+{
+    while ((rest < distance) && (delta - rest >= tenKappa) &&
+           ((rest + tenKappa < distance) || (distance - rest > rest + tenKappa - distance)))
+    {
+        --digits[length - 1];
+        rest += tenKappa;
+    }
+}
+
+//-----------------------------------------------------------------------
+
+/// Generate the shortest digits of a positive value (Grisu2 algorithm, by Florian
+/// Loitsch). The value is digits * 10^exponent, returns the number of digits.
+static int shortestDigits(unsigned long long significand, int exponent, bool bLowerCloser,
+                          char* digits, int& decimalExponent)
+{
+    // Boundaries of the interval of the values rounded to this one
+    tDiyFp plus = tDiyFp((significand << 1) + 1, exponent - 1).normalize();
+    tDiyFp minus = (bLowerCloser ? tDiyFp((significand << 2) - 1, exponent - 2) :
+                                   tDiyFp((significand << 1) - 1, exponent - 1));
+    minus.f <<= minus.e - plus.e;
+    minus.e = plus.e;
+
+    // Scale everything with a cached power of ten, so the exponent is in [-60, -32]
+    double dk = (-61 - plus.e) * 0.30102999566398114 + 347;
+    int k = (int) dk;
+    if (dk - k > 0.0)
+        ++k;
+
+    unsigned int index = (unsigned int) ((k >> 3) + 1);
+    decimalExponent = -(-348 + (int) (index << 3));
+
+    tDiyFp power(CACHED_POWERS_SIGNIFICANDS[index], CACHED_POWERS_EXPONENTS[index]);
+
+    tDiyFp w = tDiyFp(significand, exponent).normalize() * power;
+    tDiyFp wPlus = plus * power;
+    tDiyFp wMinus = minus * power;
+    ++wMinus.f;
+    --wPlus.f;
+
+    // Generate the digits
+    unsigned long long delta = wPlus.f - wMinus.f;
+    const tDiyFp one(1ULL << -wPlus.e, wPlus.e);
+    const unsigned long long distance = (wPlus - w).f;
+
+    unsigned int p1 = (unsigned int) (wPlus.f >> -one.e);
+    unsigned long long p2 = wPlus.f & (one.f - 1);
+    int kappa = (int) countDigits(p1);
+    int length = 0;
+
+    while (kappa > 0)
+    {
+        unsigned int d = p1 / POWERS_OF_TEN[kappa - 1];
+        p1 %= POWERS_OF_TEN[kappa - 1];
+
+        if (d || length)
+            digits[length++] = (char) ('0' + d);
+
+        --kappa;
+
+        unsigned long long rest = ((unsigned long long) p1 << -one.e) + p2;
+        if (rest <= delta)
+        {
+            decimalExponent += kappa;
+            roundDigits(digits, length, delta, rest,
+                        (unsigned long long) POWERS_OF_TEN[kappa] << -one.e, distance);
+            return length;
+        }
+    }
+
+    for (;;)
+    {
+        p2 *= 10;
+        delta *= 10;
+
+        char d = (char) (p2 >> -one.e);
+        if (d || length)
+            digits[length++] = (char) ('0' + d);
+
+        p2 &= one.f - 1;
+        --kappa;
+
+        if (p2 < delta)
+        {
+            decimalExponent += kappa;
+            roundDigits(digits, length, delta, p2, one.f,
+                        distance * (-kappa < 10 ? POWERS_OF_TEN[-kappa] : 0));
+            return length;
+        }
+    }
+}
+
+//-----------------------------------------------------------------------
+
+/// Generate the shortest digits of a finite, non-zero value (its absolute value is
+/// digits * 10^exponent), without trailing zeros. Returns the number of digits.
+static int shortestDigits(Real val, char* digits, int& decimalExponent)
+{
+    unsigned long long significand;
+    int exponent;
+    bool bLowerCloser = decompose(val, significand, exponent);
+
+    int length = shortestDigits(significand, exponent, bLowerCloser, digits,
+                                decimalExponent);
+
+    while ((length > 1) && (digits[length - 1] == '0'))
+    {
+        --length;
+        ++decimalExponent;
+    }
+
+    return length;
+}
+
+//-----------------------------------------------------------------------
+
+/// Write the exponent of the scientific notation (in the same way than printf())
+static char* writeExponent(char* p, int exponent, bool bUppercase)
+{
+    *p++ = (bUppercase ? 'E' : 'e');
+    *p++ = (exponent < 0 ? '-' : '+');
+
+    if (exponent < 0)
+        exponent = -exponent;
+
+    if (exponent >= 100)
+    {
+        *p++ = (char) ('0' + exponent / 100);
+        exponent %= 100;
+    }
+
+    *p++ = DIGIT_PAIRS[exponent * 2];
+    *p++ = DIGIT_PAIRS[exponent * 2 + 1];
+
+    return p;
+}
+
+//-----------------------------------------------------------------------
+
+/// Write digits (value: 0.digits * 10^position), either in fixed or scientific notation
+static char* writeDigits(char* p, const char* digits, int length, int position,
+                         bool bScientific, bool bUppercase)
+{
+    if (bScientific)
+    {
+        *p++ = digits[0];
+
+        if (length > 1)
+        {
+            *p++ = '.';
+            memcpy(p, digits + 1, length - 1);
+            p += length - 1;
+        }
+
+        return writeExponent(p, position - 1, bUppercase);
+    }
+
+    if (position <= 0)
+    {
+        *p++ = '0';
+        *p++ = '.';
+        memset(p, '0', -position);
+        p += -position;
+        memcpy(p, digits, length);
+        return p + length;
+    }
+
+    if (position >= length)
+    {
+        memcpy(p, digits, length);
+        p += length;
+        memset(p, '0', position - length);
+        return p + position - length;
+    }
+
+    memcpy(p, digits, position);
+    p += position;
+    *p++ = '.';
+    memcpy(p, digits + position, length - position);
+    return p + length - position;
+}
+
+//-----------------------------------------------------------------------
+
+/// Format a real with printf() (for the cases not handled by the fast path)
+static char* writeRealWithPrintf(char* pFirst, char* pLast, Real val,
+                                 unsigned short precision, std::ios::fmtflags flags)
+{
+    char format[8];
+    char* p = format;
+
+    *p++ = '%';
+
+    if (flags & std::ios::showpos)
+        *p++ = '+';
+
+    if (flags & std::ios::showpoint)
+        *p++ = '#';
+
+    *p++ = '.';
+    *p++ = '*';
+
+    std::ios::fmtflags floatfield = flags & std::ios::floatfield;
+    bool bUppercase = ((flags & std::ios::uppercase) != 0);
+
+    if (floatfield == std::ios::fixed)
+        *p++ = (bUppercase ? 'F' : 'f');
+    else if (floatfield == std::ios::scientific)
+        *p++ = (bUppercase ? 'E' : 'e');
+    else
+        *p++ = (bUppercase ? 'G' : 'g');
+
+    *p = 0;
+
+    char buffer[512];
+    int length = snprintf(buffer, sizeof(buffer), format, (int) precision, (double) val);
+    if ((length < 0) || (length >= (int) sizeof(buffer)) || (length > pLast - pFirst))
+        return 0;
+
+    // The decimal point of the streams is always '.' (with the "C" locale)
+    const char* strPoint = localeconv()->decimal_point;
+    if ((strPoint[0] != '.') && (strPoint[0] != 0) && (strPoint[1] == 0))
+    {
+        char* pPoint = strchr(buffer, strPoint[0]);
+        if (pPoint)
+            *pPoint = '.';
+    }
+
+    memcpy(pFirst, buffer, length);
+    return pFirst + length;
+}
+
+//-----------------------------------------------------------------------
+
+/// Add the padding needed to reach a width, in the same way than the streams
+static string pad(const char* pNumber, size_t length, unsigned short width, char fill,
+                  std::ios::fmtflags flags)
+{
+    if (length >= width)
+        return string(pNumber, length);
+
+    string result(width, fill);
+
+    std::ios::fmtflags adjustfield = flags & std::ios::adjustfield;
+
+    if (adjustfield == std::ios::left)
+    {
+        result.replace(0, length, pNumber, length);
+    }
+    else if ((adjustfield == std::ios::internal) && (length > 0) &&
+             ((pNumber[0] == '-') || (pNumber[0] == '+')))
+    {
+        result[0] = pNumber[0];
+        result.replace(width - length + 1, length - 1, pNumber + 1, length - 1);
+    }
+    else
+    {
+        result.replace(width - length, length, pNumber, length);
+    }
+
+    return result;
+}
+
+//-----------------------------------------------------------------------
+
+static inline bool isDigit(char c)
+{
+    return (unsigned int) (c - '0') < 10;
+}
+
+//-----------------------------------------------------------------------
+
+static inline bool isWhitespace(char c)
+{
+    return (c == ' ') || ((c >= '\t') && (c <= '\r'));
+}
+
+//-----------------------------------------------------------------------
+
+static StringConverter::tParseResult parseResult(const char* pEnd,
+                                                 StringConverter::tParseError error)
+{
+    StringConverter::tParseResult result;
+    result.pEnd  = pEnd;
+    result.error = error;
+    return result;
+}
+
+//-----------------------------------------------------------------------
+
+/// Parse an integer of any type
+template<typename T>
+static StringConverter::tParseResult parseInteger(const char* pFirst, const char* pLast,
+                                                  T& val)
+{
+    const char* p = pFirst;
+    bool bNegative = false;
+
+    if ((p != pLast) && ((*p == '-') || (*p == '+')))
+    {
+        bNegative = (*p == '-');
+        ++p;
+
+        if (bNegative && !std::numeric_limits<T>::is_signed)
+            return parseResult(pFirst, StringConverter::PARSE_INVALID);
+    }
+
+    const char* pDigits = p;
+    unsigned long long value = 0;
+    bool bOverflow = false;
+
+    for (; (p != pLast) && isDigit(*p); ++p)
+    {
+        unsigned int digit = (unsigned int) (*p - '0');
+
+        if (value > (~0ULL - digit) / 10)
+            bOverflow = true;
+        else
+            value = value * 10 + digit;
+    }
+
+    if (p == pDigits)
+        return parseResult(pFirst, StringConverter::PARSE_INVALID);
+
+    unsigned long long limit = (unsigned long long) std::numeric_limits<T>::max();
+    if (bNegative)
+        ++limit;
+
+    if (bOverflow || (value > limit))
+        return parseResult(p, StringConverter::PARSE_OUT_OF_RANGE);
+
+    val = (bNegative ? (T) (0ULL - value) : (T) value);
+
+    return parseResult(p, StringConverter::PARSE_SUCCESS);
+}
+
+//-----------------------------------------------------------------------
+
+/// Decomposition of a real number in a text: value = significand * 10^exponent
+struct tParsedReal
+{
+    const char*         pEnd;           ///< End of the number
+    bool                bNegative;      ///< Indicates if the number is negative
+    unsigned long long  significand;    ///< The significant digits (at most 19)
+    int                 exponent;       ///< The decimal exponent
+    bool                bTruncated;     ///< Indicates if some non-zero digits were dropped
+};
+
+//-----------------------------------------------------------------------
+
+static bool scanReal(const char* pFirst, const char* pLast, tParsedReal& result)
+{
+    const char* p = pFirst;
+
+    result.bNegative   = false;
+    result.significand = 0;
+    result.exponent    = 0;
+    result.bTruncated  = false;
+
+    if ((p != pLast) && ((*p == '-') || (*p == '+')))
+    {
+        result.bNegative = (*p == '-');
+        ++p;
+    }
+
+    int nbDigits = 0;
+    bool bDigits = false;
+
+    // Integral part
+    for (; (p != pLast) && isDigit(*p); ++p)
+    {
+        bDigits = true;
+        unsigned int digit = (unsigned int) (*p - '0');
+
+        if ((nbDigits == 0) && (digit == 0))
+            continue;
+
+        if (nbDigits < MAX_PARSED_DIGITS)
+        {
+            result.significand = result.significand * 10 + digit;
+            ++nbDigits;
+        }
+        else
+        {
+            ++result.exponent;
+            result.bTruncated = result.bTruncated || (digit != 0);
+        }
+    }
+
+    // Fractional part
+    if ((p != pLast) && (*p == '.'))
+    {
+        ++p;
+
+        for (; (p != pLast) && isDigit(*p); ++p)
+        {
+            bDigits = true;
+            unsigned int digit = (unsigned int) (*p - '0');
+
+            if ((nbDigits == 0) && (digit == 0))
+            {
+                --result.exponent;
+            }
+            else if (nbDigits < MAX_PARSED_DIGITS)
+            {
+                result.significand = result.significand * 10 + digit;
+                ++nbDigits;
+                --result.exponent;
+            }
+            else
+            {
+                result.bTruncated = result.bTruncated || (digit != 0);
+            }
+        }
+    }
+
+    if (!bDigits)
+        return false;
+
+    // Exponent (ignored if not followed by digits)
+    if ((p != pLast) && ((*p == 'e') || (*p == 'E')))
+    {
+        const char* q = p + 1;
+        bool bNegativeExponent = false;
+
+        if ((q != pLast) && ((*q == '-') || (*q == '+')))
+        {
+            bNegativeExponent = (*q == '-');
+            ++q;
+        }
+
+        if ((q != pLast) && isDigit(*q))
+        {
+            int exponent = 0;
+            for (; (q != pLast) && isDigit(*q); ++q)
+            {
+                if (exponent < 100000)
+                    exponent = exponent * 10 + (*q - '0');
+            }
+
+            result.exponent += (bNegativeExponent ? -exponent : exponent);
+            p = q;
+        }
+    }
+
+    result.pEnd = p;
+
+    return true;
+}
+
+//-----------------------------------------------------------------------
+
+/// Compute the value of a real exactly with floating-point operations, if possible
+static bool computeRealExactly(const tParsedReal& parsed, double& val)
+{
+    if (parsed.bTruncated)
+        return false;
+
+    if (parsed.significand == 0)
+    {
+        val = (parsed.bNegative ? -0.0 : 0.0);
+        return true;
+    }
+
+    // The significand and the power of ten must be exactly representable (the result of
+    // the operation is then correctly rounded)
+    if ((parsed.significand > (1ULL << 53)) || (parsed.exponent < -22) ||
+        (parsed.exponent > 22))
+    {
+        return false;
+    }
+
+    double value = (double) parsed.significand;
+
+    if (parsed.exponent < 0)
+        value /= EXACT_POWERS_OF_TEN[-parsed.exponent];
+    else
+        value *= EXACT_POWERS_OF_TEN[parsed.exponent];
+
+    val = (parsed.bNegative ? -value : value);
+
+    return true;
+}
+
+//-----------------------------------------------------------------------
+
+/// Parse a real with the C library (for the cases not handled by the fast path). The
+/// decimal point is replaced by the one of the current locale.
+template<typename T>
+static T parseRealWithStrtod(const char* pFirst, const char* pEnd)
+{
+    std::string strNumber(pFirst, pEnd);
+
+    const char* strPoint = localeconv()->decimal_point;
+    if ((strPoint[0] != '.') && (strPoint[0] != 0) && (strPoint[1] == 0))
+    {
+        size_t offset = strNumber.find('.');
+        if (offset != std::string::npos)
+            strNumber[offset] = strPoint[0];
+    }
+
+    if (sizeof(T) == sizeof(float))
+        return (T) strtof(strNumber.c_str(), 0);
+
+    return (T) strtod(strNumber.c_str(), 0);
+}
+
+//-----------------------------------------------------------------------
+
+/// Format an integer with a stream (for the bases other than 10)
+template<typename T>
+static string toStringWithStream(T val, unsigned short width, char fill,
+                                 std::ios::fmtflags flags)
 {
     stringstream stream;
-    stream.precision(precision);
     stream.width(width);
     stream.fill(fill);
     if (flags)
@@ -33,16 +830,77 @@ string StringConverter::toString(Real val, unsigned short precision, unsigned sh
 
 //-----------------------------------------------------------------------
 
+/// Format an integer in base 10
+template<typename T>
+static string integerToString(T val, unsigned short width, char fill,
+                              std::ios::fmtflags flags, bool bSigned)
+{
+    std::ios::fmtflags basefield = flags & std::ios::basefield;
+    if ((basefield == std::ios::hex) || (basefield == std::ios::oct))
+        return toStringWithStream(val, width, fill, flags);
+
+    char buffer[StringConverter::MAX_NUMBER_LENGTH];
+    char* p = buffer;
+
+    if (bSigned && (flags & std::ios::showpos) && (val >= 0))
+        *p++ = '+';
+
+    p = StringConverter::toChars(p, buffer + sizeof(buffer), val);
+
+    return pad(buffer, p - buffer, width, fill, flags);
+}
+
+//-----------------------------------------------------------------------
+
+/// Parse a number at the beginning of a string (after the whitespaces), returns 0 in
+/// case of error
+template<typename T>
+static T parseNumber(const std::string& strText)
+{
+    const char* pFirst = strText.data();
+    const char* pLast = pFirst + strText.size();
+
+    while ((pFirst != pLast) && isWhitespace(*pFirst))
+        ++pFirst;
+
+    T value = 0;
+    if (StringConverter::fromChars(pFirst, pLast, value).error != StringConverter::PARSE_SUCCESS)
+        return 0;
+
+    return value;
+}
+
+
+/************************************* STATIC METHODS ***********************************/
+
+string StringConverter::toString(Real val, unsigned short precision, unsigned short width,
+                                 char fill, std::ios::fmtflags flags)
+{
+    char buffer[512];
+    char* p = toChars(buffer, buffer + sizeof(buffer), val, precision, flags);
+
+    // Number too long for the buffer: let a stream handle it
+    if (!p)
+    {
+        stringstream stream;
+        stream.precision(precision);
+        stream.width(width);
+        stream.fill(fill);
+        if (flags)
+            stream.setf(flags);
+        stream << val;
+        return stream.str();
+    }
+
+    return pad(buffer, p - buffer, width, fill, flags);
+}
+
+//-----------------------------------------------------------------------
+
 string StringConverter::toString(int val, unsigned short width, char fill,
                                  std::ios::fmtflags flags)
 {
-    stringstream stream;
-    stream.width(width);
-    stream.fill(fill);
-    if (flags)
-        stream.setf(flags);
-    stream << val;
-    return stream.str();
+    return integerToString(val, width, fill, flags, true);
 }
 
 //-----------------------------------------------------------------------
@@ -50,13 +908,7 @@ string StringConverter::toString(int val, unsigned short width, char fill,
 string StringConverter::toString(unsigned int val, unsigned short width, char fill,
                                  std::ios::fmtflags flags)
 {
-    stringstream stream;
-    stream.width(width);
-    stream.fill(fill);
-    if (flags)
-        stream.setf(flags);
-    stream << val;
-    return stream.str();
+    return integerToString(val, width, fill, flags, false);
 }
 
 //-----------------------------------------------------------------------
@@ -64,13 +916,7 @@ string StringConverter::toString(unsigned int val, unsigned short width, char fi
 string StringConverter::toString(unsigned long val, unsigned short width, char fill,
                                  std::ios::fmtflags flags)
 {
-    stringstream stream;
-    stream.width(width);
-    stream.fill(fill);
-    if (flags)
-        stream.setf(flags);
-    stream << val;
-    return stream.str();
+    return integerToString(val, width, fill, flags, false);
 }
 
 //-----------------------------------------------------------------------
@@ -78,13 +924,243 @@ string StringConverter::toString(unsigned long val, unsigned short width, char f
 string StringConverter::toString(long val, unsigned short width, char fill,
                                  std::ios::fmtflags flags)
 {
-    stringstream stream;
-    stream.width(width);
-    stream.fill(fill);
-    if (flags)
-        stream.setf(flags);
-    stream << val;
-    return stream.str();
+    return integerToString(val, width, fill, flags, true);
+}
+
+//-----------------------------------------------------------------------
+
+char* StringConverter::toChars(char* pFirst, char* pLast, int val)
+{
+    return writeSigned(pFirst, pLast, val);
+}
+
+//-----------------------------------------------------------------------
+
+char* StringConverter::toChars(char* pFirst, char* pLast, unsigned int val)
+{
+    return writeUnsigned(pFirst, pLast, val);
+}
+
+//-----------------------------------------------------------------------
+
+char* StringConverter::toChars(char* pFirst, char* pLast, long val)
+{
+    return writeSigned(pFirst, pLast, val);
+}
+
+//-----------------------------------------------------------------------
+
+char* StringConverter::toChars(char* pFirst, char* pLast, unsigned long val)
+{
+    return writeUnsigned(pFirst, pLast, val);
+}
+
+//-----------------------------------------------------------------------
+
+char* StringConverter::toChars(char* pFirst, char* pLast, Real val)
+{
+    if (val != val)
+        return writeString(pFirst, pLast, "nan");
+
+    bool bNegative = (val < 0) || ((val == 0) && (1 / val < 0));
+
+    if (val - val != 0)
+        return writeString(pFirst, pLast, bNegative ? "-inf" : "inf");
+
+    char buffer[MAX_NUMBER_LENGTH];
+    char* p = buffer;
+
+    if (bNegative)
+        *p++ = '-';
+
+    if (val == 0)
+    {
+        *p++ = '0';
+    }
+    else
+    {
+        char digits[20];
+        int exponent;
+        int length = shortestDigits(val, digits, exponent);
+
+        int position = length + exponent;
+        p = writeDigits(p, digits, length, position, (position < -3) || (position > 17),
+                        false);
+    }
+
+    size_t length = p - buffer;
+    if ((size_t) (pLast - pFirst) < length)
+        return 0;
+
+    memcpy(pFirst, buffer, length);
+    return pFirst + length;
+}
+
+//-----------------------------------------------------------------------
+
+char* StringConverter::toChars(char* pFirst, char* pLast, Real val,
+                               unsigned short precision, std::ios::fmtflags flags)
+{
+    // Only the default notation (the one of "%g") without the 'showpoint' flag is
+    // handled here
+    if ((val != val) || (val - val != 0) || (precision > MAX_SHORTEST_PRECISION) ||
+        (flags & (std::ios::floatfield | std::ios::showpoint)))
+    {
+        return writeRealWithPrintf(pFirst, pLast, val, precision, flags);
+    }
+
+    if (precision == 0)
+        precision = 1;
+
+    char buffer[MAX_NUMBER_LENGTH];
+    char* p = buffer;
+
+    if ((val < 0) || ((val == 0) && (1 / val < 0)))
+        *p++ = '-';
+    else if (flags & std::ios::showpos)
+        *p++ = '+';
+
+    if (val == 0)
+    {
+        *p++ = '0';
+    }
+    else
+    {
+        char digits[20];
+        int exponent;
+        int length = shortestDigits(val, digits, exponent);
+
+        // When the shortest form has more digits than the precision, rounding it might
+        // not give the same result than rounding the exact value (same thing for the
+        // denormalized values, less precise)
+        if ((length > precision) || (fabs(val) < std::numeric_limits<Real>::min()))
+            return writeRealWithPrintf(pFirst, pLast, val, precision, flags);
+
+        int position = length + exponent;
+        p = writeDigits(p, digits, length, position,
+                        (position - 1 < -4) || (position - 1 >= precision),
+                        (flags & std::ios::uppercase) != 0);
+    }
+
+    size_t length = p - buffer;
+    if ((size_t) (pLast - pFirst) < length)
+        return 0;
+
+    memcpy(pFirst, buffer, length);
+    return pFirst + length;
+}
+
+//-----------------------------------------------------------------------
+
+StringConverter::tParseResult StringConverter::fromChars(const char* pFirst,
+                                                        const char* pLast, int& val)
+{
+    return parseInteger(pFirst, pLast, val);
+}
+
+//-----------------------------------------------------------------------
+
+StringConverter::tParseResult StringConverter::fromChars(const char* pFirst,
+                                                        const char* pLast, short& val)
+{
+    return parseInteger(pFirst, pLast, val);
+}
+
+//-----------------------------------------------------------------------
+
+StringConverter::tParseResult StringConverter::fromChars(const char* pFirst,
+                                                        const char* pLast, long& val)
+{
+    return parseInteger(pFirst, pLast, val);
+}
+
+//-----------------------------------------------------------------------
+
+StringConverter::tParseResult StringConverter::fromChars(const char* pFirst,
+                                                        const char* pLast,
+                                                        unsigned int& val)
+{
+    return parseInteger(pFirst, pLast, val);
+}
+
+//-----------------------------------------------------------------------
+
+StringConverter::tParseResult StringConverter::fromChars(const char* pFirst,
+                                                        const char* pLast,
+                                                        unsigned short& val)
+{
+    return parseInteger(pFirst, pLast, val);
+}
+
+//-----------------------------------------------------------------------
+
+StringConverter::tParseResult StringConverter::fromChars(const char* pFirst,
+                                                        const char* pLast,
+                                                        unsigned long& val)
+{
+    return parseInteger(pFirst, pLast, val);
+}
+
+//-----------------------------------------------------------------------
+
+StringConverter::tParseResult StringConverter::fromChars(const char* pFirst,
+                                                        const char* pLast, float& val)
+{
+    tParsedReal parsed;
+    if (!scanReal(pFirst, pLast, parsed))
+        return parseResult(pFirst, PARSE_INVALID);
+
+    float value;
+    double exact;
+
+    if (computeRealExactly(parsed, exact) && (fabs(exact) >= FLT_MIN))
+    {
+        // Rounding the correctly rounded double gives the correctly rounded float,
+        // except if the double is exactly halfway between two floats
+        unsigned long long bits;
+        memcpy(&bits, &exact, sizeof(bits));
+
+        if ((bits & 0x1FFFFFFFULL) != 0x10000000ULL)
+            value = (float) exact;
+        else
+            value = parseRealWithStrtod<float>(pFirst, parsed.pEnd);
+    }
+    else if ((parsed.significand == 0) && !parsed.bTruncated)
+    {
+        value = (float) exact;
+    }
+    else
+    {
+        value = parseRealWithStrtod<float>(pFirst, parsed.pEnd);
+    }
+
+    // Overflow (infinite) or underflow (a non-zero value rounded to zero)
+    if ((value - value != 0) || ((value == 0) && (parsed.significand != 0)))
+        return parseResult(parsed.pEnd, PARSE_OUT_OF_RANGE);
+
+    val = value;
+    return parseResult(parsed.pEnd, PARSE_SUCCESS);
+}
+
+//-----------------------------------------------------------------------
+
+StringConverter::tParseResult StringConverter::fromChars(const char* pFirst,
+                                                        const char* pLast, double& val)
+{
+    tParsedReal parsed;
+    if (!scanReal(pFirst, pLast, parsed))
+        return parseResult(pFirst, PARSE_INVALID);
+
+    double value;
+    if (!computeRealExactly(parsed, value))
+        value = parseRealWithStrtod<double>(pFirst, parsed.pEnd);
+
+    // Overflow (infinite) or underflow (a non-zero value rounded to zero)
+    if ((value - value != 0) || ((value == 0) && (parsed.significand != 0)))
+        return parseResult(parsed.pEnd, PARSE_OUT_OF_RANGE);
+
+    val = value;
+    return parseResult(parsed.pEnd, PARSE_SUCCESS);
 }
 
 //-----------------------------------------------------------------------
@@ -119,58 +1195,35 @@ string StringConverter::toString(bool val, bool yesNo)
 
 Real StringConverter::parseReal(const std::string& val)
 {
-    // Use istringstream for direct correspondence with toString
-    istringstream str(val);
-    Real ret = 0;
-    str >> ret;
-
-    return ret;
+    return parseNumber<Real>(val);
 }
 
 //-----------------------------------------------------------------------
+
 int StringConverter::parseInt(const std::string& val)
 {
-    // Use istringstream for direct correspondence with toString
-    istringstream str(val);
-    int ret = 0;
-    str >> ret;
-
-    return ret;
+    return parseNumber<int>(val);
 }
 
 //-----------------------------------------------------------------------
+
 unsigned int StringConverter::parseUnsignedInt(const std::string& val)
 {
-    // Use istringstream for direct correspondence with toString
-    istringstream str(val);
-    unsigned int ret = 0;
-    str >> ret;
-
-    return ret;
+    return parseNumber<unsigned int>(val);
 }
 
 //-----------------------------------------------------------------------
 
 long StringConverter::parseLong(const std::string& val)
 {
-    // Use istringstream for direct correspondence with toString
-    istringstream str(val);
-    long ret = 0;
-    str >> ret;
-
-    return ret;
+    return parseNumber<long>(val);
 }
 
 //-----------------------------------------------------------------------
 
 unsigned long StringConverter::parseUnsignedLong(const std::string& val)
 {
-    // Use istringstream for direct correspondence with toString
-    istringstream str(val);
-    unsigned long ret = 0;
-    str >> ret;
-
-    return ret;
+    return parseNumber<unsigned long>(val);
 }
 
 //-----------------------------------------------------------------------
@@ -185,8 +1238,14 @@ bool StringConverter::parseBool(const std::string& val)
 
 bool StringConverter::isNumber(const std::string& val)
 {
-    istringstream str(val);
-    float tst;
-    str >> tst;
-    return !str.fail() && str.eof();
+    const char* pFirst = val.data();
+    const char* pLast = pFirst + val.size();
+
+    while ((pFirst != pLast) && isWhitespace(*pFirst))
+        ++pFirst;
+
+    float number;
+    tParseResult result = fromChars(pFirst, pLast, number);
+
+    return (result.error == PARSE_SUCCESS) && (result.pEnd == pLast);
 }
@@ -0,0 +1,226 @@
+/** @file   StringReplacer.cpp
+    @author Philip Abbet
+
+    Implementation of the class 'Athena::Utils::StringReplacer'
+*/
+
+#include <Athena-Core/Utils/StringReplacer.h>
+#include <string.h>
+
+using namespace Athena::Utils;
+
+
+/****************************** CONSTRUCTION / DESTRUCTION ******************************/
+
+StringReplacer::StringReplacer(const StringUtils::tReplacementsList& replacements)
+: m_nbClasses(1)
+{
+    // The alphabet of the automaton only contains the characters used by the
+    // sub-strings (all the other ones are in the class 0)
+    memset(m_classes, 0, sizeof(m_classes));
+
+    for (StringUtils::tReplacementsList::const_iterator iter = replacements.begin();
+         iter != replacements.end(); ++iter)
+    {
+        if (iter->first.empty())
+            continue;
+
+        m_replacements.push_back(*iter);
+
+        for (size_t i = 0; i < iter->first.size(); ++i)
+        {
+            unsigned char c = (unsigned char) iter->first[i];
+            if (m_classes[c] == 0)
+                m_classes[c] = (unsigned short) m_nbClasses++;
+        }
+
+        if (m_strFirstCharacters.find(iter->first[0]) == std::string::npos)
+            m_strFirstCharacters += iter->first[0];
+    }
+
+    // Build the trie of the sub-strings (state 0 is the root)
+    m_transitions.assign(m_nbClasses, -1);
+    m_matches.push_back(-1);
+    m_depths.push_back(0);
+
+    for (unsigned int i = 0; i < m_replacements.size(); ++i)
+    {
+        const std::string& strWhat = m_replacements[i].first;
+
+        int state = 0;
+        for (size_t j = 0; j < strWhat.size(); ++j)
+        {
+            int& next = m_transitions[state * m_nbClasses + m_classes[(unsigned char) strWhat[j]]];
+            if (next == -1)
+            {
+                next = (int) m_matches.size();
+
+                m_transitions.resize(m_transitions.size() + m_nbClasses, -1);
+                m_matches.push_back(-1);
+                m_depths.push_back((unsigned int) j + 1);
+            }
+
+            state = m_transitions[state * m_nbClasses + m_classes[(unsigned char) strWhat[j]]];
+        }
+
+        // Only the first replacement of a sub-string is used
+        if (m_matches[state] == -1)
+            m_matches[state] = (int) i;
+    }
+
+    // Complete the transitions, following the failure links (computed in breadth-first
+    // order, so the ones of the shorter prefixes are known)
+    std::vector<int> failures(m_matches.size(), 0);
+    std::vector<int> queue;
+    queue.reserve(m_matches.size());
+
+    for (unsigned int c = 0; c < m_nbClasses; ++c)
+    {
+        int& next = m_transitions[c];
+        if (next == -1)
+        {
+            next = 0;
+        }
+        else
+        {
+            failures[next] = 0;
+            queue.push_back(next);
+        }
+    }
+
+    for (size_t i = 0; i < queue.size(); ++i)
+    {
+        int state = queue[i];
+
+        // The longest sub-string ending at a state is either its own, or the one of its
+        // failure state
+        if (m_matches[state] == -1)
+            m_matches[state] = m_matches[failures[state]];
+
+        for (unsigned int c = 0; c < m_nbClasses; ++c)
+        {
+            int& next = m_transitions[state * m_nbClasses + c];
+            int fallback = m_transitions[failures[state] * m_nbClasses + c];
+
+            if (next == -1)
+            {
+                next = fallback;
+            }
+            else
+            {
+                failures[next] = fallback;
+                queue.push_back(next);
+            }
+        }
+    }
+}
+
+//-----------------------------------------------------------------------
+
+StringReplacer::~StringReplacer()
+{
+}
+
+
+/*************************************** METHODS ****************************************/
+
+std::string StringReplacer::replace(const StringView& text) const
+{
+    std::string result;
+    result.reserve(text.size());
+
+    replace(text, result);
+
+    return result;
+}
+
+//-----------------------------------------------------------------------
+
+unsigned int StringReplacer::replaceAll(std::string& str) const
+{
+    std::string result;
+    result.reserve(str.size());
+
+    unsigned int nbReplacements = replace(str, result);
+    if (nbReplacements > 0)
+        str.swap(result);
+
+    return nbReplacements;
+}
+
+//-----------------------------------------------------------------------
+
+unsigned int StringReplacer::replace(const StringView& text, std::string& result) const
+{
+    const char* pText = text.data();
+    const size_t length = text.size();
+
+    unsigned int nbReplacements = 0;
+    size_t copied = 0;      // Position of the first character not copied yet
+    size_t pos = 0;         // Position of the next character to process
+
+    while (pos < length)
+    {
+        int state = 0;
+
+        // Best match found so far (the leftmost, then the longest)
+        int match = -1;
+        size_t matchStart = 0;
+
+        for (; pos < length; ++pos)
+        {
+            // Outside of any sub-string, skip the characters that can't begin one (several
+            // at a time)
+            if ((state == 0) && (match == -1))
+            {
+                size_t next = StringUtils::findFirstOf(StringView(pText + pos, length - pos),
+                                                       m_strFirstCharacters);
+                if (next == StringView::npos)
+                {
+                    pos = length;
+                    break;
+                }
+
+                pos += next;
+            }
+
+            state = m_transitions[state * m_nbClasses + m_classes[(unsigned char) pText[pos]]];
+
+            int candidate = m_matches[state];
+            if (candidate >= 0)
+            {
+                size_t start = pos + 1 - m_replacements[candidate].first.size();
+                if ((match == -1) || (start < matchStart) ||
+                    ((start == matchStart) &&
+                     (m_replacements[candidate].first.size() > m_replacements[match].first.size())))
+                {
+                    match = candidate;
+                    matchStart = start;
+                }
+            }
+
+            // No sub-string found later can begin before (or at) the best match
+            if ((match >= 0) && (matchStart + m_depths[state] < pos + 1))
+            {
+                ++pos;
+                break;
+            }
+        }
+
+        if (match == -1)
+            break;
+
+        result.append(pText + copied, matchStart - copied);
+        result.append(m_replacements[match].second);
+        ++nbReplacements;
+
+        // Continue after the sub-string (the characters following it might have been
+        // examined already, but they might belong to another sub-string)
+        copied = matchStart + m_replacements[match].first.size();
+        pos = copied;
+    }
+
+    result.append(pText + copied, length - copied);
+
+    return nbReplacements;
+}
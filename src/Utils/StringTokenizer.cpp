@@ -0,0 +1,132 @@
+/** @file   StringTokenizer.cpp
+    @author Philip Abbet
+
+    Implementation of the class 'Athena::Utils::StringTokenizer'
+*/
+
+#include <Athena-Core/Utils/StringTokenizer.h>
+#include <Athena-Core/Utils/StringUtils.h>
+#include <Athena-Core/Data/DataStream.h>
+#include <string.h>
+
+using namespace Athena::Utils;
+using namespace Athena::Data;
+
+
+/****************************** CONSTRUCTION / DESTRUCTION ******************************/
+
+StringTokenizer::StringTokenizer(const StringView& text, const StringView& delims)
+: m_pCurrent(text.begin()), m_pEnd(text.end()), m_bFinished(false), m_pStream(0)
+{
+    setDelimiters(delims);
+}
+
+//-----------------------------------------------------------------------
+
+StringTokenizer::StringTokenizer(DataStream* pStream, const StringView& delims,
+                                 size_t bufferSize)
+: m_pCurrent(0), m_pEnd(0), m_bFinished(false), m_pStream(pStream),
+  m_buffer(bufferSize > 0 ? bufferSize : 1)
+{
+    assert(pStream);
+
+    setDelimiters(delims);
+
+    m_pCurrent = &m_buffer[0];
+    m_pEnd = m_pCurrent;
+}
+
+//-----------------------------------------------------------------------
+
+StringTokenizer::~StringTokenizer()
+{
+}
+
+
+/*************************************** METHODS ****************************************/
+
+bool StringTokenizer::next(StringView& token)
+{
+    if (m_bFinished)
+        return false;
+
+    const char* pDelimiter = findDelimiter(m_pCurrent);
+
+    // When reading a stream, read more text until a delimiter is found (the characters
+    // already examined don't need to be looked at again)
+    while (!pDelimiter && m_pStream)
+    {
+        size_t examined = m_pEnd - m_pCurrent;
+
+        if (!refill())
+            break;
+
+        pDelimiter = findDelimiter(m_pCurrent + examined);
+    }
+
+    if (pDelimiter)
+    {
+        token = StringView(m_pCurrent, pDelimiter - m_pCurrent);
+        m_pCurrent = pDelimiter + 1;
+    }
+    else
+    {
+        // The rest of the text is the last token
+        token = StringView(m_pCurrent, m_pEnd - m_pCurrent);
+        m_pCurrent = m_pEnd;
+        m_bFinished = true;
+    }
+
+    return true;
+}
+
+//-----------------------------------------------------------------------
+
+void StringTokenizer::setDelimiters(const StringView& delims)
+{
+    memset(m_delimiters, 0, sizeof(m_delimiters));
+
+    m_strDelimiters.clear();
+
+    for (StringView::const_iterator iter = delims.begin(); iter != delims.end(); ++iter)
+    {
+        if (!m_delimiters[(unsigned char) *iter])
+        {
+            m_delimiters[(unsigned char) *iter] = true;
+            m_strDelimiters += *iter;
+        }
+    }
+}
+
+//-----------------------------------------------------------------------
+
+const char* StringTokenizer::findDelimiter(const char* pStart) const
+{
+    size_t pos = StringUtils::findFirstOf(StringView(pStart, m_pEnd - pStart), m_strDelimiters);
+    return (pos != StringView::npos ? pStart + pos : 0);
+}
+
+//-----------------------------------------------------------------------
+
+bool StringTokenizer::refill()
+{
+    size_t offset = m_pCurrent - &m_buffer[0];
+    size_t remaining = m_pEnd - m_pCurrent;
+
+    // Move the characters not processed yet at the beginning of the buffer (growing it
+    // if they already fill it)
+    if (remaining == m_buffer.size())
+        m_buffer.resize(m_buffer.size() * 2);
+
+    char* pBuffer = &m_buffer[0];
+
+    if ((remaining > 0) && (offset > 0))
+        memmove(pBuffer, pBuffer + offset, remaining);
+
+    size_t nbRead = m_pStream->read(pBuffer + remaining, m_buffer.size() - remaining);
+
+    m_pCurrent = pBuffer;
+    m_pEnd = pBuffer + remaining + nbRead;
+
+    return (nbRead > 0);
+}
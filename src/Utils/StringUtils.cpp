@@ -8,24 +8,531 @@
 */
 
 #include <Athena-Core/Utils/StringUtils.h>
+#include <Athena-Core/Utils/StringReplacer.h>
+#include <Athena-Core/Utils/StringTokenizer.h>
+#include <ctype.h>
+#include <string.h>
+
+#if defined(__x86_64__) || defined(_M_X64)
+    #define HAS_SIMD
+
+    #if defined(_MSC_VER)
+        #include <intrin.h>
+        #include <immintrin.h>
+        #define TARGET_AVX2
+    #else
+        #include <immintrin.h>
+        #define TARGET_AVX2 __attribute__((target("avx2")))
+    #endif
+#endif
 
 using namespace Athena::Utils;
 using namespace std;
 
 
+/************************************** CONSTANTS ***************************************/
+
+/// Maximum number of delimiters searched with SIMD instructions by findFirstOf()
+static const size_t MAX_SIMD_DELIMITERS = 16;
+
+
+/*********************************** INTERNAL TYPES *************************************/
+
+namespace {
+
+typedef void (*tChangeCaseFunction)(char* pText, size_t length);
+
+typedef size_t (*tFindFirstOfFunction)(const char* pText, size_t length,
+                                       const char* pDelims, size_t nbDelims);
+
+typedef size_t (*tSkipWhitespacesFunction)(const char* pText, size_t length);
+
+
+/// The implementations of the methods for an instruction set
+struct tKernels
+{
+    tChangeCaseFunction         toLowerCase;
+    tChangeCaseFunction         toUpperCase;
+    tFindFirstOfFunction        findFirstOf;
+    tSkipWhitespacesFunction    skipLeft;       ///< Returns the position of the first non-whitespace
+    tSkipWhitespacesFunction    skipRight;      ///< Returns the position after the last non-whitespace
+};
+
+}
+
+
+/************************************ SCALAR KERNELS ************************************/
+
+static inline bool isWhitespace(char c)
+{
+    return (c == ' ') || (c == '\t') || (c == '\r');
+}
+
+//-----------------------------------------------------------------------
+
+static inline bool isOneOf(char c, const char* pDelims, size_t nbDelims)
+{
+    for (size_t i = 0; i < nbDelims; ++i)
+    {
+        if (c == pDelims[i])
+            return true;
+    }
+
+    return false;
+}
+
+//-----------------------------------------------------------------------
+
+static void scalarToLowerCase(char* pText, size_t length)
+{
+    for (size_t i = 0; i < length; ++i)
+    {
+        if ((unsigned char) (pText[i] - 'A') < 26)
+            pText[i] += 'a' - 'A';
+    }
+}
+
+//-----------------------------------------------------------------------
+
+static void scalarToUpperCase(char* pText, size_t length)
+{
+    for (size_t i = 0; i < length; ++i)
+    {
+        if ((unsigned char) (pText[i] - 'a') < 26)
+            pText[i] -= 'a' - 'A';
+    }
+}
+
+//-----------------------------------------------------------------------
+
+static size_t scalarFindFirstOf(const char* pText, size_t length, const char* pDelims,
+                                size_t nbDelims)
+{
+    unsigned int delimiters[256 / 32] = { 0 };
+
+    for (size_t i = 0; i < nbDelims; ++i)
+    {
+        unsigned char c = (unsigned char) pDelims[i];
+        delimiters[c >> 5] |= (1U << (c & 31));
+    }
+
+    for (size_t i = 0; i < length; ++i)
+    {
+        unsigned char c = (unsigned char) pText[i];
+        if (delimiters[c >> 5] & (1U << (c & 31)))
+            return i;
+    }
+
+    return StringView::npos;
+}
+
+//-----------------------------------------------------------------------
+
+static size_t scalarSkipLeft(const char* pText, size_t length)
+{
+    size_t i = 0;
+    while ((i < length) && isWhitespace(pText[i]))
+        ++i;
+
+    return i;
+}
+
+//-----------------------------------------------------------------------
+
+static size_t scalarSkipRight(const char* pText, size_t length)
+{
+    while ((length > 0) && isWhitespace(pText[length - 1]))
+        --length;
+
+    return length;
+}
+
+
+/************************************* SSE2 KERNELS *************************************/
+
+#ifdef HAS_SIMD
+
+static inline unsigned int firstBit(unsigned int mask)
+{
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return (unsigned int) index;
+#else
+    return (unsigned int) __builtin_ctz(mask);
+#endif
+}
+
+//-----------------------------------------------------------------------
+
+static inline unsigned int lastBit(unsigned int mask)
+{
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanReverse(&index, mask);
+    return (unsigned int) index;
+#else
+    return 31 - (unsigned int) __builtin_clz(mask);
+#endif
+}
+
+//-----------------------------------------------------------------------
+
+/// Flip the bit 5 of the characters in [first, first + 25]
+static inline void sse2ChangeCase(char* pText, size_t length, char first)
+{
+    const __m128i before = _mm_set1_epi8(first - 1);
+    const __m128i after  = _mm_set1_epi8(first + 26);
+    const __m128i flip   = _mm_set1_epi8('a' - 'A');
+
+    size_t i = 0;
+    for (; i + 16 <= length; i += 16)
+    {
+        __m128i v = _mm_loadu_si128((const __m128i*) (pText + i));
+
+        // The characters >= 0x80 are negative, so never in the range
+        __m128i mask = _mm_and_si128(_mm_cmpgt_epi8(v, before), _mm_cmplt_epi8(v, after));
+
+        _mm_storeu_si128((__m128i*) (pText + i), _mm_xor_si128(v, _mm_and_si128(mask, flip)));
+    }
+
+    if (first == 'A')
+        scalarToLowerCase(pText + i, length - i);
+    else
+        scalarToUpperCase(pText + i, length - i);
+}
+
+//-----------------------------------------------------------------------
+
+static void sse2ToLowerCase(char* pText, size_t length)
+{
+    sse2ChangeCase(pText, length, 'A');
+}
+
+//-----------------------------------------------------------------------
+
+static void sse2ToUpperCase(char* pText, size_t length)
+{
+    sse2ChangeCase(pText, length, 'a');
+}
+
+//-----------------------------------------------------------------------
+
+static size_t sse2FindFirstOf(const char* pText, size_t length, const char* pDelims,
+                              size_t nbDelims)
+{
+    if (nbDelims > MAX_SIMD_DELIMITERS)
+        return scalarFindFirstOf(pText, length, pDelims, nbDelims);
+
+    __m128i delimiters[MAX_SIMD_DELIMITERS];
+    for (size_t j = 0; j < nbDelims; ++j)
+        delimiters[j] = _mm_set1_epi8(pDelims[j]);
+
+    size_t i = 0;
+    for (; i + 16 <= length; i += 16)
+    {
+        __m128i v = _mm_loadu_si128((const __m128i*) (pText + i));
+
+        __m128i found = _mm_cmpeq_epi8(v, delimiters[0]);
+        for (size_t j = 1; j < nbDelims; ++j)
+            found = _mm_or_si128(found, _mm_cmpeq_epi8(v, delimiters[j]));
+
+        unsigned int mask = (unsigned int) _mm_movemask_epi8(found);
+        if (mask)
+            return i + firstBit(mask);
+    }
+
+    for (; i < length; ++i)
+    {
+        if (isOneOf(pText[i], pDelims, nbDelims))
+            return i;
+    }
+
+    return StringView::npos;
+}
+
+//-----------------------------------------------------------------------
+
+static inline unsigned int sse2WhitespacesMask(const char* pText)
+{
+    __m128i v = _mm_loadu_si128((const __m128i*) pText);
+
+    __m128i found = _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8(' ')),
+                                 _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('\t')),
+                                              _mm_cmpeq_epi8(v, _mm_set1_epi8('\r'))));
+
+    return (unsigned int) _mm_movemask_epi8(found);
+}
+
+//-----------------------------------------------------------------------
+
+static size_t sse2SkipLeft(const char* pText, size_t length)
+{
+    size_t i = 0;
+    for (; i + 16 <= length; i += 16)
+    {
+        unsigned int mask = ~sse2WhitespacesMask(pText + i) & 0xFFFF;
+        if (mask)
+            return i + firstBit(mask);
+    }
+
+    return i + scalarSkipLeft(pText + i, length - i);
+}
+
+//-----------------------------------------------------------------------
+
+static size_t sse2SkipRight(const char* pText, size_t length)
+{
+    for (; length >= 16; length -= 16)
+    {
+        unsigned int mask = ~sse2WhitespacesMask(pText + length - 16) & 0xFFFF;
+        if (mask)
+            return length - 16 + lastBit(mask) + 1;
+    }
+
+    return scalarSkipRight(pText, length);
+}
+
+
+/************************************* AVX2 KERNELS *************************************/
+
+/// Flip the bit 5 of the characters in [first, first + 25]
+TARGET_AVX2 static inline void avx2ChangeCase(char* pText, size_t length, char first)
+{
+    const __m256i before = _mm256_set1_epi8(first - 1);
+    const __m256i after  = _mm256_set1_epi8(first + 26);
+    const __m256i flip   = _mm256_set1_epi8('a' - 'A');
+
+    size_t i = 0;
+    for (; i + 32 <= length; i += 32)
+    {
+        __m256i v = _mm256_loadu_si256((const __m256i*) (pText + i));
+
+        __m256i mask = _mm256_and_si256(_mm256_cmpgt_epi8(v, before),
+                                        _mm256_cmpgt_epi8(after, v));
+
+        _mm256_storeu_si256((__m256i*) (pText + i),
+                            _mm256_xor_si256(v, _mm256_and_si256(mask, flip)));
+    }
+
+    sse2ChangeCase(pText + i, length - i, first);
+}
+
+//-----------------------------------------------------------------------
+
+TARGET_AVX2 static void avx2ToLowerCase(char* pText, size_t length)
+{
+    avx2ChangeCase(pText, length, 'A');
+}
+
+//-----------------------------------------------------------------------
+
+TARGET_AVX2 static void avx2ToUpperCase(char* pText, size_t length)
+{
+    avx2ChangeCase(pText, length, 'a');
+}
+
+//-----------------------------------------------------------------------
+
+TARGET_AVX2 static size_t avx2FindFirstOf(const char* pText, size_t length,
+                                          const char* pDelims, size_t nbDelims)
+{
+    if (nbDelims > MAX_SIMD_DELIMITERS)
+        return scalarFindFirstOf(pText, length, pDelims, nbDelims);
+
+    __m256i delimiters[MAX_SIMD_DELIMITERS];
+    for (size_t j = 0; j < nbDelims; ++j)
+        delimiters[j] = _mm256_set1_epi8(pDelims[j]);
+
+    size_t i = 0;
+    for (; i + 32 <= length; i += 32)
+    {
+        __m256i v = _mm256_loadu_si256((const __m256i*) (pText + i));
+
+        __m256i found = _mm256_cmpeq_epi8(v, delimiters[0]);
+        for (size_t j = 1; j < nbDelims; ++j)
+            found = _mm256_or_si256(found, _mm256_cmpeq_epi8(v, delimiters[j]));
+
+        unsigned int mask = (unsigned int) _mm256_movemask_epi8(found);
+        if (mask)
+            return i + firstBit(mask);
+    }
+
+    size_t pos = sse2FindFirstOf(pText + i, length - i, pDelims, nbDelims);
+    return (pos != StringView::npos ? i + pos : pos);
+}
+
+//-----------------------------------------------------------------------
+
+TARGET_AVX2 static inline unsigned int avx2WhitespacesMask(const char* pText)
+{
+    __m256i v = _mm256_loadu_si256((const __m256i*) pText);
+
+    __m256i found = _mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8(' ')),
+                                    _mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8('\t')),
+                                                    _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\r'))));
+
+    return (unsigned int) _mm256_movemask_epi8(found);
+}
+
+//-----------------------------------------------------------------------
+
+TARGET_AVX2 static size_t avx2SkipLeft(const char* pText, size_t length)
+{
+    size_t i = 0;
+    for (; i + 32 <= length; i += 32)
+    {
+        unsigned int mask = ~avx2WhitespacesMask(pText + i);
+        if (mask)
+            return i + firstBit(mask);
+    }
+
+    return i + sse2SkipLeft(pText + i, length - i);
+}
+
+//-----------------------------------------------------------------------
+
+TARGET_AVX2 static size_t avx2SkipRight(const char* pText, size_t length)
+{
+    for (; length >= 32; length -= 32)
+    {
+        unsigned int mask = ~avx2WhitespacesMask(pText + length - 32);
+        if (mask)
+            return length - 32 + lastBit(mask) + 1;
+    }
+
+    return sse2SkipRight(pText, length);
+}
+
+//-----------------------------------------------------------------------
+
+static bool cpuSupportsAVX2()
+{
+#if defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7)
+        return false;
+
+    // The OS must save the AVX registers
+    __cpuid(info, 1);
+    if (((info[2] & (1 << 27)) == 0) || ((info[2] & (1 << 28)) == 0) ||
+        ((_xgetbv(0) & 6) != 6))
+    {
+        return false;
+    }
+
+    __cpuidex(info, 7, 0);
+    return ((info[1] & (1 << 5)) != 0);
+#else
+    __builtin_cpu_init();
+    return (__builtin_cpu_supports("avx2") != 0);
+#endif
+}
+
+#endif
+
+
+/********************************** STATIC ATTRIBUTES ***********************************/
+
+const size_t StringView::npos;
+
+
+static const tKernels SCALAR_KERNELS =
+{
+    scalarToLowerCase, scalarToUpperCase, scalarFindFirstOf, scalarSkipLeft, scalarSkipRight
+};
+
+#ifdef HAS_SIMD
+static const tKernels SSE2_KERNELS =
+{
+    sse2ToLowerCase, sse2ToUpperCase, sse2FindFirstOf, sse2SkipLeft, sse2SkipRight
+};
+
+static const tKernels AVX2_KERNELS =
+{
+    avx2ToLowerCase, avx2ToUpperCase, avx2FindFirstOf, avx2SkipLeft, avx2SkipRight
+};
+#endif
+
+/// The kernels in use (the scalar ones until the best ones are selected, since the
+/// methods might be called during the initialisation of other modules)
+static tKernels g_kernels =
+{
+    scalarToLowerCase, scalarToUpperCase, scalarFindFirstOf, scalarSkipLeft, scalarSkipRight
+};
+
+static StringUtils::tInstructionSet g_instructionSet = StringUtils::INSTRUCTIONS_SCALAR;
+
+//-----------------------------------------------------------------------
+
+/// Selects the best kernels supported by the CPU when the library is loaded
+struct tKernelsSelection
+{
+    tKernelsSelection()
+    {
+        if (!StringUtils::setInstructionSet(StringUtils::INSTRUCTIONS_AVX2))
+            StringUtils::setInstructionSet(StringUtils::INSTRUCTIONS_SSE2);
+    }
+};
+
+static tKernelsSelection g_kernelsSelection;
+
+
+/*********************************** STATIC FUNCTIONS ***********************************/
+
+/// Compares some characters with a pattern, optionally lower casing them
+static inline bool matches(const char* pText, const char* pPattern, size_t length,
+                           bool lowerCase)
+{
+    if (!lowerCase)
+        return (memcmp(pText, pPattern, length) == 0);
+
+    for (size_t i = 0; i < length; ++i)
+    {
+        if ((char) ::tolower((unsigned char) pText[i]) != pPattern[i])
+            return false;
+    }
+
+    return true;
+}
+
+
 /************************************* STATIC METHODS ***********************************/
 
 void StringUtils::replaceAll(string &strSource, const string& strWhat, const string& strWith)
 {
+    if (strWhat.empty())
+        return;
+
     size_t index = strSource.find(strWhat);
+    if (index == string::npos)
+        return;
+
+    string result;
+    result.reserve(strSource.length());
 
+    size_t start = 0;
     while (index != string::npos)
     {
-        strSource.erase(index, strWhat.length());
-        strSource.insert(index, strWith);
+        result.append(strSource, start, index - start);
+        result.append(strWith);
 
-        index = strSource.find(strWhat, index + strWith.length());
+        start = index + strWhat.length();
+        index = strSource.find(strWhat, start);
     }
+
+    result.append(strSource, start, string::npos);
+
+    strSource.swap(result);
+}
+
+//-----------------------------------------------------------------------
+
+void StringUtils::replaceAll(string &strSource, const tReplacementsList& replacements)
+{
+    StringReplacer replacer(replacements);
+    replacer.replaceAll(strSource);
 }
 
 //-----------------------------------------------------------------------
@@ -37,91 +544,127 @@ StringUtils::tStringsList StringUtils::split(const string& str, const string& de
     // Pre-allocate some space for performance
     ret.reserve(10);    // 10 is guessed capacity for most case
 
-    // Use STL methods
-    size_t start, pos;
-    start = 0;
-    do
-    {
-        pos = str.find_first_of(delims, start);
-        if (pos == start)
-        {
-            // Do nothing
-            ret.push_back("");
-            start = pos + 1;
-        }
-        else if (pos == string::npos)
-        {
-            // Copy the rest of the string
-            ret.push_back(str.substr(start));
-            break;
-        }
-        else
-        {
-            // Copy up to delimiter
-            ret.push_back(str.substr(start, pos - start));
-            start = pos + 1;
-        }
+    StringTokenizer tokenizer(str, delims);
 
-    } while ((start != string::npos) && (pos != string::npos));
+    StringView token;
+    while (tokenizer.next(token))
+        ret.push_back(string(token.data(), token.size()));
 
     return ret;
 }
 
 //-----------------------------------------------------------------------
 
+size_t StringUtils::findFirstOf(const StringView& str, const StringView& delims)
+{
+    if (delims.empty())
+        return StringView::npos;
+
+    if (delims.size() == 1)
+        return str.find(delims[0]);
+
+    return g_kernels.findFirstOf(str.data(), str.size(), delims.data(), delims.size());
+}
+
+//-----------------------------------------------------------------------
+
 void StringUtils::toLowerCase(std::string& str)
 {
-    std::transform(str.begin(), str.end(), str.begin(), ::tolower);
+    if (!str.empty())
+        g_kernels.toLowerCase(&str[0], str.size());
 }
 
 //-----------------------------------------------------------------------
 
 void StringUtils::toUpperCase(std::string& str)
 {
-    std::transform(str.begin(), str.end(), str.begin(), ::toupper);
+    if (!str.empty())
+        g_kernels.toUpperCase(&str[0], str.size());
 }
 
 //-----------------------------------------------------------------------
 
 bool StringUtils::startsWith(const std::string& str, const std::string& pattern, bool lowerCase)
 {
-    size_t thisLen = str.length();
+    return startsWith(StringView(str), StringView(pattern), lowerCase);
+}
+
+//-----------------------------------------------------------------------
+
+bool StringUtils::startsWith(const StringView& str, const StringView& pattern, bool lowerCase)
+{
     size_t patternLen = pattern.length();
-    if (thisLen < patternLen || patternLen == 0)
+    if (str.length() < patternLen || patternLen == 0)
         return false;
 
-    string startOfThis = str.substr(0, patternLen);
-    if (lowerCase)
-        StringUtils::toLowerCase(startOfThis);
-
-    return (startOfThis == pattern);
+    return matches(str.data(), pattern.data(), patternLen, lowerCase);
 }
 
 //-----------------------------------------------------------------------
 
 bool StringUtils::endsWith(const std::string& str, const std::string& pattern, bool lowerCase)
+{
+    return endsWith(StringView(str), StringView(pattern), lowerCase);
+}
+
+//-----------------------------------------------------------------------
+
+bool StringUtils::endsWith(const StringView& str, const StringView& pattern, bool lowerCase)
 {
     size_t thisLen = str.length();
     size_t patternLen = pattern.length();
     if (thisLen < patternLen || patternLen == 0)
         return false;
 
-    string endOfThis = str.substr(thisLen - patternLen, patternLen);
-    if (lowerCase)
-        StringUtils::toLowerCase(endOfThis);
-
-    return (endOfThis == pattern);
+    return matches(str.data() + thisLen - patternLen, pattern.data(), patternLen, lowerCase);
 }
 
 //-----------------------------------------------------------------------
 
 void StringUtils::trim(std::string& str, bool left, bool right)
 {
-    static const string delims = " \t\r";
-
     if (right)
-        str.erase(str.find_last_not_of(delims) + 1); // trim right
+        str.erase(g_kernels.skipRight(str.data(), str.size())); // trim right
 
     if (left)
-        str.erase(0, str.find_first_not_of(delims)); // trim left
+        str.erase(0, g_kernels.skipLeft(str.data(), str.size())); // trim left
+}
+
+//-----------------------------------------------------------------------
+
+StringUtils::tInstructionSet StringUtils::instructionSet()
+{
+    return g_instructionSet;
+}
+
+//-----------------------------------------------------------------------
+
+bool StringUtils::setInstructionSet(tInstructionSet instructionSet)
+{
+    // g_kernels is modified without synchronisation: see the remark in the header
+    switch (instructionSet)
+    {
+        case INSTRUCTIONS_SCALAR:
+            g_kernels = SCALAR_KERNELS;
+            break;
+
+#ifdef HAS_SIMD
+        case INSTRUCTIONS_SSE2:
+            g_kernels = SSE2_KERNELS;
+            break;
+
+        case INSTRUCTIONS_AVX2:
+            if (!cpuSupportsAVX2())
+                return false;
+
+            g_kernels = AVX2_KERNELS;
+            break;
+#endif
+
+        default:
+            return false;
+    }
+
+    g_instructionSet = instructionSet;
+    return true;
 }
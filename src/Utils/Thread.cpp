@@ -0,0 +1,83 @@
+/** @file   Thread.cpp
+    @author Philip Abbet
+
+    Implementation of the class 'Athena::Utils::Thread'
+*/
+
+#include <Athena-Core/Utils/Thread.h>
+#include <Athena-Core/Utils/PoolAllocator.h>
+
+#if ATHENA_PLATFORM == ATHENA_PLATFORM_WIN32
+    #include <process.h>
+#endif
+
+using namespace Athena::Utils;
+
+
+/****************************** CONSTRUCTION / DESTRUCTION ******************************/
+
+Thread::Thread()
+: m_bRunning(false)
+{
+}
+
+//-----------------------------------------------------------------------
+
+Thread::~Thread()
+{
+    // Assertions
+    assert(!m_bRunning);
+}
+
+
+/*************************************** METHODS ****************************************/
+
+bool Thread::start()
+{
+    // Assertions
+    assert(!m_bRunning);
+
+#if ATHENA_PLATFORM == ATHENA_PLATFORM_WIN32
+    m_thread = (HANDLE) _beginthreadex(0, 0, &Thread::entryPoint, this, 0, 0);
+    m_bRunning = (m_thread != 0);
+#else
+    m_bRunning = (pthread_create(&m_thread, 0, &Thread::entryPoint, this) == 0);
+#endif
+
+    return m_bRunning;
+}
+
+//-----------------------------------------------------------------------
+
+void Thread::join()
+{
+    if (!m_bRunning)
+        return;
+
+#if ATHENA_PLATFORM == ATHENA_PLATFORM_WIN32
+    WaitForSingleObject(m_thread, INFINITE);
+    CloseHandle(m_thread);
+#else
+    pthread_join(m_thread, 0);
+#endif
+
+    m_bRunning = false;
+}
+
+//-----------------------------------------------------------------------
+
+#if ATHENA_PLATFORM == ATHENA_PLATFORM_WIN32
+unsigned int __stdcall Thread::entryPoint(void* pThread)
+{
+    static_cast<Thread*>(pThread)->run();
+    PoolAllocator::releaseThreadCache();
+    return 0;
+}
+#else
+void* Thread::entryPoint(void* pThread)
+{
+    static_cast<Thread*>(pThread)->run();
+    PoolAllocator::releaseThreadCache();
+    return 0;
+}
+#endif
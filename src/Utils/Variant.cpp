@@ -6,10 +6,10 @@
 
 #include <Athena-Core/Utils/Variant.h>
 #include <Athena-Core/Utils/StringConverter.h>
+#include <Athena-Core/Utils/Metrics.h>
 #include <Athena-Math/Vector3.h>
 #include <Athena-Math/Quaternion.h>
 #include <Athena-Math/Color.h>
-#include <sstream>
 #include <assert.h>
 
 using namespace Athena;
@@ -18,6 +18,67 @@ using namespace Athena::Math;
 using namespace std;
 
 
+/*************************************** METRICS ****************************************/
+
+static Counter g_nbCreatedVariants("variants.created", "Number of variants created");
+static Gauge g_nbAliveVariants("variants.alive", "Number of variants alive");
+static Counter g_nbConversions("variants.conversions", "Number of conversions of variants");
+
+
+/*********************************** STATIC FUNCTIONS ***********************************/
+
+static inline const char* skipWhitespaces(const char* p, const char* pLast)
+{
+    while ((p != pLast) && ((*p == ' ') || ((*p >= '\t') && (*p <= '\r'))))
+        ++p;
+
+    return p;
+}
+
+//-----------------------------------------------------------------------
+
+/// Parse a string containing only a number (and whitespaces around it)
+template<typename T>
+static bool parseNumber(const string& strText, T& value)
+{
+    const char* pLast = strText.data() + strText.size();
+    const char* p = skipWhitespaces(strText.data(), pLast);
+
+    StringConverter::tParseResult result = StringConverter::fromChars(p, pLast, value);
+    if (result.error != StringConverter::PARSE_SUCCESS)
+        return false;
+
+    return (skipWhitespaces(result.pEnd, pLast) == pLast);
+}
+
+//-----------------------------------------------------------------------
+
+/// Parse a list of numbers like "(1, 2, 3)" (the delimiters can be any character)
+static bool parseNumbers(const string& strText, float* values, unsigned int nbValues)
+{
+    const char* pLast = strText.data() + strText.size();
+    const char* p = skipWhitespaces(strText.data(), pLast);
+
+    for (unsigned int i = 0; i < nbValues; ++i)
+    {
+        // Opening parenthesis or separator
+        if (p == pLast)
+            return false;
+
+        p = skipWhitespaces(p + 1, pLast);
+
+        StringConverter::tParseResult result = StringConverter::fromChars(p, pLast, values[i]);
+        if (result.error != StringConverter::PARSE_SUCCESS)
+            return false;
+
+        p = skipWhitespaces(result.pEnd, pLast);
+    }
+
+    // Closing parenthesis
+    return (p != pLast);
+}
+
+
 /****************************** CONSTRUCTION / DESTRUCTION *****************************/
 
 //---------------------------------------------------------------------------------------
@@ -28,6 +89,9 @@ using namespace std;
 Variant::Variant()
 : m_type(NONE), m_bNull(true)
 {
+    g_nbCreatedVariants.increment();
+    g_nbAliveVariants.increment();
+
     memset(&m_value, 0, sizeof(m_value));
 }
 
@@ -41,6 +105,9 @@ Variant::Variant()
 Variant::Variant(tType type)
 : m_type(type), m_bNull(true)
 {
+    g_nbCreatedVariants.increment();
+    g_nbAliveVariants.increment();
+
     memset(&m_value, 0, sizeof(m_value));
 
     if (type == STRUCT)
@@ -59,6 +126,9 @@ Variant::Variant(tType type)
 Variant::Variant(const Variant& value)
 : m_type(NONE), m_bNull(true)
 {
+    g_nbCreatedVariants.increment();
+    g_nbAliveVariants.increment();
+
     (*this) = value;
 }
 
@@ -185,6 +255,8 @@ void Variant::clear()
     Variant::Variant(TYPE value)                                    \
     : m_type(TYPEID), m_bNull(false)                                \
     {                                                               \
+        g_nbCreatedVariants.increment();                            \
+        g_nbAliveVariants.increment();                              \
         m_value.MEMBER = value;                                     \
     }
 
@@ -193,6 +265,8 @@ void Variant::clear()
     Variant::Variant(const TYPE& value)                             \
     : m_type(TYPEID), m_bNull(false)                                \
     {                                                               \
+        g_nbCreatedVariants.increment();                            \
+        g_nbAliveVariants.increment();                              \
         m_value._others = new TYPE(value);                          \
     }
 
@@ -218,6 +292,9 @@ DECLARE_CONSTRUCTOR_FOR_CLASS(Degree,       DEGREE)
 Variant::Variant(const char* strValue)
 : m_type(STRING), m_bNull(false)
 {
+    g_nbCreatedVariants.increment();
+    g_nbAliveVariants.increment();
+
     m_value._others = new string(strValue);
 }
 
@@ -231,6 +308,8 @@ Variant::Variant(const char* strValue)
 //---------------------------------------------------------------------------------------
 Variant::~Variant()
 {
+    g_nbAliveVariants.decrement();
+
     clear();
 }
 
@@ -362,10 +441,8 @@ Variant::tFieldsIterator Variant::getFieldsIterator()
     case DST_TYPEID:                                                            \
     {                                                                           \
         string* p = static_cast<string*>(m_value._others);                      \
-        std::istringstream str(*p);                                             \
-        str >> m_value.DST_MEMBER;                                              \
                                                                                 \
-        if (str.fail())                                                         \
+        if (!parseNumber(*p, m_value.DST_MEMBER))                               \
         {                                                                       \
             m_value._others = p;                                                \
             return false;                                                       \
@@ -427,6 +504,8 @@ bool Variant::convertTo(tType type)
     if (m_type == type)
         return true;
 
+    g_nbConversions.increment();
+
     // If null, rests null
     if (isNull())
     {
@@ -454,12 +533,9 @@ bool Variant::convertTo(tType type)
         case CHAR:
             {
                 string* p = static_cast<string*>(m_value._others);
-                std::istringstream str(*p);
 
                 int temp;
-                str >> temp;
-
-                if (str.fail())
+                if (!parseNumber(*p, temp) || (temp < -128) || (temp > 127))
                     return false;
 
                 delete p;
@@ -472,12 +548,9 @@ bool Variant::convertTo(tType type)
         case UNSIGNED_CHAR:
             {
                 string* p = static_cast<string*>(m_value._others);
-                std::istringstream str(*p);
 
                 unsigned int temp;
-                str >> temp;
-
-                if (str.fail())
+                if (!parseNumber(*p, temp) || (temp > 255))
                     return false;
 
                 delete p;
@@ -512,54 +585,45 @@ bool Variant::convertTo(tType type)
         case VECTOR3:
             {
                 string* p = static_cast<string*>(m_value._others);
-                char c;
-                float x, y, z;
-                std::istringstream str(*p);
+                float v[3];
 
-                str >> c >> x >> c >> y >> c >> z >> c;
-                if (str.fail())
+                if (!parseNumbers(*p, v, 3))
                     return false;
 
                 delete p;
 
                 m_type = type;
-                m_value._others = new Vector3(x, y, z);
+                m_value._others = new Vector3(v[0], v[1], v[2]);
                 return true;
             }
 
         case QUATERNION:
             {
                 string* p = static_cast<string*>(m_value._others);
-                char c;
-                float w, x, y, z;
-                std::istringstream str(*p);
+                float v[4];
 
-                str >> c >> w >> c >> x >> c >> y >> c >> z >> c;
-                if (str.fail())
+                if (!parseNumbers(*p, v, 4))
                     return false;
 
                 delete p;
 
                 m_type = type;
-                m_value._others = new Quaternion(w, x, y, z);
+                m_value._others = new Quaternion(v[0], v[1], v[2], v[3]);
                 return true;
             }
 
         case COLOR:
             {
                 string* p = static_cast<string*>(m_value._others);
-                char c;
-                float r, g, b, a;
-                std::istringstream str(*p);
+                float v[4];
 
-                str >> c >> r >> c >> g >> c >> b >> c >> a >> c;
-                if (str.fail())
+                if (!parseNumbers(*p, v, 4))
                     return false;
 
                 delete p;
 
                 m_type = type;
-                m_value._others = new Color(r, g, b, a);
+                m_value._others = new Color(v[0], v[1], v[2], v[3]);
                 return true;
             }
 
@@ -567,10 +631,8 @@ bool Variant::convertTo(tType type)
             {
                 string* p = static_cast<string*>(m_value._others);
                 float a;
-                std::istringstream str(*p);
 
-                str >> a;
-                if (str.fail())
+                if (!parseNumber(*p, a))
                     return false;
 
                 delete p;
@@ -584,10 +646,8 @@ bool Variant::convertTo(tType type)
             {
                 string* p = static_cast<string*>(m_value._others);
                 float a;
-                std::istringstream str(*p);
 
-                str >> a;
-                if (str.fail())
+                if (!parseNumber(*p, a))
                     return false;
 
                 delete p;
@@ -160,6 +160,48 @@ unsigned long Timer::getMicroseconds()
 
 //-----------------------------------------------------------------------
 
+unsigned long long Timer::getNanoseconds()
+{
+    LARGE_INTEGER curTime;
+
+    HANDLE thread = GetCurrentThread();
+
+    // Set affinity to the first core
+    DWORD oldMask = (DWORD) SetThreadAffinityMask(thread, timerMask);
+
+    // Query the timer
+    QueryPerformanceCounter(&curTime);
+
+    // Reset affinity
+    SetThreadAffinityMask(thread, oldMask);
+
+    LONGLONG newTime = curTime.QuadPart - startTime.QuadPart;
+
+    // get milliseconds to check against GetTickCount
+    unsigned long newTicks = (unsigned long) (1000 * newTime / frequency.QuadPart);
+
+    // detect and compensate for performance counter leaps
+    // (surprisingly common, see Microsoft KB: Q274323)
+    unsigned long check = GetTickCount() - startTick;
+    signed long msecOff = (signed long)(newTicks - check);
+    if (msecOff < -100 || msecOff > 100)
+    {
+        // We must keep the timer running forward :)
+        LONGLONG adjust = (std::min)(msecOff * frequency.QuadPart / 1000, newTime - lastTime);
+        startTime.QuadPart += adjust;
+        newTime -= adjust;
+    }
+
+    // Record last time for adjust
+    lastTime = newTime;
+
+    // scale by 1000000000 for nanoseconds (in two steps, to avoid an overflow)
+    return (unsigned long long) (newTime / frequency.QuadPart) * 1000000000ULL +
+           (unsigned long long) ((newTime % frequency.QuadPart) * 1000000000LL / frequency.QuadPart);
+}
+
+//-----------------------------------------------------------------------
+
 unsigned long Timer::getMillisecondsCPU()
 {
     clock_t newClock = clock();
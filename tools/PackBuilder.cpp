@@ -0,0 +1,43 @@
+/** @file   PackBuilder.cpp
+    @author Philip Abbet
+
+    Command-line tool creating a pack file from a directory
+*/
+
+#include <Athena-Core/Data/PackFile.h>
+#include <Athena-Core/Log/LogManager.h>
+#include <Athena-Core/Log/ConsoleLogListener.h>
+#include <iostream>
+
+using namespace Athena::Data;
+using namespace Athena::Log;
+using namespace std;
+
+
+int main(int argc, char** argv)
+{
+    if (argc != 3)
+    {
+        cerr << "Usage: " << argv[0] << " <directory> <pack file>" << endl;
+        return 1;
+    }
+
+    LogManager logManager;
+    logManager.addListener(new ConsoleLogListener(), true);
+
+    if (!PackFile::build(argv[1], argv[2]))
+        return 1;
+
+    PackFile* pPackFile = PackFile::load(argv[2]);
+    if (!pPackFile)
+    {
+        cerr << "Failed to load the pack file '" << argv[2] << "'" << endl;
+        return 1;
+    }
+
+    cout << pPackFile->nbEntries() << " file(s) packed into '" << argv[2] << "'" << endl;
+
+    pPackFile->release();
+
+    return 0;
+}
@@ -0,0 +1,144 @@
+#include <UnitTest++.h>
+#include <Athena-Core/Data/Checksum.h>
+#include <Athena-Core/Data/ChecksumDataStream.h>
+#include <Athena-Core/Data/FileDataStream.h>
+#include <string.h>
+
+using namespace Athena::Data;
+using namespace std;
+
+
+static unsigned int referenceCRC32C(const unsigned char* pData, size_t size)
+{
+    unsigned int crc = 0xFFFFFFFF;
+
+    for (size_t i = 0; i < size; ++i)
+    {
+        crc ^= pData[i];
+        for (unsigned int k = 0; k < 8; ++k)
+            crc = (crc & 1) ? (crc >> 1) ^ 0x82F63B78 : crc >> 1;
+    }
+
+    return crc ^ 0xFFFFFFFF;
+}
+
+
+static std::vector<unsigned char> makeData(size_t size)
+{
+    std::vector<unsigned char> data(size);
+    unsigned int seed = 42;
+
+    for (size_t i = 0; i < size; ++i)
+    {
+        seed = seed * 1103515245 + 12345;
+        data[i] = (unsigned char) (seed >> 16);
+    }
+
+    return data;
+}
+
+
+SUITE(ChecksumTests)
+{
+    TEST(CRC32CKnownValues)
+    {
+        CHECK_EQUAL(0, Checksum::crc32c("", 0));
+        CHECK_EQUAL(0xE3069283, Checksum::crc32c("123456789", 9));
+    }
+
+
+    TEST(CRC32CLargeBuffer)
+    {
+        // Large enough to use the parallel computation of the hardware implementation,
+        // with an unaligned start and a size that isn't a multiple of 8
+        std::vector<unsigned char> data = makeData(100000);
+
+        CHECK_EQUAL(referenceCRC32C(&data[3], data.size() - 10),
+                    Checksum::crc32c(&data[3], data.size() - 10));
+    }
+
+
+    TEST(CRC32CIncremental)
+    {
+        std::vector<unsigned char> data = makeData(30000);
+
+        unsigned int crc = Checksum::crc32c(&data[0], 1000);
+        crc = Checksum::crc32c(&data[1000], 25001, crc);
+        crc = Checksum::crc32c(&data[26001], data.size() - 26001, crc);
+
+        CHECK_EQUAL(Checksum::crc32c(&data[0], data.size()), crc);
+    }
+
+
+    TEST(Hash64KnownValues)
+    {
+        CHECK(Checksum::hash64("", 0) == 0xEF46DB3751D8E999ULL);
+        CHECK(Checksum::hash64("abc", 3) != Checksum::hash64("abd", 3));
+        CHECK(Checksum::hash64("abc", 3) != Checksum::hash64("abc", 3, 1));
+    }
+
+
+    TEST(Hash64Incremental)
+    {
+        std::vector<unsigned char> data = makeData(1000);
+
+        const size_t sizes[] = { 0, 1, 7, 31, 32, 33, 100, 1000 };
+        for (unsigned int i = 0; i < sizeof(sizes) / sizeof(size_t); ++i)
+        {
+            Hash64 hash(5);
+            size_t offset = 0;
+
+            // Feed the data in pieces of increasing sizes
+            for (size_t piece = 1; offset < sizes[i]; ++piece)
+            {
+                size_t size = std::min(piece, sizes[i] - offset);
+                hash.update(&data[offset], size);
+                offset += size;
+            }
+
+            CHECK(hash.value() == Checksum::hash64(&data[0], sizes[i], 5));
+        }
+    }
+}
+
+
+SUITE(ChecksumDataStreamTests)
+{
+    TEST(Read)
+    {
+        ChecksumDataStream stream(new FileDataStream(ATHENA_CORE_UNITTESTS_DATA_PATH "lines.txt"));
+
+        CHECK_EQUAL("Line 1", stream.getLine());
+        CHECK_EQUAL(28, stream.readToEnd() + 7);
+        CHECK(stream.eof());
+
+        const char* content = "Line 1\nLine 2\nLine 3\n\nLine 5";
+
+        CHECK_EQUAL(28, stream.nbBytes());
+        CHECK_EQUAL(Checksum::crc32c(content, 28), stream.crc32c());
+        CHECK(Checksum::hash64(content, 28) == stream.hash64());
+
+        stream.reset();
+        CHECK_EQUAL(0, stream.nbBytes());
+        CHECK_EQUAL(0, stream.crc32c());
+    }
+
+
+    TEST(Write)
+    {
+        std::vector<unsigned char> data = makeData(5000);
+
+        {
+            ChecksumDataStream stream(new FileDataStream(ATHENA_CORE_UNITTESTS_GENERATED_PATH "checksum.bin", DataStream::WRITE));
+
+            CHECK_EQUAL(2000, stream.write(&data[0], 2000));
+            CHECK_EQUAL(3000, stream.write(&data[2000], 3000));
+
+            CHECK_EQUAL(Checksum::crc32c(&data[0], data.size()), stream.crc32c());
+        }
+
+        ChecksumDataStream stream(new FileDataStream(ATHENA_CORE_UNITTESTS_GENERATED_PATH "checksum.bin"));
+        CHECK_EQUAL(5000, stream.readToEnd());
+        CHECK(Checksum::hash64(&data[0], data.size()) == stream.hash64());
+    }
+}
@@ -0,0 +1,239 @@
+#include <UnitTest++.h>
+#include <Athena-Core/Data/CompressedDataStream.h>
+#include <Athena-Core/Data/LZCodec.h>
+#include <Athena-Core/Data/FileDataStream.h>
+#include <Athena-Core/Data/MemoryDataStream.h>
+#include <string.h>
+#include <stdio.h>
+
+using namespace Athena::Data;
+using namespace std;
+
+
+static std::string makeText(size_t size)
+{
+    std::string text;
+
+    for (unsigned int i = 0; text.size() < size; ++i)
+    {
+        char buffer[64];
+        sprintf(buffer, "{ \"name\": \"entity%u\", \"position\": [%u, %u, 0] },\n", i, i * 7 % 100, i % 13);
+        text += buffer;
+    }
+
+    return text.substr(0, size);
+}
+
+
+static std::string makeNoise(size_t size)
+{
+    std::string noise(size, '\0');
+    unsigned int seed = 12345;
+
+    for (size_t i = 0; i < size; ++i)
+    {
+        seed = seed * 1103515245 + 12345;
+        noise[i] = (char) (seed >> 16);
+    }
+
+    return noise;
+}
+
+
+SUITE(LZCodecTests)
+{
+    TEST(CompressText)
+    {
+        std::string text = makeText(10000);
+        std::vector<char> compressed(LZCodec::maxCompressedSize(text.size()));
+
+        size_t size = LZCodec::compress(text.data(), text.size(), &compressed[0], compressed.size());
+        CHECK(size > 0);
+        CHECK(size < text.size() / 2);
+
+        std::vector<char> decompressed(text.size());
+        CHECK(LZCodec::decompress(&compressed[0], size, &decompressed[0], decompressed.size()));
+        CHECK(memcmp(text.data(), &decompressed[0], text.size()) == 0);
+    }
+
+
+    TEST(CompressRepeatedByte)
+    {
+        std::string data(1000, 'a');
+        std::vector<char> compressed(LZCodec::maxCompressedSize(data.size()));
+
+        size_t size = LZCodec::compress(data.data(), data.size(), &compressed[0], compressed.size());
+        CHECK(size > 0);
+        CHECK(size < 20);
+
+        std::vector<char> decompressed(data.size());
+        CHECK(LZCodec::decompress(&compressed[0], size, &decompressed[0], decompressed.size()));
+        CHECK(memcmp(data.data(), &decompressed[0], data.size()) == 0);
+    }
+
+
+    TEST(CompressIncompressibleData)
+    {
+        std::string data = makeNoise(5000);
+        std::vector<char> compressed(LZCodec::maxCompressedSize(data.size()));
+
+        size_t size = LZCodec::compress(data.data(), data.size(), &compressed[0], compressed.size());
+        CHECK(size > 0);
+
+        std::vector<char> decompressed(data.size());
+        CHECK(LZCodec::decompress(&compressed[0], size, &decompressed[0], decompressed.size()));
+        CHECK(memcmp(data.data(), &decompressed[0], data.size()) == 0);
+    }
+
+
+    TEST(CompressInTooSmallBuffer)
+    {
+        std::string data = makeNoise(1000);
+        std::vector<char> compressed(500);
+
+        CHECK_EQUAL(0, LZCodec::compress(data.data(), data.size(), &compressed[0], compressed.size()));
+    }
+
+
+    TEST(DecompressCorruptedData)
+    {
+        std::string text = makeText(2000);
+        std::vector<char> compressed(LZCodec::maxCompressedSize(text.size()));
+
+        size_t size = LZCodec::compress(text.data(), text.size(), &compressed[0], compressed.size());
+
+        std::vector<char> decompressed(text.size());
+        CHECK(!LZCodec::decompress(&compressed[0], size / 2, &decompressed[0], decompressed.size()));
+        CHECK(!LZCodec::decompress(&compressed[0], size, &decompressed[0], decompressed.size() - 1));
+
+        std::string garbage = makeNoise(500);
+        CHECK(!LZCodec::decompress(garbage.data(), garbage.size(), &decompressed[0], decompressed.size()));
+    }
+}
+
+
+SUITE(CompressedDataStreamTests)
+{
+    TEST(WriteAndRead)
+    {
+        std::string text = makeText(10000);
+
+        {
+            CompressedDataStream stream(new FileDataStream(ATHENA_CORE_UNITTESTS_GENERATED_PATH "compressed.bin", DataStream::WRITE), DataStream::WRITE, 1024);
+            CHECK(stream.isValid());
+
+            CHECK_EQUAL(3000, stream.write(text.data(), 3000));
+            CHECK_EQUAL(7000, stream.write(text.data() + 3000, 7000));
+            CHECK_EQUAL(10000, stream.tell());
+        }
+
+        CompressedDataStream stream(new FileDataStream(ATHENA_CORE_UNITTESTS_GENERATED_PATH "compressed.bin"));
+        CHECK(stream.isValid());
+        CHECK_EQUAL(10000, stream.size());
+        CHECK_EQUAL(10, stream.nbBlocks());
+        CHECK(stream.compressedSize() < 10000 / 2);
+
+        std::string content(10000, '\0');
+        CHECK_EQUAL(10000, stream.read(&content[0], 10000));
+        CHECK(content == text);
+
+        char c;
+        CHECK_EQUAL(0, stream.read(&c, 1));
+        CHECK(stream.eof());
+    }
+
+
+    TEST(Seek)
+    {
+        std::string text = makeText(10000);
+
+        {
+            CompressedDataStream stream(new FileDataStream(ATHENA_CORE_UNITTESTS_GENERATED_PATH "compressed.bin", DataStream::WRITE), DataStream::WRITE, 1024);
+            stream.write(text.data(), text.size());
+        }
+
+        CompressedDataStream stream(new FileDataStream(ATHENA_CORE_UNITTESTS_GENERATED_PATH "compressed.bin"));
+
+        char buffer[100];
+
+        stream.seek(5000);
+        CHECK_EQUAL(100, stream.read(buffer, 100));
+        CHECK(memcmp(text.data() + 5000, buffer, 100) == 0);
+
+        stream.seek(1000);
+        CHECK_EQUAL(100, stream.read(buffer, 100));
+        CHECK(memcmp(text.data() + 1000, buffer, 100) == 0);
+
+        stream.skip(-600);
+        CHECK_EQUAL(500, stream.tell());
+        CHECK_EQUAL(100, stream.read(buffer, 100));
+        CHECK(memcmp(text.data() + 500, buffer, 100) == 0);
+
+        stream.seek(9950);
+        CHECK_EQUAL(50, stream.read(buffer, 100));
+        CHECK(memcmp(text.data() + 9950, buffer, 50) == 0);
+        CHECK(stream.eof());
+    }
+
+
+    TEST(FlushAndIncompressibleBlocks)
+    {
+        std::string text = makeText(1500);
+        std::string noise = makeNoise(1500);
+
+        {
+            CompressedDataStream stream(new FileDataStream(ATHENA_CORE_UNITTESTS_GENERATED_PATH "compressed.bin", DataStream::WRITE), DataStream::WRITE, 1024);
+            stream.write(text.data(), text.size());
+            CHECK(stream.flush());
+            stream.write(noise.data(), noise.size());
+        }
+
+        CompressedDataStream stream(new FileDataStream(ATHENA_CORE_UNITTESTS_GENERATED_PATH "compressed.bin"));
+        CHECK(stream.isValid());
+        CHECK_EQUAL(4, stream.nbBlocks());
+
+        std::string content(3000, '\0');
+        CHECK_EQUAL(3000, stream.read(&content[0], 3000));
+        CHECK(content == text + noise);
+    }
+
+
+    TEST(EmptyStream)
+    {
+        {
+            CompressedDataStream stream(new FileDataStream(ATHENA_CORE_UNITTESTS_GENERATED_PATH "compressed.bin", DataStream::WRITE), DataStream::WRITE);
+        }
+
+        CompressedDataStream stream(new FileDataStream(ATHENA_CORE_UNITTESTS_GENERATED_PATH "compressed.bin"));
+        CHECK(stream.isValid());
+        CHECK_EQUAL(0, stream.size());
+
+        char c;
+        CHECK_EQUAL(0, stream.read(&c, 1));
+        CHECK(stream.eof());
+    }
+
+
+    TEST(InvalidStream)
+    {
+        CompressedDataStream stream(new FileDataStream(ATHENA_CORE_UNITTESTS_DATA_PATH "lines.txt"));
+        CHECK(!stream.isValid());
+
+        char c;
+        CHECK_EQUAL(0, stream.read(&c, 1));
+    }
+
+
+    TEST(SeekTableOutsideOfStream)
+    {
+        // Header announcing 0xFFFFFFFF blocks of 1 byte, with the seek table right after it
+        unsigned char header[32] = {
+            'A', 'C', 'M', 'P',  1, 0, 0, 0,  1, 0, 0, 0,  0xFF, 0xFF, 0xFF, 0xFF,
+            0xFF, 0xFF, 0xFF, 0xFF, 0, 0, 0, 0,  32, 0, 0, 0, 0, 0, 0, 0,
+        };
+
+        CompressedDataStream stream(new MemoryDataStream(header, sizeof(header)));
+        CHECK(!stream.isValid());
+        CHECK_EQUAL(0, stream.nbBlocks());
+    }
+}
@@ -1,10 +1,49 @@
 #include <UnitTest++.h>
 #include <Athena-Core/Data/FileDataStream.h>
+#include <Athena-Core/Utils/Thread.h>
+#include <vector>
 
 using namespace Athena::Data;
+using namespace Athena::Utils;
 using namespace std;
 
 
+class ReaderThread: public Thread
+{
+public:
+    ReaderThread(const FileDataStream& stream, size_t offset)
+    : m_stream(stream), m_offset(offset), m_nbErrors(0)
+    {
+    }
+
+    inline unsigned int nbErrors() const
+    {
+        return m_nbErrors;
+    }
+
+protected:
+    virtual void run()
+    {
+        char buf[6];
+
+        for (unsigned int i = 0; i < 1000; ++i)
+        {
+            if ((m_stream.readAt(m_offset, buf, 6) != 6) ||
+                (string(buf, 6) != "Line " + string(1, buf[5])) ||
+                (buf[5] != '1' + (char) (m_offset / 7)))
+            {
+                ++m_nbErrors;
+            }
+        }
+    }
+
+private:
+    const FileDataStream&   m_stream;
+    size_t                  m_offset;
+    unsigned int            m_nbErrors;
+};
+
+
 SUITE(FileDataStreamTests)
 {
     TEST(OpenExistingFile)
@@ -165,3 +204,262 @@ SUITE(FileDataStreamTests)
         CHECK_EQUAL("1", buf);
     }
 }
+
+
+SUITE(FileDataStreamVectoredTests)
+{
+    TEST(ReadV)
+    {
+        FileDataStream stream(ATHENA_CORE_UNITTESTS_DATA_PATH "lines.txt");
+
+        char buf1[7];
+        char buf2[1];
+        char buf3[6];
+
+        DataStream::tBuffer buffers[] = {
+            { buf1, 6 },
+            { buf2, 0 },
+            { buf2, 1 },
+            { buf3, 6 },
+        };
+
+        size_t c = stream.readv(buffers, 4);
+        CHECK_EQUAL(13, c);
+        CHECK(!stream.eof());
+
+        buf1[6] = '\0';
+        CHECK_EQUAL("Line 1", buf1);
+        CHECK_EQUAL('\n', buf2[0]);
+        CHECK_EQUAL("Line 2", string(buf3, 6));
+
+        CHECK_EQUAL(13, stream.tell());
+    }
+
+
+    TEST(ReadVUntilEnd)
+    {
+        FileDataStream stream(ATHENA_CORE_UNITTESTS_DATA_PATH "lines.txt");
+
+        char buf1[20];
+        char buf2[20];
+
+        DataStream::tBuffer buffers[] = {
+            { buf1, 20 },
+            { buf2, 20 },
+        };
+
+        size_t c = stream.readv(buffers, 2);
+        CHECK_EQUAL(28, c);
+        CHECK(stream.eof());
+        CHECK_EQUAL("Line 5", string(buf2 + 2, 6));
+    }
+
+
+    TEST(WriteVAndReadArray)
+    {
+        const unsigned int values[] = { 1, 2, 3, 0x01020304 };
+        const char* header = "HEAD";
+
+        {
+            FileDataStream stream(ATHENA_CORE_UNITTESTS_GENERATED_PATH "vectored.bin", DataStream::WRITE);
+            CHECK(stream.isOpen());
+
+            DataStream::tConstBuffer buffers[] = {
+                { header, 4 },
+                { values, sizeof(values) },
+            };
+
+            CHECK_EQUAL(4 + sizeof(values), stream.writev(buffers, 2));
+            CHECK_EQUAL(4, stream.writeArray(values, 4, DataStream::ENDIAN_BIG));
+        }
+
+        FileDataStream stream(ATHENA_CORE_UNITTESTS_GENERATED_PATH "vectored.bin");
+        CHECK(stream.isOpen());
+
+        char buf[5] = { 0 };
+        CHECK_EQUAL(4, stream.readArray(buf, 4));
+        CHECK_EQUAL("HEAD", buf);
+
+        unsigned int read[4];
+        CHECK_EQUAL(4, stream.readArray(read, 4));
+        CHECK_EQUAL(3, read[2]);
+        CHECK_EQUAL(0x01020304, read[3]);
+
+        unsigned char bytes[4];
+        stream.skip(3 * sizeof(unsigned int));
+        CHECK_EQUAL(4, stream.readArray(bytes, 4));
+        CHECK_EQUAL(0x01, bytes[0]);
+        CHECK_EQUAL(0x04, bytes[3]);
+
+        stream.seek(4 + sizeof(values));
+        CHECK_EQUAL(4, stream.readArray(read, 4, DataStream::ENDIAN_BIG));
+        CHECK_EQUAL(1, read[0]);
+        CHECK_EQUAL(0x01020304, read[3]);
+
+        CHECK_EQUAL(0, stream.readArray(read, 4));
+        CHECK(stream.eof());
+    }
+
+
+    TEST(WriteInReadOnlyMode)
+    {
+        FileDataStream stream(ATHENA_CORE_UNITTESTS_DATA_PATH "lines.txt");
+
+        CHECK_EQUAL(0, stream.write("test", 4));
+    }
+}
+
+
+SUITE(FileDataStreamPositionalTests)
+{
+    TEST(ReadAt)
+    {
+        FileDataStream stream(ATHENA_CORE_UNITTESTS_DATA_PATH "lines.txt");
+        CHECK(stream.isOpen());
+
+        char buf[7] = { 0 };
+        CHECK_EQUAL(6, stream.readAt(7, buf, 6));
+        CHECK_EQUAL("Line 2", buf);
+
+        CHECK_EQUAL(0, stream.tell());
+        CHECK(!stream.eof());
+
+        CHECK_EQUAL(6, stream.read(buf, 6));
+        CHECK_EQUAL("Line 1", buf);
+        CHECK_EQUAL(6, stream.tell());
+    }
+
+
+    TEST(ReadAtEnd)
+    {
+        FileDataStream stream(ATHENA_CORE_UNITTESTS_DATA_PATH "lines.txt");
+
+        char buf[10];
+        CHECK_EQUAL(6, stream.readAt(22, buf, 10));
+        CHECK_EQUAL("Line 5", string(buf, 6));
+
+        CHECK_EQUAL(0, stream.readAt(100, buf, 10));
+        CHECK(!stream.eof());
+    }
+
+
+    TEST(WriteAt)
+    {
+        {
+            FileDataStream stream(ATHENA_CORE_UNITTESTS_GENERATED_PATH "positional.txt", DataStream::WRITE);
+            CHECK(stream.isOpen());
+
+            CHECK_EQUAL(6, stream.write("Line 1", 6));
+            CHECK_EQUAL(6, stream.writeAt(12, "Line 3", 6));
+            CHECK_EQUAL(6, stream.tell());
+            CHECK_EQUAL(6, stream.write("-Line 2-", 6));
+        }
+
+        FileDataStream stream(ATHENA_CORE_UNITTESTS_GENERATED_PATH "positional.txt");
+
+        char buf[18];
+        CHECK_EQUAL(18, stream.read(buf, 18));
+        CHECK_EQUAL("Line 1-Line Line 3", string(buf, 18));
+    }
+
+
+    TEST(ConcurrentReadAt)
+    {
+        FileDataStream stream(ATHENA_CORE_UNITTESTS_DATA_PATH "lines.txt");
+        CHECK(stream.isOpen());
+
+        ReaderThread thread1(stream, 0);
+        ReaderThread thread2(stream, 7);
+        ReaderThread thread3(stream, 14);
+
+        CHECK(thread1.start());
+        CHECK(thread2.start());
+        CHECK(thread3.start());
+
+        thread1.join();
+        thread2.join();
+        thread3.join();
+
+        CHECK_EQUAL(0, thread1.nbErrors());
+        CHECK_EQUAL(0, thread2.nbErrors());
+        CHECK_EQUAL(0, thread3.nbErrors());
+    }
+}
+
+
+SUITE(FileDataStreamBufferingTests)
+{
+    TEST(SmallWritesAndSeek)
+    {
+        {
+            FileDataStream stream(ATHENA_CORE_UNITTESTS_GENERATED_PATH "buffered.txt", DataStream::WRITE);
+            CHECK(stream.isOpen());
+
+            for (unsigned int i = 0; i < 1000; ++i)
+                CHECK_EQUAL(4, stream.write("abcd", 4));
+
+            CHECK_EQUAL(4000, stream.tell());
+
+            stream.seek(2);
+            CHECK_EQUAL(2, stream.write("XY", 2));
+            CHECK_EQUAL(4, stream.tell());
+        }
+
+        FileDataStream stream(ATHENA_CORE_UNITTESTS_GENERATED_PATH "buffered.txt");
+
+        char buf[8];
+        CHECK_EQUAL(8, stream.read(buf, 8));
+        CHECK_EQUAL("abXYabcd", string(buf, 8));
+
+        stream.seek(3996);
+        CHECK_EQUAL(4, stream.read(buf, 8));
+        CHECK_EQUAL("abcd", string(buf, 4));
+        CHECK(stream.eof());
+    }
+
+
+    TEST(ReadAfterWrite)
+    {
+        FileDataStream stream(ATHENA_CORE_UNITTESTS_GENERATED_PATH "buffered.txt", DataStream::WRITE);
+        CHECK(stream.isOpen());
+        stream.close();
+
+        FileDataStream stream2(ATHENA_CORE_UNITTESTS_GENERATED_PATH "buffered.txt", DataStream::READ_WRITE);
+        CHECK(stream2.isOpen());
+
+        CHECK_EQUAL(12, stream2.write("Line 1\nLine 2", 12));
+
+        char buf[6];
+        CHECK_EQUAL(0, stream2.readAt(0, buf, 6));
+        CHECK(stream2.flush());
+        CHECK_EQUAL(6, stream2.readAt(0, buf, 6));
+        CHECK_EQUAL("Line 1", string(buf, 6));
+
+        CHECK_EQUAL(1, stream2.write("2", 1));
+        stream2.seek(7);
+        CHECK_EQUAL(6, stream2.read(buf, 6));
+        CHECK_EQUAL("Line 2", string(buf, 6));
+    }
+
+
+    TEST(LargeTransfers)
+    {
+        vector<unsigned char> data(100000);
+        for (size_t i = 0; i < data.size(); ++i)
+            data[i] = (unsigned char) (i * 7);
+
+        {
+            FileDataStream stream(ATHENA_CORE_UNITTESTS_GENERATED_PATH "buffered.bin", DataStream::WRITE);
+            CHECK_EQUAL(10, stream.write(&data[0], 10));
+            CHECK_EQUAL(data.size() - 10, stream.write(&data[10], data.size() - 10));
+        }
+
+        FileDataStream stream(ATHENA_CORE_UNITTESTS_GENERATED_PATH "buffered.bin");
+
+        vector<unsigned char> read(data.size());
+        CHECK_EQUAL(3, stream.read(&read[0], 3));
+        CHECK_EQUAL(data.size() - 3, stream.read(&read[3], data.size()));
+        CHECK(stream.eof());
+        CHECK(read == data);
+    }
+}
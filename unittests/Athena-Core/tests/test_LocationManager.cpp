@@ -2,6 +2,17 @@
 #include <Athena-Core/Data/LocationManager.h>
 #include <Athena-Core/Data/DataStream.h>
 #include <Athena-Core/Data/Serialization.h>
+#include <Athena-Core/Data/FileDataStream.h>
+#include <Athena-Core/Data/FileRequest.h>
+#include <Athena-Core/Data/MemoryDataStream.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <stdio.h>
+
+#if ATHENA_PLATFORM == ATHENA_PLATFORM_WIN32
+    #include <direct.h>
+    #define mkdir(PATH, MODE) _mkdir(PATH)
+#endif
 
 using namespace Athena;
 using namespace Athena::Data;
@@ -169,6 +180,169 @@ SUITE(LocationManager_Paths)
 
         CHECK_EQUAL(string(ATHENA_CORE_UNITTESTS_DATA_PATH) + "lines.txt", path);
     }
+
+
+    TEST_FIXTURE(LocationEnvironment, FileInSubDirectory)
+    {
+        pLocationManager->addLocation("default", ATHENA_CORE_UNITTESTS_DATA_PATH);
+
+        string path = pLocationManager->path("default", "subdir/file.txt");
+
+        CHECK_EQUAL(string(ATHENA_CORE_UNITTESTS_DATA_PATH) + "subdir/file.txt", path);
+    }
+
+
+    TEST_FIXTURE(LocationEnvironment, NonCanonicalFileName)
+    {
+        pLocationManager->addLocation("default", ATHENA_CORE_UNITTESTS_DATA_PATH);
+
+        string path = pLocationManager->path("default", "subdir/../lines.txt");
+
+        CHECK_EQUAL(string(ATHENA_CORE_UNITTESTS_DATA_PATH) + "subdir/../lines.txt", path);
+    }
+
+
+    TEST_FIXTURE(LocationEnvironment, LocationWithoutTrailingSeparator)
+    {
+        pLocationManager->addLocation("default", ATHENA_CORE_UNITTESTS_DATA_PATH "subdir");
+
+        string path = pLocationManager->path("default", "/file.txt");
+
+        CHECK_EQUAL(string(ATHENA_CORE_UNITTESTS_DATA_PATH) + "subdir/file.txt", path);
+    }
+
+
+    TEST_FIXTURE(LocationEnvironment, SearchOrder)
+    {
+        pLocationManager->addLocation("default", ATHENA_CORE_UNITTESTS_DATA_PATH "subdir/");
+        pLocationManager->addLocation("default", ATHENA_CORE_UNITTESTS_DATA_PATH);
+
+        CHECK_EQUAL(string(ATHENA_CORE_UNITTESTS_DATA_PATH) + "subdir/file.txt",
+                    pLocationManager->path("default", "file.txt"));
+
+        CHECK_EQUAL(string(ATHENA_CORE_UNITTESTS_DATA_PATH) + "lines.txt",
+                    pLocationManager->path("default", "lines.txt"));
+    }
+
+
+    TEST_FIXTURE(LocationEnvironment, Refresh)
+    {
+        string strDirectory = ATHENA_CORE_UNITTESTS_GENERATED_PATH "locations/";
+        mkdir(ATHENA_CORE_UNITTESTS_GENERATED_PATH, 0755);
+        mkdir(strDirectory.c_str(), 0755);
+        remove((strDirectory + "new.txt").c_str());
+
+        pLocationManager->addLocation("default", strDirectory);
+
+        CHECK_EQUAL("", pLocationManager->path("default", "new.txt"));
+
+        FileDataStream stream(strDirectory + "new.txt", DataStream::WRITE);
+        CHECK(stream.isOpen());
+        stream.close();
+
+        // The result of the first search is remembered
+        CHECK_EQUAL("", pLocationManager->path("default", "new.txt"));
+
+        pLocationManager->refresh("default");
+
+        CHECK_EQUAL(strDirectory + "new.txt", pLocationManager->path("default", "new.txt"));
+
+        remove((strDirectory + "new.txt").c_str());
+    }
+
+
+#if ATHENA_PLATFORM == ATHENA_PLATFORM_LINUX
+    TEST_FIXTURE(LocationEnvironment, AutoRefresh)
+    {
+        string strDirectory = ATHENA_CORE_UNITTESTS_GENERATED_PATH "locations/";
+        mkdir(ATHENA_CORE_UNITTESTS_GENERATED_PATH, 0755);
+        mkdir(strDirectory.c_str(), 0755);
+        remove((strDirectory + "new.txt").c_str());
+
+        CHECK(pLocationManager->setAutoRefresh(true));
+        CHECK(pLocationManager->isAutoRefreshEnabled());
+
+        pLocationManager->addLocation("default", strDirectory);
+
+        CHECK_EQUAL("", pLocationManager->path("default", "new.txt"));
+
+        FileDataStream stream(strDirectory + "new.txt", DataStream::WRITE);
+        CHECK(stream.isOpen());
+        stream.close();
+
+        CHECK_EQUAL(strDirectory + "new.txt", pLocationManager->path("default", "new.txt"));
+
+        remove((strDirectory + "new.txt").c_str());
+
+        CHECK_EQUAL("", pLocationManager->path("default", "new.txt"));
+
+        CHECK(pLocationManager->setAutoRefresh(false));
+        CHECK(!pLocationManager->isAutoRefreshEnabled());
+    }
+
+
+    TEST_FIXTURE(LocationEnvironment, AutoRefreshAfterRefresh)
+    {
+        string strDirectory = ATHENA_CORE_UNITTESTS_GENERATED_PATH "locations/";
+        mkdir(ATHENA_CORE_UNITTESTS_GENERATED_PATH, 0755);
+        mkdir(strDirectory.c_str(), 0755);
+        remove((strDirectory + "new.txt").c_str());
+
+        CHECK(pLocationManager->setAutoRefresh(true));
+
+        pLocationManager->addLocation("default", strDirectory);
+
+        CHECK_EQUAL("", pLocationManager->path("default", "new.txt"));
+
+        // The directory is watched again when the group is scanned again
+        pLocationManager->refresh();
+        CHECK_EQUAL("", pLocationManager->path("default", "new.txt"));
+
+        FileDataStream stream(strDirectory + "new.txt", DataStream::WRITE);
+        CHECK(stream.isOpen());
+        stream.close();
+
+        CHECK_EQUAL(strDirectory + "new.txt", pLocationManager->path("default", "new.txt"));
+
+        remove((strDirectory + "new.txt").c_str());
+
+        CHECK(pLocationManager->setAutoRefresh(false));
+    }
+#endif
+
+
+    TEST_FIXTURE(LocationEnvironment, ManyUnknownFiles)
+    {
+        // The location can't be scanned, so each search is remembered
+        string strDirectory = ATHENA_CORE_UNITTESTS_GENERATED_PATH "unknown";
+        mkdir(ATHENA_CORE_UNITTESTS_GENERATED_PATH, 0755);
+        mkdir(strDirectory.c_str(), 0755);
+        remove((strDirectory + "/unknown0.txt").c_str());
+
+        pLocationManager->addLocation("default", strDirectory);
+
+        CHECK_EQUAL("", pLocationManager->path("default", "/unknown0.txt"));
+
+        FileDataStream stream(strDirectory + "/unknown0.txt", DataStream::WRITE);
+        CHECK(stream.isOpen());
+        stream.close();
+
+        // The result of the first search is remembered
+        CHECK_EQUAL("", pLocationManager->path("default", "/unknown0.txt"));
+
+        // Until too many files not found are remembered
+        char name[32];
+        for (unsigned int i = 1; i <= 1024; ++i)
+        {
+            sprintf(name, "/unknown%u.txt", i);
+            CHECK_EQUAL("", pLocationManager->path("default", name));
+        }
+
+        CHECK_EQUAL(strDirectory + "/unknown0.txt",
+                    pLocationManager->path("default", "/unknown0.txt"));
+
+        remove((strDirectory + "/unknown0.txt").c_str());
+    }
 }
 
 
@@ -203,3 +377,116 @@ SUITE(LocationManager_DataStream)
         delete pStream;
     }
 }
+
+
+SUITE(LocationManager_AsyncLoading)
+{
+    TEST_FIXTURE(LocationEnvironment, UnknownFile)
+    {
+        pLocationManager->addLocation("default", ATHENA_CORE_UNITTESTS_DATA_PATH);
+
+        CHECK(!pLocationManager->openAsync("unknown", "lines.txt"));
+        CHECK(!pLocationManager->openAsync("default", "unknown.txt"));
+    }
+
+
+    TEST_FIXTURE(LocationEnvironment, ExistingFile)
+    {
+        pLocationManager->addLocation("default", ATHENA_CORE_UNITTESTS_DATA_PATH);
+
+        FileRequest* pRequest = pLocationManager->openAsync("default", "lines.txt");
+        CHECK(pRequest);
+        CHECK_EQUAL(string(ATHENA_CORE_UNITTESTS_DATA_PATH) + "lines.txt", pRequest->path());
+
+        CHECK_EQUAL(FileRequest::SUCCEEDED, pRequest->wait());
+        CHECK(pRequest->isReady());
+
+        DataStream* pStream = pRequest->createStream();
+        CHECK(pStream);
+        CHECK_EQUAL("Line 1", pStream->getLine());
+        CHECK_EQUAL("Line 2", pStream->getLine());
+
+        DataStream* pStream2 = pRequest->createStream();
+        CHECK(pStream2);
+        CHECK_EQUAL("Line 1", pStream2->getLine());
+
+        delete pStream;
+        delete pStream2;
+        pRequest->release();
+    }
+
+
+    TEST_FIXTURE(LocationEnvironment, ManyFiles)
+    {
+        pLocationManager->setNbIOThreads(4);
+        pLocationManager->addLocation("default", ATHENA_CORE_UNITTESTS_DATA_PATH);
+
+        std::vector<FileRequest*> requests;
+        for (unsigned int i = 0; i < 50; ++i)
+            requests.push_back(pLocationManager->openAsync("default", (i % 2 == 0) ? "lines.txt" : "subdir/file.txt"));
+
+        for (unsigned int i = 0; i < 50; ++i)
+        {
+            DataStream* pStream = requests[i]->createStream();
+            CHECK(pStream);
+            CHECK_EQUAL((i % 2 == 0) ? "Line 1" : "Content of a file in a sub-directory", pStream->getLine());
+
+            delete pStream;
+            requests[i]->release();
+        }
+    }
+
+
+    TEST_FIXTURE(LocationEnvironment, PendingRequestsAtDestruction)
+    {
+        pLocationManager->setNbIOThreads(1);
+        pLocationManager->addLocation("default", ATHENA_CORE_UNITTESTS_DATA_PATH);
+
+        std::vector<FileRequest*> requests;
+        for (unsigned int i = 0; i < 50; ++i)
+            requests.push_back(pLocationManager->openAsync("default", "lines.txt"));
+
+        delete pLocationManager;
+        pLocationManager = new LocationManager();
+
+        for (unsigned int i = 0; i < 50; ++i)
+        {
+            CHECK(requests[i]->isReady());
+            requests[i]->release();
+        }
+    }
+
+
+    TEST_FIXTURE(LocationEnvironment, Prefetch)
+    {
+        pLocationManager->addLocation("default", ATHENA_CORE_UNITTESTS_DATA_PATH);
+
+        LocationManager::tFilesList files;
+        files.push_back("lines.txt");
+        files.push_back("subdir/file.txt");
+        files.push_back("unknown.txt");
+
+        pLocationManager->prefetch("default", files);
+
+        DataStream* pStream = pLocationManager->open("default", "subdir/file.txt");
+        CHECK(pStream);
+        CHECK_EQUAL("Content of a file in a sub-directory", pStream->getLine());
+
+        // The prefetched content is shared by all the streams
+        MemoryDataStream* pStream2 = dynamic_cast<MemoryDataStream*>(pLocationManager->open("default", "subdir/file.txt"));
+        CHECK(pStream2);
+        CHECK(pStream2->buffer());
+        CHECK(pStream2->buffer() == dynamic_cast<MemoryDataStream*>(pStream)->buffer());
+        CHECK_EQUAL("Content of a file in a sub-directory", pStream2->getLine());
+
+        delete pStream;
+        delete pStream2;
+
+        FileRequest* pRequest = pLocationManager->openAsync("default", "lines.txt");
+        CHECK(pRequest);
+        CHECK_EQUAL(FileRequest::SUCCEEDED, pRequest->wait());
+        pRequest->release();
+
+        CHECK(!pLocationManager->open("default", "unknown.txt"));
+    }
+}
@@ -0,0 +1,189 @@
+#include <UnitTest++.h>
+#include <Athena-Core/Data/MemoryDataStream.h>
+#include <Athena-Core/Data/SharedBuffer.h>
+#include <string.h>
+
+using namespace Athena::Data;
+using namespace std;
+
+
+static const char* CONTENT = "Line 1\nLine 2\nLine 3\n\nLine 5";
+
+
+struct MemoryDataStreamEnvironment
+{
+    MemoryDataStreamEnvironment()
+    : stream(CONTENT, strlen(CONTENT))
+    {
+    }
+
+    MemoryDataStream stream;
+};
+
+
+SUITE(MemoryDataStreamTests)
+{
+    TEST_FIXTURE(MemoryDataStreamEnvironment, Creation)
+    {
+        CHECK_EQUAL(strlen(CONTENT), stream.size());
+        CHECK(stream.data() == (const unsigned char*) CONTENT);
+        CHECK(!stream.buffer());
+        CHECK_EQUAL(0, stream.tell());
+        CHECK(!stream.eof());
+    }
+
+
+    TEST_FIXTURE(MemoryDataStreamEnvironment, GetLine)
+    {
+        CHECK_EQUAL("Line 1", stream.getLine());
+        CHECK_EQUAL("Line 2", stream.getLine());
+        CHECK_EQUAL("Line 3", stream.getLine());
+        CHECK_EQUAL("", stream.getLine());
+        CHECK_EQUAL("Line 5", stream.getLine());
+        CHECK(stream.eof());
+    }
+
+
+    TEST_FIXTURE(MemoryDataStreamEnvironment, Read)
+    {
+        char buffer[64];
+
+        CHECK_EQUAL(4, stream.read(buffer, 4));
+        CHECK(!stream.eof());
+        CHECK_EQUAL(4, stream.tell());
+
+        CHECK_EQUAL(strlen(CONTENT) - 4, stream.read(buffer, 64));
+        CHECK(stream.eof());
+    }
+
+
+    TEST_FIXTURE(MemoryDataStreamEnvironment, SeekAndSkip)
+    {
+        stream.seek(7);
+        CHECK_EQUAL(7, stream.tell());
+        CHECK_EQUAL("Line 2", stream.getLine());
+
+        stream.skip(-7);
+        CHECK_EQUAL(7, stream.tell());
+
+        stream.skip(-100);
+        CHECK_EQUAL(0, stream.tell());
+
+        stream.seek(1000);
+        CHECK_EQUAL(strlen(CONTENT), stream.tell());
+    }
+
+
+    TEST_FIXTURE(MemoryDataStreamEnvironment, BorrowedSlice)
+    {
+        MemoryDataStream* pSlice = stream.slice(7, 13);
+
+        CHECK(pSlice->data() == (const unsigned char*) CONTENT + 7);
+        CHECK_EQUAL(13, pSlice->size());
+        CHECK_EQUAL("Line 2", pSlice->getLine());
+        CHECK_EQUAL("Line 3", pSlice->getLine());
+        CHECK(pSlice->eof());
+
+        delete pSlice;
+    }
+
+
+    TEST_FIXTURE(MemoryDataStreamEnvironment, SliceOutOfBounds)
+    {
+        MemoryDataStream* pSlice = stream.slice(20, 1000);
+        CHECK_EQUAL(strlen(CONTENT) - 20, pSlice->size());
+        delete pSlice;
+
+        pSlice = stream.slice(1000);
+        CHECK_EQUAL(0, pSlice->size());
+        delete pSlice;
+    }
+
+
+    TEST(TakeOwnership)
+    {
+        unsigned char* pData = new unsigned char[strlen(CONTENT)];
+        memcpy(pData, CONTENT, strlen(CONTENT));
+
+        MemoryDataStream* pStream = new MemoryDataStream(pData, strlen(CONTENT),
+                                                         MemoryDataStream::TAKE_OWNERSHIP);
+        CHECK(pStream->buffer());
+
+        MemoryDataStream* pSlice = pStream->slice(7);
+
+        // The slice keeps the data alive
+        delete pStream;
+
+        CHECK(pSlice->data() == pData + 7);
+        CHECK_EQUAL("Line 2", pSlice->getLine());
+
+        delete pSlice;
+    }
+
+
+    TEST(SharedBuffer)
+    {
+        SharedBuffer* pBuffer = SharedBuffer::create(strlen(CONTENT));
+        CHECK(!pBuffer->isReadOnly());
+        memcpy(pBuffer->writableData(), CONTENT, strlen(CONTENT));
+
+        MemoryDataStream stream1(pBuffer);
+        MemoryDataStream stream2(pBuffer, 7, 6);
+
+        pBuffer->release();
+
+        CHECK(stream1.buffer() == stream2.buffer());
+        CHECK(stream2.data() == stream1.data() + 7);
+
+        CHECK_EQUAL("Line 1", stream1.getLine());
+        CHECK_EQUAL("Line 2", stream2.getLine());
+        CHECK(stream2.eof());
+
+        MemoryDataStream* pSlice = stream2.slice(2);
+        CHECK(pSlice->buffer() == stream1.buffer());
+        CHECK_EQUAL("ne 2", pSlice->getLine());
+        delete pSlice;
+    }
+}
+
+
+SUITE(DataStreamBulkTests)
+{
+    TEST_FIXTURE(MemoryDataStreamEnvironment, ReadV)
+    {
+        char buf1[6];
+        char buf2[64];
+
+        DataStream::tBuffer buffers[] = {
+            { buf1, 6 },
+            { buf2, 64 },
+        };
+
+        CHECK_EQUAL(strlen(CONTENT), stream.readv(buffers, 2));
+        CHECK_EQUAL("Line 1", string(buf1, 6));
+        CHECK_EQUAL("\nLine 2", string(buf2, 7));
+        CHECK(stream.eof());
+    }
+
+
+    TEST(ReadArrayWithSwap)
+    {
+        const unsigned char data[] = { 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09 };
+
+        MemoryDataStream stream(data, sizeof(data));
+
+        unsigned short values[5];
+        CHECK_EQUAL(4, stream.readArray(values, 5, DataStream::ENDIAN_BIG));
+        CHECK_EQUAL(0x0102, values[0]);
+        CHECK_EQUAL(0x0708, values[3]);
+
+        stream.seek(0);
+        CHECK_EQUAL(4, stream.readArray(values, 4, DataStream::ENDIAN_LITTLE));
+        CHECK_EQUAL(0x0201, values[0]);
+
+        stream.seek(1);
+        unsigned long long value;
+        CHECK_EQUAL(1, stream.readArray(&value, 1, DataStream::ENDIAN_BIG));
+        CHECK(value == 0x0203040506070809ULL);
+    }
+}
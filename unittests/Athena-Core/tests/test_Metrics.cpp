@@ -0,0 +1,254 @@
+#include <UnitTest++.h>
+#include <Athena-Core/Utils/Metrics.h>
+#include <Athena-Core/Utils/Thread.h>
+#include <Athena-Core/Utils/Variant.h>
+#include <Athena-Core/Signals/Signal.h>
+
+using namespace Athena::Utils;
+using namespace Athena::Signals;
+
+
+class IncrementingThread: public Thread
+{
+public:
+    IncrementingThread(Counter& counter, Histogram& histogram)
+    : m_counter(counter), m_histogram(histogram)
+    {
+    }
+
+protected:
+    virtual void run()
+    {
+        for (unsigned int i = 0; i < 10000; ++i)
+        {
+            m_counter.increment();
+            m_histogram.record(i);
+        }
+    }
+
+private:
+    Counter&    m_counter;
+    Histogram&  m_histogram;
+};
+
+
+static const MetricsRegistry::tMetricValue* findValue(const MetricsRegistry::tSnapshot& snapshot,
+                                                      const std::string& strName)
+{
+    for (unsigned int i = 0; i < snapshot.size(); ++i)
+    {
+        if (snapshot[i].strName == strName)
+            return &snapshot[i];
+    }
+
+    return 0;
+}
+
+
+SUITE(MetricsTests)
+{
+    TEST(Counter)
+    {
+        Counter counter("tests.counter");
+
+        CHECK_EQUAL(Metric::COUNTER, counter.type());
+        CHECK_EQUAL(0, counter.value());
+
+        counter.increment();
+        counter.add(10);
+        CHECK_EQUAL(11, counter.value());
+
+        counter.reset();
+        CHECK_EQUAL(0, counter.value());
+    }
+
+
+    TEST(Gauge)
+    {
+        Gauge gauge("tests.gauge");
+
+        CHECK_EQUAL(Metric::GAUGE, gauge.type());
+
+        gauge.increment();
+        gauge.increment();
+        gauge.decrement();
+        gauge.add(-5);
+        CHECK_EQUAL(-4, gauge.value());
+
+        gauge.set(20);
+        CHECK_EQUAL(20, gauge.value());
+    }
+
+
+    TEST(HistogramBuckets)
+    {
+        CHECK_EQUAL(0, Histogram::bucket(0));
+        CHECK_EQUAL(1, Histogram::bucket(1));
+        CHECK_EQUAL(2, Histogram::bucket(2));
+        CHECK_EQUAL(2, Histogram::bucket(3));
+        CHECK_EQUAL(3, Histogram::bucket(4));
+        CHECK_EQUAL(11, Histogram::bucket(1024));
+        CHECK_EQUAL(64, Histogram::bucket(~0ULL));
+
+        CHECK_EQUAL(0, Histogram::bucketUpperBound(0));
+        CHECK_EQUAL(1, Histogram::bucketUpperBound(1));
+        CHECK_EQUAL(3, Histogram::bucketUpperBound(2));
+        CHECK_EQUAL(2047, Histogram::bucketUpperBound(11));
+    }
+
+
+    TEST(Histogram)
+    {
+        Histogram histogram("tests.histogram");
+
+        for (unsigned int i = 1; i <= 100; ++i)
+            histogram.record(i);
+
+        CHECK_EQUAL(100, histogram.count());
+        CHECK_EQUAL(5050, histogram.sum());
+
+        std::vector<unsigned long long> buckets = histogram.buckets();
+        CHECK_EQUAL((unsigned int) Metric::NB_BUCKETS, buckets.size());
+        CHECK_EQUAL(1, buckets[1]);
+        CHECK_EQUAL(2, buckets[2]);
+        CHECK_EQUAL(37, buckets[7]);
+
+        histogram.reset();
+        CHECK_EQUAL(0, histogram.count());
+        CHECK_EQUAL(0, histogram.sum());
+    }
+
+
+    TEST(Registry)
+    {
+        {
+            Counter counter("tests.registered");
+            CHECK(MetricsRegistry::find("tests.registered") == &counter);
+        }
+
+        CHECK(!MetricsRegistry::find("tests.registered"));
+    }
+
+
+    TEST(Snapshot)
+    {
+        Counter counter("tests.snapshot.counter", "A counter");
+        Histogram histogram("tests.snapshot.histogram");
+
+        counter.add(3);
+        histogram.record(10);
+        histogram.record(1000);
+
+        MetricsRegistry::tSnapshot snapshot = MetricsRegistry::snapshot();
+
+        const MetricsRegistry::tMetricValue* pCounter = findValue(snapshot, "tests.snapshot.counter");
+        CHECK(pCounter);
+        if (pCounter)
+        {
+            CHECK_EQUAL("A counter", pCounter->strDescription);
+            CHECK_EQUAL(Metric::COUNTER, pCounter->type);
+            CHECK_EQUAL(3, pCounter->value);
+        }
+
+        const MetricsRegistry::tMetricValue* pHistogram = findValue(snapshot, "tests.snapshot.histogram");
+        CHECK(pHistogram);
+        if (pHistogram)
+        {
+            CHECK_EQUAL(2, pHistogram->value);
+            CHECK_EQUAL(1010, pHistogram->sum);
+            CHECK_EQUAL(15, MetricsRegistry::percentile(*pHistogram, 50.0));
+            CHECK_EQUAL(1023, MetricsRegistry::percentile(*pHistogram, 99.0));
+        }
+
+        // Sorted by name
+        for (unsigned int i = 1; i < snapshot.size(); ++i)
+            CHECK(snapshot[i - 1].strName < snapshot[i].strName);
+    }
+
+
+    TEST(JSON)
+    {
+        Counter counter("tests.json.counter");
+        Histogram histogram("tests.json.histogram");
+
+        counter.add(42);
+        histogram.record(5);
+
+        std::string strJSON = MetricsRegistry::toJSON();
+
+        CHECK(strJSON.find("\"tests.json.counter\":42") != std::string::npos);
+        CHECK(strJSON.find("\"tests.json.histogram\":{\"count\":1,\"sum\":5,\"buckets\":[[7,1]]}") != std::string::npos);
+    }
+
+
+    TEST(Threads)
+    {
+        Counter counter("tests.threads.counter");
+        Histogram histogram("tests.threads.histogram");
+
+        IncrementingThread* threads[8];
+
+        for (unsigned int i = 0; i < 8; ++i)
+        {
+            threads[i] = new IncrementingThread(counter, histogram);
+            CHECK(threads[i]->start());
+        }
+
+        for (unsigned int i = 0; i < 8; ++i)
+        {
+            threads[i]->join();
+            delete threads[i];
+        }
+
+        CHECK_EQUAL(80000, counter.value());
+        CHECK_EQUAL(80000, histogram.count());
+        CHECK_EQUAL(8ULL * 49995000ULL, histogram.sum());
+    }
+
+
+    TEST(VariantMetrics)
+    {
+        Counter* pCreated = static_cast<Counter*>(MetricsRegistry::find("variants.created"));
+        Gauge* pAlive = static_cast<Gauge*>(MetricsRegistry::find("variants.alive"));
+        Counter* pConversions = static_cast<Counter*>(MetricsRegistry::find("variants.conversions"));
+
+        CHECK(pCreated && pAlive && pConversions);
+        if (!pCreated || !pAlive || !pConversions)
+            return;
+
+        unsigned long long nbCreated = pCreated->value();
+        long long nbAlive = pAlive->value();
+        unsigned long long nbConversions = pConversions->value();
+
+        {
+            Variant value1(10);
+            Variant value2("20");
+
+            CHECK_EQUAL(nbCreated + 2, pCreated->value());
+            CHECK_EQUAL(nbAlive + 2, pAlive->value());
+
+            value2.convertTo(Variant::INTEGER);
+            CHECK_EQUAL(nbConversions + 1, pConversions->value());
+        }
+
+        CHECK_EQUAL(nbAlive, pAlive->value());
+    }
+
+
+    TEST(SignalMetrics)
+    {
+        Counter* pFired = static_cast<Counter*>(MetricsRegistry::find("signals.fired"));
+
+        CHECK(pFired);
+        if (!pFired)
+            return;
+
+        unsigned long long nbFired = pFired->value();
+
+        Signal signal;
+        signal.fire();
+        signal.fire();
+
+        CHECK_EQUAL(nbFired + 2, pFired->value());
+    }
+}
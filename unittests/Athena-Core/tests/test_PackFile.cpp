@@ -0,0 +1,198 @@
+#include <UnitTest++.h>
+#include <Athena-Core/Data/PackFile.h>
+#include <Athena-Core/Data/MemoryDataStream.h>
+#include <Athena-Core/Data/LocationManager.h>
+#include <Athena-Core/Data/FileDataStream.h>
+
+using namespace Athena::Data;
+using namespace std;
+
+
+struct PackFileEnvironment
+{
+    PackFileEnvironment()
+    : strFileName(ATHENA_CORE_UNITTESTS_GENERATED_PATH "data.pack"), pPackFile(0)
+    {
+        if (PackFile::build(ATHENA_CORE_UNITTESTS_DATA_PATH, strFileName))
+            pPackFile = PackFile::load(strFileName);
+    }
+
+    ~PackFileEnvironment()
+    {
+        if (pPackFile)
+            pPackFile->release();
+    }
+
+    string      strFileName;
+    PackFile*   pPackFile;
+};
+
+
+SUITE(PackFileTests)
+{
+    TEST_FIXTURE(PackFileEnvironment, Load)
+    {
+        CHECK(pPackFile);
+        CHECK_EQUAL(strFileName, pPackFile->fileName());
+        CHECK(pPackFile->nbEntries() >= 3);
+        CHECK(pPackFile->isReadOnly());
+        CHECK(!pPackFile->writableData());
+    }
+
+
+    TEST(LoadInvalidFile)
+    {
+        CHECK(!PackFile::load(ATHENA_CORE_UNITTESTS_DATA_PATH "lines.txt"));
+        CHECK(!PackFile::load(ATHENA_CORE_UNITTESTS_DATA_PATH "unknown.pack"));
+    }
+
+
+    TEST_FIXTURE(PackFileEnvironment, Verify)
+    {
+        CHECK(pPackFile->verify());
+    }
+
+
+    TEST(VerifyCorruptedFile)
+    {
+        string strFileName = ATHENA_CORE_UNITTESTS_GENERATED_PATH "corrupted.pack";
+        CHECK(PackFile::build(ATHENA_CORE_UNITTESTS_DATA_PATH, strFileName));
+
+        {
+            FileDataStream stream(strFileName, DataStream::READ_WRITE);
+
+            char c;
+            CHECK_EQUAL(1, stream.readAt(40, &c, 1));
+            c = ~c;
+            CHECK_EQUAL(1, stream.writeAt(40, &c, 1));
+        }
+
+        PackFile* pPackFile = PackFile::load(strFileName);
+        CHECK(pPackFile);
+        CHECK(!pPackFile->verify());
+
+        pPackFile->release();
+    }
+
+
+    TEST(BuildInsideTheDirectory)
+    {
+        string strFileName = ATHENA_CORE_UNITTESTS_GENERATED_PATH "self.pack";
+        CHECK(PackFile::build(ATHENA_CORE_UNITTESTS_GENERATED_PATH, strFileName));
+        CHECK(PackFile::build(ATHENA_CORE_UNITTESTS_GENERATED_PATH, strFileName));
+
+        PackFile* pPackFile = PackFile::load(strFileName);
+        CHECK(pPackFile);
+        CHECK(!pPackFile->contains("self.pack"));
+        CHECK(pPackFile->verify());
+
+        pPackFile->release();
+    }
+
+
+    TEST_FIXTURE(PackFileEnvironment, Contains)
+    {
+        CHECK(pPackFile->contains("lines.txt"));
+        CHECK(pPackFile->contains("subdir/file.txt"));
+        CHECK(!pPackFile->contains("subdir"));
+        CHECK(!pPackFile->contains("unknown.txt"));
+    }
+
+
+    TEST_FIXTURE(PackFileEnvironment, EntryNames)
+    {
+        bool bFound = false;
+        for (unsigned int i = 0; i < pPackFile->nbEntries(); ++i)
+            bFound = bFound || (pPackFile->entryName(i) == "subdir/file.txt");
+
+        CHECK(bFound);
+    }
+
+
+    TEST_FIXTURE(PackFileEnvironment, OpenUnknownFile)
+    {
+        CHECK(!pPackFile->open("unknown.txt"));
+    }
+
+
+    TEST_FIXTURE(PackFileEnvironment, GetLine)
+    {
+        DataStream* pStream = pPackFile->open("lines.txt");
+        CHECK(pStream);
+        CHECK(!pStream->eof());
+
+        CHECK_EQUAL("Line 1", pStream->getLine());
+        CHECK_EQUAL("Line 2", pStream->getLine());
+        CHECK_EQUAL("Line 3", pStream->getLine());
+        CHECK_EQUAL("", pStream->getLine());
+        CHECK_EQUAL("Line 5", pStream->getLine());
+        CHECK(pStream->eof());
+
+        delete pStream;
+    }
+
+
+    TEST_FIXTURE(PackFileEnvironment, SeekAndSkip)
+    {
+        DataStream* pStream = pPackFile->open("lines.txt");
+
+        pStream->seek(7);
+        CHECK_EQUAL(7, pStream->tell());
+        CHECK_EQUAL("Line 2", pStream->getLine());
+
+        pStream->skip(-7);
+        CHECK_EQUAL(7, pStream->tell());
+
+        char buffer[64];
+        CHECK_EQUAL(21, pStream->read(buffer, 64));
+        CHECK(pStream->eof());
+
+        delete pStream;
+    }
+
+
+    TEST_FIXTURE(PackFileEnvironment, ZeroCopy)
+    {
+        MemoryDataStream* pStream = pPackFile->open("lines.txt");
+
+        CHECK(pStream->buffer() == pPackFile);
+        CHECK(pStream->data() >= pPackFile->data());
+        CHECK(pStream->data() + pStream->size() <= pPackFile->data() + pPackFile->size());
+
+        delete pStream;
+    }
+
+
+    TEST_FIXTURE(PackFileEnvironment, StreamOutlivesPackFile)
+    {
+        DataStream* pStream = pPackFile->open("subdir/file.txt");
+
+        pPackFile->release();
+        pPackFile = 0;
+
+        CHECK_EQUAL("Content of a file in a sub-directory", pStream->getLine());
+
+        delete pStream;
+    }
+
+
+    TEST_FIXTURE(PackFileEnvironment, LocationManager)
+    {
+        LocationManager* pLocationManager = new LocationManager();
+        pLocationManager->addLocation("default", strFileName);
+
+        CHECK_EQUAL(strFileName + "/subdir/file.txt",
+                    pLocationManager->path("default", "subdir/file.txt"));
+        CHECK_EQUAL("", pLocationManager->path("default", "unknown.txt"));
+
+        DataStream* pStream = pLocationManager->open("default", "lines.txt");
+        CHECK(pStream);
+        CHECK_EQUAL("Line 1", pStream->getLine());
+
+        delete pLocationManager;
+
+        CHECK_EQUAL("Line 2", pStream->getLine());
+
+        delete pStream;
+    }
+}
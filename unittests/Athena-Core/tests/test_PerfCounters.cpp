@@ -0,0 +1,101 @@
+#include <UnitTest++.h>
+#include <Athena-Core/Utils/PerfCounters.h>
+
+using namespace Athena::Utils;
+
+
+static volatile unsigned int g_sink = 0;
+
+static void work()
+{
+    unsigned int total = 0;
+    for (unsigned int i = 0; i < 100000; ++i)
+        total += (i * 7) ^ (total >> 3);
+
+    g_sink = total;
+}
+
+
+SUITE(PerfCountersTests)
+{
+    TEST(Names)
+    {
+        CHECK_EQUAL("instructions", PerfCounters::name(PerfCounters::INSTRUCTIONS));
+        CHECK_EQUAL("cycles", PerfCounters::name(PerfCounters::CYCLES));
+        CHECK_EQUAL("cache-references", PerfCounters::name(PerfCounters::CACHE_REFERENCES));
+        CHECK_EQUAL("cache-misses", PerfCounters::name(PerfCounters::CACHE_MISSES));
+        CHECK_EQUAL("branches", PerfCounters::name(PerfCounters::BRANCHES));
+        CHECK_EQUAL("branch-misses", PerfCounters::name(PerfCounters::BRANCH_MISSES));
+    }
+
+
+    TEST(NoCounter)
+    {
+        PerfCounters counters(0);
+
+        CHECK(!counters.isAvailable());
+
+        counters.start();
+        work();
+        counters.stop();
+
+        CHECK_EQUAL(0, counters.value(PerfCounters::INSTRUCTIONS));
+        CHECK_EQUAL(0.0, counters.ipc());
+        CHECK_EQUAL(0.0, counters.cacheMissRate());
+        CHECK_EQUAL(0.0, counters.branchMissRate());
+    }
+
+
+    TEST(Selection)
+    {
+        PerfCounters counters(PerfCounters::INSTRUCTIONS);
+
+        CHECK(!counters.isAvailable(PerfCounters::CYCLES));
+        CHECK(!counters.isAvailable(PerfCounters::BRANCH_MISSES));
+        CHECK_EQUAL(counters.isAvailable(), counters.isAvailable(PerfCounters::INSTRUCTIONS));
+    }
+
+
+    TEST(Counting)
+    {
+        PerfCounters counters;
+
+        counters.start();
+        work();
+        counters.stop();
+
+        // The counters might not be available (virtual machine, restricted permissions)
+        if (counters.isAvailable(PerfCounters::INSTRUCTIONS))
+            CHECK(counters.value(PerfCounters::INSTRUCTIONS) >= 100000);
+        else
+            CHECK_EQUAL(0, counters.value(PerfCounters::INSTRUCTIONS));
+
+        if (counters.isAvailable(PerfCounters::INSTRUCTIONS) &&
+            counters.isAvailable(PerfCounters::CYCLES))
+        {
+            CHECK(counters.ipc() > 0.0);
+        }
+
+        CHECK(counters.cacheMissRate() <= 1.0);
+        CHECK(counters.branchMissRate() <= 1.0);
+    }
+
+
+    TEST(Restart)
+    {
+        PerfCounters counters(PerfCounters::INSTRUCTIONS);
+
+        counters.start();
+        work();
+        work();
+        counters.stop();
+
+        unsigned long long nbInstructions = counters.value(PerfCounters::INSTRUCTIONS);
+
+        counters.start();
+        work();
+        counters.stop();
+
+        CHECK(counters.value(PerfCounters::INSTRUCTIONS) <= nbInstructions);
+    }
+}
@@ -0,0 +1,253 @@
+#include <UnitTest++.h>
+#include <Athena-Core/Utils/PoolAllocator.h>
+#include <Athena-Core/Utils/Thread.h>
+#include <Athena-Core/Utils/Mutex.h>
+#include <Athena-Core/Utils/Variant.h>
+#include <string.h>
+
+using namespace Athena::Utils;
+
+
+/// Size of the blocks used by the stress tests (not used by other objects, so the
+/// counts of blocks aren't disturbed)
+static const size_t STRESS_SIZE = 232;
+
+
+//---------------------------------------------------------------------------------------
+/// @brief  Allocate blocks, and give half of them to the next thread, which release
+///         them (the blocks are filled with a pattern to detect the corruptions)
+//---------------------------------------------------------------------------------------
+class AllocatingThread: public Thread
+{
+public:
+    AllocatingThread()
+    : pNext(0), nbErrors(0)
+    {
+    }
+
+    void give(unsigned char* pBlock)
+    {
+        ScopedLock lock(mutex);
+        received.push_back(pBlock);
+    }
+
+protected:
+    virtual void run()
+    {
+        std::vector<unsigned char*> blocks;
+
+        for (unsigned int round = 0; round < 200; ++round)
+        {
+            unsigned char pattern = (unsigned char) (round + (size_t) this);
+
+            for (unsigned int i = 0; i < 100; ++i)
+            {
+                unsigned char* pBlock = (unsigned char*) PoolAllocator::allocate(STRESS_SIZE);
+                memset(pBlock, pattern, STRESS_SIZE);
+                blocks.push_back(pBlock);
+            }
+
+            for (unsigned int i = 0; i < blocks.size(); ++i)
+            {
+                if ((blocks[i][0] != pattern) || (blocks[i][STRESS_SIZE - 1] != pattern))
+                    ++nbErrors;
+
+                if (i % 2)
+                    pNext->give(blocks[i]);
+                else
+                    PoolAllocator::deallocate(blocks[i], STRESS_SIZE);
+            }
+
+            blocks.clear();
+
+            releaseReceived();
+        }
+    }
+
+public:
+    void releaseReceived()
+    {
+        ScopedLock lock(mutex);
+
+        for (unsigned int i = 0; i < received.size(); ++i)
+            PoolAllocator::deallocate(received[i], STRESS_SIZE);
+
+        received.clear();
+    }
+
+    AllocatingThread*           pNext;
+    unsigned int                nbErrors;
+
+private:
+    Mutex                       mutex;
+    std::vector<unsigned char*> received;
+};
+
+
+//---------------------------------------------------------------------------------------
+/// @brief  Create and destroy variants
+//---------------------------------------------------------------------------------------
+class VariantsThread: public Thread
+{
+public:
+    VariantsThread()
+    : nbErrors(0)
+    {
+    }
+
+protected:
+    virtual void run()
+    {
+        std::vector<Variant*> variants;
+
+        for (unsigned int round = 0; round < 100; ++round)
+        {
+            for (unsigned int i = 0; i < 200; ++i)
+                variants.push_back(new Variant((int) (round * 1000 + i)));
+
+            for (unsigned int i = 0; i < variants.size(); ++i)
+            {
+                if (variants[i]->toInt() != (int) (round * 1000 + i))
+                    ++nbErrors;
+
+                delete variants[i];
+            }
+
+            variants.clear();
+        }
+    }
+
+public:
+    unsigned int nbErrors;
+};
+
+
+//---------------------------------------------------------------------------------------
+/// @brief  Allocate and release some blocks, then end
+//---------------------------------------------------------------------------------------
+class ShortThread: public Thread
+{
+protected:
+    virtual void run()
+    {
+        void* blocks[PoolAllocator::BATCH_SIZE];
+
+        for (unsigned int i = 0; i < PoolAllocator::BATCH_SIZE; ++i)
+            blocks[i] = PoolAllocator::allocate(STRESS_SIZE - 16);
+
+        for (unsigned int i = 0; i < PoolAllocator::BATCH_SIZE; ++i)
+            PoolAllocator::deallocate(blocks[i], STRESS_SIZE - 16);
+    }
+};
+
+
+SUITE(PoolAllocatorTests)
+{
+    TEST(BlocksAreReused)
+    {
+        void* p = PoolAllocator::allocate(24);
+        CHECK(p);
+
+        PoolAllocator::deallocate(p, 24);
+
+        CHECK_EQUAL(p, PoolAllocator::allocate(20));
+        PoolAllocator::deallocate(p, 20);
+    }
+
+
+    TEST(SizeClasses)
+    {
+        void* p1 = PoolAllocator::allocate(0);
+        void* p2 = PoolAllocator::allocate(16);
+        void* p3 = PoolAllocator::allocate(17);
+        void* p4 = PoolAllocator::allocate(PoolAllocator::MAX_SIZE + 1);
+
+        CHECK(p1 && p2 && p3 && p4);
+        CHECK(p1 != p2);
+        CHECK(p2 != p3);
+
+        CHECK_EQUAL(0, (size_t) p2 % sizeof(void*));
+        CHECK_EQUAL(0, (size_t) p3 % sizeof(void*));
+
+        memset(p3, 0xFF, 17);
+        memset(p4, 0xFF, PoolAllocator::MAX_SIZE + 1);
+
+        PoolAllocator::deallocate(p1, 0);
+        PoolAllocator::deallocate(p2, 16);
+        PoolAllocator::deallocate(p3, 17);
+        PoolAllocator::deallocate(p4, PoolAllocator::MAX_SIZE + 1);
+        PoolAllocator::deallocate(0, 16);
+    }
+
+
+    TEST(ExtraBlocksGoToTheReserve)
+    {
+        std::vector<void*> blocks;
+
+        for (unsigned int i = 0; i < 3 * PoolAllocator::BATCH_SIZE; ++i)
+            blocks.push_back(PoolAllocator::allocate(STRESS_SIZE));
+
+        size_t nbReserveBlocks = PoolAllocator::nbReserveBlocks();
+
+        for (unsigned int i = 0; i < blocks.size(); ++i)
+            PoolAllocator::deallocate(blocks[i], STRESS_SIZE);
+
+        CHECK(PoolAllocator::nbReserveBlocks() > nbReserveBlocks);
+    }
+
+
+    TEST(ThreadCachesAreReclaimed)
+    {
+        ShortThread thread1;
+        CHECK(thread1.start());
+        thread1.join();
+
+        size_t nbReservedBytes = PoolAllocator::nbReservedBytes();
+
+        // The following threads reuse the blocks of the first one
+        for (unsigned int i = 0; i < 10; ++i)
+        {
+            ShortThread thread;
+            CHECK(thread.start());
+            thread.join();
+        }
+
+        CHECK_EQUAL(nbReservedBytes, PoolAllocator::nbReservedBytes());
+    }
+
+
+    TEST(StressWithEightThreads)
+    {
+        AllocatingThread threads[8];
+
+        for (unsigned int i = 0; i < 8; ++i)
+            threads[i].pNext = &threads[(i + 1) % 8];
+
+        for (unsigned int i = 0; i < 8; ++i)
+            CHECK(threads[i].start());
+
+        for (unsigned int i = 0; i < 8; ++i)
+            threads[i].join();
+
+        for (unsigned int i = 0; i < 8; ++i)
+        {
+            threads[i].releaseReceived();
+            CHECK_EQUAL(0, threads[i].nbErrors);
+        }
+    }
+
+
+    TEST(VariantsWithEightThreads)
+    {
+        VariantsThread threads[8];
+
+        for (unsigned int i = 0; i < 8; ++i)
+            CHECK(threads[i].start());
+
+        for (unsigned int i = 0; i < 8; ++i)
+            threads[i].join();
+
+        for (unsigned int i = 0; i < 8; ++i)
+            CHECK_EQUAL(0, threads[i].nbErrors);
+    }
+}
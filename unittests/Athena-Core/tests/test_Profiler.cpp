@@ -0,0 +1,222 @@
+#include <UnitTest++.h>
+#include <Athena-Core/Utils/Profiler.h>
+#include <Athena-Core/Utils/Thread.h>
+
+using namespace Athena::Utils;
+
+
+class ProfiledThread: public Thread
+{
+protected:
+    virtual void run()
+    {
+        for (unsigned int i = 0; i < 1000; ++i)
+        {
+            ATHENA_PROFILE_SCOPE("worker");
+        }
+    }
+};
+
+
+struct ProfilerEnvironment
+{
+    ProfilerEnvironment()
+    {
+        Profiler::reset();
+        Profiler::enable(true);
+    }
+
+    ~ProfilerEnvironment()
+    {
+        Profiler::enable(false);
+        Profiler::reset();
+    }
+
+
+    const Profiler::tScopeStatistics* find(const Profiler::tStatisticsList& statistics,
+                                           const std::string& strPath)
+    {
+        for (unsigned int i = 0; i < statistics.size(); ++i)
+        {
+            if (statistics[i].strPath == strPath)
+                return &statistics[i];
+        }
+
+        return 0;
+    }
+};
+
+
+SUITE(ProfilerTests)
+{
+    TEST(DisabledByDefault)
+    {
+        CHECK(!Profiler::isEnabled());
+    }
+
+
+    TEST_FIXTURE(ProfilerEnvironment, Disabled)
+    {
+        Profiler::enable(false);
+
+        {
+            ATHENA_PROFILE_SCOPE("scope");
+        }
+
+        CHECK(Profiler::getStatistics().empty());
+    }
+
+
+    TEST_FIXTURE(ProfilerEnvironment, Scope)
+    {
+        for (unsigned int i = 0; i < 3; ++i)
+        {
+            ATHENA_PROFILE_SCOPE("scope");
+        }
+
+        Profiler::tStatisticsList statistics = Profiler::getStatistics();
+        CHECK_EQUAL(1, statistics.size());
+
+        const Profiler::tScopeStatistics* pScope = find(statistics, "scope");
+        CHECK(pScope);
+        if (pScope)
+        {
+            CHECK_EQUAL("scope", pScope->strName);
+            CHECK_EQUAL(1, pScope->depth);
+            CHECK_EQUAL(3, pScope->count);
+            CHECK(pScope->min <= pScope->max);
+            CHECK(pScope->total >= pScope->max);
+        }
+    }
+
+
+    TEST_FIXTURE(ProfilerEnvironment, Hierarchy)
+    {
+        {
+            ATHENA_PROFILE_SCOPE("frame");
+
+            for (unsigned int i = 0; i < 2; ++i)
+            {
+                ATHENA_PROFILE_SCOPE("update");
+                {
+                    ATHENA_PROFILE_SCOPE("physics");
+                }
+            }
+
+            ATHENA_PROFILE_SCOPE("render");
+        }
+
+        Profiler::tStatisticsList statistics = Profiler::getStatistics();
+        CHECK_EQUAL(4, statistics.size());
+
+        const Profiler::tScopeStatistics* pFrame   = find(statistics, "frame");
+        const Profiler::tScopeStatistics* pUpdate  = find(statistics, "frame/update");
+        const Profiler::tScopeStatistics* pPhysics = find(statistics, "frame/update/physics");
+        const Profiler::tScopeStatistics* pRender  = find(statistics, "frame/render");
+
+        CHECK(pFrame && pUpdate && pPhysics && pRender);
+        if (pFrame && pUpdate && pPhysics && pRender)
+        {
+            CHECK_EQUAL(1, pFrame->count);
+            CHECK_EQUAL(2, pUpdate->count);
+            CHECK_EQUAL(2, pPhysics->count);
+            CHECK_EQUAL(1, pRender->count);
+            CHECK_EQUAL(3, pPhysics->depth);
+            CHECK(pFrame->total >= pUpdate->total);
+        }
+    }
+
+
+    TEST_FIXTURE(ProfilerEnvironment, DisabledInsideScope)
+    {
+        {
+            ATHENA_PROFILE_SCOPE("scope");
+            Profiler::enable(false);
+        }
+
+        Profiler::enable(true);
+
+        {
+            ATHENA_PROFILE_SCOPE("other");
+        }
+
+        Profiler::tStatisticsList statistics = Profiler::getStatistics();
+        CHECK_EQUAL(2, statistics.size());
+        CHECK(find(statistics, "scope"));
+        CHECK(find(statistics, "other"));
+    }
+
+
+    TEST_FIXTURE(ProfilerEnvironment, Threads)
+    {
+        ProfiledThread threads[4];
+
+        for (unsigned int i = 0; i < 4; ++i)
+            CHECK(threads[i].start());
+
+        for (unsigned int i = 0; i < 4; ++i)
+            threads[i].join();
+
+        Profiler::tStatisticsList statistics = Profiler::getStatistics();
+        CHECK_EQUAL(1, statistics.size());
+
+        const Profiler::tScopeStatistics* pScope = find(statistics, "worker");
+        CHECK(pScope);
+        if (pScope)
+            CHECK_EQUAL(4000, pScope->count);
+    }
+
+
+    TEST_FIXTURE(ProfilerEnvironment, Overflow)
+    {
+        unsigned long long nbDropped = Profiler::nbDroppedEvents();
+
+        for (unsigned int i = 0; i < 10000; ++i)
+        {
+            ATHENA_PROFILE_SCOPE("scope");
+        }
+
+        CHECK(Profiler::nbDroppedEvents() > nbDropped);
+
+        // The events that fit in the buffer are still processed
+        Profiler::tStatisticsList statistics = Profiler::getStatistics();
+        CHECK_EQUAL(1, statistics.size());
+        CHECK(statistics[0].count > 0);
+        CHECK(statistics[0].count < 10000);
+
+        // The dropped events are forgotten by a reset
+        Profiler::reset();
+        CHECK_EQUAL(0, Profiler::nbDroppedEvents());
+    }
+
+
+    TEST_FIXTURE(ProfilerEnvironment, ChromeTrace)
+    {
+        {
+            ATHENA_PROFILE_SCOPE("outer");
+            {
+                ATHENA_PROFILE_SCOPE("inner");
+            }
+        }
+
+        std::string strTrace = Profiler::toChromeTrace();
+
+        CHECK(strTrace.find("\"traceEvents\"") != std::string::npos);
+        CHECK(strTrace.find("\"outer\"") != std::string::npos);
+        CHECK(strTrace.find("\"inner\"") != std::string::npos);
+        CHECK(strTrace.find("\"ph\":\"X\"") != std::string::npos);
+    }
+
+
+    TEST_FIXTURE(ProfilerEnvironment, Reset)
+    {
+        {
+            ATHENA_PROFILE_SCOPE("scope");
+        }
+
+        Profiler::reset();
+
+        CHECK(Profiler::getStatistics().empty());
+        CHECK(Profiler::toChromeTrace().find("\"scope\"") == std::string::npos);
+    }
+}
@@ -376,4 +376,199 @@ SUITE(PropertiesListTests)
         category = iter.getNext();
         CHECK_EQUAL("Cat1", category.strName);
     }
+
+
+    TEST(CopySharesCategories)
+    {
+        PropertiesList list1;
+        list1.set("Cat1", "int", new Variant(10));
+        list1.set("Cat2", "float", new Variant(10.0f));
+
+        CHECK(!list1.isShared("Cat1"));
+
+        PropertiesList list2(list1);
+
+        CHECK(list1.isShared("Cat1"));
+        CHECK(list1.isShared("Cat2"));
+        CHECK(list2.isShared("Cat1"));
+        CHECK_EQUAL(2, list2.nbCategories());
+        CHECK_EQUAL(2, list2.nbTotalProperties());
+
+        const PropertiesList& constList1 = list1;
+        const PropertiesList& constList2 = list2;
+        CHECK_EQUAL(constList1.get("Cat1", "int"), constList2.get("Cat1", "int"));
+    }
+
+
+    TEST(ModificationDetachesOnlyTheCategory)
+    {
+        PropertiesList list1;
+        list1.set("Cat1", "int", new Variant(10));
+        list1.set("Cat2", "float", new Variant(10.0f));
+
+        PropertiesList list2(list1);
+
+        list2.set("Cat1", "int", new Variant(20));
+
+        CHECK(!list1.isShared("Cat1"));
+        CHECK(!list2.isShared("Cat1"));
+        CHECK(list1.isShared("Cat2"));
+        CHECK(list2.isShared("Cat2"));
+
+        CHECK_EQUAL(10, list1.get("Cat1", "int")->toInt());
+        CHECK_EQUAL(20, list2.get("Cat1", "int")->toInt());
+    }
+
+
+    TEST(NonConstAccessDetaches)
+    {
+        PropertiesList list1;
+        list1.set("Cat1", "int", new Variant(10));
+
+        PropertiesList list2(list1);
+
+        // The value can be modified through the returned pointer
+        Variant* pValue = list2.get("Cat1", "int");
+        CHECK(!list1.isShared("Cat1"));
+
+        *pValue = Variant(20);
+
+        CHECK_EQUAL(10, list1.get("Cat1", "int")->toInt());
+        CHECK_EQUAL(20, list2.get("Cat1", "int")->toInt());
+    }
+
+
+    TEST(ValueTakenBeforeTheCopyOnlyModifiesTheOriginal)
+    {
+        PropertiesList list1;
+        list1.set("Cat1", "int", new Variant(10));
+        list1.set("Cat2", "float", new Variant(10.0f));
+
+        Variant* pValue = list1.get("Cat1", "int");
+
+        PropertiesList list2(list1);
+
+        CHECK(!list1.isShared("Cat1"));
+        CHECK(list1.isShared("Cat2"));
+
+        *pValue = Variant(20);
+
+        CHECK_EQUAL(20, list1.get("Cat1", "int")->toInt());
+        CHECK_EQUAL(10, list2.get("Cat1", "int")->toInt());
+    }
+
+
+    TEST(IteratorTakenBeforeTheCopyOnlyModifiesTheOriginal)
+    {
+        PropertiesList list1;
+        list1.set("Cat1", "int", new Variant(10));
+
+        PropertiesList::tCategoriesIterator iter = list1.getCategoriesIterator();
+
+        PropertiesList list2;
+        list2 = list1;
+
+        PropertiesList list3;
+        list3.append(&list1);
+
+        CHECK(!list1.isShared("Cat1"));
+
+        *(iter.peekNextPtr()->values[0].pValue) = Variant(20);
+
+        CHECK_EQUAL(20, list1.get("Cat1", "int")->toInt());
+        CHECK_EQUAL(10, list2.get("Cat1", "int")->toInt());
+        CHECK_EQUAL(10, list3.get("Cat1", "int")->toInt());
+    }
+
+
+    TEST(ConstAccessDoesNotDetach)
+    {
+        PropertiesList list1;
+        list1.set("Cat1", "int", new Variant(10));
+
+        PropertiesList list2(list1);
+        const PropertiesList& constList2 = list2;
+
+        CHECK_EQUAL(10, constList2.get("Cat1", "int")->toInt());
+        CHECK_EQUAL(1, constList2.nbProperties("Cat1"));
+
+        PropertiesList::tConstCategoriesIterator iter = constList2.getCategoriesIterator();
+        CHECK(iter.hasMoreElements());
+        CHECK_EQUAL("Cat1", iter.peekNextPtr()->strName);
+
+        CHECK(list1.isShared("Cat1"));
+    }
+
+
+    TEST(RemoveDetaches)
+    {
+        PropertiesList list1;
+        list1.set("Cat1", "int", new Variant(10));
+        list1.set("Cat1", "bool", new Variant(true));
+
+        PropertiesList list2(list1);
+
+        list2.remove("Cat1", "int");
+
+        CHECK_EQUAL(2, list1.nbProperties("Cat1"));
+        CHECK_EQUAL(1, list2.nbProperties("Cat1"));
+    }
+
+
+    TEST(DestructionOfTheOriginal)
+    {
+        PropertiesList* pList1 = new PropertiesList();
+        pList1->set("Cat1", "int", new Variant(10));
+
+        PropertiesList list2(*pList1);
+        delete pList1;
+
+        CHECK(!list2.isShared("Cat1"));
+        CHECK_EQUAL(10, list2.get("Cat1", "int")->toInt());
+    }
+
+
+    TEST(Assignment)
+    {
+        PropertiesList list1;
+        list1.set("Cat1", "int", new Variant(10));
+
+        PropertiesList list2;
+        list2.set("Cat2", "float", new Variant(10.0f));
+
+        list2 = list1;
+        list2 = list2;
+
+        CHECK(list1.isShared("Cat1"));
+        CHECK_EQUAL(1, list2.nbCategories());
+        CHECK_EQUAL(10, list2.get("Cat1", "int")->toInt());
+
+        // The selected category is kept
+        list2.set("string", new Variant("test"));
+        CHECK_EQUAL(2, list2.nbProperties("Cat1"));
+        CHECK_EQUAL(1, list1.nbProperties("Cat1"));
+    }
+
+
+    TEST(AppendSharesNewCategories)
+    {
+        PropertiesList list1;
+        list1.set("Cat1", "int", new Variant(10));
+
+        PropertiesList list2;
+        list2.set("Cat1", "bool", new Variant(true));
+        list2.set("Cat2", "float", new Variant(10.0f));
+
+        list1.append(&list2);
+
+        CHECK(!list1.isShared("Cat1"));
+        CHECK(list1.isShared("Cat2"));
+        CHECK_EQUAL(2, list1.nbProperties("Cat1"));
+        CHECK_EQUAL(1, list2.nbProperties("Cat1"));
+
+        list1.set("Cat2", "float", new Variant(20.0f));
+
+        CHECK_CLOSE(10.0f, list2.get("Cat2", "float")->toFloat(), 1e-6f);
+        CHECK_CLOSE(20.0f, list1.get("Cat2", "float")->toFloat(), 1e-6f);
+    }
 }
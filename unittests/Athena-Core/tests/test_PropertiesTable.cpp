@@ -0,0 +1,919 @@
+#include <UnitTest++.h>
+#include <Athena-Core/Utils/PropertiesTable.h>
+#include <Athena-Core/Data/Serialization.h>
+#include <Athena-Core/Data/FileDataStream.h>
+#include <Athena-Core/Data/JSONDocument.h>
+#include <Athena-Math/Color.h>
+#include "../mocks/Describable.h"
+
+using namespace Athena;
+using namespace Athena::Math;
+using namespace Athena::Utils;
+using namespace Athena::Data;
+
+
+//---------------------------------------------------------------------------------------
+/// @brief    Same as MockDescribable1, but using a table of properties
+//---------------------------------------------------------------------------------------
+class TableDescribable1: public Describable
+{
+    ATHENA_DESCRIBABLE(TableDescribable1, Describable)
+
+public:
+    TableDescribable1()
+    : strName("test"), bDelayedCalled(false)
+    {
+    }
+
+    Variant* getDelayed() const
+    {
+        return 0;
+    }
+
+    bool setDelayed(Variant* pValue)
+    {
+        bDelayedCalled = true;
+        delete pValue;
+        return false;
+    }
+
+    std::string strName;
+    bool        bDelayedCalled;
+};
+
+
+ATHENA_PROPERTIES_BEGIN(TableDescribable1, "Cat1")
+    ATHENA_PROPERTY("name", std::string, strName)
+    ATHENA_PROPERTY_HANDLERS("delayed", getDelayed, setDelayed)
+ATHENA_PROPERTIES_END()
+
+
+//---------------------------------------------------------------------------------------
+/// @brief    Same as MockDescribable2, but using a table of properties
+//---------------------------------------------------------------------------------------
+class TableDescribable2: public TableDescribable1
+{
+    ATHENA_DESCRIBABLE(TableDescribable2, TableDescribable1)
+
+public:
+    TableDescribable2()
+    : iIndex(10)
+    {
+    }
+
+    int iIndex;
+};
+
+
+ATHENA_PROPERTIES_BEGIN(TableDescribable2, "Cat2")
+    ATHENA_PROPERTY("index", int, iIndex)
+ATHENA_PROPERTIES_END()
+
+
+//---------------------------------------------------------------------------------------
+/// @brief    Describable using a table of properties, with a base class implementing
+///           its methods by hand
+//---------------------------------------------------------------------------------------
+class MixedDescribable: public MockDescribable1
+{
+    ATHENA_DESCRIBABLE(MixedDescribable, MockDescribable1)
+
+public:
+    MixedDescribable()
+    : m_color(1.0f, 0.0f, 0.0f, 1.0f), m_fScale(1.0f)
+    {
+    }
+
+    const Color& getColor() const { return m_color; }
+    void setColor(const Color& color) { m_color = color; }
+
+    float getScale() const { return m_fScale; }
+    void setScale(float fScale) { m_fScale = fScale; }
+
+private:
+    Color   m_color;
+    float   m_fScale;
+};
+
+
+ATHENA_PROPERTIES_BEGIN(MixedDescribable, "Mixed")
+    ATHENA_PROPERTY_ACCESSORS("color", const Color&, getColor, setColor)
+    ATHENA_PROPERTY_ACCESSORS("scale", float, getScale, setScale)
+ATHENA_PROPERTIES_END()
+
+
+//---------------------------------------------------------------------------------------
+/// @brief    Another version of MixedDescribable, with the same properties declared in
+///           another order
+//---------------------------------------------------------------------------------------
+class ReorderedMixedDescribable: public MockDescribable1
+{
+    ATHENA_DESCRIBABLE(ReorderedMixedDescribable, MockDescribable1)
+
+public:
+    ReorderedMixedDescribable()
+    : m_color(1.0f, 0.0f, 0.0f, 1.0f), m_fScale(1.0f)
+    {
+    }
+
+    const Color& getColor() const { return m_color; }
+    void setColor(const Color& color) { m_color = color; }
+
+    float getScale() const { return m_fScale; }
+    void setScale(float fScale) { m_fScale = fScale; }
+
+private:
+    Color   m_color;
+    float   m_fScale;
+};
+
+
+ATHENA_PROPERTIES_BEGIN(ReorderedMixedDescribable, "Mixed")
+    ATHENA_PROPERTY_ACCESSORS("scale", float, getScale, setScale)
+    ATHENA_PROPERTY_ACCESSORS("color", const Color&, getColor, setColor)
+ATHENA_PROPERTIES_END()
+
+
+SUITE(PropertiesTableTests)
+{
+    TEST(TableContent)
+    {
+        const PropertiesTable* pTable = TableDescribable2::staticPropertiesTable();
+        CHECK(pTable);
+
+        CHECK_EQUAL("Cat2", pTable->category());
+        CHECK_EQUAL(1, pTable->nbProperties());
+        CHECK_EQUAL("index", pTable->property(0).strName);
+        CHECK_EQUAL(Variant::INTEGER, pTable->property(0).type);
+
+        const PropertiesTable* pBase = pTable->base();
+        CHECK(pBase);
+        CHECK(pBase == TableDescribable1::staticPropertiesTable());
+
+        CHECK_EQUAL("Cat1", pBase->category());
+        CHECK_EQUAL(2, pBase->nbProperties());
+        CHECK_EQUAL(Variant::STRING, pBase->property(0).type);
+        CHECK_EQUAL(Variant::NONE, pBase->property(1).type);
+        CHECK(!pBase->base());
+    }
+
+
+    TEST(TableOfTheObject)
+    {
+        TableDescribable2 desc;
+        Describable* pDescribable = &desc;
+
+        CHECK(pDescribable->getPropertiesTable() == TableDescribable2::staticPropertiesTable());
+
+        MockDescribable1 mock;
+        CHECK(!mock.getPropertiesTable());
+    }
+
+
+    TEST(Find)
+    {
+        const PropertiesTable* pTable = TableDescribable1::staticPropertiesTable();
+
+        CHECK_EQUAL(0, pTable->find("name"));
+        CHECK_EQUAL(1, pTable->find("delayed"));
+        CHECK_EQUAL(-1, pTable->find("unknown"));
+        CHECK_EQUAL(-1, pTable->find(""));
+    }
+
+
+    TEST(FindInBigTable)
+    {
+        static const char* NAMES[] = { "a", "b", "c", "d", "e", "f", "g", "h", "i", "j",
+                                       "position", "orientation", "scale", "color" };
+        const unsigned int NB_NAMES = sizeof(NAMES) / sizeof(NAMES[0]);
+
+        PropertiesTable::tDescriptor descriptors[NB_NAMES];
+        for (unsigned int i = 0; i < NB_NAMES; ++i)
+        {
+            descriptors[i].strName = NAMES[i];
+            descriptors[i].type = Variant::NONE;
+            descriptors[i].get = TableDescribable1::staticPropertiesTable()->property(1).get;
+            descriptors[i].set = TableDescribable1::staticPropertiesTable()->property(1).set;
+            descriptors[i].getValue = 0;
+            descriptors[i].setValue = 0;
+        }
+
+        PropertiesTable table("Big", descriptors, NB_NAMES, 0);
+
+        for (unsigned int i = 0; i < NB_NAMES; ++i)
+            CHECK_EQUAL((int) i, table.find(NAMES[i]));
+
+        CHECK_EQUAL(-1, table.find("k"));
+        CHECK_EQUAL(-1, table.find("positio"));
+    }
+
+
+    TEST(CategoriesOrder)
+    {
+        TableDescribable2 desc;
+
+        PropertiesList* pProperties = desc.getProperties();
+        CHECK(pProperties);
+
+        PropertiesList::tCategoriesIterator iter = pProperties->getCategoriesIterator();
+
+        CHECK(iter.hasMoreElements());
+        CHECK_EQUAL("Cat2", iter.getNext().strName);
+
+        CHECK(iter.hasMoreElements());
+        CHECK_EQUAL("Cat1", iter.getNext().strName);
+
+        CHECK(!iter.hasMoreElements());
+
+        delete pProperties;
+    }
+
+
+    TEST(GetProperties)
+    {
+        TableDescribable2 desc;
+
+        PropertiesList* pProperties = desc.getProperties();
+        CHECK(pProperties);
+
+        Variant* pStringValue = pProperties->get("Cat1", "name");
+        Variant* pIntValue = pProperties->get("Cat2", "index");
+
+        CHECK(pStringValue);
+        CHECK(pIntValue);
+        CHECK_EQUAL(desc.strName, pStringValue->toString());
+        CHECK_EQUAL(desc.iIndex, pIntValue->toInt());
+
+        // The handlers returning no value don't produce a property
+        CHECK(!pProperties->get("Cat1", "delayed"));
+        CHECK_EQUAL(2, pProperties->nbTotalProperties());
+
+        delete pProperties;
+    }
+
+
+    TEST(SetProperties)
+    {
+        TableDescribable2 desc;
+
+        PropertiesList* pProperties = new PropertiesList();
+
+        pProperties->selectCategory("Cat1");
+        pProperties->set("name", new Variant("hello"));
+
+        pProperties->selectCategory("Cat2", false);
+        pProperties->set("index", new Variant(200));
+
+        desc.setProperties(pProperties);
+        delete pProperties;
+
+        CHECK(!desc.getUnknownProperties());
+        CHECK_EQUAL("hello", desc.strName);
+        CHECK_EQUAL(200, desc.iIndex);
+    }
+
+
+    TEST(UnknownProperties)
+    {
+        TableDescribable2 desc;
+
+        PropertiesList* pProperties = new PropertiesList();
+
+        pProperties->selectCategory("Cat3", false);
+        pProperties->set("value", new Variant(37));
+
+        pProperties->selectCategory("Cat2");
+        pProperties->set("unknown", new Variant(12));
+
+        desc.setProperties(pProperties);
+        delete pProperties;
+
+        PropertiesList* pUnknowProperties = desc.getUnknownProperties();
+        CHECK(pUnknowProperties);
+
+        Variant* pIntValue = pUnknowProperties->get("Cat3", "value");
+        CHECK(pIntValue);
+        CHECK_EQUAL(37, pIntValue->toInt());
+
+        // The unknown properties of a known category are ignored
+        CHECK(!pUnknowProperties->get("Cat2", "unknown"));
+        CHECK_EQUAL(10, desc.iIndex);
+    }
+
+
+    TEST(DelayedProperties)
+    {
+        TableDescribable2 desc;
+
+        PropertiesList* pProperties = new PropertiesList();
+
+        pProperties->selectCategory("Cat1");
+        pProperties->set("name", new Variant("hello"));
+        pProperties->set("delayed", new Variant("something"));
+
+        PropertiesList* pDelayedProperties = new PropertiesList();
+
+        desc.setProperties(pProperties, pDelayedProperties);
+        delete pProperties;
+
+        CHECK(desc.bDelayedCalled);
+        CHECK_EQUAL("hello", desc.strName);
+
+        Variant* pValue = pDelayedProperties->get("Cat1", "delayed");
+        CHECK(pValue);
+        CHECK_EQUAL("something", pValue->toString());
+        CHECK_EQUAL(1, pDelayedProperties->nbTotalProperties());
+
+        delete pDelayedProperties;
+    }
+
+
+    TEST(Accessors)
+    {
+        MixedDescribable desc;
+
+        CHECK(desc.setProperty("Mixed", "color", new Variant(Color(0.0f, 0.0f, 1.0f, 1.0f))));
+        CHECK(desc.setProperty("Mixed", "scale", new Variant(2.5f)));
+        CHECK(desc.setProperty("Cat1", "name", new Variant("mixed")));
+
+        CHECK(desc.getColor() == Color(0.0f, 0.0f, 1.0f, 1.0f));
+        CHECK_EQUAL(2.5f, desc.getScale());
+        CHECK_EQUAL("mixed", desc.strName);
+
+        PropertiesList* pProperties = desc.getProperties();
+
+        PropertiesList::tCategoriesIterator iter = pProperties->getCategoriesIterator();
+        CHECK_EQUAL("Mixed", iter.getNext().strName);
+        CHECK_EQUAL("Cat1", iter.getNext().strName);
+
+        Variant* pColor = pProperties->get("Mixed", "color");
+        CHECK(pColor);
+        CHECK_EQUAL(Variant::COLOR, pColor->getType());
+        CHECK(pColor->toColor() == Color(0.0f, 0.0f, 1.0f, 1.0f));
+
+        CHECK_EQUAL(2.5f, pProperties->get("Mixed", "scale")->toFloat());
+        CHECK_EQUAL("mixed", pProperties->get("Cat1", "name")->toString());
+
+        delete pProperties;
+    }
+
+
+    TEST(SameJSONThanHandwrittenImplementation)
+    {
+        MockDescribable2 mock;
+        TableDescribable2 desc;
+
+        CHECK_EQUAL(toJSON(&mock), toJSON(&desc));
+
+        mock.strName = "other";
+        mock.iIndex = -5;
+
+        CHECK(fromJSON(toJSON(&mock), &desc));
+
+        CHECK_EQUAL("other", desc.strName);
+        CHECK_EQUAL(-5, desc.iIndex);
+        CHECK_EQUAL(toJSON(&mock), toJSON(&desc));
+    }
+
+
+    TEST(ResolveHandle)
+    {
+        const PropertiesTable* pTable = TableDescribable2::staticPropertiesTable();
+
+        PropertyHandle handle = pTable->resolve("Cat2", "index");
+        CHECK(handle.isValid());
+        CHECK(handle.table() == pTable);
+        CHECK_EQUAL(0, handle.index());
+
+        // Property of a base class
+        handle = pTable->resolve("Cat1", "delayed");
+        CHECK(handle.isValid());
+        CHECK(handle.table() == TableDescribable1::staticPropertiesTable());
+        CHECK_EQUAL(1, handle.index());
+
+        CHECK(!pTable->resolve("Cat2", "unknown").isValid());
+        CHECK(!pTable->resolve("Cat3", "index").isValid());
+        CHECK(!TableDescribable1::staticPropertiesTable()->resolve("Cat2", "index").isValid());
+
+        TableDescribable2 desc;
+        CHECK(desc.resolveProperty("Cat2", "index") == pTable->resolve("Cat2", "index"));
+
+        MockDescribable2 mock;
+        CHECK(!mock.resolveProperty("Cat2", "index").isValid());
+    }
+
+
+    TEST(HandleValidity)
+    {
+        PropertyHandle handle = TableDescribable1::staticPropertiesTable()->resolve("Cat1", "name");
+
+        TableDescribable1 desc1;
+        TableDescribable2 desc2;
+        MixedDescribable mixed;
+
+        CHECK(handle.isValidFor(&desc1));
+        CHECK(handle.isValidFor(&desc2));
+        CHECK(!handle.isValidFor(&mixed));
+        CHECK(!PropertyHandle().isValidFor(&desc1));
+    }
+
+
+    TEST(TypedAccessWithHandle)
+    {
+        TableDescribable2 desc;
+
+        PropertyHandle index = desc.resolveProperty("Cat2", "index");
+        PropertyHandle name = desc.resolveProperty("Cat1", "name");
+
+        CHECK(desc.setPropertyValue(index, 42));
+        CHECK(desc.setPropertyValue(name, std::string("hello")));
+
+        CHECK_EQUAL(42, desc.iIndex);
+        CHECK_EQUAL("hello", desc.strName);
+
+        int iIndex = 0;
+        std::string strName;
+
+        CHECK(desc.getPropertyValue(index, iIndex));
+        CHECK(desc.getPropertyValue(name, strName));
+
+        CHECK_EQUAL(42, iIndex);
+        CHECK_EQUAL("hello", strName);
+
+        // Conversion between types
+        CHECK(desc.setPropertyValue(index, 12.0f));
+        CHECK_EQUAL(12, desc.iIndex);
+
+        float fIndex = 0.0f;
+        CHECK(desc.getPropertyValue(index, fIndex));
+        CHECK_EQUAL(12.0f, fIndex);
+    }
+
+
+    TEST(AccessorsWithHandle)
+    {
+        MixedDescribable desc;
+
+        PropertyHandle color = desc.resolveProperty("Mixed", "color");
+        PropertyHandle scale = desc.resolveProperty("Mixed", "scale");
+
+        CHECK(desc.setPropertyValue(color, Color(0.0f, 1.0f, 0.0f, 1.0f)));
+        CHECK(desc.setPropertyValue(scale, 3.0f));
+
+        CHECK(desc.getColor() == Color(0.0f, 1.0f, 0.0f, 1.0f));
+        CHECK_EQUAL(3.0f, desc.getScale());
+
+        Color c;
+        CHECK(desc.getPropertyValue(color, c));
+        CHECK(c == Color(0.0f, 1.0f, 0.0f, 1.0f));
+    }
+
+
+    TEST(VariantAccessWithHandle)
+    {
+        TableDescribable2 desc;
+
+        PropertyHandle index = desc.resolveProperty("Cat2", "index");
+
+        CHECK(desc.setPropertyValue(index, Variant("37")));
+        CHECK_EQUAL(37, desc.iIndex);
+
+        Variant value;
+        CHECK(desc.getPropertyValue(index, value));
+        CHECK_EQUAL(Variant::INTEGER, value.getType());
+        CHECK_EQUAL(37, value.toInt());
+    }
+
+
+    TEST(HandlersWithHandle)
+    {
+        TableDescribable2 desc;
+
+        PropertyHandle delayed = desc.resolveProperty("Cat1", "delayed");
+
+        CHECK(!desc.setPropertyValue(delayed, Variant("something")));
+        CHECK(desc.bDelayedCalled);
+
+        desc.bDelayedCalled = false;
+        CHECK(!desc.setPropertyValue(delayed, 10));
+        CHECK(desc.bDelayedCalled);
+
+        // The handler doesn't return any value
+        Variant value;
+        CHECK(!desc.getPropertyValue(delayed, value));
+
+        int iValue = 0;
+        CHECK(!desc.getPropertyValue(delayed, iValue));
+    }
+}
+
+
+SUITE(ChangesTrackingTests)
+{
+    TEST(DisabledByDefault)
+    {
+        TableDescribable2 desc;
+
+        CHECK(!desc.isTrackingChanges());
+
+        desc.setPropertyValue(desc.resolveProperty("Cat2", "index"), 5);
+
+        CHECK(!desc.hasChangedProperties());
+        CHECK_EQUAL(0, desc.nbChangedProperties());
+    }
+
+
+    TEST(SetPropertyMarksTheProperty)
+    {
+        TableDescribable2 desc;
+        desc.setChangesTracking(true);
+
+        PropertyHandle index = desc.resolveProperty("Cat2", "index");
+        PropertyHandle name = desc.resolveProperty("Cat1", "name");
+
+        CHECK(!desc.hasChangedProperties());
+
+        desc.setProperty("Cat1", "name", new Variant("hello"));
+
+        CHECK(desc.hasChangedProperties());
+        CHECK(desc.isPropertyChanged(name));
+        CHECK(!desc.isPropertyChanged(index));
+
+        desc.setPropertyValue(index, 5);
+        CHECK(desc.isPropertyChanged(index));
+        CHECK_EQUAL(2, desc.nbChangedProperties());
+
+        desc.clearChangedProperties();
+        CHECK(!desc.hasChangedProperties());
+        CHECK(!desc.isPropertyChanged(name));
+
+        desc.setPropertyValue(index, Variant(6));
+        CHECK(desc.isPropertyChanged(index));
+        CHECK_EQUAL(1, desc.nbChangedProperties());
+    }
+
+
+    TEST(DelayedPropertiesAreNotMarked)
+    {
+        TableDescribable2 desc;
+        desc.setChangesTracking(true);
+
+        desc.setProperty("Cat1", "delayed", new Variant("something"));
+        desc.setProperty("Cat1", "unknown", new Variant("something"));
+
+        CHECK(desc.bDelayedCalled);
+        CHECK(!desc.hasChangedProperties());
+    }
+
+
+    TEST(MarkPropertyChanged)
+    {
+        TableDescribable2 desc;
+        desc.setChangesTracking(true);
+
+        desc.iIndex = 12;
+
+        CHECK(desc.markPropertyChanged("Cat2", "index"));
+        CHECK(!desc.markPropertyChanged("Cat2", "unknown"));
+
+        CHECK(desc.isPropertyChanged(desc.resolveProperty("Cat2", "index")));
+        CHECK_EQUAL(1, desc.nbChangedProperties());
+
+        desc.setChangesTracking(false);
+        CHECK(!desc.hasChangedProperties());
+    }
+
+
+    TEST(GetChangedProperties)
+    {
+        TableDescribable2 desc;
+        desc.setChangesTracking(true);
+
+        PropertiesList* pChanges = desc.getChangedProperties();
+        CHECK_EQUAL(0, pChanges->nbCategories());
+        delete pChanges;
+
+        desc.setProperty("Cat1", "name", new Variant("hello"));
+        desc.setProperty("Cat2", "index", new Variant(3));
+
+        pChanges = desc.getChangedProperties();
+
+        PropertiesList::tCategoriesIterator iter = pChanges->getCategoriesIterator();
+        CHECK_EQUAL("Cat2", iter.getNext().strName);
+        CHECK_EQUAL("Cat1", iter.getNext().strName);
+        CHECK(!iter.hasMoreElements());
+
+        CHECK_EQUAL(2, pChanges->nbTotalProperties());
+        CHECK_EQUAL("hello", pChanges->get("Cat1", "name")->toString());
+        CHECK_EQUAL(3, pChanges->get("Cat2", "index")->toInt());
+
+        delete pChanges;
+
+        desc.clearChangedProperties();
+        desc.setProperty("Cat2", "index", new Variant(4));
+
+        pChanges = desc.getChangedProperties();
+        CHECK_EQUAL(1, pChanges->nbCategories());
+        CHECK_EQUAL(1, pChanges->nbTotalProperties());
+        CHECK_EQUAL(4, pChanges->get("Cat2", "index")->toInt());
+        delete pChanges;
+    }
+
+
+    TEST(ChangesToJSON)
+    {
+        TableDescribable2 source;
+        TableDescribable2 destination;
+
+        source.setChangesTracking(true);
+        source.setProperty("Cat2", "index", new Variant(25));
+        source.strName = "not sent";
+
+        std::string strChanges = changesToJSON(&source);
+        CHECK(strChanges.find("index") != std::string::npos);
+        CHECK(strChanges.find("name") == std::string::npos);
+
+        CHECK(fromJSON(strChanges, &destination));
+
+        CHECK_EQUAL(25, destination.iIndex);
+        CHECK_EQUAL("test", destination.strName);
+    }
+
+
+    TEST(BinaryChanges)
+    {
+        MixedDescribable source;
+        MixedDescribable destination;
+
+        source.setChangesTracking(true);
+        source.setPropertyValue(source.resolveProperty("Mixed", "color"), Color(0.0f, 1.0f, 0.5f, 1.0f));
+        source.setPropertyValue(source.resolveProperty("Mixed", "scale"), 4.0f);
+        source.strName = "not sent";
+
+        {
+            FileDataStream stream(ATHENA_CORE_UNITTESTS_GENERATED_PATH "changes.bin", DataStream::WRITE);
+            CHECK(writeChanges(&source, &stream));
+        }
+
+        FileDataStream stream(ATHENA_CORE_UNITTESTS_GENERATED_PATH "changes.bin");
+        CHECK(readChanges(&stream, &destination));
+
+        CHECK(destination.getColor() == Color(0.0f, 1.0f, 0.5f, 1.0f));
+        CHECK_EQUAL(4.0f, destination.getScale());
+        CHECK_EQUAL("test", destination.strName);
+    }
+
+
+    TEST(BinaryChangesOfAnotherClass)
+    {
+        TableDescribable2 source;
+        MixedDescribable destination;
+
+        source.setChangesTracking(true);
+        source.setProperty("Cat2", "index", new Variant(3));
+
+        {
+            FileDataStream stream(ATHENA_CORE_UNITTESTS_GENERATED_PATH "changes.bin", DataStream::WRITE);
+            CHECK(writeChanges(&source, &stream));
+        }
+
+        FileDataStream stream(ATHENA_CORE_UNITTESTS_GENERATED_PATH "changes.bin");
+        CHECK(!readChanges(&stream, &destination));
+    }
+
+
+    TEST(BinaryChangesOfAnotherLayoutWithTheSameNumberOfProperties)
+    {
+        MixedDescribable source;
+        ReorderedMixedDescribable destination;
+
+        CHECK_EQUAL(source.getPropertiesTable()->nbTotalProperties(),
+                    destination.getPropertiesTable()->nbTotalProperties());
+
+        source.setChangesTracking(true);
+        source.setPropertyValue(source.resolveProperty("Mixed", "scale"), 4.0f);
+
+        {
+            FileDataStream stream(ATHENA_CORE_UNITTESTS_GENERATED_PATH "changes.bin", DataStream::WRITE);
+            CHECK(writeChanges(&source, &stream));
+        }
+
+        FileDataStream stream(ATHENA_CORE_UNITTESTS_GENERATED_PATH "changes.bin");
+        CHECK(!readChanges(&stream, &destination));
+
+        CHECK_EQUAL(1.0f, destination.getScale());
+        CHECK(destination.getColor() == Color(1.0f, 0.0f, 0.0f, 1.0f));
+    }
+
+
+    TEST(BinaryChangesOfStrings)
+    {
+        TableDescribable2 source;
+        TableDescribable2 destination;
+
+        source.setChangesTracking(true);
+        source.setProperty("Cat1", "name", new Variant("a longer name"));
+        source.setProperty("Cat2", "index", new Variant(-7));
+
+        {
+            FileDataStream stream(ATHENA_CORE_UNITTESTS_GENERATED_PATH "changes.bin", DataStream::WRITE);
+            CHECK(writeChanges(&source, &stream));
+        }
+
+        FileDataStream stream(ATHENA_CORE_UNITTESTS_GENERATED_PATH "changes.bin");
+        CHECK(readChanges(&stream, &destination));
+
+        CHECK_EQUAL("a longer name", destination.strName);
+        CHECK_EQUAL(-7, destination.iIndex);
+    }
+
+
+    TEST(BinaryChangesOfDescribableWithoutTable)
+    {
+        MockDescribable1 destination;
+
+        {
+            FileDataStream stream(ATHENA_CORE_UNITTESTS_GENERATED_PATH "changes.bin", DataStream::WRITE);
+
+            const unsigned long long layoutHash = 0;
+            const unsigned int header[] = { 1, 0 };
+            const unsigned char type = Variant::INTEGER;
+            const int value = 5;
+
+            CHECK_EQUAL(1, stream.writeArray(&layoutHash, 1, DataStream::ENDIAN_LITTLE));
+            CHECK_EQUAL(2, stream.writeArray(header, 2, DataStream::ENDIAN_LITTLE));
+            CHECK_EQUAL(1, stream.writeArray(&type, 1));
+            CHECK_EQUAL(1, stream.writeArray(&value, 1, DataStream::ENDIAN_LITTLE));
+        }
+
+        FileDataStream stream(ATHENA_CORE_UNITTESTS_GENERATED_PATH "changes.bin");
+        CHECK(!readChanges(&stream, &destination));
+    }
+
+
+    TEST(BinaryChangesWithCorruptedStringLength)
+    {
+        TableDescribable2 destination;
+
+        {
+            FileDataStream stream(ATHENA_CORE_UNITTESTS_GENERATED_PATH "changes.bin", DataStream::WRITE);
+
+            const unsigned long long layoutHash = destination.getPropertiesTable()->layoutHash();
+            const unsigned int header[] = { 1, 0 };
+            const unsigned char type = Variant::STRING;
+            const unsigned int length = 0xFFFFFFFF;
+
+            CHECK_EQUAL(1, stream.writeArray(&layoutHash, 1, DataStream::ENDIAN_LITTLE));
+            CHECK_EQUAL(2, stream.writeArray(header, 2, DataStream::ENDIAN_LITTLE));
+            CHECK_EQUAL(1, stream.writeArray(&type, 1));
+            CHECK_EQUAL(1, stream.writeArray(&length, 1, DataStream::ENDIAN_LITTLE));
+            CHECK_EQUAL(4, stream.write("test", 4));
+        }
+
+        FileDataStream stream(ATHENA_CORE_UNITTESTS_GENERATED_PATH "changes.bin");
+        CHECK(!readChanges(&stream, &destination));
+        CHECK_EQUAL("test", destination.strName);
+    }
+}
+
+
+SUITE(LazyLoadingTests)
+{
+    static const char* JSON = "[{\"__category__\": \"Cat2\", \"index\": 100}, "
+                              "{\"__category__\": \"Cat1\", \"name\": \"test2\", \"delayed\": \"unused\"}]";
+
+
+    TEST(PropertiesArePendingUntilAccessed)
+    {
+        TableDescribable2 desc;
+        PropertiesList delayed;
+
+        CHECK(fromJSON(std::string(JSON), &desc, &delayed, true));
+
+        CHECK(desc.hasPendingProperties());
+        CHECK_EQUAL(2, desc.nbPendingProperties());
+        CHECK_EQUAL(10, desc.iIndex);
+        CHECK_EQUAL("test", desc.strName);
+
+        // The properties handled by methods are assigned immediately
+        CHECK(desc.bDelayedCalled);
+        CHECK(delayed.get("Cat1", "delayed"));
+
+        PropertyHandle handle = desc.resolveProperty("Cat2", "index");
+        CHECK(desc.isPropertyPending(handle));
+
+        int index = 0;
+        CHECK(desc.getPropertyValue(handle, index));
+        CHECK_EQUAL(100, index);
+        CHECK_EQUAL(100, desc.iIndex);
+        CHECK(!desc.isPropertyPending(handle));
+        CHECK_EQUAL(1, desc.nbPendingProperties());
+        CHECK_EQUAL("test", desc.strName);
+    }
+
+
+    TEST(MaterializeAll)
+    {
+        TableDescribable2 desc;
+
+        CHECK(fromJSON(std::string(JSON), &desc, 0, true));
+
+        desc.materializeAll();
+
+        CHECK(!desc.hasPendingProperties());
+        CHECK_EQUAL(100, desc.iIndex);
+        CHECK_EQUAL("test2", desc.strName);
+    }
+
+
+    TEST(GetPropertiesMaterializesAll)
+    {
+        TableDescribable2 lazy;
+        TableDescribable2 eager;
+
+        CHECK(fromJSON(std::string(JSON), &lazy, 0, true));
+        CHECK(fromJSON(std::string(JSON), &eager));
+
+        CHECK_EQUAL(toJSON(&eager), toJSON(&lazy));
+        CHECK(!lazy.hasPendingProperties());
+    }
+
+
+    TEST(ModificationDiscardsThePendingValue)
+    {
+        TableDescribable2 desc;
+
+        CHECK(fromJSON(std::string(JSON), &desc, 0, true));
+
+        CHECK(desc.setProperty("Cat1", "name", new Variant("other")));
+        CHECK(desc.setPropertyValue(desc.resolveProperty("Cat2", "index"), 5));
+
+        CHECK(!desc.hasPendingProperties());
+        CHECK_EQUAL("other", desc.strName);
+        CHECK_EQUAL(5, desc.iIndex);
+    }
+
+
+    TEST(SharedDocument)
+    {
+        TableDescribable2 desc1;
+        TableDescribable2 desc2;
+
+        JSONDocument* pDocument = JSONDocument::create();
+        rapidjson::Document& document = pDocument->document();
+
+        document.Parse<0>("[[{\"__category__\": \"Cat2\", \"index\": 1}], "
+                          " [{\"__category__\": \"Cat2\", \"index\": 2}]]");
+        CHECK(!document.HasParseError());
+
+        fromJSON(document[0u], &desc1, pDocument);
+        fromJSON(document[1u], &desc2, pDocument);
+
+        // The describables keep the document alive
+        pDocument->release();
+
+        CHECK(desc1.hasPendingProperties());
+        CHECK(desc2.hasPendingProperties());
+
+        desc2.materializeAll();
+        desc1.materializeAll();
+
+        CHECK_EQUAL(1, desc1.iIndex);
+        CHECK_EQUAL(2, desc2.iIndex);
+    }
+
+
+    TEST(PropertiesWithoutTable)
+    {
+        MixedDescribable desc;
+
+        CHECK(fromJSON(std::string("[{\"__category__\": \"Mixed\", \"scale\": 2.5}, "
+                                   "{\"__category__\": \"Cat1\", \"name\": \"mixed\"}]"),
+                       &desc, 0, true));
+
+        // Only the properties declared in a table are pending
+        CHECK_EQUAL(1, desc.nbPendingProperties());
+        CHECK_EQUAL("mixed", desc.strName);
+        CHECK_EQUAL(1.0f, desc.getScale());
+
+        desc.materializeAll();
+        CHECK_EQUAL(2.5f, desc.getScale());
+    }
+
+
+    TEST(PendingPropertiesAreMarkedAsChanged)
+    {
+        TableDescribable2 desc;
+        desc.setChangesTracking(true);
+
+        CHECK(fromJSON(std::string(JSON), &desc, 0, true));
+
+        CHECK(desc.isPropertyChanged(desc.resolveProperty("Cat2", "index")));
+        CHECK(desc.isPropertyChanged(desc.resolveProperty("Cat1", "name")));
+
+        desc.clearChangedProperties();
+        desc.materializeAll();
+
+        CHECK(!desc.hasChangedProperties());
+    }
+}
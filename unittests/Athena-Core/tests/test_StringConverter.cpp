@@ -0,0 +1,407 @@
+#include <UnitTest++.h>
+#include <Athena-Core/Utils/StringConverter.h>
+#include <sstream>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+using namespace Athena::Utils;
+using namespace Athena::Math;
+using namespace std;
+
+
+template<typename T>
+static string withStream(T val, unsigned short precision, unsigned short width, char fill,
+                         std::ios::fmtflags flags)
+{
+    stringstream stream;
+    stream.precision(precision);
+    stream.width(width);
+    stream.fill(fill);
+    if (flags)
+        stream.setf(flags);
+    stream << val;
+    return stream.str();
+}
+
+
+static string shortest(Real val)
+{
+    char buffer[StringConverter::MAX_NUMBER_LENGTH];
+    char* p = StringConverter::toChars(buffer, buffer + sizeof(buffer), val);
+    return string(buffer, p ? p : buffer);
+}
+
+
+static const Real REALS[] =
+{
+    0.0f, 1.0f, -1.0f, 0.5f, 0.1f, 0.2f, 0.3f, 1.5f, 3.25f, 10.0f, 100.0f, 123456.0f,
+    1234567.0f, 12345678.0f, 1.0f / 3.0f, 2.0f / 3.0f, 3.14159265f, 2.71828182f,
+    1e-3f, 1e-4f, 1e-5f, 1.5e-5f, 1e10f, 1.5e10f, 1e20f, 1e-20f, 1e30f, 3.4e38f,
+    1.17549435e-38f, 1.4e-45f, 0.999999f, 9.9999995f, 999999.5f, 0.00012345f, -0.0f,
+    -123.456f, 65536.0f, 4294967296.0f, 0.7f, 1e6f, 1e7f,
+};
+
+
+SUITE(StringConverterTests)
+{
+    TEST(IntegerToChars)
+    {
+        char buffer[StringConverter::MAX_NUMBER_LENGTH];
+
+        char* p = StringConverter::toChars(buffer, buffer + sizeof(buffer), 0);
+        CHECK_EQUAL("0", string(buffer, p));
+
+        p = StringConverter::toChars(buffer, buffer + sizeof(buffer), -1234567);
+        CHECK_EQUAL("-1234567", string(buffer, p));
+
+        p = StringConverter::toChars(buffer, buffer + sizeof(buffer), 4294967295U);
+        CHECK_EQUAL("4294967295", string(buffer, p));
+
+        p = StringConverter::toChars(buffer, buffer + sizeof(buffer), (long) -2147483647 - 1);
+        CHECK_EQUAL("-2147483648", string(buffer, p));
+    }
+
+
+    TEST(IntegerToCharsTooSmall)
+    {
+        char buffer[4];
+
+        CHECK(!StringConverter::toChars(buffer, buffer + sizeof(buffer), 12345));
+        CHECK(!StringConverter::toChars(buffer, buffer + sizeof(buffer), -1234));
+        CHECK(StringConverter::toChars(buffer, buffer + sizeof(buffer), -123) == buffer + 4);
+    }
+
+
+    TEST(IntegerToStringLikeStreams)
+    {
+        const int values[] = { 0, 1, -1, 9, 10, 99, 100, -100, 12345, -987654321,
+                               2147483647, -2147483647 - 1 };
+
+        const std::ios::fmtflags flags[] = {
+            std::ios::fmtflags(0), std::ios::showpos, std::ios::left, std::ios::internal,
+            std::ios::showpos | std::ios::internal, std::ios::hex,
+            std::ios::hex | std::ios::showbase | std::ios::uppercase, std::ios::oct,
+        };
+
+        for (unsigned int i = 0; i < sizeof(values) / sizeof(int); ++i)
+        {
+            for (unsigned int j = 0; j < sizeof(flags) / sizeof(std::ios::fmtflags); ++j)
+            {
+                CHECK_EQUAL(withStream(values[i], 6, 0, ' ', flags[j]),
+                            StringConverter::toString(values[i], 0, ' ', flags[j]));
+
+                CHECK_EQUAL(withStream(values[i], 6, 12, '*', flags[j]),
+                            StringConverter::toString(values[i], 12, '*', flags[j]));
+
+                CHECK_EQUAL(withStream((unsigned int) values[i], 6, 12, '0', flags[j]),
+                            StringConverter::toString((unsigned int) values[i], 12, '0', flags[j]));
+
+                CHECK_EQUAL(withStream((long) values[i], 6, 3, ' ', flags[j]),
+                            StringConverter::toString((long) values[i], 3, ' ', flags[j]));
+
+                CHECK_EQUAL(withStream((unsigned long) values[i], 6, 0, ' ', flags[j]),
+                            StringConverter::toString((unsigned long) values[i], 0, ' ', flags[j]));
+            }
+        }
+    }
+
+
+    TEST(RealToStringLikeStreams)
+    {
+        const std::ios::fmtflags flags[] = {
+            std::ios::fmtflags(0), std::ios::showpos, std::ios::uppercase,
+            std::ios::left, std::ios::internal | std::ios::showpos, std::ios::fixed,
+            std::ios::scientific, std::ios::showpoint,
+        };
+
+        const unsigned short precisions[] = { 0, 1, 2, 3, 6, 8, 9, 15, 17, 20 };
+
+        for (unsigned int i = 0; i < sizeof(REALS) / sizeof(Real); ++i)
+        {
+            for (unsigned int j = 0; j < sizeof(flags) / sizeof(std::ios::fmtflags); ++j)
+            {
+                for (unsigned int k = 0; k < sizeof(precisions) / sizeof(unsigned short); ++k)
+                {
+                    CHECK_EQUAL(withStream(REALS[i], precisions[k], 14, '_', flags[j]),
+                                StringConverter::toString(REALS[i], precisions[k], 14, '_', flags[j]));
+
+                    CHECK_EQUAL(withStream(-REALS[i], precisions[k], 0, ' ', flags[j]),
+                                StringConverter::toString(-REALS[i], precisions[k], 0, ' ', flags[j]));
+                }
+            }
+        }
+    }
+
+
+    TEST(RealToStringRandom)
+    {
+        srand(42);
+
+        for (unsigned int i = 0; i < 20000; ++i)
+        {
+            unsigned int bits = ((unsigned int) rand() << 16) ^ (unsigned int) rand();
+            bits &= 0x7FFFFFFF;
+
+            // Skip the infinite and NaN values
+            if ((bits >> 23) == 0xFF)
+                continue;
+
+            float value;
+            memcpy(&value, &bits, sizeof(value));
+
+            CHECK_EQUAL(withStream((Real) value, 6, 0, ' ', std::ios::fmtflags(0)),
+                        StringConverter::toString((Real) value));
+        }
+    }
+
+
+    TEST(RealShortest)
+    {
+        CHECK_EQUAL("0", shortest(0.0f));
+        CHECK_EQUAL("-0", shortest(-0.0f));
+        CHECK_EQUAL("1", shortest(1.0f));
+        CHECK_EQUAL("0.1", shortest(0.1f));
+        CHECK_EQUAL("-2.5", shortest(-2.5f));
+        CHECK_EQUAL("100", shortest(100.0f));
+        CHECK_EQUAL("123456", shortest(123456.0f));
+        CHECK_EQUAL("0.0001", shortest(1e-4f));
+        CHECK_EQUAL("1e-05", shortest(1e-5f));
+        CHECK_EQUAL("1e+20", shortest(1e20f));
+    }
+
+
+    TEST(RealShortestRoundTrip)
+    {
+        srand(1234);
+
+        for (unsigned int i = 0; i < sizeof(REALS) / sizeof(Real); ++i)
+            CHECK_EQUAL(REALS[i], (Real) strtod(shortest(REALS[i]).c_str(), 0));
+
+        for (unsigned int i = 0; i < 20000; ++i)
+        {
+            unsigned int bits = ((unsigned int) rand() << 16) ^ (unsigned int) rand();
+            if (((bits >> 23) & 0xFF) == 0xFF)
+                continue;
+
+            float value;
+            memcpy(&value, &bits, sizeof(value));
+
+            string str = shortest(value);
+            CHECK_EQUAL(value, (Real) strtod(str.c_str(), 0));
+            CHECK(str.size() <= 18);
+        }
+    }
+
+
+    TEST(RealSpecialValues)
+    {
+        Real zero = 0.0f;
+
+        CHECK_EQUAL("inf", shortest(1.0f / zero));
+        CHECK_EQUAL("-inf", shortest(-1.0f / zero));
+        CHECK_EQUAL("nan", shortest(zero / zero));
+        CHECK_EQUAL(withStream(1.0f / zero, 6, 0, ' ', std::ios::fmtflags(0)),
+                    StringConverter::toString(1.0f / zero));
+    }
+
+
+    TEST(RealToCharsTooSmall)
+    {
+        char buffer[4];
+
+        CHECK(!StringConverter::toChars(buffer, buffer + sizeof(buffer), 1.125f));
+        CHECK(StringConverter::toChars(buffer, buffer + sizeof(buffer), 1.5f) == buffer + 3);
+        CHECK(!StringConverter::toChars(buffer, buffer + sizeof(buffer), 123.5f, 6));
+    }
+
+
+    TEST(IntegerFromChars)
+    {
+        const char* strText = "-1234xyz";
+        int value = 0;
+
+        StringConverter::tParseResult result = StringConverter::fromChars(strText, strText + 8, value);
+        CHECK_EQUAL(StringConverter::PARSE_SUCCESS, result.error);
+        CHECK_EQUAL(strText + 5, result.pEnd);
+        CHECK_EQUAL(-1234, value);
+
+        result = StringConverter::fromChars(strText, strText + 3, value);
+        CHECK_EQUAL(StringConverter::PARSE_SUCCESS, result.error);
+        CHECK_EQUAL(-12, value);
+
+        result = StringConverter::fromChars(strText + 5, strText + 8, value);
+        CHECK_EQUAL(StringConverter::PARSE_INVALID, result.error);
+        CHECK_EQUAL(strText + 5, result.pEnd);
+        CHECK_EQUAL(-12, value);
+    }
+
+
+    TEST(IntegerFromCharsLimits)
+    {
+        string strText;
+        int intValue = 0;
+        unsigned int uintValue = 0;
+        short shortValue = 0;
+        unsigned short ushortValue = 0;
+
+        strText = "-2147483648";
+        CHECK_EQUAL(StringConverter::PARSE_SUCCESS, StringConverter::fromChars(strText.data(), strText.data() + strText.size(), intValue).error);
+        CHECK_EQUAL(-2147483647 - 1, intValue);
+
+        strText = "2147483648";
+        CHECK_EQUAL(StringConverter::PARSE_OUT_OF_RANGE, StringConverter::fromChars(strText.data(), strText.data() + strText.size(), intValue).error);
+        CHECK_EQUAL(StringConverter::PARSE_SUCCESS, StringConverter::fromChars(strText.data(), strText.data() + strText.size(), uintValue).error);
+        CHECK_EQUAL(2147483648U, uintValue);
+
+        strText = "99999999999999999999999";
+        StringConverter::tParseResult result = StringConverter::fromChars(strText.data(), strText.data() + strText.size(), uintValue);
+        CHECK_EQUAL(StringConverter::PARSE_OUT_OF_RANGE, result.error);
+        CHECK_EQUAL(strText.data() + strText.size(), result.pEnd);
+
+        strText = "-32768";
+        CHECK_EQUAL(StringConverter::PARSE_SUCCESS, StringConverter::fromChars(strText.data(), strText.data() + strText.size(), shortValue).error);
+        CHECK_EQUAL(-32768, shortValue);
+
+        strText = "65536";
+        CHECK_EQUAL(StringConverter::PARSE_OUT_OF_RANGE, StringConverter::fromChars(strText.data(), strText.data() + strText.size(), ushortValue).error);
+
+        strText = "-1";
+        CHECK_EQUAL(StringConverter::PARSE_INVALID, StringConverter::fromChars(strText.data(), strText.data() + strText.size(), ushortValue).error);
+
+        strText = "+";
+        CHECK_EQUAL(StringConverter::PARSE_INVALID, StringConverter::fromChars(strText.data(), strText.data() + strText.size(), intValue).error);
+    }
+
+
+    TEST(RealFromChars)
+    {
+        const char* texts[] = { "0", "-0", "1", "+2.5", "0.1", ".5", "5.", "1e10", "1.5E-3",
+                                "123456789", "3.14159265358979323846", "1e-40", "2e-45",
+                                "340282346638528859811704183484516925440", "1e22", "1e23",
+                                "0.000000000000000000000000000001", "8388609.5", "16777217",
+                                "9007199254740993", "4.9e-324", "1.7976931348623157e308",
+                                "0.30000000000000004", "1e-7", "7.038531e-26" };
+
+        for (unsigned int i = 0; i < sizeof(texts) / sizeof(const char*); ++i)
+        {
+            const char* pLast = texts[i] + strlen(texts[i]);
+
+            float floatValue = 1.0f;
+            StringConverter::tParseResult result = StringConverter::fromChars(texts[i], pLast, floatValue);
+            CHECK_EQUAL(pLast, result.pEnd);
+
+            // Out of range if infinite, or if a non-zero value is rounded to zero
+            float expected = strtof(texts[i], 0);
+            if ((expected - expected == 0) && ((expected != 0) || (strtod(texts[i], 0) == 0)))
+            {
+                CHECK_EQUAL(StringConverter::PARSE_SUCCESS, result.error);
+                CHECK_EQUAL(expected, floatValue);
+            }
+            else
+            {
+                CHECK_EQUAL(StringConverter::PARSE_OUT_OF_RANGE, result.error);
+                CHECK_EQUAL(1.0f, floatValue);
+            }
+
+            double doubleValue = 1.0;
+            result = StringConverter::fromChars(texts[i], pLast, doubleValue);
+            CHECK_EQUAL(StringConverter::PARSE_SUCCESS, result.error);
+            CHECK_EQUAL(pLast, result.pEnd);
+            CHECK_EQUAL(strtod(texts[i], 0), doubleValue);
+        }
+    }
+
+
+    TEST(RealFromCharsRandom)
+    {
+        srand(777);
+
+        for (unsigned int i = 0; i < 20000; ++i)
+        {
+            char buffer[32];
+            int length = sprintf(buffer, "%u.%ue%d", (unsigned int) rand() % 100000000,
+                                 (unsigned int) rand() % 1000, (rand() % 70) - 40);
+
+            float floatValue;
+            CHECK_EQUAL(StringConverter::PARSE_SUCCESS, StringConverter::fromChars(buffer, buffer + length, floatValue).error);
+            CHECK_EQUAL(strtof(buffer, 0), floatValue);
+
+            double doubleValue;
+            CHECK_EQUAL(StringConverter::PARSE_SUCCESS, StringConverter::fromChars(buffer, buffer + length, doubleValue).error);
+            CHECK_EQUAL(strtod(buffer, 0), doubleValue);
+        }
+    }
+
+
+    TEST(RealFromCharsErrors)
+    {
+        const char* texts[] = { "", "-", ".", "e5", "abc", "inf", "nan", "-.e1" };
+
+        for (unsigned int i = 0; i < sizeof(texts) / sizeof(const char*); ++i)
+        {
+            float value = 1.0f;
+            StringConverter::tParseResult result = StringConverter::fromChars(texts[i], texts[i] + strlen(texts[i]), value);
+            CHECK_EQUAL(StringConverter::PARSE_INVALID, result.error);
+            CHECK_EQUAL(texts[i], result.pEnd);
+            CHECK_EQUAL(1.0f, value);
+        }
+
+        const char* strText = "1e39";
+        float value = 1.0f;
+        StringConverter::tParseResult result = StringConverter::fromChars(strText, strText + 4, value);
+        CHECK_EQUAL(StringConverter::PARSE_OUT_OF_RANGE, result.error);
+        CHECK_EQUAL(strText + 4, result.pEnd);
+        CHECK_EQUAL(1.0f, value);
+
+        // Non-zero values too small to be represented
+        strText = "1e-50";
+        result = StringConverter::fromChars(strText, strText + 5, value);
+        CHECK_EQUAL(StringConverter::PARSE_OUT_OF_RANGE, result.error);
+        CHECK_EQUAL(strText + 5, result.pEnd);
+        CHECK_EQUAL(1.0f, value);
+
+        strText = "1e-400";
+        double doubleValue = 1.0;
+        result = StringConverter::fromChars(strText, strText + 6, doubleValue);
+        CHECK_EQUAL(StringConverter::PARSE_OUT_OF_RANGE, result.error);
+        CHECK_EQUAL(1.0, doubleValue);
+
+        // Zero isn't an underflow
+        strText = "0e-400";
+        result = StringConverter::fromChars(strText, strText + 6, doubleValue);
+        CHECK_EQUAL(StringConverter::PARSE_SUCCESS, result.error);
+        CHECK_EQUAL(0.0, doubleValue);
+
+        // The exponent isn't part of the number if not followed by digits
+        strText = "2.5e+x";
+        result = StringConverter::fromChars(strText, strText + 6, value);
+        CHECK_EQUAL(StringConverter::PARSE_SUCCESS, result.error);
+        CHECK_EQUAL(strText + 3, result.pEnd);
+        CHECK_EQUAL(2.5f, value);
+    }
+
+
+    TEST(Parse)
+    {
+        CHECK_EQUAL(42, StringConverter::parseInt("  42"));
+        CHECK_EQUAL(12, StringConverter::parseInt("12abc"));
+        CHECK_EQUAL(0, StringConverter::parseInt("abc"));
+        CHECK_EQUAL(4000000000U, StringConverter::parseUnsignedInt("4000000000"));
+        CHECK_EQUAL(-5L, StringConverter::parseLong("\t-5"));
+        CHECK_EQUAL(7UL, StringConverter::parseUnsignedLong("7"));
+        CHECK_EQUAL(0.25f, StringConverter::parseReal(" 0.25 "));
+        CHECK_EQUAL(0.0f, StringConverter::parseReal("x"));
+    }
+
+
+    TEST(IsNumber)
+    {
+        CHECK(StringConverter::isNumber("12"));
+        CHECK(StringConverter::isNumber(" -1.5e3"));
+        CHECK(!StringConverter::isNumber("12 "));
+        CHECK(!StringConverter::isNumber("12a"));
+        CHECK(!StringConverter::isNumber(""));
+        CHECK(!StringConverter::isNumber("abc"));
+    }
+}
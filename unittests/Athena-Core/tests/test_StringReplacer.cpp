@@ -0,0 +1,234 @@
+#include <UnitTest++.h>
+#include <Athena-Core/Utils/StringReplacer.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+using namespace Athena;
+using namespace Athena::Utils;
+using namespace std;
+
+
+/// Reference implementation: at each position, replace the longest sub-string found
+static string replaceNaively(const string& text, const StringUtils::tReplacementsList& replacements)
+{
+    string result;
+
+    size_t pos = 0;
+    while (pos < text.size())
+    {
+        int best = -1;
+        for (unsigned int i = 0; i < replacements.size(); ++i)
+        {
+            const string& strWhat = replacements[i].first;
+            if (!strWhat.empty() && (text.compare(pos, strWhat.size(), strWhat) == 0) &&
+                ((best == -1) || (strWhat.size() > replacements[best].first.size())))
+            {
+                best = (int) i;
+            }
+        }
+
+        if (best == -1)
+        {
+            result += text[pos];
+            ++pos;
+        }
+        else
+        {
+            result += replacements[best].second;
+            pos += replacements[best].first.size();
+        }
+    }
+
+    return result;
+}
+
+
+SUITE(StringReplacerTests)
+{
+    TEST(SeveralSubStrings)
+    {
+        StringUtils::tReplacementsList replacements;
+        replacements.push_back(make_pair("$(A)", "first"));
+        replacements.push_back(make_pair("$(B)", "second"));
+
+        StringReplacer replacer(replacements);
+
+        CHECK_EQUAL("first and second, then first", replacer.replace("$(A) and $(B), then $(A)"));
+    }
+
+
+    TEST(NoSubString)
+    {
+        StringUtils::tReplacementsList replacements;
+        replacements.push_back(make_pair("ab", "xy"));
+
+        StringReplacer replacer(replacements);
+
+        string s = "cdefgh";
+        CHECK_EQUAL(0, replacer.replaceAll(s));
+        CHECK_EQUAL("cdefgh", s);
+    }
+
+
+    TEST(NoReplacement)
+    {
+        StringUtils::tReplacementsList replacements;
+
+        StringReplacer replacer(replacements);
+
+        CHECK_EQUAL("abcdef", replacer.replace("abcdef"));
+    }
+
+
+    TEST(EmptyText)
+    {
+        StringUtils::tReplacementsList replacements;
+        replacements.push_back(make_pair("ab", "xy"));
+
+        StringReplacer replacer(replacements);
+
+        CHECK_EQUAL("", replacer.replace(""));
+    }
+
+
+    TEST(LeftmostSubStringIsReplaced)
+    {
+        StringUtils::tReplacementsList replacements;
+        replacements.push_back(make_pair("bc", "1"));
+        replacements.push_back(make_pair("abcd", "2"));
+
+        StringReplacer replacer(replacements);
+
+        CHECK_EQUAL("x2y", replacer.replace("xabcdy"));
+        CHECK_EQUAL("xa1y", replacer.replace("xabcy"));
+    }
+
+
+    TEST(LongestSubStringIsReplaced)
+    {
+        StringUtils::tReplacementsList replacements;
+        replacements.push_back(make_pair("ab", "1"));
+        replacements.push_back(make_pair("abc", "2"));
+        replacements.push_back(make_pair("a", "3"));
+
+        StringReplacer replacer(replacements);
+
+        CHECK_EQUAL("2 1 3 2", replacer.replace("abc ab a abc"));
+    }
+
+
+    TEST(SubStringsEndingInsideAnother)
+    {
+        StringUtils::tReplacementsList replacements;
+        replacements.push_back(make_pair("abcde", "1"));
+        replacements.push_back(make_pair("cd", "2"));
+        replacements.push_back(make_pair("ef", "3"));
+
+        StringReplacer replacer(replacements);
+
+        CHECK_EQUAL("1f", replacer.replace("abcdef"));
+        CHECK_EQUAL("ab2x3", replacer.replace("abcdxef"));
+    }
+
+
+    TEST(ReplacementsAreNotScannedAgain)
+    {
+        StringUtils::tReplacementsList replacements;
+        replacements.push_back(make_pair("a", "aa"));
+        replacements.push_back(make_pair("b", "a"));
+
+        StringReplacer replacer(replacements);
+
+        string s = "abab";
+        CHECK_EQUAL(4, replacer.replaceAll(s));
+        CHECK_EQUAL("aaaaaa", s);
+    }
+
+
+    TEST(FirstReplacementOfASubStringIsUsed)
+    {
+        StringUtils::tReplacementsList replacements;
+        replacements.push_back(make_pair("ab", "1"));
+        replacements.push_back(make_pair("ab", "2"));
+        replacements.push_back(make_pair("", "3"));
+
+        StringReplacer replacer(replacements);
+
+        CHECK_EQUAL("1c1", replacer.replace("abcab"));
+    }
+
+
+    TEST(SameResultsThanReplaceAll)
+    {
+        StringUtils::tReplacementsList replacements;
+        replacements.push_back(make_pair("aba", "X"));
+
+        StringReplacer replacer(replacements);
+
+        string text = "abababaabaxabab";
+
+        string expected = text;
+        StringUtils::replaceAll(expected, "aba", "X");
+
+        CHECK_EQUAL(expected, replacer.replace(text));
+        CHECK_EQUAL("XbXXxXb", expected);
+    }
+
+
+    TEST(NonAsciiCharacters)
+    {
+        StringUtils::tReplacementsList replacements;
+        replacements.push_back(make_pair("\xC3\xA9", "e"));
+        replacements.push_back(make_pair("\xFF", "y"));
+
+        StringReplacer replacer(replacements);
+
+        CHECK_EQUAL("ete y", replacer.replace("\xC3\xA9t\xC3\xA9 \xFF"));
+    }
+
+
+    TEST(StringUtilsReplaceAll)
+    {
+        StringUtils::tReplacementsList replacements;
+        replacements.push_back(make_pair("$(NAME)", "world"));
+        replacements.push_back(make_pair("$(GREETING)", "Hello"));
+
+        string s = "$(GREETING), $(NAME)!";
+        StringUtils::replaceAll(s, replacements);
+
+        CHECK_EQUAL("Hello, world!", s);
+    }
+
+
+    TEST(SameResultsThanReferenceImplementation)
+    {
+        srand(42);
+
+        for (unsigned int n = 0; n < 200; ++n)
+        {
+            // Small alphabet, so the sub-strings overlap a lot
+            StringUtils::tReplacementsList replacements;
+
+            unsigned int nbReplacements = 1 + rand() % 6;
+            for (unsigned int i = 0; i < nbReplacements; ++i)
+            {
+                string strWhat(1 + rand() % 4, 'a');
+                for (unsigned int j = 0; j < strWhat.size(); ++j)
+                    strWhat[j] = 'a' + rand() % 3;
+
+                char strWith[16];
+                sprintf(strWith, "<%u>", i);
+
+                replacements.push_back(make_pair(strWhat, string(strWith)));
+            }
+
+            string text(rand() % 60, 'a');
+            for (unsigned int j = 0; j < text.size(); ++j)
+                text[j] = 'a' + rand() % 4;
+
+            StringReplacer replacer(replacements);
+
+            CHECK_EQUAL(replaceNaively(text, replacements), replacer.replace(text));
+        }
+    }
+}
@@ -0,0 +1,174 @@
+#include <UnitTest++.h>
+#include <Athena-Core/Utils/StringTokenizer.h>
+#include <Athena-Core/Utils/StringUtils.h>
+#include <Athena-Core/Data/MemoryDataStream.h>
+
+using namespace Athena;
+using namespace Athena::Utils;
+using namespace Athena::Data;
+using namespace std;
+
+
+SUITE(StringTokenizerTests)
+{
+    TEST(SeveralTokens)
+    {
+        StringTokenizer tokenizer("ab;cd,ef", ";,");
+
+        StringView token;
+
+        CHECK(tokenizer.next(token));
+        CHECK_EQUAL("ab", token.toString());
+
+        CHECK(tokenizer.next(token));
+        CHECK_EQUAL("cd", token.toString());
+
+        CHECK(tokenizer.next(token));
+        CHECK_EQUAL("ef", token.toString());
+
+        CHECK(!tokenizer.next(token));
+    }
+
+
+    TEST(EmptyTokens)
+    {
+        StringTokenizer tokenizer(";ab;;", ";");
+
+        StringView token;
+
+        CHECK(tokenizer.next(token));
+        CHECK(token.empty());
+
+        CHECK(tokenizer.next(token));
+        CHECK_EQUAL("ab", token.toString());
+
+        CHECK(tokenizer.next(token));
+        CHECK(token.empty());
+
+        CHECK(tokenizer.next(token));
+        CHECK(token.empty());
+
+        CHECK(!tokenizer.next(token));
+    }
+
+
+    TEST(EmptyText)
+    {
+        StringTokenizer tokenizer("", ";");
+
+        StringView token;
+
+        CHECK(tokenizer.next(token));
+        CHECK(token.empty());
+
+        CHECK(!tokenizer.next(token));
+    }
+
+
+    TEST(TokensReferenceTheText)
+    {
+        string text = "abc def";
+
+        StringTokenizer tokenizer(text);
+
+        StringView token;
+
+        CHECK(tokenizer.next(token));
+        CHECK_EQUAL(text.data(), token.data());
+        CHECK_EQUAL(3, token.size());
+
+        CHECK(tokenizer.next(token));
+        CHECK_EQUAL(text.data() + 4, token.data());
+        CHECK_EQUAL(3, token.size());
+    }
+
+
+    TEST(SameTokensThanSplit)
+    {
+        string text = "a b\tcc\n\nddd  e\t";
+
+        StringUtils::tStringsList expected = StringUtils::split(text);
+
+        StringTokenizer tokenizer(text);
+
+        StringView token;
+        unsigned int nbTokens = 0;
+
+        while (tokenizer.next(token))
+        {
+            CHECK(nbTokens < expected.size());
+            if (nbTokens < expected.size())
+                CHECK_EQUAL(expected[nbTokens], token.toString());
+
+            ++nbTokens;
+        }
+
+        CHECK_EQUAL(expected.size(), nbTokens);
+    }
+
+
+    TEST(Stream)
+    {
+        string text = "first;second;third";
+
+        MemoryDataStream stream(text.data(), text.size());
+        StringTokenizer tokenizer(&stream, ";", 4);
+
+        StringView token;
+
+        CHECK(tokenizer.next(token));
+        CHECK_EQUAL("first", token.toString());
+
+        CHECK(tokenizer.next(token));
+        CHECK_EQUAL("second", token.toString());
+
+        CHECK(tokenizer.next(token));
+        CHECK_EQUAL("third", token.toString());
+
+        CHECK(!tokenizer.next(token));
+    }
+
+
+    TEST(StreamWithTokensAcrossChunks)
+    {
+        string text;
+        for (unsigned int i = 0; i < 1000; ++i)
+        {
+            text.append(i % 37, 'a' + (i % 26));
+            text += (i % 3 == 0 ? "," : ";");
+        }
+
+        StringUtils::tStringsList expected = StringUtils::split(text, ",;");
+
+        MemoryDataStream stream(text.data(), text.size());
+        StringTokenizer tokenizer(&stream, ",;", 16);
+
+        StringView token;
+        unsigned int nbTokens = 0;
+
+        while (tokenizer.next(token))
+        {
+            CHECK(nbTokens < expected.size());
+            if (nbTokens < expected.size())
+                CHECK_EQUAL(expected[nbTokens], token.toString());
+
+            ++nbTokens;
+        }
+
+        CHECK_EQUAL(expected.size(), nbTokens);
+    }
+
+
+    TEST(EmptyStream)
+    {
+        MemoryDataStream stream("", 0);
+        StringTokenizer tokenizer(&stream);
+
+        StringView token;
+
+        CHECK(tokenizer.next(token));
+        CHECK(token.empty());
+
+        CHECK(!tokenizer.next(token));
+    }
+}
@@ -1,5 +1,6 @@
 #include <UnitTest++.h>
 #include <Athena-Core/Utils/StringUtils.h>
+#include <stdlib.h>
 
 using namespace Athena;
 using namespace Athena::Utils;
@@ -131,6 +132,52 @@ SUITE(StringUtilsTests)
     }
 
 
+    TEST(StartsWith)
+    {
+        string s = "Abcdefgh";
+
+        CHECK(StringUtils::startsWith(s, "abc"));
+        CHECK(!StringUtils::startsWith(s, "abc", false));
+        CHECK(StringUtils::startsWith(s, "Abc", false));
+        CHECK(!StringUtils::startsWith(s, "bcd"));
+        CHECK(!StringUtils::startsWith(s, ""));
+        CHECK(!StringUtils::startsWith(s, "abcdefghi"));
+    }
+
+
+    TEST(StartsWith_View)
+    {
+        const char* text = "ABCdefgh;ijkl";
+
+        CHECK(StringUtils::startsWith(StringView(text, 8), StringView("abcdefgh")));
+        CHECK(!StringUtils::startsWith(StringView(text, 8), StringView("abcdefgh;")));
+        CHECK(StringUtils::startsWith(StringView(text + 9, 4), StringView("ijk"), false));
+    }
+
+
+    TEST(EndsWith)
+    {
+        string s = "abcdeFGH";
+
+        CHECK(StringUtils::endsWith(s, "fgh"));
+        CHECK(!StringUtils::endsWith(s, "fgh", false));
+        CHECK(StringUtils::endsWith(s, "FGH", false));
+        CHECK(!StringUtils::endsWith(s, "efg"));
+        CHECK(!StringUtils::endsWith(s, ""));
+        CHECK(!StringUtils::endsWith(s, "_abcdefgh"));
+    }
+
+
+    TEST(EndsWith_View)
+    {
+        const char* text = "abcdeFGH;ijkl";
+
+        CHECK(StringUtils::endsWith(StringView(text, 8), StringView("defgh")));
+        CHECK(!StringUtils::endsWith(StringView(text, 8), StringView("fgh;")));
+        CHECK(StringUtils::endsWith(StringView(text, 8), StringView("FGH"), false));
+    }
+
+
     TEST(Trim)
     {
         string s = " \tab c\td \t";
@@ -159,4 +206,113 @@ SUITE(StringUtilsTests)
 
         CHECK_EQUAL(" \tab c\td", s);
     }
+
+
+    TEST(ToLowerCase)
+    {
+        string s = "Hello, WORLD! [@Z`az{] \xC3\x89t\xC3\xA9";
+
+        StringUtils::toLowerCase(s);
+
+        CHECK_EQUAL("hello, world! [@z`az{] \xC3\x89t\xC3\xA9", s);
+    }
+
+
+    TEST(ToUpperCase)
+    {
+        string s = "Hello, world! [@Z`az{] \xC3\x89t\xC3\xA9";
+
+        StringUtils::toUpperCase(s);
+
+        CHECK_EQUAL("HELLO, WORLD! [@Z`AZ{] \xC3\x89T\xC3\xA9", s);
+    }
+
+
+    TEST(FindFirstOf)
+    {
+        CHECK_EQUAL(3, StringUtils::findFirstOf("abc;def,ghi", ",;"));
+        CHECK_EQUAL(7, StringUtils::findFirstOf("abc;def,ghi", ","));
+        CHECK_EQUAL(StringView::npos, StringUtils::findFirstOf("abcdefghi", ",;"));
+        CHECK_EQUAL(StringView::npos, StringUtils::findFirstOf("abc;def", ""));
+        CHECK_EQUAL(StringView::npos, StringUtils::findFirstOf("", ",;"));
+    }
+
+
+    TEST(InstructionSetsGiveSameResults)
+    {
+        StringUtils::tInstructionSet initial = StringUtils::instructionSet();
+
+        const StringUtils::tInstructionSet instructionSets[] = {
+            StringUtils::INSTRUCTIONS_SCALAR,
+            StringUtils::INSTRUCTIONS_SSE2,
+            StringUtils::INSTRUCTIONS_AVX2,
+        };
+
+        const char* delims = ";,|\n";
+
+        // Texts of all the lengths up to 100 characters, with the special characters at
+        // all the positions
+        srand(42);
+
+        for (unsigned int length = 0; length <= 100; ++length)
+        {
+            for (unsigned int n = 0; n < 20; ++n)
+            {
+                string text(length, ' ');
+                for (unsigned int i = 0; i < length; ++i)
+                {
+                    unsigned int r = rand() % 8;
+                    text[i] = (r < 3 ? " \t\r"[r] : (r < 5 ? delims[rand() % 4] : (char) (rand() % 256)));
+                }
+
+                // Expected results, computed with the STL
+                string lower = text;
+                string upper = text;
+                for (unsigned int i = 0; i < length; ++i)
+                {
+                    if ((text[i] >= 'A') && (text[i] <= 'Z'))
+                        lower[i] = text[i] + ('a' - 'A');
+                    else if ((text[i] >= 'a') && (text[i] <= 'z'))
+                        upper[i] = text[i] - ('a' - 'A');
+                }
+
+                size_t first = text.find_first_of(delims);
+
+                string trimmed = text;
+                trimmed.erase(trimmed.find_last_not_of(" \t\r") + 1);
+                trimmed.erase(0, trimmed.find_first_not_of(" \t\r"));
+
+                for (unsigned int i = 0; i < 3; ++i)
+                {
+                    if (!StringUtils::setInstructionSet(instructionSets[i]))
+                        continue;
+
+                    string s = text;
+                    StringUtils::toLowerCase(s);
+                    CHECK_EQUAL(lower, s);
+
+                    s = text;
+                    StringUtils::toUpperCase(s);
+                    CHECK_EQUAL(upper, s);
+
+                    CHECK_EQUAL(first, StringUtils::findFirstOf(text, delims));
+
+                    s = text;
+                    StringUtils::trim(s);
+                    CHECK_EQUAL(trimmed, s);
+                }
+            }
+        }
+
+        StringUtils::setInstructionSet(initial);
+    }
+
+
+    TEST(SelectedInstructionSetIsSupported)
+    {
+        StringUtils::tInstructionSet instructionSet = StringUtils::instructionSet();
+
+        CHECK(StringUtils::setInstructionSet(instructionSet));
+        CHECK_EQUAL(instructionSet, StringUtils::instructionSet());
+    }
 }
@@ -0,0 +1,115 @@
+#include <UnitTest++.h>
+#include <Athena-Core/Utils/Thread.h>
+#include <Athena-Core/Utils/Mutex.h>
+#include <Athena-Core/Utils/Condition.h>
+
+using namespace Athena::Utils;
+
+
+class CounterThread: public Thread
+{
+public:
+    CounterThread(Mutex& mutex, unsigned int& counter)
+    : m_mutex(mutex), m_counter(counter)
+    {
+    }
+
+protected:
+    virtual void run()
+    {
+        for (unsigned int i = 0; i < 10000; ++i)
+        {
+            ScopedLock lock(m_mutex);
+            ++m_counter;
+        }
+    }
+
+private:
+    Mutex&          m_mutex;
+    unsigned int&   m_counter;
+};
+
+
+class SignalingThread: public Thread
+{
+public:
+    SignalingThread(Mutex& mutex, Condition& condition, bool& bFlag)
+    : m_mutex(mutex), m_condition(condition), m_bFlag(bFlag)
+    {
+    }
+
+protected:
+    virtual void run()
+    {
+        ScopedLock lock(m_mutex);
+        m_bFlag = true;
+        m_condition.signal();
+    }
+
+private:
+    Mutex&      m_mutex;
+    Condition&  m_condition;
+    bool&       m_bFlag;
+};
+
+
+SUITE(ThreadTests)
+{
+    TEST(MutexTryLock)
+    {
+        Mutex mutex;
+
+        CHECK(mutex.tryLock());
+        mutex.unlock();
+
+        {
+            ScopedLock lock(mutex);
+        }
+
+        CHECK(mutex.tryLock());
+        mutex.unlock();
+    }
+
+
+    TEST(StartAndJoin)
+    {
+        Mutex mutex;
+        unsigned int counter = 0;
+
+        CounterThread thread1(mutex, counter);
+        CounterThread thread2(mutex, counter);
+
+        CHECK(thread1.start());
+        CHECK(thread2.start());
+        CHECK(thread1.isRunning());
+
+        thread1.join();
+        thread2.join();
+
+        CHECK(!thread1.isRunning());
+        CHECK_EQUAL(20000, counter);
+    }
+
+
+    TEST(Condition)
+    {
+        Mutex mutex;
+        Condition condition;
+        bool bFlag = false;
+
+        SignalingThread thread(mutex, condition, bFlag);
+
+        {
+            ScopedLock lock(mutex);
+
+            CHECK(thread.start());
+
+            while (!bFlag)
+                condition.wait(mutex);
+        }
+
+        thread.join();
+
+        CHECK(bFlag);
+    }
+}
@@ -5,11 +5,96 @@ using namespace Athena;
 using namespace Athena::Utils;
 
 
+static void busyWait(unsigned long microseconds)
+{
+    Timer timer;
+    while (timer.getMicroseconds() < microseconds)
+        ;
+}
+
+
 SUITE(TimerTests)
 {
     TEST(Creation)
     {
         Timer timer;
     }
-}
 
+
+    TEST(ElapsedTime)
+    {
+        Timer timer;
+
+        busyWait(5000);
+
+        unsigned long long nanoseconds = timer.getNanoseconds();
+        unsigned long microseconds = timer.getMicroseconds();
+        unsigned long milliseconds = timer.getMilliseconds();
+
+        CHECK(nanoseconds >= 5000000ULL);
+        CHECK(microseconds >= 5000);
+        CHECK(microseconds >= nanoseconds / 1000);
+        CHECK(milliseconds >= 5);
+        CHECK(milliseconds < 1000);
+    }
+
+
+    TEST(Reset)
+    {
+        Timer timer;
+
+        busyWait(5000);
+        timer.reset();
+
+        CHECK(timer.getMicroseconds() < 5000);
+    }
+
+
+    TEST(CPUTime)
+    {
+        Timer timer;
+
+        busyWait(20000);
+
+        CHECK(timer.getMicrosecondsCPU() > 0);
+        CHECK(timer.getMillisecondsCPU() <= timer.getMilliseconds() + 1);
+    }
+
+
+#if ATHENA_PLATFORM == ATHENA_PLATFORM_LINUX
+    TEST(Cycles)
+    {
+        unsigned long long start = Timer::getCycles();
+
+        busyWait(1000);
+
+        CHECK(Timer::getCycles() > start);
+    }
+
+
+    TEST(TSC)
+    {
+        if (!Timer::enableTSC(true))
+        {
+            CHECK(!Timer::isTSCEnabled());
+            return;
+        }
+
+        CHECK(Timer::isTSCEnabled());
+
+        Timer timer;
+        Timer reference;
+        Timer::enableTSC(false);
+        reference.reset();
+
+        busyWait(10000);
+
+        unsigned long long elapsed = timer.getNanoseconds();
+        unsigned long long expected = reference.getNanoseconds();
+
+        CHECK(elapsed >= expected * 9 / 10);
+        CHECK(elapsed <= expected * 11 / 10 + 1000000);
+        CHECK(!Timer::isTSCEnabled());
+    }
+#endif
+}
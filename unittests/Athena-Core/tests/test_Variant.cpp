@@ -382,6 +382,63 @@ SUITE(VariantExplicitConversionsSuite)
     DECLARE_TEST_INVALID_CONVERSION(string, STRING, "test", DOUBLE)
     DECLARE_TEST_INVALID_CONVERSION(string, STRING, "test", BOOLEAN)
 
+    TEST(ConversionFromStringWithWhitespaces)
+    {
+        Variant v(" \t42 ");
+        CHECK(v.convertTo(Variant::INTEGER));
+        CHECK_EQUAL(42, v.toInt());
+
+        Variant v2(" 1.5e3\n");
+        CHECK(v2.convertTo(Variant::FLOAT));
+        CHECK_EQUAL(1500.0f, v2.toFloat());
+
+        Variant v3("( 1 ,2.5,  -3e-1 )");
+        CHECK(v3.convertTo(Variant::VECTOR3));
+        CHECK(Vector3(1.0f, 2.5f, -0.3f) == v3.toVector3());
+    }
+
+    TEST(ConversionFromStringWithTrailingCharacters)
+    {
+        Variant v("10abc");
+        CHECK(!v.convertTo(Variant::INTEGER));
+        CHECK(v.hasType(Variant::STRING));
+        CHECK_EQUAL("10abc", v.toString());
+
+        Variant v2("10.5 m");
+        CHECK(!v2.convertTo(Variant::DOUBLE));
+        CHECK_EQUAL("10.5 m", v2.toString());
+    }
+
+    TEST(ConversionFromStringOutOfRange)
+    {
+        Variant v("70000");
+        CHECK(!v.convertTo(Variant::SHORT));
+        CHECK(v.convertTo(Variant::INTEGER));
+
+        Variant v2("300");
+        CHECK(!v2.convertTo(Variant::UNSIGNED_CHAR));
+
+        Variant v3("-1");
+        CHECK(!v3.convertTo(Variant::UNSIGNED_INTEGER));
+
+        Variant v4("1e40");
+        CHECK(!v4.convertTo(Variant::FLOAT));
+        CHECK(v4.convertTo(Variant::DOUBLE));
+        CHECK_EQUAL(1e40, v4.toDouble());
+
+        Variant v5("1e-50");
+        CHECK(!v5.convertTo(Variant::FLOAT));
+        CHECK(v5.convertTo(Variant::DOUBLE));
+        CHECK_EQUAL(1e-50, v5.toDouble());
+    }
+
+    TEST(InvalidConversionFromStringToVector3)
+    {
+        Variant v("(10.0, 20.0)");
+        CHECK(!v.convertTo(Variant::VECTOR3));
+        CHECK(v.hasType(Variant::STRING));
+    }
+
     // From integer to ...
     DECLARE_TEST_VALID_CONVERSION(int, INTEGER, 10,    STRING,           "10",  toString)
     DECLARE_TEST_VALID_CONVERSION(int, INTEGER, 10,    INTEGER,          10,    toInt)
@@ -0,0 +1,184 @@
+#include <UnitTest++.h>
+#include <Athena-Core/Data/WriteBehindDataStream.h>
+#include <Athena-Core/Data/FileDataStream.h>
+#include <Athena-Core/Utils/Mutex.h>
+#include <string.h>
+
+using namespace Athena::Data;
+using namespace Athena::Utils;
+using namespace std;
+
+
+class FailingDataStream: public DataStream
+{
+public:
+    FailingDataStream(size_t capacity)
+    : DataStream(WRITE), m_capacity(capacity), m_position(0)
+    {
+    }
+
+    virtual size_t read(void* buf, size_t count) { return 0; }
+
+    virtual size_t write(const void* buf, size_t count)
+    {
+        size_t size = std::min(count, m_capacity - m_position);
+        m_position += size;
+        return size;
+    }
+
+    virtual void skip(long count) {}
+    virtual void seek(size_t pos) {}
+    virtual size_t tell() { return m_position; }
+    virtual bool eof() const { return false; }
+    virtual void close() {}
+
+private:
+    size_t m_capacity;
+    size_t m_position;
+};
+
+
+class BlockingDataStream: public FailingDataStream
+{
+public:
+    BlockingDataStream(Mutex& gate)
+    : FailingDataStream(0), m_gate(gate)
+    {
+    }
+
+    // Blocks until the gate is opened, then fails
+    virtual size_t write(const void* buf, size_t count)
+    {
+        ScopedLock lock(m_gate);
+        return FailingDataStream::write(buf, count);
+    }
+
+private:
+    Mutex& m_gate;
+};
+
+
+SUITE(WriteBehindDataStreamTests)
+{
+    TEST(WriteAndClose)
+    {
+        char data[1000];
+        for (unsigned int i = 0; i < 1000; ++i)
+            data[i] = (char) i;
+
+        {
+            WriteBehindDataStream stream(new FileDataStream(ATHENA_CORE_UNITTESTS_GENERATED_PATH "writebehind.bin", DataStream::WRITE), 64, 2);
+
+            for (unsigned int i = 0; i < 10; ++i)
+                CHECK_EQUAL(1000, stream.write(data, 1000));
+
+            CHECK_EQUAL(10000, stream.tell());
+        }
+
+        FileDataStream stream(ATHENA_CORE_UNITTESTS_GENERATED_PATH "writebehind.bin");
+        CHECK(stream.isOpen());
+
+        char buf[1000];
+        for (unsigned int i = 0; i < 10; ++i)
+        {
+            CHECK_EQUAL(1000, stream.read(buf, 1000));
+            CHECK(memcmp(data, buf, 1000) == 0);
+        }
+
+        CHECK_EQUAL(0, stream.read(buf, 1));
+    }
+
+
+    TEST(Flush)
+    {
+        WriteBehindDataStream stream(new FileDataStream(ATHENA_CORE_UNITTESTS_GENERATED_PATH "writebehind.txt", DataStream::WRITE));
+
+        CHECK_EQUAL(6, stream.write("Line 1", 6));
+        CHECK(stream.flush());
+
+        FileDataStream reader(ATHENA_CORE_UNITTESTS_GENERATED_PATH "writebehind.txt");
+
+        char buf[7] = { 0 };
+        CHECK_EQUAL(6, reader.read(buf, 6));
+        CHECK_EQUAL("Line 1", buf);
+
+        CHECK_EQUAL(6, stream.write("Line 2", 6));
+        CHECK(stream.sync());
+
+        CHECK_EQUAL(6, reader.read(buf, 6));
+        CHECK_EQUAL("Line 2", buf);
+    }
+
+
+    TEST(Seek)
+    {
+        {
+            WriteBehindDataStream stream(new FileDataStream(ATHENA_CORE_UNITTESTS_GENERATED_PATH "writebehind.txt", DataStream::WRITE));
+
+            CHECK_EQUAL(12, stream.write("Line 1Line 2", 12));
+            stream.seek(5);
+            CHECK_EQUAL(5, stream.tell());
+            CHECK_EQUAL(1, stream.write("X", 1));
+            CHECK_EQUAL(6, stream.tell());
+        }
+
+        FileDataStream reader(ATHENA_CORE_UNITTESTS_GENERATED_PATH "writebehind.txt");
+
+        char buf[13] = { 0 };
+        CHECK_EQUAL(12, reader.read(buf, 12));
+        CHECK_EQUAL("Line XLine 2", buf);
+    }
+
+
+    TEST(ErrorPropagation)
+    {
+        WriteBehindDataStream stream(new FailingDataStream(100), 64, 2);
+
+        char data[64] = { 0 };
+
+        CHECK_EQUAL(64, stream.write(data, 64));
+        CHECK(stream.flush());
+        CHECK(!stream.hasFailed());
+
+        CHECK_EQUAL(64, stream.write(data, 64));
+        CHECK(!stream.flush());
+        CHECK(stream.hasFailed());
+
+        CHECK_EQUAL(0, stream.write(data, 64));
+        CHECK(!stream.sync());
+    }
+
+
+    TEST(ErrorWithPartiallyFilledBuffer)
+    {
+        Mutex gate;
+        gate.lock();
+
+        WriteBehindDataStream stream(new BlockingDataStream(gate), 64, 2);
+
+        char data[74] = { 0 };
+
+        // The first buffer is handed to the writer thread, the second one is partially
+        // filled
+        CHECK_EQUAL(74, stream.write(data, 74));
+
+        gate.unlock();
+
+        while (!stream.hasFailed())
+            ;
+
+        CHECK_EQUAL(0, stream.write(data, 5));
+        CHECK_EQUAL(74, stream.tell());
+        CHECK(!stream.flush());
+    }
+
+
+    TEST(ReadNotSupported)
+    {
+        WriteBehindDataStream stream(new FailingDataStream(100));
+
+        char buf[10];
+        CHECK_EQUAL(0, stream.read(buf, 10));
+        CHECK(!stream.eof());
+    }
+}